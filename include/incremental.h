@@ -0,0 +1,117 @@
+/**
+ * @file incremental.h
+ * @author Jose Ruiz Alarcon
+ * @brief  Module that defines the functions implemented by incremental.c
+ */
+
+#ifndef _QBAF_INCREMENTAL_H_
+#define _QBAF_INCREMENTAL_H_
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "plan.h"
+
+#define INCREMENTAL_HUB_MIN_DEPENDENCIES 32   /* minimum number of attackers plus supporters of a hub argument */
+
+/**
+ * @brief Struct with the aggregation of the attackers and supporters of a hub argument,
+ * so it can be updated when one of them changes without gathering all of them again.
+ *
+ */
+typedef struct {
+    Py_ssize_t  id;                 /* the id of the hub argument */
+    int         valid;              /* 0 if the aggregation cannot be maintained (e.g. NaN strengths) and must be gathered */
+    Py_ssize_t  updates;            /* number of updates since the aggregation was rebuilt */
+    double      attack_value;       /* sum (sum) or mantissa of the product of the non-zero factors (product) of the attackers */
+    double      support_value;      /* sum (sum) or mantissa of the product of the non-zero factors (product) of the supporters */
+    long        attack_exponent;    /* product: the product of the attackers is attack_value * 2^attack_exponent, so it never underflows */
+    long        support_exponent;   /* product: the product of the supporters is support_value * 2^support_exponent */
+    Py_ssize_t  attack_count;       /* zero factors (product) or attackers out of [-1, 1] (top) */
+    Py_ssize_t  support_count;      /* zero factors (product) */
+    Py_ssize_t *attack_heap;        /* top: max-heap of attacker relations, relative to the attacker offset of id */
+    Py_ssize_t *attack_positions;   /* top: position of every attacker relation in attack_heap */
+    Py_ssize_t *support_heap;       /* top: max-heap of supporter relations, relative to the supporter offset of id */
+    Py_ssize_t *support_positions;  /* top: position of every supporter relation in support_heap */
+} QBAFHubAggregate;
+
+/**
+ * @brief Struct with the state needed to propagate changes of initial strengths
+ * through an acyclic plan with a native aggregation function.
+ *
+ */
+typedef struct {
+    QBAFPlanObject   *plan;         /* borrowed reference, the state is only valid while the plan is used */
+    int               kind;         /* the aggregation function of the plan (sum, product or top) */
+    Py_ssize_t       *hub_indices;  /* the index in hubs of every id, -1 if it is not a hub */
+    QBAFHubAggregate *hubs;         /* the aggregations of the hub arguments */
+    Py_ssize_t        hubs_size;    /* number of hubs */
+    char             *queued;       /* 1 if the id is waiting to be recalculated, 0 otherwise */
+    Py_ssize_t       *queue;        /* min-heap of the ids waiting to be recalculated by topological rank */
+    Py_ssize_t        queue_size;   /* number of items of queue */
+    double           *buffer;       /* scratch space with room for plan->max_dependencies doubles */
+    double           *amplification;    /* upper bound of the number of paths from id to any other argument */
+    char             *out_of_range;     /* 1 if the initial strength of id is not within [0, 1], 0 otherwise */
+    Py_ssize_t        out_of_range_size;    /* number of ids whose initial strength is not within [0, 1] */
+} QBAFIncremental;
+
+/**
+ * @brief Return 1 if changes can be propagated incrementally through plan, 0 otherwise.
+ * It requires an acyclic plan with native functions and the aggregation function sum, product or top.
+ *
+ * @param plan a QBAFPlan
+ * @return int 1 if it is supported, 0 otherwise
+ */
+int QBAFIncremental_Supports(QBAFPlanObject *plan);
+
+/**
+ * @brief Create the incremental state of plan given the current strengths.
+ *
+ * @param plan a QBAFPlan supported by QBAFIncremental_Supports
+ * @param initial_strengths the initial strengths indexed by id
+ * @param final_strengths the final strengths indexed by id
+ * @return QBAFIncremental* the new state, NULL if an error occurred
+ */
+QBAFIncremental *QBAFIncremental_Create(QBAFPlanObject *plan, const double *initial_strengths, const double *final_strengths);
+
+/**
+ * @brief Free the incremental state. It does nothing if incremental is NULL.
+ *
+ * @param incremental the state
+ */
+void QBAFIncremental_Free(QBAFIncremental *incremental);
+
+/**
+ * @brief Mark the argument id as changed (e.g. its initial strength was modified).
+ *
+ * @param incremental the state
+ * @param id the id of the argument
+ */
+void QBAFIncremental_MarkChanged(QBAFIncremental *incremental, Py_ssize_t id);
+
+/**
+ * @brief Set marks[id] to 1 for every argument id that was marked as changed and has not been recalculated yet.
+ *
+ * @param incremental the state
+ * @param marks an array of flags indexed by id
+ */
+void QBAFIncremental_MarkPending(QBAFIncremental *incremental, char *marks);
+
+/**
+ * @brief Recalculate the final strengths of the changed arguments and of every argument whose attackers or supporters changed,
+ * in topological order. The aggregations of the hubs are updated with the changes instead of being gathered again.
+ * A change smaller than tolerance is not propagated to the successors of the argument; the largest error that this
+ * may cause in any final strength is added to staleness_bound (infinity if the semantics is not known to be contracting).
+ * It does not need the GIL.
+ *
+ * @param incremental the state
+ * @param initial_strengths the initial strengths indexed by id
+ * @param final_strengths the final strengths indexed by id, updated in place
+ * @param tolerance the largest change that is not propagated, 0 to propagate every change
+ * @param staleness_bound a pointer to the bound of the error of the final strengths, updated in place
+ * @return Py_ssize_t the number of arguments that were recalculated
+ */
+Py_ssize_t QBAFIncremental_Update(QBAFIncremental *incremental, const double *initial_strengths, double *final_strengths,
+                                  double tolerance, double *staleness_bound);
+
+#endif
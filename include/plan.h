@@ -0,0 +1,291 @@
+/**
+ * @file plan.h
+ * @author Jose Ruiz Alarcon
+ * @brief  Module that defines the functions implemented by plan.c
+ */
+
+#ifndef _QBAF_PLAN_H_
+#define _QBAF_PLAN_H_
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "qbaf_module.h"
+#include "relations.h"
+
+#define PLAN_MAX_RESIDUALS 1024   /* maximum number of residuals kept by a QBAFSolveTrace */
+#define PLAN_PARALLEL_MIN_DEPENDENCIES (1 << 18)  /* minimum number of attackers plus supporters aggregated by several threads */
+#define PLAN_PARALLEL_MAX_THREADS 16   /* maximum number of threads that aggregate the dependencies of an argument */
+#define PLAN_PARALLEL_MIN_COMPONENT_ARGUMENTS (1 << 16)   /* minimum number of arguments of the components evaluated by several threads */
+
+/**
+ * @brief Aggregation function over the final strengths of the attackers and supporters of an argument.
+ *
+ */
+typedef double (*QBAFAggregationFunction)(const double*, Py_ssize_t, const double*, Py_ssize_t);
+
+/**
+ * @brief Influence function over the initial strength and the aggregation of an argument.
+ *
+ */
+typedef double (*QBAFInfluenceFunction)(double, double);
+
+/**
+ * @brief Struct with the semantics and the convergence settings of a QBAFramework.
+ * The callables are borrowed references.
+ *
+ */
+typedef struct {
+    const char *semantics;                      /* name of the semantic model, NULL if it is custom */
+    QBAFAggregationFunction aggregation_function;   /* NULL if aggregation_function_callable must be used */
+    QBAFInfluenceFunction influence_function;       /* NULL if influence_function_callable must be used */
+    PyObject *aggregation_function_callable;    /* aggregation function given from python */
+    PyObject *influence_function_callable;      /* influence function given from python */
+    double min_strength;                        /* min value for the initial strengths */
+    double max_strength;                        /* max value for the initial strengths */
+    int allow_cycles;                           /* 1 if cyclic frameworks are evaluated iteratively, 0 otherwise */
+    Py_ssize_t max_iterations;                  /* maximum number of synchronous iterations for cyclic frameworks */
+    double convergence_threshold;               /* convergence threshold for cyclic frameworks */
+} QBAFSemantics;
+
+/**
+ * @brief Struct that defines the Object Type Plan in a QBAF: the immutable structure of a QBAFramework
+ * ready to be evaluated with different initial strengths.
+ *
+ */
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t  size;               /* number of arguments */
+    PyObject   *arguments;          /* a tuple of QBAFArgument indexed by id (the order of the strength buffers) */
+    Py_ssize_t *dependency_offsets; /* the attackers of id are dependencies[dependency_offsets[id]:supporter_starts[id]] */
+    Py_ssize_t *supporter_starts;   /* and its supporters are dependencies[supporter_starts[id]:dependency_offsets[id+1]] */
+    Py_ssize_t *dependencies;       /* ids of the attackers and supporters of every argument, in two contiguous runs */
+    Py_ssize_t  max_dependencies;   /* the maximum number of attackers plus supporters of an argument */
+    Py_ssize_t *schedule;           /* the ids in topological order, NULL if the framework is cyclic */
+    Py_ssize_t *ranks;              /* the position of every id in schedule, NULL if the framework is cyclic */
+    Py_ssize_t *successor_offsets;  /* the arguments that id attacks or supports are successors[successor_offsets[id]:successor_offsets[id+1]] (built on demand) */
+    Py_ssize_t *successors;         /* ids of the attacked or supported arguments */
+    Py_ssize_t *successor_edges;    /* the index of every successor relation in dependencies */
+    Py_ssize_t  components_size;    /* number of weakly connected components (built on demand) */
+    Py_ssize_t *components;         /* the component of every id, numbered by their smallest id */
+    Py_ssize_t *component_offsets;  /* the members of component c are component_members[component_offsets[c]:component_offsets[c+1]] */
+    Py_ssize_t *component_members;  /* ids of the members of every component, in topological order if the plan is acyclic */
+    QBAFSemantics settings;         /* semantics of the framework (the callables are owned references) */
+    const char *ordering;           /* name of the ordering of the ids: "natural", "rcm" or "topological" */
+} QBAFPlanObject;
+
+/**
+ * @brief Struct with the telemetry of an iterative evaluation.
+ *
+ */
+typedef struct {
+    Py_ssize_t iterations;                      /* number of iterations used */
+    int        converged;                       /* 1 if it converged, 0 otherwise */
+    double     final_residual;                  /* the maximum change of a strength in the last iteration */
+    double     residuals[PLAN_MAX_RESIDUALS];   /* the maximum change of a strength in the sampled iterations */
+    Py_ssize_t residuals_size;                  /* number of items of residuals */
+    Py_ssize_t residual_stride;                 /* number of iterations between two consecutive items of residuals */
+} QBAFSolveTrace;
+
+/**
+ * @brief Struct with cheap statistics of the structure of a plan, used to choose how it is evaluated.
+ *
+ */
+typedef struct {
+    Py_ssize_t relations;               /* number of attack and support relations */
+    Py_ssize_t max_in_degree;           /* the maximum number of attackers plus supporters of an argument */
+    Py_ssize_t components;              /* number of weakly connected components */
+    Py_ssize_t largest_component;       /* number of arguments of the largest weakly connected component */
+    Py_ssize_t levels;                  /* number of topological levels (0 if the plan is cyclic) */
+    Py_ssize_t max_level_width;         /* number of arguments of the widest topological level (0 if the plan is cyclic) */
+    Py_ssize_t cycles;                  /* number of strongly connected components with a cycle */
+    Py_ssize_t largest_cycle;           /* number of arguments of the largest strongly connected component with a cycle */
+    Py_ssize_t arguments_in_cycles;     /* number of arguments that belong to a cycle */
+} QBAFPlanStatistics;
+
+/**
+ * @brief Create a new QBAFPlan from the arguments and relations of a framework.
+ *
+ * @param id_arguments a PyList of QBAFArgument indexed by id
+ * @param argument_ids a PyDict (argument: QBAFArgument, id: int)
+ * @param attack_relations the attack relations
+ * @param support_relations the support relations
+ * @param settings the semantics of the framework
+ * @return PyObject* new QBAFPlan, NULL if an error occurred
+ */
+PyObject *QBAFPlan_Create(PyObject *id_arguments, PyObject *argument_ids,
+                          QBAFARelationsObject *attack_relations, QBAFARelationsObject *support_relations,
+                          const QBAFSemantics *settings);
+
+/**
+ * @brief Return a plan with the same arguments, relations and semantics as plan whose ids follow ordering:
+ * "natural" (plan itself), "rcm" (reverse Cuthill-McKee) or "topological" (by topological level, only for acyclic plans).
+ * The relations of every argument keep their order, so both plans calculate the same final strengths.
+ *
+ * @param plan a QBAFPlan
+ * @param ordering the name of the ordering
+ * @return PyObject* new reference to a QBAFPlan, NULL if an error occurred
+ */
+PyObject *QBAFPlan_Reorder(QBAFPlanObject *plan, const char *ordering);
+
+/**
+ * @brief Return the quotient of plan by strength equivalence: arguments with the same initial strength whose attackers
+ * and supporters are the same multisets of equivalent arguments (the coarsest such partition) are merged into one class.
+ * Equivalent arguments always have the same final strength, so evaluating the quotient with the initial strength of every
+ * class gives the final strengths of all the arguments. The argument of a class in the quotient is its representative
+ * (the first member in topological order if plan is acyclic, the member with the smallest id otherwise),
+ * and its relations keep the order of the relations of the representative.
+ *
+ * @param plan a QBAFPlan
+ * @param initial_strengths the initial strengths indexed by id
+ * @param classes the array (size) where the class of every id is stored
+ * @return PyObject* new QBAFPlan whose ids are the classes, NULL if an error occurred
+ */
+PyObject *QBAFPlan_Compress(QBAFPlanObject *plan, const double *initial_strengths, Py_ssize_t *classes);
+
+/**
+ * @brief Build the successors of every argument of the plan if they have not been built yet.
+ *
+ * @param plan a QBAFPlan
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFPlan_EnsureSuccessors(QBAFPlanObject *plan);
+
+/**
+ * @brief Build the weakly connected components of the plan if they have not been built yet.
+ * Two arguments are in the same component if they are connected by attack or support relations in any direction,
+ * so the final strengths of a component do not depend on the other components.
+ *
+ * @param plan a QBAFPlan
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFPlan_EnsureComponents(QBAFPlanObject *plan);
+
+/**
+ * @brief Fill statistics with the size, degrees, components, topological levels and cycles of the plan.
+ * It builds the components of the plan if they have not been built yet.
+ *
+ * @param plan a QBAFPlan
+ * @param statistics the QBAFPlanStatistics that is filled
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFPlan_Statistics(QBAFPlanObject *plan, QBAFPlanStatistics *statistics);
+
+/**
+ * @brief Return the number of online processors, 1 if threads are not supported.
+ *
+ * @return Py_ssize_t the number of processors
+ */
+Py_ssize_t QBAFPlan_Processors(void);
+
+/**
+ * @brief Return the number of threads used to aggregate the dependencies of an argument, 1 if it is not a hub.
+ * Only the native sum, product and top aggregation functions are split.
+ *
+ * @param plan a QBAFPlan
+ * @param dependencies the number of attackers plus supporters of the argument
+ * @return Py_ssize_t the number of threads
+ */
+Py_ssize_t QBAFPlan_HubThreads(QBAFPlanObject *plan, Py_ssize_t dependencies);
+
+/**
+ * @brief Return the number of threads used by QBAFPlan_EvaluateComponents, 1 if they are evaluated sequentially.
+ * Only the components of acyclic plans with native functions are split, once they have enough arguments.
+ *
+ * @param plan a QBAFPlan
+ * @param components_size the number of components to evaluate
+ * @param members_size the number of arguments of the components to evaluate
+ * @return Py_ssize_t the number of threads
+ */
+Py_ssize_t QBAFPlan_ComponentThreads(QBAFPlanObject *plan, Py_ssize_t components_size, Py_ssize_t members_size);
+
+/**
+ * @brief Return 1 if the plan evaluation does not need the GIL (it has no python callables), 0 otherwise.
+ *
+ * @param plan a QBAFPlan
+ * @return int 1 if the evaluation is native, 0 otherwise
+ */
+int QBAFPlan_IsNative(QBAFPlanObject *plan);
+
+/**
+ * @brief Calculate the final strength of the argument id from the final strengths of its attackers and supporters,
+ * and store it in final_strengths[id].
+ *
+ * @param plan a QBAFPlan
+ * @param id the id of the argument
+ * @param initial_strengths the initial strengths indexed by id
+ * @param final_strengths the final strengths indexed by id
+ * @param buffer scratch space with room for plan->max_dependencies doubles
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFPlan_EvaluateArgument(QBAFPlanObject *plan, Py_ssize_t id, const double *initial_strengths,
+                              double *final_strengths, double *buffer);
+
+/**
+ * @brief Calculate the final strengths of an acyclic plan following its topological order.
+ *
+ * @param plan a QBAFPlan with a schedule
+ * @param initial_strengths the initial strengths indexed by id
+ * @param final_strengths the array where the final strengths are stored
+ * @param buffer scratch space with room for plan->max_dependencies doubles
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFPlan_EvaluateAcyclic(QBAFPlanObject *plan, const double *initial_strengths, double *final_strengths, double *buffer);
+
+/**
+ * @brief Calculate the final strengths of the members of some components of an acyclic plan.
+ * The final strengths of the other arguments are not modified. If the components are large enough
+ * and the plan is native, they are split across threads.
+ *
+ * @param plan a QBAFPlan with a schedule and its components built
+ * @param components the components to evaluate
+ * @param components_size the number of components to evaluate
+ * @param initial_strengths the initial strengths indexed by id
+ * @param final_strengths the array where the final strengths are stored
+ * @param buffer scratch space with room for plan->max_dependencies doubles
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFPlan_EvaluateComponents(QBAFPlanObject *plan, const Py_ssize_t *components, Py_ssize_t components_size,
+                                const double *initial_strengths, double *final_strengths, double *buffer);
+
+/**
+ * @brief Calculate the final strengths of a plan by synchronous fixed-point iteration.
+ * The final strengths are stored even if it does not converge.
+ * If ids is not NULL only those arguments are iterated, so the attackers and supporters of them that are not
+ * in ids (if any) must already have their final strengths (e.g. ids are the members of some components).
+ *
+ * @param plan a QBAFPlan
+ * @param ids the ids of the arguments to iterate, NULL to iterate all of them
+ * @param ids_size the number of ids (ignored if ids is NULL)
+ * @param initial_strengths the initial strengths indexed by id
+ * @param final_strengths the array where the final strengths are stored
+ * @param previous_strengths the array where the strengths of the previous iteration are stored
+ * @param buffer scratch space with room for plan->max_dependencies doubles
+ * @param trace the telemetry of the evaluation (it can be NULL)
+ * @return int 0 if it converged, 1 if it did not converge, -1 if an error occurred
+ */
+int QBAFPlan_EvaluateIterative(QBAFPlanObject *plan, const Py_ssize_t *ids, Py_ssize_t ids_size,
+                               const double *initial_strengths, double *final_strengths,
+                               double *previous_strengths, double *buffer, QBAFSolveTrace *trace);
+
+/**
+ * @brief Calculate the final strengths of a plan under several native semantics at once.
+ * The traversal and the gathering of the strengths of attackers and supporters are shared,
+ * and every semantics is applied once per argument (per iteration if the plan is cyclic).
+ * It does not need the GIL.
+ *
+ * @param plan a QBAFPlan (its convergence settings are used if it is cyclic)
+ * @param semantics count semantics with native aggregation and influence functions
+ * @param count the number of semantics
+ * @param initial_strengths the initial strengths indexed by id
+ * @param final_strengths the array (size * count) where the final strength of id under semantics k is stored in id * count + k
+ * @param work_strengths scratch space with room for 2 * size * count doubles (only used if the plan is cyclic)
+ * @param converged scratch space with room for count flags (only used if the plan is cyclic)
+ * @param buffer scratch space with room for plan->max_dependencies * count doubles
+ * @return int 0 if every semantics converged, 1 otherwise
+ */
+int QBAFPlan_EvaluateMultiple(QBAFPlanObject *plan, const QBAFSemantics *semantics, Py_ssize_t count,
+                              const double *initial_strengths, double *final_strengths,
+                              double *work_strengths, char *converged, double *buffer);
+
+#endif
@@ -12,33 +12,40 @@
 
 /**
  * @brief Given the final strengths of attackers and supporters, return the result of the aggregation function 'sum'.
- * Return -1 if an error has occurred.
  * 
- * @param attacker_strengths PyList of attackers' final strengths
- * @param supporter_strengths PyList of supporters' final strengths
- * @return double the result of the aggregation function 'sum', -1 if an error has occurred.
+ * @param attacker_strengths array of attackers' final strengths
+ * @param attackers_size the number of attackers
+ * @param supporter_strengths array of supporters' final strengths
+ * @param supporters_size the number of supporters
+ * @return double the result of the aggregation function 'sum'
  */
-double sum(PyObject *attacker_strengths, PyObject *supporter_strengths);
+double sum(const double *attacker_strengths, Py_ssize_t attackers_size,
+           const double *supporter_strengths, Py_ssize_t supporters_size);
 
 /**
  * @brief Given the final strengths of attackers and supporters, return the result of the aggregation function 'product'.
- * Return -1 if an error has occurred.
  * 
- * @param attacker_strengths PyList of attackers' final strengths
- * @param supporter_strengths PyList of supporters' final strengths
- * @return double the result of the aggregation function 'product', -1 if an error has occurred.
+ * @param attacker_strengths array of attackers' final strengths
+ * @param attackers_size the number of attackers
+ * @param supporter_strengths array of supporters' final strengths
+ * @param supporters_size the number of supporters
+ * @return double the result of the aggregation function 'product'
  */
-double product(PyObject *attacker_strengths, PyObject *supporter_strengths);
+double product(const double *attacker_strengths, Py_ssize_t attackers_size,
+               const double *supporter_strengths, Py_ssize_t supporters_size);
 
 /**
  * @brief Given the final strengths of attackers and supporters, return the result of the aggregation function 'top'.
- * Return -1 if an error has occurred.
+ * Return -1 if the strength of an attacker is not within [-1, 1].
  * 
- * @param attacker_strengths PyList of attackers' final strengths
- * @param supporter_strengths PyList of supporters' final strengths
- * @return double the result of the aggregation function 'top', -1 if an error has occurred.
+ * @param attacker_strengths array of attackers' final strengths
+ * @param attackers_size the number of attackers
+ * @param supporter_strengths array of supporters' final strengths
+ * @param supporters_size the number of supporters
+ * @return double the result of the aggregation function 'top', -1 if an attacker strength is out of range.
  */
-double top(PyObject *attacker_strengths, PyObject *supporter_strengths);
+double top(const double *attacker_strengths, Py_ssize_t attackers_size,
+           const double *supporter_strengths, Py_ssize_t supporters_size);
 
 /**
  * @brief Return the influence result of the basic model.
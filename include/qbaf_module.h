@@ -24,6 +24,13 @@ PyTypeObject *get_QBAFArgumentType(void);
  */
 PyTypeObject *get_QBAFARelationsType(void);
 
+/**
+ * @brief Get the QBAFARelationsViewType object that defines the class QBAFARelationsView
+ * 
+ * @return PyTypeObject* a pointer to the QBAFARelationsView class definition
+ */
+PyTypeObject *get_QBAFARelationsViewType(void);
+
 /**
  * @brief Get the QBAFrameworkType object that defines the class QBAFramework
  * 
@@ -31,4 +38,11 @@ PyTypeObject *get_QBAFARelationsType(void);
  */
 PyTypeObject *get_QBAFrameworkType(void);
 
+/**
+ * @brief Get the QBAFPlanType object that defines the class QBAFPlan
+ * 
+ * @return PyTypeObject* a pointer to the QBAFPlan class definition
+ */
+PyTypeObject *get_QBAFPlanType(void);
+
 #endif
\ No newline at end of file
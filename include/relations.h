@@ -9,6 +9,7 @@
 
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
+#include <stdint.h>
 
 #include "qbaf_module.h"
 
@@ -19,18 +20,238 @@
  */
 // PyTypeObject *get_QBAFARelationsType(void);
 
+/**
+ * @brief Struct with the ids of the arguments related to an argument.
+ *
+ */
+typedef struct {
+    Py_ssize_t *ids;            /* ids of the related arguments, in the order their relations were added */
+    Py_ssize_t  size;           /* number of items of ids */
+    Py_ssize_t  capacity;       /* allocated length of ids, 0 if ids is part of the block of the relations */
+} QBAFIdArray;
+
+/**
+ * @brief Open addressing hash set of relations between ids.
+ * Every relation is packed in 64 bits: the id of the agent in the high half and the id of the patient in the low half.
+ *
+ */
+typedef struct {
+    uint64_t   *keys;           /* the slots of the table, QBAF_PAIR_EMPTY or QBAF_PAIR_DELETED if they have no relation */
+    Py_ssize_t  size;           /* number of relations */
+    Py_ssize_t  used;           /* number of slots with a relation or QBAF_PAIR_DELETED */
+    Py_ssize_t  mask;           /* number of slots - 1 (a power of 2), 0 if keys is NULL */
+} QBAFPairSet;
+
+/**
+ * @brief Compressed sparse row snapshot of the relations in both directions.
+ * The agents of the argument id are agents[agent_offsets[id]] ... agents[agent_offsets[id + 1] - 1],
+ * in the order their relations were added, and likewise for the patients.
+ *
+ */
+typedef struct {
+    Py_ssize_t  size;               /* number of ids of the snapshot */
+    Py_ssize_t *agent_offsets;      /* size + 1 offsets into agents */
+    Py_ssize_t *agents;             /* the ids of the agents of every argument */
+    Py_ssize_t *patient_offsets;    /* size + 1 offsets into patients */
+    Py_ssize_t *patients;           /* the ids of the patients of every argument */
+} QBAFAdjacency;
+
 /**
  * @brief Struct that defines the Object Type ARelations in a QBAF.
+ * Every argument of a relation is interned with a dense id: the arguments are hashed once when they are
+ * looked up, and the relations of every argument are arrays of ids.
  * 
  */
 typedef struct {
     PyObject_HEAD
-    PyObject *relations;        /* set of tuples (Agent: QBAFArgument, Patient: QBAFArgument) */
-    PyObject *agent_patients;   /* dictonary of (key, value) = (Agent, set of Patients) */
-    PyObject *patient_agents;   /* dictonary of (key, value) = (Patient, set of Agents) */
+    QBAFPairSet pairs;          /* the relations (agent id, patient id); the set of tuples is only created on demand */
+    PyObject *argument_ids;     /* dictionary (argument: QBAFArgument, id: int) with the id of every interned argument */
+    PyObject *id_arguments;     /* list of QBAFArgument indexed by id */
+    QBAFIdArray *patients;      /* the ids of the patients of every agent, indexed by the id of the agent */
+    QBAFIdArray *agents;        /* the ids of the agents of every patient, indexed by the id of the patient */
+    Py_ssize_t ids_capacity;    /* the allocated length of patients and agents */
+    Py_ssize_t *shared;         /* number of copies that share pairs, patients and agents, NULL if only self uses them */
+    Py_ssize_t *block;          /* the ids of the arrays with capacity 0, copied at once from shared relations */
+    QBAFAdjacency adjacency;    /* the snapshot of patients and agents, valid if adjacency_valid is 1 */
+    int adjacency_valid;        /* 1 if adjacency is up to date, 0 if it must be built again */
+    int bound;                  /* 1 if the ids are the internal ids of a QBAFramework, 0 if they are its own */
+    Py_ssize_t version;         /* incremented every time the relations are modified */
     int modifiable;             /* 1 if this object can be modified through python, 0 otherwise */
 } QBAFARelationsObject;
 
+/**
+ * @brief Return the number of relations.
+ *
+ * @param self instance of QBAFARelations
+ * @return Py_ssize_t the number of relations
+ */
+static inline Py_ssize_t
+QBAFARelations_Size(QBAFARelationsObject *self)
+{
+    return self->pairs.size;
+}
+
+/**
+ * @brief Return the ids of the agents of the argument id, and store their number in size.
+ * The array is valid until the relations are modified.
+ *
+ * @param self instance of QBAFARelations
+ * @param id the id of the patient
+ * @param size where the number of agents is stored
+ * @return const Py_ssize_t* the ids of the agents
+ */
+static inline const Py_ssize_t *
+QBAFARelations_AgentIds(QBAFARelationsObject *self, Py_ssize_t id, Py_ssize_t *size)
+{
+    if (id >= self->ids_capacity) {
+        *size = 0;
+        return NULL;
+    }
+    *size = self->agents[id].size;
+    return self->agents[id].ids;
+}
+
+/**
+ * @brief Return the ids of the patients of the argument id, and store their number in size.
+ * The array is valid until the relations are modified.
+ *
+ * @param self instance of QBAFARelations
+ * @param id the id of the agent
+ * @param size where the number of patients is stored
+ * @return const Py_ssize_t* the ids of the patients
+ */
+static inline const Py_ssize_t *
+QBAFARelations_PatientIds(QBAFARelationsObject *self, Py_ssize_t id, Py_ssize_t *size)
+{
+    if (id >= self->ids_capacity) {
+        *size = 0;
+        return NULL;
+    }
+    *size = self->patients[id].size;
+    return self->patients[id].ids;
+}
+
+/**
+ * @brief Return a read-only sequence with the agents (if agents is 1) or the patients (if agents is 0) of argument.
+ * It reads the arrays of ids of self, and it raises a RuntimeError if it is used after self is modified.
+ *
+ * @param self instance of QBAFARelations
+ * @param argument a QBAFArgument
+ * @param agents 1 for the agents of argument, 0 for its patients
+ * @return PyObject* new QBAFARelationsView, NULL if an error occurred
+ */
+PyObject *QBAFARelations_View(QBAFARelationsObject *self, PyObject *argument, int agents);
+
+/**
+ * @brief Return the number of agents (if agents is 1) or patients (if agents is 0) of argument, -1 if an error occurred.
+ *
+ * @param self instance of QBAFARelations
+ * @param argument a QBAFArgument
+ * @param agents 1 for the agents of argument, 0 for its patients
+ * @return Py_ssize_t the number of agents or patients, -1 if an error occurred
+ */
+Py_ssize_t QBAFARelations_Degree(QBAFARelationsObject *self, PyObject *argument, int agents);
+
+/**
+ * @brief Return 1 if self contains the relation between the ids agent and patient, 0 otherwise.
+ * It does not allocate nor look up any argument.
+ *
+ * @param self instance of QBAFARelations
+ * @param agent the id of the agent
+ * @param patient the id of the patient
+ * @return int 1 if contained, 0 if not contained
+ */
+int QBAFARelations_HasRelation(QBAFARelationsObject *self, Py_ssize_t agent, Py_ssize_t patient);
+
+/**
+ * @brief Return 1 if self contains the relation between the arguments with ids agent and patient in other,
+ * 0 if it does not, -1 if an error occurred. Relations bound to the same ids are compared without lookups.
+ *
+ * @param self instance of QBAFARelations
+ * @param other instance of QBAFARelations whose ids are agent and patient (it can be self)
+ * @param agent the id of the agent in other
+ * @param patient the id of the patient in other
+ * @return int 1 if contained, 0 if not contained, -1 if an error occurred
+ */
+int QBAFARelations_ContainsIds(QBAFARelationsObject *self, QBAFARelationsObject *other, Py_ssize_t agent, Py_ssize_t patient);
+
+/**
+ * @brief Return the compressed sparse row snapshot of the relations for the ids 0 ... size - 1.
+ * It is built lazily and kept until the relations are modified, so consecutive traversals share it.
+ *
+ * @param self instance of QBAFARelations
+ * @param size the number of ids (at least the number of ids that have relations)
+ * @return const QBAFAdjacency* the snapshot (owned by self), NULL if an error occurred
+ */
+const QBAFAdjacency *QBAFARelations_Adjacency(QBAFARelationsObject *self, Py_ssize_t size);
+
+/**
+ * @brief Use the ids of a QBAFramework (argument_ids and id_arguments) instead of the own ids of the relations.
+ * Every argument of the relations must have an id. Afterwards the relations cannot be modified from python,
+ * and the QBAFramework assigns the ids of the new arguments.
+ *
+ * @param self instance of QBAFARelations
+ * @param argument_ids a PyDict (argument: QBAFArgument, id: int)
+ * @param id_arguments a PyList of QBAFArgument indexed by id
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFARelations_Bind(QBAFARelationsObject *self, PyObject *argument_ids, PyObject *id_arguments);
+
+/**
+ * @brief Return new relations bound to a QBAFramework (argument_ids and id_arguments) with the same ids as self.
+ * They share the relations of self until one of them is modified, which then copies them.
+ *
+ * @param self instance of QBAFARelations
+ * @param argument_ids a PyDict (argument: QBAFArgument, id: int) with the ids of self
+ * @param id_arguments a PyList of QBAFArgument indexed by id with the ids of self
+ * @return PyObject* new QBAFARelations, NULL if an error occurred
+ */
+PyObject *QBAFARelations_Share(QBAFARelationsObject *self, PyObject *argument_ids, PyObject *id_arguments);
+
+/**
+ * @brief Replace the ids of the QBAFramework that self is bound to by a copy of them with the same ids.
+ *
+ * @param self instance of QBAFARelations bound to a QBAFramework
+ * @param argument_ids a PyDict (argument: QBAFArgument, id: int) equal to the one self uses
+ * @param id_arguments a PyList of QBAFArgument indexed by id equal to the one self uses
+ */
+void QBAFARelations_SetIds(QBAFARelationsObject *self, PyObject *argument_ids, PyObject *id_arguments);
+
+/**
+ * @brief Add the relations (agents[index], patients[index]) between ids of the QBAFramework that self is bound to,
+ * growing the storage once for all of them. Repeated relations are added once.
+ *
+ * @param self instance of QBAFARelations bound to a QBAFramework
+ * @param agents the ids of the agents
+ * @param patients the ids of the patients
+ * @param size the number of relations
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFARelations_AddIdArrays(QBAFARelationsObject *self, const Py_ssize_t *agents, const Py_ssize_t *patients, Py_ssize_t size);
+
+/**
+ * @brief Remove the relations (agents[index], patients[index]) between ids of the QBAFramework that self is bound to.
+ * The relations that are not contained are ignored.
+ *
+ * @param self instance of QBAFARelations bound to a QBAFramework
+ * @param agents the ids of the agents
+ * @param patients the ids of the patients
+ * @param size the number of relations
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFARelations_RemoveIdArrays(QBAFARelationsObject *self, const Py_ssize_t *agents, const Py_ssize_t *patients, Py_ssize_t size);
+
+/**
+ * @brief Give the relations of the argument with id from to the id to, which has no relations.
+ * It is used by a QBAFramework when it reassigns the id of an argument.
+ *
+ * @param self instance of QBAFARelations
+ * @param from the previous id of the argument
+ * @param to the new id of the argument
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int QBAFARelations_MoveId(QBAFARelationsObject *self, Py_ssize_t from, Py_ssize_t to);
+
 /**
  * @brief Create a new object QBAFARelations. It cannot be modified from python.
  * 
@@ -42,6 +263,7 @@ PyObject *QBAFARelations_Create(PyObject *relations);
 /**
  * @brief Return a copy of this instance.
  * New references are created for the copy, except for the QBAFArgument objects.
+ * The copy shares the relations of self until one of them is modified, which then copies them.
  * 
  * @param self instance of QBAFARelations
  * @param Py_UNUSED 
@@ -144,7 +366,7 @@ int _QBAFARelations_remove_arguments(QBAFARelationsObject *self, PyObject *itera
  * 
  * @param self instance of QBAFARelations
  * @param agent instance of QBAFArgument
- * @return PyObject* borrowed PySet of QBAFArgument, NULL if an error occurred
+ * @return PyObject* new PySet of QBAFArgument, NULL if an error occurred
  */
 PyObject * _QBAFARelations_patients_set(QBAFARelationsObject *self, PyObject *agent);
 
@@ -85,6 +85,25 @@ def is_expansion(qbaf_initial: QBAFramework,
 
 
 
+def evaluate_expansion(qbaf_initial: QBAFramework,
+                       qbaf_update: QBAFramework) -> None:
+    """
+    Calculates the final strengths of qbaf_update, a normal expansion of qbaf_initial,
+    reusing the final strengths of qbaf_initial for the arguments that the expansion does not reach.
+    If both QBAFs do not calculate final strengths the same way, they are calculated from scratch when needed.
+
+    Args:
+       qbaf_initial (QBAFramework): The initial QBAF.
+       qbaf_update (QBAFramework): The updated QBAF, a normal expansion of qbaf_initial.
+    """
+    try:
+      qbaf_update.evaluate_expansion(qbaf_initial)
+    except ValueError:
+      pass
+
+
+
+
 def is_general_robust_consistent(qbaf_initial: QBAFramework,
                               qbaf_collection: list[QBAFramework],
                               topic_argument_1: str,
@@ -136,6 +155,7 @@ def is_expansion_robust_consistent(qbaf_initial: QBAFramework,
     updated_qbaf_collection = [qbaf for qbaf in qbaf_collection if (is_expansion(qbaf_initial, qbaf))]
 
     for qbaf in updated_qbaf_collection:
+      evaluate_expansion(qbaf_initial, qbaf)
       if (not qbaf.are_strength_consistent(qbaf_initial,
                                            topic_argument_1,     
                                            topic_argument_2)):
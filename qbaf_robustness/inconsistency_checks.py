@@ -1,5 +1,5 @@
 from qbaf import QBAFramework
-from qbaf_robustness.consistency_checks import is_expansion,is_bounded_update
+from qbaf_robustness.consistency_checks import is_expansion,is_bounded_update,evaluate_expansion
 
 
 
@@ -56,6 +56,7 @@ def is_expansion_robust_inconsistent( qbaf_initial: QBAFramework,
     updated_qbaf_collection = [qbaf for qbaf in qbaf_collection if (is_expansion (qbaf_initial, qbaf))]
 
     for qbaf in updated_qbaf_collection:
+      evaluate_expansion(qbaf_initial, qbaf)
       if (not qbaf.are_strength_consistent(qbaf_initial,
                                        topic_argument_1,
                                        topic_argument_2)):
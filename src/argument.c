@@ -18,6 +18,7 @@ typedef struct {
     PyObject_HEAD
     PyObject *name;         /* name of the argument and identifier */
     PyObject *description;  /* description of the argument */
+    Py_hash_t hash;         /* the hash of name, -1 if it has not been calculated yet */
 } QBAFArgumentObject;
 
 /**
@@ -77,6 +78,7 @@ QBAFArgument_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     QBAFArgumentObject *self;
     self = (QBAFArgumentObject *) type->tp_alloc(type, 0);
     if (self != NULL) {
+        self->hash = -1;
         self->name = PyUnicode_FromString("");
         if (self->name == NULL) {
             Py_DECREF(self);
@@ -112,6 +114,7 @@ QBAFArgument_init(QBAFArgumentObject *self, PyObject *args, PyObject *kwds)
     tmp = self->name;
     Py_INCREF(name);
     self->name = name;
+    self->hash = -1;
     Py_DECREF(tmp);
 
     if (description) {
@@ -196,11 +199,15 @@ QBAFArgument_richcompare(QBAFArgumentObject *self, PyObject *other, int op)
         PyErr_SetString(PyExc_TypeError, "Compare instance of 'QBAFArgument' with instance of a different type not supported");
         return NULL;
     }
+    if (other == (PyObject *)self && (op == Py_EQ || op == Py_NE)) {
+        return PyBool_FromLong(op == Py_EQ);
+    }
     return PyObject_RichCompare(self->name, ((QBAFArgumentObject *)other)->name, op);
 }
 
 /**
  * @brief Return the hash of the name of a QBAFArgument instance.
+ * It is calculated once, since the name cannot be modified.
  * 
  * @param self the QBAFArgument object
  * @return PyObject* a object with the hash
@@ -208,7 +215,10 @@ QBAFArgument_richcompare(QBAFArgumentObject *self, PyObject *other, int op)
 static Py_hash_t
 QBAFArgument_hashfunc(QBAFArgumentObject *self)
 {
-    return PyObject_Hash(self->name);
+    if (self->hash == -1) {
+        self->hash = PyObject_Hash(self->name);
+    }
+    return self->hash;
 }
 
 /**
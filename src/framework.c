@@ -10,11 +10,19 @@
 #include <stdarg.h>
 #include <float.h>
 #include <string.h>
+#include <math.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 #include "framework.h"
 #include "relations.h"
 #include "qbaf_utils.h"
 #include "qbaf_functions.h"
+#include "plan.h"
+#include "incremental.h"
 
 #ifndef stricmp
 #include <ctype.h>
@@ -43,6 +51,14 @@ static const char *STR_EULERBASEDTOP_MODEL = "EulerBasedTop_model";
 static const char *STR_EULERBASED_MODEL = "EulerBased_model";
 static const char *STR_DFQUAD_MODEL = "DFQuAD_model";
 
+static const char *STR_TOPOLOGICAL_SCHEME = "topological";
+static const char *STR_JACOBI_SCHEME = "jacobi";
+static const char *STR_INCREMENTAL_SCHEME = "incremental";
+
+#define SOLVE_INFO_MAX_RESIDUALS 1024   /* maximum number of residuals kept in last_solve_info */
+#define SOLVE_INFO_TOP_ARGUMENTS 10     /* number of arguments with the largest final residuals kept in last_solve_info */
+#define CONSISTENCY_BOUNDS_DEPTH 3     /* depth of the cones whose bounds may decide a strength consistency query */
+
 /**
  * @brief Struct that defines the Object Type Framework in a QBAF.
  * 
@@ -50,22 +66,42 @@ static const char *STR_DFQUAD_MODEL = "DFQuAD_model";
 typedef struct {
     PyObject_HEAD
     PyObject *arguments;            /* a set of QBAFArgument */
-    PyObject *initial_strengths;      /* a dictionary (argument: QBAFArgument, initial_strength: double) */
+    PyObject *argument_ids;         /* a dictionary (argument: QBAFArgument, id: int) with the internal id of every argument */
+    PyObject *id_arguments;         /* a list of QBAFArgument indexed by their internal id */
+    Py_ssize_t *shared;             /* number of copies that share arguments, argument_ids and id_arguments, NULL if only self uses them */
+    double   *initial_strengths;      /* the initial strengths indexed by internal id */
+    double   *final_strengths;        /* the final strengths indexed by internal id (valid if modified is 0, or if the id is not stale) */
+    char     *stale;                  /* 1 if the final strength of the internal id must be calculated again, 0 otherwise */
+    Py_ssize_t strengths_capacity;  /* the allocated length of initial_strengths, final_strengths and stale */
     PyObject *attack_relations;     /* an instance of QBAFARelations */
     PyObject *support_relations;    /* an instance of QBAFARelations */
-    PyObject *final_strengths;        /* a dictionary (argument: QBAFArgument, final_strength: double) */
     int       modified;             /* 0 if the framework has not been modified after calculating the final strengths. Otherwise, 1 */
     int       disjoint_relations;   /* 1 if the attack/support relations must be disjoint, 0 if they do not have to */
     char     *semantics;            /* name of the semantic model */
-    double  (*influence_function)(double, double);   /* influence function that is going to be used to calcualte the final strengths */
-    double  (*aggregation_function)(PyObject*, PyObject*); /* aggregation function that is going to be used to calcualte the final strengths */
+    QBAFInfluenceFunction influence_function;       /* influence function that is going to be used to calcualte the final strengths */
+    QBAFAggregationFunction aggregation_function;   /* aggregation function that is going to be used to calcualte the final strengths */
     double    min_strength;           /* min value for the initial strengths */
     double    max_strength;           /* max value for the initial strengths */
     int       allow_cycles;           /* 1 if cyclic frameworks should be evaluated iteratively, 0 otherwise */
     Py_ssize_t max_iterations;        /* maximum number of synchronous iterations for cyclic frameworks */
     double    convergence_threshold;  /* convergence threshold for cyclic frameworks */
+    int       compress;               /* 1 if strength-equivalent arguments are evaluated once, 0 otherwise */
+    double    incremental_tolerance;  /* changes of final strengths smaller than it are not propagated incrementally */
+    double    staleness_bound;        /* bound of the error of the final strengths caused by the changes that were not propagated */
+    Py_ssize_t outside_unit;          /* number of ids whose initial strength is not within [0, 1] */
+    int       reject_cycles;          /* 1 if relations that create a cycle are rejected when cycles are not allowed, 0 otherwise */
+    int       acyclic;                /* 1 if the relations are acyclic, 0 if they are cyclic, -1 if it is not known */
+    Py_ssize_t *order;                /* if acyclic is 1, an order of the ids where every agent precedes its patients */
+    Py_ssize_t next_order;            /* the order of the next argument that is added */
+    char     *order_marks;            /* scratch flags indexed by id for the searches that maintain order, all 0 between them */
     PyObject *influence_function_callable;   /* influence function given from python */
     PyObject *aggregation_function_callable; /* aggregation function given from python */
+    PyObject *last_solve_info;        /* a dictionary with the telemetry of the last calculation of the final strengths */
+    PyObject *plan;                   /* the cached QBAFPlan of the current structure, NULL if it must be rebuilt */
+    QBAFIncremental *incremental;     /* the state to propagate changes of initial strengths through plan, NULL if not available */
+    int       frozen;                 /* 1 if the framework cannot be modified, 0 otherwise */
+    Py_hash_t fingerprint;            /* the structural hash of a frozen framework */
+    PyThread_type_lock evaluation_lock;   /* held while the final strengths of a frozen framework are calculated */
 } QBAFrameworkObject;
 
 /**
@@ -80,12 +116,14 @@ static int
 QBAFramework_traverse(QBAFrameworkObject *self, visitproc visit, void *arg)
 {
     Py_VISIT(self->arguments);
-    Py_VISIT(self->initial_strengths);
+    Py_VISIT(self->argument_ids);
+    Py_VISIT(self->id_arguments);
     Py_VISIT(self->attack_relations);
     Py_VISIT(self->support_relations);
-    Py_VISIT(self->final_strengths);
     Py_VISIT(self->influence_function_callable);
     Py_VISIT(self->aggregation_function_callable);
+    Py_VISIT(self->last_solve_info);
+    Py_VISIT(self->plan);
     return 0;
 }
 
@@ -99,12 +137,112 @@ static int
 QBAFramework_clear(QBAFrameworkObject *self)
 {
     Py_CLEAR(self->arguments);
-    Py_CLEAR(self->initial_strengths);
+    Py_CLEAR(self->argument_ids);
+    Py_CLEAR(self->id_arguments);
     Py_CLEAR(self->attack_relations);
     Py_CLEAR(self->support_relations);
-    Py_CLEAR(self->final_strengths);
     Py_CLEAR(self->influence_function_callable);
     Py_CLEAR(self->aggregation_function_callable);
+    Py_CLEAR(self->last_solve_info);
+    Py_CLEAR(self->plan);
+    return 0;
+}
+
+/**
+ * @brief Make copy use the arguments and the internal ids of self, which are shared by both until one of them
+ * adds or removes an argument.
+ *
+ * @param copy a new instance of QBAFramework
+ * @param self an instance of QBAFramework
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_share_arguments(QBAFrameworkObject *copy, QBAFrameworkObject *self)
+{
+    if (self->shared == NULL) {
+        self->shared = PyMem_Malloc(sizeof(Py_ssize_t));
+        if (self->shared == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        *self->shared = 1;
+    }
+    (*self->shared)++;
+    copy->shared = self->shared;
+    Py_INCREF(self->arguments);
+    Py_SETREF(copy->arguments, self->arguments);
+    Py_INCREF(self->argument_ids);
+    Py_SETREF(copy->argument_ids, self->argument_ids);
+    Py_INCREF(self->id_arguments);
+    Py_SETREF(copy->id_arguments, self->id_arguments);
+    return 0;
+}
+
+/**
+ * @brief Make sure self is the only user of its arguments and their internal ids, copying them if they are shared.
+ * It must be called before arguments, argument_ids or id_arguments are modified.
+ *
+ * @param self an instance of QBAFramework
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_unshare_arguments(QBAFrameworkObject *self)
+{
+    if (self->shared == NULL) {
+        return 0;
+    }
+    if (*self->shared == 1) {   // The copies that shared them have been modified or deallocated
+        PyMem_Free(self->shared);
+        self->shared = NULL;
+        return 0;
+    }
+
+    PyObject *arguments = PySet_New(self->arguments);
+    PyObject *argument_ids = PyDict_Copy(self->argument_ids);
+    PyObject *id_arguments = PyList_GetSlice(self->id_arguments, 0, PyList_GET_SIZE(self->id_arguments));
+    if (arguments == NULL || argument_ids == NULL || id_arguments == NULL) {
+        Py_XDECREF(arguments); Py_XDECREF(argument_ids); Py_XDECREF(id_arguments);
+        return -1;
+    }
+    Py_SETREF(self->arguments, arguments);
+    Py_SETREF(self->argument_ids, argument_ids);
+    Py_SETREF(self->id_arguments, id_arguments);
+    QBAFARelations_SetIds((QBAFARelationsObject*)self->attack_relations, argument_ids, id_arguments);
+    QBAFARelations_SetIds((QBAFARelationsObject*)self->support_relations, argument_ids, id_arguments);
+
+    (*self->shared)--;
+    self->shared = NULL;
+    return 0;
+}
+
+/**
+ * @brief Stop sharing the arguments and the internal ids of self with its copies, without copying them.
+ * It is used when they are replaced or deallocated.
+ *
+ * @param self an instance of QBAFramework
+ */
+static inline void
+_QBAFramework_release_arguments(QBAFrameworkObject *self)
+{
+    if (self->shared != NULL && --(*self->shared) == 0) {
+        PyMem_Free(self->shared);
+    }
+    self->shared = NULL;
+}
+
+/**
+ * @brief Return 0 if self can be modified, -1 with a TypeError if it is frozen.
+ *
+ * @param self an instance of QBAFramework
+ * @return int 0 if it can be modified, -1 if it is frozen
+ */
+static inline int
+_QBAFramework_check_mutable(QBAFrameworkObject *self)
+{
+    if (self->frozen) {
+        PyErr_SetString(PyExc_TypeError, "a frozen QBAFramework cannot be modified");
+        return -1;
+    }
     return 0;
 }
 
@@ -118,6 +256,16 @@ QBAFramework_dealloc(QBAFrameworkObject *self)
 {
     PyObject_GC_UnTrack(self);
     QBAFramework_clear(self);
+    _QBAFramework_release_arguments(self);
+    PyMem_Free(self->initial_strengths);
+    PyMem_Free(self->final_strengths);
+    PyMem_Free(self->stale);
+    PyMem_Free(self->order);
+    PyMem_Free(self->order_marks);
+    QBAFIncremental_Free(self->incremental);
+    if (self->evaluation_lock != NULL) {
+        PyThread_free_lock(self->evaluation_lock);
+    }
     Py_TYPE(self)->tp_free((PyObject *) self);
 }
 
@@ -137,14 +285,21 @@ QBAFramework_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (self != NULL) {
         Py_INCREF(Py_None);
         self->arguments = Py_None;
-        Py_INCREF(Py_None);
-        self->initial_strengths = Py_None;
+        self->argument_ids = PyDict_New();
+        self->id_arguments = PyList_New(0);
+        self->shared = NULL;
+        if (self->argument_ids == NULL || self->id_arguments == NULL) {
+            Py_DECREF(self);
+            return NULL;
+        }
+        self->initial_strengths = NULL;
+        self->final_strengths = NULL;
+        self->stale = NULL;
+        self->strengths_capacity = 0;
         Py_INCREF(Py_None);
         self->attack_relations = Py_None;
         Py_INCREF(Py_None);
         self->support_relations = Py_None;
-        Py_INCREF(Py_None);
-        self->final_strengths = Py_None;
         self->modified = TRUE;
         self->disjoint_relations = TRUE;
         self->semantics = STR_BASIC_MODEL;
@@ -155,71 +310,26 @@ QBAFramework_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->allow_cycles = FALSE;
         self->max_iterations = 1000;
         self->convergence_threshold = 1e-9;
+        self->compress = FALSE;
+        self->incremental_tolerance = 0.0;
+        self->staleness_bound = 0.0;
+        self->outside_unit = 0;
+        self->reject_cycles = FALSE;
+        self->acyclic = -1;
+        self->next_order = 0;
         self->influence_function_callable = NULL;
         self->aggregation_function = NULL;
+        Py_INCREF(Py_None);
+        self->last_solve_info = Py_None;
+        self->plan = NULL;
+        self->incremental = NULL;
+        self->frozen = FALSE;
+        self->fingerprint = -1;
+        self->evaluation_lock = NULL;
     }
     return (PyObject *) self;
 }
 
-/**
- * @brief It creates a PyDict from a list of keys and a list of values.
- * 
- * @param keys a list of keys (not NULL)
- * @param values a list of values (not NULL) with same size as keys
- * @return PyObject* New reference
- */
-static inline PyObject *
-PyDict_FromLists(PyObject *keys, PyObject *values) {
-    PyObject *key_iterator, *value_iterator;
-    PyObject *key_item, *value_item;
-
-    key_iterator = PyObject_GetIter(keys);
-    if (key_iterator == NULL) {
-        return NULL;
-    }
-
-    value_iterator = PyObject_GetIter(values);
-    if (value_iterator == NULL) {
-        Py_DECREF(key_iterator);
-        return NULL;
-    }
-
-    PyObject *dict = PyDict_New();
-    if (dict == NULL) {
-        Py_DECREF(key_iterator);
-        Py_DECREF(value_iterator);
-        return NULL;
-    }
-
-    while ((key_item = PyIter_Next(key_iterator))) {    // PyIter_Next returns a new reference
-        value_item = PyIter_Next(value_iterator);
-        if (value_item == NULL) {
-            Py_DECREF(key_item);
-            Py_DECREF(key_iterator);
-            Py_DECREF(value_iterator);
-            Py_DECREF(dict);
-            return NULL; 
-        }
-
-        if (PyDict_SetItem(dict, key_item, value_item) < 0) {
-            Py_DECREF(key_item);
-            Py_DECREF(value_item);
-            Py_DECREF(key_iterator);
-            Py_DECREF(value_iterator);
-            Py_DECREF(dict);
-            return NULL;
-        }
-
-        Py_DECREF(value_item);
-        Py_DECREF(key_item);
-    }
-
-    Py_DECREF(key_iterator);
-    Py_DECREF(value_iterator);
-
-    return dict;
-}
-
 /**
  * @brief It creates a list of PyFloat from a list of numeric (PyFloat or PyLong),
  *        return NULL if an error occurred and raises an exception.
@@ -283,1383 +393,3984 @@ PyListFloat_FromPyListNumeric(PyObject *list) {
 }
 
 /**
- * @brief Return true if the double value of pyfloat is within the range (min, max),
- * false if is not, and -1 if an error has occurred.
- * 
- * @param pyfloat a PyFloat
- * @param max the maximum value of the range
- * @param min the minimum value of the range
- * @return int 1 if within range, 0 if not, -1 if an error occurred
+ * @brief Discard the cached evaluation plan and mark the final strengths as outdated.
+ * It must be called every time the arguments or the relations of the Framework are modified.
+ *
+ * @param self an instance of QBAFramework
  */
-static inline int
-strength_in_minmax(PyObject *pyfloat, double min, double max)
+static inline void
+_QBAFramework_structure_modified(QBAFrameworkObject *self)
 {
-    double strength = PyFloat_AsDouble(pyfloat);
-    if (strength == -1.0 && PyErr_Occurred()) {
-        return -1;
-    }
-
-    if (strength < min || strength > max) {
-        return FALSE;
+    if (self->incremental != NULL) {    // The changes that have not been propagated yet
+        QBAFIncremental_MarkPending(self->incremental, self->stale);
     }
-
-    return TRUE;
+    QBAFIncremental_Free(self->incremental);
+    self->incremental = NULL;
+    Py_CLEAR(self->plan);
+    self->modified = TRUE;
 }
 
+/**
+ * @brief Return 1 and store the internal id of argument in id if argument is in the Framework,
+ * 0 if it is not, -1 if an error has occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param argument a QBAFArgument
+ * @param id a pointer where the internal id is stored
+ * @return int 1 if contained, 0 if not contained, -1 if an error occurred
+ */
 static inline int
-_QBAFramework_initial_strengths_in_minmax(QBAFrameworkObject *self)
+_QBAFramework_argument_id(QBAFrameworkObject *self, PyObject *argument, Py_ssize_t *id)
 {
-    PyObject *initial_strength_list = PyDict_Values(self->initial_strengths);
-    if (initial_strength_list == NULL) {
-        return -1;
-    }
-
-    PyObject *iterator = PyObject_GetIter(initial_strength_list);
-    PyObject *initial_strength;
-    int in_minmax;
-
-    if (iterator == NULL) {
-        Py_DECREF(initial_strength_list);
-        return -1;
+    PyObject *pyid = PyDict_GetItemWithError(self->argument_ids, argument);   // Borrowed reference
+    if (pyid == NULL) {
+        return PyErr_Occurred() ? -1 : FALSE;
     }
-
-    while ((initial_strength = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        in_minmax = strength_in_minmax(initial_strength, self->min_strength, self->max_strength);
-        Py_DECREF(initial_strength);
-
-        if (in_minmax < 0) {
-            Py_DECREF(iterator); Py_DECREF(initial_strength_list);
-            return -1;
-        }
-
-        if (!in_minmax) {
-            Py_DECREF(iterator); Py_DECREF(initial_strength_list);
-            return FALSE;
-        }
-    }
-
-    Py_DECREF(iterator);
-    Py_DECREF(initial_strength_list);
-
+    *id = PyLong_AsSsize_t(pyid);
     return TRUE;
 }
 
 /**
- * @brief Initializer of a QBAFramework instance. It is called right after the constructor by the python interpreter.
- * 
- * @param self the Object 
- * @param args the argument values that might be used by the initializer
- * @param kwds the names of the argument values
- * @return int 0 if it was executed with no errors. Otherwise, -1.
+ * @brief Make sure the strength arrays of the Framework can hold at least capacity arguments.
+ *
+ * @param self an instance of QBAFramework
+ * @param capacity the minimum number of arguments
+ * @return int 0 if successful, -1 if an error occurred
  */
 static int
-QBAFramework_init(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+_QBAFramework_reserve_strengths(QBAFrameworkObject *self, Py_ssize_t capacity)
 {
-    static char *kwlist[] = {"arguments", "initial_strengths", "attack_relations", "support_relations",
-                            "disjoint_relations", "semantics", "aggregation_function", "influence_function",
-                            "min_strength", "max_strength", "allow_cycles", "max_iterations", "convergence_threshold", NULL};
-    PyObject *arguments, *initial_strengths, *attack_relations, *support_relations, *tmp;
-    int disjoint_relations = TRUE;
-    char *semantics = NULL; // (e.g. "basic_model") If None it will be NULL, otherwise it is a pointer to char that is only accesible in this function.
-    PyObject *aggregation_function = NULL, *influence_function = NULL;
-    double min_strength = -DBL_MAX, max_strength = DBL_MAX;
-    int allow_cycles = FALSE;
-    Py_ssize_t max_iterations = 1000;
-    double convergence_threshold = 1e-9;
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|pzOOddpnd", kwlist,
-                                     &arguments, &initial_strengths, &attack_relations, &support_relations,
-                                     &disjoint_relations, &semantics, &aggregation_function, &influence_function,
-                                     &min_strength, &max_strength, &allow_cycles, &max_iterations, &convergence_threshold))
-        return -1;
-
-    if (!PyList_Check(arguments)) {
-        PyErr_SetString(PyExc_TypeError, "arguments must be of type list");
-        return -1;
+    if (capacity <= self->strengths_capacity) {
+        return 0;
+    }
+    Py_ssize_t new_capacity = self->strengths_capacity > 0 ? self->strengths_capacity : 8;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
     }
 
-    if (!PyList_Check(initial_strengths)) {
-        PyErr_SetString(PyExc_TypeError, "initial_strengths must be of type list");
+    double *initial_strengths = PyMem_Realloc(self->initial_strengths, new_capacity * sizeof(double));
+    if (initial_strengths == NULL) {
+        PyErr_NoMemory();
         return -1;
     }
+    self->initial_strengths = initial_strengths;
 
-    if (PyList_GET_SIZE(arguments) != PyList_GET_SIZE(initial_strengths)) {
-        PyErr_SetString(PyExc_ValueError, "the lengths of arguments and initial_strengths must be equal");
+    double *final_strengths = PyMem_Realloc(self->final_strengths, new_capacity * sizeof(double));
+    if (final_strengths == NULL) {
+        PyErr_NoMemory();
         return -1;
     }
-    
-    // Initialize arguments
-    tmp = self->arguments;
-    self->arguments = PySet_New(arguments);
-    if (self->arguments == NULL) {
-        /* propagate error*/
-        self->arguments = tmp;
+    self->final_strengths = final_strengths;
+
+    char *stale = PyMem_Realloc(self->stale, new_capacity * sizeof(char));
+    if (stale == NULL) {
+        PyErr_NoMemory();
         return -1;
     }
-    Py_DECREF(tmp);
+    self->stale = stale;
 
-    // Check that all init strengths are numerical values
-    initial_strengths = PyListFloat_FromPyListNumeric(initial_strengths);   // New reference
-    if (initial_strengths == NULL) {
+    Py_ssize_t *order = PyMem_Realloc(self->order, new_capacity * sizeof(Py_ssize_t));
+    if (order == NULL) {
+        PyErr_NoMemory();
         return -1;
     }
+    self->order = order;
 
-    // Initialize initial_strengths
-    tmp = self->initial_strengths;
-    self->initial_strengths = PyDict_FromLists(arguments, initial_strengths);
-    Py_DECREF(initial_strengths);
-    if (self->initial_strengths == NULL) {
-        /* propagate error*/
-        self->initial_strengths = tmp;
+    char *order_marks = PyMem_Realloc(self->order_marks, new_capacity * sizeof(char));
+    if (order_marks == NULL) {
+        PyErr_NoMemory();
         return -1;
     }
-    Py_DECREF(tmp);
+    memset(order_marks + self->strengths_capacity, FALSE, (new_capacity - self->strengths_capacity) * sizeof(char));
+    self->order_marks = order_marks;
 
-    // Initialize attack relations
-    tmp = self->attack_relations;
-    self->attack_relations = QBAFARelations_Create(attack_relations);
-    if (self->attack_relations == NULL) {
-        /* propagate error*/
-        self->attack_relations = tmp;
+    self->strengths_capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * @brief Return 1 if strength is not within [0, 1], 0 otherwise.
+ *
+ * @param strength an initial strength
+ * @return int 1 if strength is outside [0, 1], 0 otherwise
+ */
+static inline int
+_QBAFramework_outside_unit(double strength)
+{
+    return !(strength >= 0.0 && strength <= 1.0);
+}
+
+/**
+ * @brief Assign an internal id to argument (if it does not have one yet) and set its initial strength.
+ * It does not modify self->arguments.
+ *
+ * @param self an instance of QBAFramework
+ * @param argument a QBAFArgument
+ * @param initial_strength the initial strength of argument
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_insert_argument(QBAFrameworkObject *self, PyObject *argument, double initial_strength)
+{
+    Py_ssize_t id;
+    int contains = _QBAFramework_argument_id(self, argument, &id);
+    if (contains < 0) {
         return -1;
     }
-    Py_DECREF(tmp);
+    if (contains) {
+        self->outside_unit += _QBAFramework_outside_unit(initial_strength) - _QBAFramework_outside_unit(self->initial_strengths[id]);
+        self->initial_strengths[id] = initial_strength;
+        self->stale[id] = TRUE;
+        self->modified = TRUE;
+        return 0;
+    }
 
-    // Initialize support relations
-    tmp = self->support_relations;
-    self->support_relations = QBAFARelations_Create(support_relations);
-    if (self->support_relations == NULL) {
-        /* propagate error*/
-        self->support_relations = tmp;
+    id = PyList_GET_SIZE(self->id_arguments);
+    if (_QBAFramework_unshare_arguments(self) < 0 || _QBAFramework_reserve_strengths(self, id + 1) < 0) {
         return -1;
     }
-    Py_DECREF(tmp);
 
-    // Check that the arguments of attack relations are in the arguments
-    int contained = QBAFARelations_ArgsContained((QBAFARelationsObject*)self->attack_relations, self->arguments);
-    if (contained < 0) {
+    PyObject *pyid = PyLong_FromSsize_t(id);
+    if (pyid == NULL) {
         return -1;
     }
-    if (!contained)  {
-        PyErr_SetString(PyExc_ValueError, "all relation components of attack_relations must be in arguments");
+    if (PyDict_SetItem(self->argument_ids, argument, pyid) < 0) {
+        Py_DECREF(pyid);
         return -1;
     }
+    Py_DECREF(pyid);
 
-    // Check that the arguments of support relations are in the arguments
-    contained = QBAFARelations_ArgsContained((QBAFARelationsObject*)self->support_relations, self->arguments);
-    if (contained < 0) {
-        return -1;
-    }
-    if (!contained)  {
-        PyErr_SetString(PyExc_ValueError, "all relation components of support_relations must be in arguments");
+    if (PyList_Append(self->id_arguments, argument) < 0) {
+        PyDict_DelItem(self->argument_ids, argument);
         return -1;
     }
 
-    
-    self->disjoint_relations = disjoint_relations;
-    self->allow_cycles = allow_cycles;
-    self->max_iterations = max_iterations;
-    self->convergence_threshold = convergence_threshold;
+    self->initial_strengths[id] = initial_strength;
+    self->outside_unit += _QBAFramework_outside_unit(initial_strength);
+    self->stale[id] = TRUE;
+    self->order[id] = self->next_order++;   // An argument without relations can go anywhere in the order
+    _QBAFramework_structure_modified(self);
+    return 0;
+}
 
-    if (self->max_iterations <= 0) {
-        PyErr_SetString(PyExc_ValueError, "max_iterations must be greater than 0");
-        return -1;
+/**
+ * @brief Release the internal id of argument. The last argument takes its id, so ids stay dense.
+ * It does not modify self->arguments.
+ *
+ * @param self an instance of QBAFramework
+ * @param argument a QBAFArgument contained in the Framework
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_delete_argument(QBAFrameworkObject *self, PyObject *argument)
+{
+    Py_ssize_t id;
+    int contains = _QBAFramework_argument_id(self, argument, &id);
+    if (contains <= 0) {
+        return contains;
     }
-    if (self->convergence_threshold <= 0.0) {
-        PyErr_SetString(PyExc_ValueError, "convergence_threshold must be greater than 0");
+    if (_QBAFramework_unshare_arguments(self) < 0) {
         return -1;
     }
+    _QBAFramework_structure_modified(self);
+    self->outside_unit -= _QBAFramework_outside_unit(self->initial_strengths[id]);
 
-    if (self->disjoint_relations) {
-        // Check attack and support relations are disjoint
-        int disjoint = _QBAFARelations_isDisjoint((QBAFARelationsObject*)self->attack_relations, (QBAFARelationsObject*)self->support_relations);
-        if (disjoint < 0) {
+    Py_ssize_t last_id = PyList_GET_SIZE(self->id_arguments) - 1;
+    if (id != last_id) {
+        PyObject *last_argument = PyList_GET_ITEM(self->id_arguments, last_id);
+        PyObject *pyid = PyLong_FromSsize_t(id);
+        if (pyid == NULL) {
             return -1;
         }
-        if (!disjoint) {
-            PyErr_SetString(PyExc_ValueError, "attack_relations and support_relations must be disjoint");
+        if (PyDict_SetItem(self->argument_ids, last_argument, pyid) < 0) {
+            Py_DECREF(pyid);
             return -1;
         }
+        Py_DECREF(pyid);
+        Py_INCREF(last_argument);
+        PyList_SetItem(self->id_arguments, id, last_argument);  // Steals the reference
+        self->initial_strengths[id] = self->initial_strengths[last_id];
+        self->final_strengths[id] = self->final_strengths[last_id];
+        self->stale[id] = self->stale[last_id];
+        self->order[id] = self->order[last_id];
     }
-
-    if (semantics == NULL && PyObject_IsNoneOrNULL(aggregation_function) && PyObject_IsNoneOrNULL(influence_function)) {
-        semantics = STR_BASIC_MODEL;
+    if (QBAFARelations_MoveId((QBAFARelationsObject*)self->attack_relations, last_id, id) < 0 ||
+        QBAFARelations_MoveId((QBAFARelationsObject*)self->support_relations, last_id, id) < 0) {
+        return -1;
     }
 
-    if (semantics != NULL && (min_strength != -DBL_MAX || max_strength != DBL_MAX)) {
-        PyErr_SetString(PyExc_ValueError,
-                        "cannot modify min_strength or max_strength without implementing your own aggregation function and influence function");
+    if (PyDict_DelItem(self->argument_ids, argument) < 0) {
         return -1;
     }
+    return PyList_SetSlice(self->id_arguments, last_id, last_id + 1, NULL);
+}
 
-    // Implement aggregation_function, influence_function
+/**
+ * @brief Fill settings with the semantics and the convergence settings of the Framework.
+ *
+ * @param self an instance of QBAFramework
+ * @param settings the QBAFSemantics that is filled (the callables are borrowed references)
+ */
+static inline void
+_QBAFramework_settings(QBAFrameworkObject *self, QBAFSemantics *settings)
+{
+    settings->semantics = self->semantics;
+    settings->aggregation_function = self->aggregation_function;
+    settings->influence_function = self->influence_function;
+    settings->aggregation_function_callable = self->aggregation_function_callable;
+    settings->influence_function_callable = self->influence_function_callable;
+    settings->min_strength = self->min_strength;
+    settings->max_strength = self->max_strength;
+    settings->allow_cycles = self->allow_cycles;
+    settings->max_iterations = self->max_iterations;
+    settings->convergence_threshold = self->convergence_threshold;
+}
+
+/**
+ * @brief Return the evaluation plan of the current structure of the Framework, NULL if an error occurred.
+ * The plan is cached until the arguments or the relations of the Framework are modified.
+ *
+ * @param self an instance of QBAFramework
+ * @return QBAFPlanObject* borrowed reference, NULL if an error occurred
+ */
+static QBAFPlanObject *
+_QBAFramework_plan(QBAFrameworkObject *self)
+{
+    if (self->plan == NULL) {
+        QBAFSemantics settings;
+        _QBAFramework_settings(self, &settings);
+        self->plan = QBAFPlan_Create(self->id_arguments, self->argument_ids,
+                                     (QBAFARelationsObject*)self->attack_relations,
+                                     (QBAFARelationsObject*)self->support_relations, &settings);
+        if (self->plan == NULL) {
+            return NULL;
+        }
+    }
+
+    // The schedule of the plan is the order that later relations maintain incrementally
+    QBAFPlanObject *plan = (QBAFPlanObject*)self->plan;
+    if (self->acyclic < 0) {
+        self->acyclic = plan->schedule != NULL;
+        if (self->acyclic && plan->size > 0) {
+            memcpy(self->order, plan->ranks, plan->size * sizeof(Py_ssize_t));
+        }
+        self->next_order = plan->size;
+    }
+    return plan;
+}
+
+/**
+ * @brief Append to ids the arguments reached from the last items of ids through relations (forward)
+ * or the arguments that reach them (backward), as long as their order is within (lower, upper).
+ * The appended arguments are marked in self->order_marks.
+ *
+ * @param self an instance of QBAFramework with a valid order
+ * @param forward 1 to follow the relations from agent to patient, 0 from patient to agent
+ * @param lower the order that the arguments must be greater than
+ * @param upper the order that the arguments must be less than
+ * @param ids a pointer to an array with the ids where the search starts, it may be reallocated
+ * @param ids_size a pointer to the number of items of ids
+ * @param ids_capacity a pointer to the capacity of ids
+ * @return int 1 if the search reached an argument with order upper (forward), 0 if not, -1 if an error occurred
+ */
+static int
+_QBAFramework_order_search(QBAFrameworkObject *self, int forward, Py_ssize_t lower, Py_ssize_t upper,
+                           Py_ssize_t **ids, Py_ssize_t *ids_size, Py_ssize_t *ids_capacity)
+{
+    PyObject *relations[2] = {self->attack_relations, self->support_relations};
+
+    for (Py_ssize_t index = 0; index < *ids_size; index++) {
+        for (int kind = 0; kind < 2; kind++) {
+            QBAFARelationsObject *kind_relations = (QBAFARelationsObject*)relations[kind];
+            Py_ssize_t neighbours_size;
+            const Py_ssize_t *neighbours = forward ? QBAFARelations_PatientIds(kind_relations, (*ids)[index], &neighbours_size) :
+                                                     QBAFARelations_AgentIds(kind_relations, (*ids)[index], &neighbours_size);
+            for (Py_ssize_t neighbour = 0; neighbour < neighbours_size; neighbour++) {
+                Py_ssize_t id = neighbours[neighbour];
+                if (forward && self->order[id] == upper) {
+                    return 1;
+                }
+                if (self->order_marks[id] || self->order[id] <= lower || self->order[id] >= upper) {
+                    continue;
+                }
+                if (*ids_size == *ids_capacity) {
+                    Py_ssize_t *new_ids = PyMem_Realloc(*ids, 2 * *ids_capacity * sizeof(Py_ssize_t));
+                    if (new_ids == NULL) {
+                        PyErr_NoMemory();
+                        return -1;
+                    }
+                    *ids = new_ids;
+                    *ids_capacity *= 2;
+                }
+                self->order_marks[id] = TRUE;
+                (*ids)[(*ids_size)++] = id;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief An id together with its order, to sort ids by order.
+ *
+ */
+typedef struct {
+    Py_ssize_t order;
+    Py_ssize_t id;
+} QBAFOrderedId;
+
+/**
+ * @brief Compare two QBAFOrderedId by order, for qsort.
+ *
+ * @param a a pointer to a QBAFOrderedId
+ * @param b a pointer to a QBAFOrderedId
+ * @return int negative if a goes first, positive if b goes first, 0 if they have the same order
+ */
+static int
+_QBAFOrderedId_compare(const void *a, const void *b)
+{
+    Py_ssize_t first = ((const QBAFOrderedId*)a)->order, second = ((const QBAFOrderedId*)b)->order;
+    return (first > second) - (first < second);
+}
+
+/**
+ * @brief Compare two orders, for qsort.
+ *
+ * @param a a pointer to a Py_ssize_t
+ * @param b a pointer to a Py_ssize_t
+ * @return int negative if a is smaller, positive if b is smaller, 0 if they are equal
+ */
+static int
+_QBAFramework_compare_orders(const void *a, const void *b)
+{
+    Py_ssize_t first = *(const Py_ssize_t*)a, second = *(const Py_ssize_t*)b;
+    return (first > second) - (first < second);
+}
+
+/**
+ * @brief Update the order of the ids so the relation (agent, patient) can be added without breaking it
+ * (dynamic topological sort of Pearce and Kelly): only the arguments whose order lies between the order
+ * of patient and the order of agent are visited and reordered.
+ * Return 1 if the relations stay acyclic or if it is not known whether they are acyclic,
+ * 0 if the relation would create a cycle (the order is not modified), -1 if an error occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param agent a QBAFArgument of the Framework
+ * @param patient a QBAFArgument of the Framework
+ * @return int 1 if the relations stay acyclic, 0 if the relation creates a cycle, -1 if an error occurred
+ */
+static int
+_QBAFramework_order_relation(QBAFrameworkObject *self, PyObject *agent, PyObject *patient)
+{
+    if (self->acyclic < 0 && self->reject_cycles && !self->allow_cycles) {
+        if (_QBAFramework_plan(self) == NULL) {     // It finds out whether the relations are acyclic
+            return -1;
+        }
+    }
+    if (self->acyclic <= 0) {
+        return TRUE;
+    }
+
+    Py_ssize_t agent_id = 0, patient_id = 0;
+    if (_QBAFramework_argument_id(self, agent, &agent_id) < 0 ||
+        _QBAFramework_argument_id(self, patient, &patient_id) < 0) {
+        return -1;
+    }
+    if (agent_id == patient_id) {
+        return FALSE;
+    }
+    Py_ssize_t lower = self->order[patient_id], upper = self->order[agent_id];
+    if (upper < lower) {
+        return TRUE;
+    }
+
+    Py_ssize_t forward_capacity = 16, backward_capacity = 16;
+    Py_ssize_t forward_size = 1, backward_size = 1;
+    Py_ssize_t *forward = PyMem_Malloc(forward_capacity * sizeof(Py_ssize_t));
+    Py_ssize_t *backward = PyMem_Malloc(backward_capacity * sizeof(Py_ssize_t));
+    if (forward == NULL || backward == NULL) {
+        PyMem_Free(forward); PyMem_Free(backward);
+        PyErr_NoMemory();
+        return -1;
+    }
+    forward[0] = patient_id;
+    backward[0] = agent_id;
+    self->order_marks[patient_id] = TRUE;
+    self->order_marks[agent_id] = TRUE;
+
+    // The arguments reached from patient before agent, and the arguments that reach agent after patient
+    int result = _QBAFramework_order_search(self, TRUE, lower, upper, &forward, &forward_size, &forward_capacity);
+    if (result == 0) {
+        result = _QBAFramework_order_search(self, FALSE, lower, upper, &backward, &backward_size, &backward_capacity);
+    }
+    for (Py_ssize_t index = 0; index < forward_size; index++) {
+        self->order_marks[forward[index]] = FALSE;
+    }
+    for (Py_ssize_t index = 0; index < backward_size; index++) {
+        self->order_marks[backward[index]] = FALSE;
+    }
+
+    QBAFOrderedId *ids = NULL;
+    Py_ssize_t *orders = NULL;
+    if (result == 0) {
+        ids = PyMem_Malloc((backward_size + forward_size) * sizeof(QBAFOrderedId));
+        orders = PyMem_Malloc((backward_size + forward_size) * sizeof(Py_ssize_t));
+        if (ids == NULL || orders == NULL) {
+            PyErr_NoMemory();
+            result = -1;
+        }
+    }
+    if (result == 0) {
+        // The arguments that reach agent take the lowest of their orders, keeping their relative order,
+        // followed by the arguments reached from patient
+        for (Py_ssize_t index = 0; index < backward_size; index++) {
+            ids[index].id = backward[index];
+            ids[index].order = self->order[backward[index]];
+        }
+        for (Py_ssize_t index = 0; index < forward_size; index++) {
+            ids[backward_size + index].id = forward[index];
+            ids[backward_size + index].order = self->order[forward[index]];
+        }
+        qsort(ids, backward_size, sizeof(QBAFOrderedId), _QBAFOrderedId_compare);
+        qsort(ids + backward_size, forward_size, sizeof(QBAFOrderedId), _QBAFOrderedId_compare);
+        for (Py_ssize_t index = 0; index < backward_size + forward_size; index++) {
+            orders[index] = ids[index].order;
+        }
+        qsort(orders, backward_size + forward_size, sizeof(Py_ssize_t), _QBAFramework_compare_orders);
+        for (Py_ssize_t index = 0; index < backward_size + forward_size; index++) {
+            self->order[ids[index].id] = orders[index];
+        }
+    }
+
+    PyMem_Free(forward); PyMem_Free(backward);
+    PyMem_Free(ids); PyMem_Free(orders);
+    if (result < 0) {
+        return -1;
+    }
+    return result == 0;     // A search that reaches agent from patient found a cycle
+}
+
+/**
+ * @brief Mark the final strength of argument as outdated, together with the rest of its connected component
+ * when they are calculated again. It must be called when the initial strength, the attackers or the supporters
+ * of argument are modified.
+ *
+ * @param self an instance of QBAFramework
+ * @param argument a QBAFArgument
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_mark_stale(QBAFrameworkObject *self, PyObject *argument)
+{
+    Py_ssize_t id;
+    int contains = _QBAFramework_argument_id(self, argument, &id);
+    if (contains < 0) {
+        return -1;
+    }
+    if (contains) {
+        self->stale[id] = TRUE;
+    }
+    self->modified = TRUE;
+    return 0;
+}
+
+/**
+ * @brief Return a PyDict (argument: QBAFArgument, strength: float) from an array where the strength
+ * of the internal id is stored in strengths[id * stride].
+ *
+ * @param self an instance of QBAFramework
+ * @param strengths an array of strengths with one item every stride items per argument
+ * @param stride the distance between the strengths of two consecutive ids
+ * @return PyObject* a new PyDict, NULL if an error occurred
+ */
+static PyObject *
+_QBAFramework_strided_strengths_dict(QBAFrameworkObject *self, const double *strengths, Py_ssize_t stride)
+{
+    PyObject *dict = PyDict_New();
+    if (dict == NULL) {
+        return NULL;
+    }
+
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    for (Py_ssize_t id = 0; id < size; id++) {
+        PyObject *pyfloat = PyFloat_FromDouble(strengths[id * stride]);
+        if (pyfloat == NULL) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+        if (PyDict_SetItem(dict, PyList_GET_ITEM(self->id_arguments, id), pyfloat) < 0) {
+            Py_DECREF(pyfloat); Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(pyfloat);
+    }
+
+    return dict;
+}
+
+/**
+ * @brief Return a PyDict (argument: QBAFArgument, strength: float) from an array of strengths indexed by internal id.
+ *
+ * @param self an instance of QBAFramework
+ * @param strengths an array of strengths with one item per argument
+ * @return PyObject* a new PyDict, NULL if an error occurred
+ */
+static inline PyObject *
+_QBAFramework_strengths_dict(QBAFrameworkObject *self, const double *strengths)
+{
+    return _QBAFramework_strided_strengths_dict(self, strengths, 1);
+}
+
+/**
+ * @brief Return 1 and store the initial strength of argument in strength if argument is in the Framework,
+ * 0 if it is not, -1 if an error has occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param argument a QBAFArgument
+ * @param strength a pointer where the initial strength is stored
+ * @return int 1 if contained, 0 if not contained, -1 if an error occurred
+ */
+static inline int
+_QBAFramework_initial_strength_of(QBAFrameworkObject *self, PyObject *argument, double *strength)
+{
+    Py_ssize_t id;
+    int contains = _QBAFramework_argument_id(self, argument, &id);
+    if (contains > 0) {
+        *strength = self->initial_strengths[id];
+    }
+    return contains;
+}
+
+/**
+ * @brief Return true if all the initial strengths are within the range (min_strength, max_strength), false otherwise.
+ *
+ * @param self an instance of QBAFramework
+ * @return int 1 if within range, 0 if not
+ */
+static inline int
+_QBAFramework_initial_strengths_in_minmax(QBAFrameworkObject *self)
+{
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    for (Py_ssize_t id = 0; id < size; id++) {
+        if (self->initial_strengths[id] < self->min_strength || self->initial_strengths[id] > self->max_strength) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Fill the name, functions and strength range of model with the semantics called name (case insensitive).
+ * The convergence settings of model are not modified.
+ *
+ * @param name the name of a semantic model
+ * @param model the QBAFSemantics that is filled
+ * @return int 1 if the semantics exists, 0 otherwise
+ */
+static int
+_QBAFramework_lookup_semantics(const char *name, QBAFSemantics *model)
+{
+    model->aggregation_function_callable = NULL;
+    model->influence_function_callable = NULL;
+    model->min_strength = -DBL_MAX;
+    model->max_strength = DBL_MAX;
+
+    if (streq(name, STR_BASIC_MODEL)) {
+        model->semantics = STR_BASIC_MODEL;
+        model->aggregation_function = sum;
+        model->influence_function = simple_influence;
+    }
+    else if (streq(name, STR_QUADRATICENERGY_MODEL)) {
+        model->semantics = STR_QUADRATICENERGY_MODEL;
+        model->aggregation_function = sum;
+        model->influence_function = max_2_1; // 2-Max(1)
+    }
+    else if (streq(name, STR_SQUAREDDFQUAD_MODEL)) {
+        model->semantics = STR_SQUAREDDFQUAD_MODEL;
+        model->aggregation_function = product;
+        model->influence_function = max_1_1; // 1-Max(1)
+    }
+    else if (streq(name, STR_EULERBASEDTOP_MODEL)) {
+        model->semantics = STR_EULERBASEDTOP_MODEL;
+        model->aggregation_function = top;
+        model->influence_function = euler_based;
+    }
+    else if (streq(name, STR_EULERBASED_MODEL)) {
+        model->semantics = STR_EULERBASED_MODEL;
+        model->aggregation_function = sum;
+        model->influence_function = euler_based;
+    }
+    else if (streq(name, STR_DFQUAD_MODEL)) {
+        model->semantics = STR_DFQUAD_MODEL;
+        model->aggregation_function = product;
+        model->influence_function = linear_1; // Linear(1)
+        model->min_strength = -1;
+        model->max_strength = 1;
+    }
+    else {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Initializer of a QBAFramework instance. It is called right after the constructor by the python interpreter.
+ * 
+ * @param self the Object 
+ * @param args the argument values that might be used by the initializer
+ * @param kwds the names of the argument values
+ * @return int 0 if it was executed with no errors. Otherwise, -1.
+ */
+static int
+QBAFramework_init(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return -1;
+    }
+    static char *kwlist[] = {"arguments", "initial_strengths", "attack_relations", "support_relations",
+                            "disjoint_relations", "semantics", "aggregation_function", "influence_function",
+                            "min_strength", "max_strength", "allow_cycles", "max_iterations", "convergence_threshold",
+                            "compress", "incremental_tolerance", "reject_cycles", NULL};
+    PyObject *arguments, *initial_strengths, *attack_relations, *support_relations, *tmp;
+    int disjoint_relations = TRUE;
+    char *semantics = NULL; // (e.g. "basic_model") If None it will be NULL, otherwise it is a pointer to char that is only accesible in this function.
+    PyObject *aggregation_function = NULL, *influence_function = NULL;
+    double min_strength = -DBL_MAX, max_strength = DBL_MAX;
+    int allow_cycles = FALSE;
+    Py_ssize_t max_iterations = 1000;
+    double convergence_threshold = 1e-9;
+    int compress = FALSE;
+    double incremental_tolerance = 0.0;
+    int reject_cycles = FALSE;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|pzOOddpndpdp", kwlist,
+                                     &arguments, &initial_strengths, &attack_relations, &support_relations,
+                                     &disjoint_relations, &semantics, &aggregation_function, &influence_function,
+                                     &min_strength, &max_strength, &allow_cycles, &max_iterations, &convergence_threshold,
+                                     &compress, &incremental_tolerance, &reject_cycles))
+        return -1;
+
+    if (!PyList_Check(arguments)) {
+        PyErr_SetString(PyExc_TypeError, "arguments must be of type list");
+        return -1;
+    }
+
+    if (!PyList_Check(initial_strengths)) {
+        PyErr_SetString(PyExc_TypeError, "initial_strengths must be of type list");
+        return -1;
+    }
+
+    if (PyList_GET_SIZE(arguments) != PyList_GET_SIZE(initial_strengths)) {
+        PyErr_SetString(PyExc_ValueError, "the lengths of arguments and initial_strengths must be equal");
+        return -1;
+    }
+    
+    // Initialize arguments
+    tmp = self->arguments;
+    self->arguments = PySet_New(arguments);
+    if (self->arguments == NULL) {
+        /* propagate error*/
+        self->arguments = tmp;
+        return -1;
+    }
+    Py_DECREF(tmp);
+
+    // Check that all init strengths are numerical values
+    initial_strengths = PyListFloat_FromPyListNumeric(initial_strengths);   // New reference
+    if (initial_strengths == NULL) {
+        return -1;
+    }
+
+    // Initialize the internal ids and initial_strengths
+    Py_SETREF(self->argument_ids, PyDict_New());
+    Py_SETREF(self->id_arguments, PyList_New(0));
+    _QBAFramework_release_arguments(self);  // The previous ones may be shared with a copy
+    if (self->argument_ids == NULL || self->id_arguments == NULL) {
+        Py_DECREF(initial_strengths);
+        return -1;
+    }
+    self->outside_unit = 0;
+    Py_ssize_t size = PyList_GET_SIZE(arguments);
+    if (_QBAFramework_reserve_strengths(self, size) < 0) {
+        Py_DECREF(initial_strengths);
+        return -1;
+    }
+    for (Py_ssize_t index = 0; index < size; index++) {
+        if (_QBAFramework_insert_argument(self, PyList_GET_ITEM(arguments, index),
+                                          PyFloat_AS_DOUBLE(PyList_GET_ITEM(initial_strengths, index))) < 0) {
+            Py_DECREF(initial_strengths);
+            return -1;
+        }
+    }
+    Py_DECREF(initial_strengths);
+
+    // Initialize attack relations
+    self->acyclic = -1;     // It is not known until the order of the relations is needed
+    tmp = self->attack_relations;
+    self->attack_relations = QBAFARelations_Create(attack_relations);
+    if (self->attack_relations == NULL) {
+        /* propagate error*/
+        self->attack_relations = tmp;
+        return -1;
+    }
+    Py_DECREF(tmp);
+
+    // Initialize support relations
+    tmp = self->support_relations;
+    self->support_relations = QBAFARelations_Create(support_relations);
+    if (self->support_relations == NULL) {
+        /* propagate error*/
+        self->support_relations = tmp;
+        return -1;
+    }
+    Py_DECREF(tmp);
+
+    // Check that the arguments of attack relations are in the arguments
+    int contained = QBAFARelations_ArgsContained((QBAFARelationsObject*)self->attack_relations, self->arguments);
+    if (contained < 0) {
+        return -1;
+    }
+    if (!contained)  {
+        PyErr_SetString(PyExc_ValueError, "all relation components of attack_relations must be in arguments");
+        return -1;
+    }
+
+    // Check that the arguments of support relations are in the arguments
+    contained = QBAFARelations_ArgsContained((QBAFARelationsObject*)self->support_relations, self->arguments);
+    if (contained < 0) {
+        return -1;
+    }
+    if (!contained)  {
+        PyErr_SetString(PyExc_ValueError, "all relation components of support_relations must be in arguments");
+        return -1;
+    }
+
+    // The relations use the internal ids of the arguments
+    if (QBAFARelations_Bind((QBAFARelationsObject*)self->attack_relations, self->argument_ids, self->id_arguments) < 0 ||
+        QBAFARelations_Bind((QBAFARelationsObject*)self->support_relations, self->argument_ids, self->id_arguments) < 0) {
+        return -1;
+    }
+
+    
+    self->disjoint_relations = disjoint_relations;
+    self->allow_cycles = allow_cycles;
+    self->max_iterations = max_iterations;
+    self->convergence_threshold = convergence_threshold;
+    self->compress = compress;
+    self->incremental_tolerance = incremental_tolerance;
+    self->reject_cycles = reject_cycles;
+
+    if (self->max_iterations <= 0) {
+        PyErr_SetString(PyExc_ValueError, "max_iterations must be greater than 0");
+        return -1;
+    }
+    if (self->convergence_threshold <= 0.0) {
+        PyErr_SetString(PyExc_ValueError, "convergence_threshold must be greater than 0");
+        return -1;
+    }
+    if (!(self->incremental_tolerance >= 0.0)) {
+        PyErr_SetString(PyExc_ValueError, "incremental_tolerance must be greater than or equal to 0");
+        return -1;
+    }
+
+    if (self->disjoint_relations) {
+        // Check attack and support relations are disjoint
+        int disjoint = _QBAFARelations_isDisjoint((QBAFARelationsObject*)self->attack_relations, (QBAFARelationsObject*)self->support_relations);
+        if (disjoint < 0) {
+            return -1;
+        }
+        if (!disjoint) {
+            PyErr_SetString(PyExc_ValueError, "attack_relations and support_relations must be disjoint");
+            return -1;
+        }
+    }
+
+    if (semantics == NULL && PyObject_IsNoneOrNULL(aggregation_function) && PyObject_IsNoneOrNULL(influence_function)) {
+        semantics = STR_BASIC_MODEL;
+    }
+
+    if (semantics != NULL && (min_strength != -DBL_MAX || max_strength != DBL_MAX)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "cannot modify min_strength or max_strength without implementing your own aggregation function and influence function");
+        return -1;
+    }
+
+    // Implement aggregation_function, influence_function
     if (!PyObject_IsNoneOrNULL(aggregation_function) || !PyObject_IsNoneOrNULL(influence_function)) {
         if (semantics != NULL) {
             PyErr_SetString(PyExc_ValueError,
-                            "cannot modify the aggregation_function and influence_function of the semantics");
+                            "cannot modify the aggregation_function and influence_function of the semantics");
+            return -1;
+        }
+
+        if (!PyCallable_Check(aggregation_function) || !PyCallable_Check(influence_function)) {
+            PyErr_SetString(PyExc_ValueError,
+            "aggregation_function and influence_function must be callable");
+            return -1;
+        }
+
+        self->semantics = NULL;
+        self->influence_function = NULL;
+        self->aggregation_function = NULL;
+
+        Py_XDECREF(self->influence_function_callable);
+        Py_INCREF(influence_function);
+        self->influence_function_callable = influence_function;
+
+        Py_XDECREF(self->aggregation_function_callable);
+        Py_INCREF(aggregation_function);
+        self->aggregation_function_callable = aggregation_function;
+
+        self->min_strength = min_strength;
+        self->max_strength = max_strength;
+
+    }
+
+    // Assign the influence_function and aggregation_function based on the value of semantics
+    if (semantics != NULL) {
+
+        QBAFSemantics model;
+        if (!_QBAFramework_lookup_semantics(semantics, &model)) {
+            PyErr_SetString(PyExc_ValueError, "incorrect value of semantics");
+            return -1;
+        }
+        self->semantics = (char*)model.semantics;
+        self->aggregation_function = model.aggregation_function;
+        self->influence_function = model.influence_function;
+        self->min_strength = model.min_strength;
+        self->max_strength = model.max_strength;
+
+    }
+
+    // Check all the initial strengths are in range (min_strength, max_strength)
+    if (!_QBAFramework_initial_strengths_in_minmax(self)) {
+        char msg[100];
+        sprintf(msg, "every initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
+        PyErr_SetString(PyExc_ValueError, msg);
+        return -1;
+    }
+
+    if (self->reject_cycles && !self->allow_cycles) {
+        if (_QBAFramework_plan(self) == NULL) {     // It finds out whether the relations are acyclic
+            return -1;
+        }
+        if (!self->acyclic) {
+            PyErr_SetString(PyExc_ValueError,
+                            "attack_relations and support_relations must be acyclic when reject_cycles is True and allow_cycles is False");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Return a new array with the numbers of object and store their number in size.
+ * object can support the buffer protocol with format 'd' or be a sequence of numbers.
+ *
+ * @param object the python object with the numbers
+ * @param name the name of the parameter, used in the error messages
+ * @param size where the number of items is stored
+ * @return double* a new array (it must be freed with PyMem_Free), NULL if an error occurred
+ */
+static double *
+_QBAFramework_read_doubles(PyObject *object, const char *name, Py_ssize_t *size)
+{
+    double *values;
+
+    if (PyObject_CheckBuffer(object)) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(object, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+            return NULL;
+        }
+        const char *format = view.format != NULL ? view.format : "B";
+        if (format[0] == '@' || format[0] == '=' || format[0] == '<') {
+            format++;
+        }
+        if (strcmp(format, "d") != 0 || view.itemsize != sizeof(double)) {
+            PyBuffer_Release(&view);
+            PyErr_Format(PyExc_TypeError, "%s buffer must contain doubles (format 'd')", name);
+            return NULL;
+        }
+        *size = view.len / sizeof(double);
+        values = PyMem_Malloc((*size + 1) * sizeof(double));
+        if (values == NULL) {
+            PyBuffer_Release(&view);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        memcpy(values, view.buf, view.len);
+        PyBuffer_Release(&view);
+        return values;
+    }
+
+    PyObject *sequence = PySequence_Fast(object, "the numbers must be a buffer of doubles or a sequence of numbers");
+    if (sequence == NULL) {
+        return NULL;
+    }
+    *size = PySequence_Fast_GET_SIZE(sequence);
+    values = PyMem_Malloc((*size + 1) * sizeof(double));
+    if (values == NULL) {
+        Py_DECREF(sequence);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (Py_ssize_t index = 0; index < *size; index++) {
+        PyObject *item = PySequence_Fast_GET_ITEM(sequence, index);
+        if (!PyFloat_Check(item) && !PyLong_Check(item)) {
+            PyErr_Format(PyExc_TypeError, "all items of %s must be of a numeric type (int, float)", name);
+            break;
+        }
+        values[index] = PyFloat_AsDouble(item);
+        if (values[index] == -1.0 && PyErr_Occurred()) {
+            break;
+        }
+    }
+    Py_DECREF(sequence);
+    if (PyErr_Occurred()) {
+        PyMem_Free(values);
+        return NULL;
+    }
+    return values;
+}
+
+/**
+ * @brief Return a new array with the internal ids of object and store their number in size.
+ * object can support the buffer protocol with an integer format (e.g. 'i', 'l', 'q') or be a sequence of ints.
+ * Every id must be lower than the number of arguments of the Framework.
+ *
+ * @param self an instance of QBAFramework
+ * @param object the python object with the ids
+ * @param name the name of the parameter, used in the error messages
+ * @param size where the number of items is stored
+ * @return Py_ssize_t* a new array (it must be freed with PyMem_Free), NULL if an error occurred
+ */
+static Py_ssize_t *
+_QBAFramework_read_ids(QBAFrameworkObject *self, PyObject *object, const char *name, Py_ssize_t *size)
+{
+    Py_ssize_t *ids;
+
+    if (PyObject_CheckBuffer(object)) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(object, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+            return NULL;
+        }
+        const char *format = view.format != NULL ? view.format : "B";
+        if (format[0] == '@' || format[0] == '=' || format[0] == '<') {
+            format++;
+        }
+        if (format[0] == '\0' || format[1] != '\0' || strchr("bBhHiIlLqQnN", format[0]) == NULL) {
+            PyBuffer_Release(&view);
+            PyErr_Format(PyExc_TypeError, "%s buffer must contain integers", name);
+            return NULL;
+        }
+        *size = view.len / view.itemsize;
+        ids = PyMem_Malloc((*size + 1) * sizeof(Py_ssize_t));
+        if (ids == NULL) {
+            PyBuffer_Release(&view);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        int is_signed = strchr("bhilqn", format[0]) != NULL;
+        for (Py_ssize_t index = 0; index < *size; index++) {
+            const char *item = (const char *) view.buf + index * view.itemsize;
+            switch (view.itemsize) {
+            case 1:
+                ids[index] = is_signed ? *(const int8_t *) item : *(const uint8_t *) item;
+                break;
+            case 2:
+                ids[index] = is_signed ? *(const int16_t *) item : *(const uint16_t *) item;
+                break;
+            case 4:
+                if (is_signed) {
+                    ids[index] = *(const int32_t *) item;
+                }
+                else {
+                    uint32_t id = *(const uint32_t *) item;
+                    ids[index] = id > (uint64_t) PY_SSIZE_T_MAX ? -1 : (Py_ssize_t) id;
+                }
+                break;
+            default:
+                // Ids that do not fit in a Py_ssize_t are out of range (-1), instead of wrapping onto valid ids
+                if (is_signed) {
+                    int64_t id = *(const int64_t *) item;
+                    ids[index] = id > (int64_t) PY_SSIZE_T_MAX || id < (int64_t) PY_SSIZE_T_MIN ? -1 : (Py_ssize_t) id;
+                }
+                else {
+                    uint64_t id = *(const uint64_t *) item;
+                    ids[index] = id > (uint64_t) PY_SSIZE_T_MAX ? -1 : (Py_ssize_t) id;
+                }
+                break;
+            }
+        }
+        PyBuffer_Release(&view);
+    }
+    else {
+        PyObject *sequence = PySequence_Fast(object, "the ids must be a buffer of integers or a sequence of ints");
+        if (sequence == NULL) {
+            return NULL;
+        }
+        *size = PySequence_Fast_GET_SIZE(sequence);
+        ids = PyMem_Malloc((*size + 1) * sizeof(Py_ssize_t));
+        if (ids == NULL) {
+            Py_DECREF(sequence);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        for (Py_ssize_t index = 0; index < *size; index++) {
+            ids[index] = PyLong_AsSsize_t(PySequence_Fast_GET_ITEM(sequence, index));
+            if (ids[index] == -1 && PyErr_Occurred()) {
+                Py_DECREF(sequence);
+                PyMem_Free(ids);
+                return NULL;
+            }
+        }
+        Py_DECREF(sequence);
+    }
+
+    Py_ssize_t arguments = PyList_GET_SIZE(self->id_arguments);
+    for (Py_ssize_t index = 0; index < *size; index++) {
+        if (ids[index] < 0 || ids[index] >= arguments) {
+            PyMem_Free(ids);
+            PyErr_Format(PyExc_ValueError, "every id of %s must be within range [0, %zd)", name, arguments);
+            return NULL;
+        }
+    }
+    return ids;
+}
+
+/**
+ * @brief Add to relations the relations between the ids of agents and the ids of patients, in the same positions.
+ *
+ * @param self an instance of QBAFramework
+ * @param relations the attack or the support relations of self
+ * @param agents the ids of the agents
+ * @param patients the ids of the patients
+ * @param agents_name the name of the parameter agents, used in the error messages
+ * @param patients_name the name of the parameter patients, used in the error messages
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_add_id_arrays(QBAFrameworkObject *self, PyObject *relations, PyObject *agents, PyObject *patients,
+                            const char *agents_name, const char *patients_name)
+{
+    Py_ssize_t agents_size, patients_size;
+    Py_ssize_t *agent_ids = _QBAFramework_read_ids(self, agents, agents_name, &agents_size);
+    if (agent_ids == NULL) {
+        return -1;
+    }
+    Py_ssize_t *patient_ids = _QBAFramework_read_ids(self, patients, patients_name, &patients_size);
+    if (patient_ids == NULL) {
+        PyMem_Free(agent_ids);
+        return -1;
+    }
+    if (agents_size != patients_size) {
+        PyMem_Free(agent_ids); PyMem_Free(patient_ids);
+        PyErr_Format(PyExc_ValueError, "the lengths of %s and %s must be equal", agents_name, patients_name);
+        return -1;
+    }
+
+    int result = QBAFARelations_AddIdArrays((QBAFARelationsObject *) relations, agent_ids, patient_ids, agents_size);
+    PyMem_Free(agent_ids);
+    PyMem_Free(patient_ids);
+    return result;
+}
+
+/**
+ * @brief Fill an empty Framework with the arguments names, their initial strengths and the relations
+ * between the positions of the arguments in names given by the arrays of ids.
+ *
+ * @param self an empty instance of QBAFramework
+ * @param arrays names, initial_strengths, attack_src, attack_dst, support_src and support_dst
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_load_arrays(QBAFrameworkObject *self, PyObject **arrays)
+{
+    PyObject *names = PySequence_Fast(arrays[0], "names must be a sequence");
+    if (names == NULL) {
+        return -1;
+    }
+    Py_ssize_t size, strengths_size;
+    double *strengths = _QBAFramework_read_doubles(arrays[1], "initial_strengths", &strengths_size);
+    if (strengths == NULL) {
+        Py_DECREF(names);
+        return -1;
+    }
+    size = PySequence_Fast_GET_SIZE(names);
+    if (size != strengths_size) {
+        PyErr_SetString(PyExc_ValueError, "the lengths of names and initial_strengths must be equal");
+        goto error;
+    }
+
+    // Initialize the arguments, their ids are their positions in names
+    Py_SETREF(self->arguments, PySet_New(names));
+    if (self->arguments == NULL || _QBAFramework_reserve_strengths(self, size) < 0) {
+        goto error;
+    }
+    for (Py_ssize_t index = 0; index < size; index++) {
+        if (_QBAFramework_insert_argument(self, PySequence_Fast_GET_ITEM(names, index), strengths[index]) < 0) {
+            goto error;
+        }
+    }
+    if (PyList_GET_SIZE(self->id_arguments) != size) {
+        PyErr_SetString(PyExc_ValueError, "names must not contain repeated arguments");
+        goto error;
+    }
+    if (!_QBAFramework_initial_strengths_in_minmax(self)) {
+        char msg[100];
+        sprintf(msg, "every initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
+        PyErr_SetString(PyExc_ValueError, msg);
+        goto error;
+    }
+    PyMem_Free(strengths);
+    Py_DECREF(names);
+
+    // Initialize the relations
+    if (_QBAFramework_add_id_arrays(self, self->attack_relations, arrays[2], arrays[3], "attack_src", "attack_dst") < 0 ||
+        _QBAFramework_add_id_arrays(self, self->support_relations, arrays[4], arrays[5], "support_src", "support_dst") < 0) {
+        return -1;
+    }
+    self->acyclic = -1;     // It is not known until the order of the relations is needed
+    _QBAFramework_structure_modified(self);
+
+    if (self->disjoint_relations) {
+        int disjoint = _QBAFARelations_isDisjoint((QBAFARelationsObject*)self->attack_relations, (QBAFARelationsObject*)self->support_relations);
+        if (disjoint < 0) {
+            return -1;
+        }
+        if (!disjoint) {
+            PyErr_SetString(PyExc_ValueError, "attack_relations and support_relations must be disjoint");
+            return -1;
+        }
+    }
+
+    if (self->reject_cycles && !self->allow_cycles) {
+        if (_QBAFramework_plan(self) == NULL) {     // It finds out whether the relations are acyclic
+            return -1;
+        }
+        if (!self->acyclic) {
+            PyErr_SetString(PyExc_ValueError,
+                            "attack_relations and support_relations must be acyclic when reject_cycles is True and allow_cycles is False");
+            return -1;
+        }
+    }
+
+    return 0;
+
+error:
+    PyMem_Free(strengths);
+    Py_DECREF(names);
+    return -1;
+}
+
+/**
+ * @brief Create a QBAFramework from arrays: the names of the arguments, their initial strengths and the relations
+ * given as pairs of positions in names. The rest of keyword arguments are the settings of the constructor.
+ *
+ * @param type the class QBAFramework (or a subclass)
+ * @param args the argument values (names, initial_strengths, attack_src, attack_dst, support_src, support_dst)
+ * @param kwds the argument names, and the settings of the new QBAFramework
+ * @return PyObject* new QBAFramework, NULL if an error occurred
+ */
+static PyObject *
+QBAFramework_from_arrays(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    static const char *kwlist[] = {"names", "initial_strengths", "attack_src", "attack_dst", "support_src", "support_dst"};
+    PyObject *arrays[6] = {NULL, NULL, NULL, NULL, NULL, NULL};
+    PyObject *settings = NULL, *empty = NULL, *self = NULL;
+    Py_ssize_t positional = PyTuple_GET_SIZE(args);
+
+    if (positional > 6) {
+        PyErr_SetString(PyExc_TypeError, "from_arrays() takes at most 6 positional arguments");
+        return NULL;
+    }
+    settings = kwds != NULL ? PyDict_Copy(kwds) : PyDict_New();
+    if (settings == NULL) {
+        return NULL;
+    }
+
+    // The arrays are separated from the settings, which are given to the constructor
+    for (int index = 0; index < 6; index++) {
+        PyObject *value = PyDict_GetItemString(settings, kwlist[index]);    // Borrowed reference
+        if (index < positional) {
+            if (value != NULL) {
+                PyErr_Format(PyExc_TypeError, "from_arrays() got multiple values for argument '%s'", kwlist[index]);
+                goto end;
+            }
+            value = PyTuple_GET_ITEM(args, index);
+        }
+        else if (value == NULL) {
+            PyErr_Format(PyExc_TypeError, "from_arrays() missing required argument '%s'", kwlist[index]);
+            goto end;
+        }
+        Py_INCREF(value);
+        arrays[index] = value;
+        if (index >= positional && PyDict_DelItemString(settings, kwlist[index]) < 0) {
+            goto end;
+        }
+    }
+
+    empty = Py_BuildValue("([][][][])");
+    if (empty == NULL) {
+        goto end;
+    }
+    self = PyObject_Call((PyObject *) type, empty, settings);
+    if (self != NULL && _QBAFramework_load_arrays((QBAFrameworkObject *) self, arrays) < 0) {
+        Py_CLEAR(self);
+    }
+
+end:
+    for (int index = 0; index < 6; index++) {
+        Py_XDECREF(arrays[index]);
+    }
+    Py_XDECREF(empty);
+    Py_DECREF(settings);
+    return self;
+}
+
+/**
+ * @brief A list with the attributes of the class QBAFramework
+ * 
+ */
+static PyMemberDef QBAFramework_members[] = {
+    {NULL}  /* Sentinel */
+};
+
+/**
+ * @brief Getter of the attribute arguments.
+ * 
+ * @param self the QBAFramework object
+ * @param closure 
+ * @return PyObject* copy of a set of QBAFramework
+ */
+static PyObject *
+QBAFramework_getarguments(QBAFrameworkObject *self, void *closure)
+{
+    return PySet_New(self->arguments);
+}
+
+/**
+ * @brief Getter of the attribute initial_strengths.
+ * 
+ * @param self the QBAFramework object
+ * @param closure 
+ * @return PyObject* copy of a dict of (argument: QBAFArgument, initial_strength: float)
+ */
+static PyObject *
+QBAFramework_getinitial_strengths(QBAFrameworkObject *self, void *closure)
+{
+    return _QBAFramework_strengths_dict(self, self->initial_strengths);
+}
+
+/**
+ * @brief Getter of the attribute attack_relations.
+ * 
+ * @param self the QBAFramework object
+ * @param closure 
+ * @return PyObject* a instance of QBAFARelations 
+ */
+static PyObject *
+QBAFramework_getattack_relations(QBAFrameworkObject *self, void *closure)
+{
+    Py_INCREF(self->attack_relations);
+    return self->attack_relations;
+}
+
+/**
+ * @brief Getter of the attribute support_relations.
+ * 
+ * @param self the QBAFramework object
+ * @param closure 
+ * @return PyObject* a instance of QBAFARelations 
+ */
+static PyObject *
+QBAFramework_getsupport_relations(QBAFrameworkObject *self, void *closure)
+{
+    Py_INCREF(self->support_relations);
+    return self->support_relations;
+}
+
+/**
+ * @brief Getter of the attribute disjoint relations.
+ * 
+ * @param self the QBAFramework object
+ * @param closure 
+ * @return PyObject* a new PyBool
+ */
+static PyObject *
+QBAFramework_getdisjoint_relations(QBAFrameworkObject *self, void *closure)
+{
+    Py_RETURN_BOOL(self->disjoint_relations);
+}
+
+/**
+ * @brief Getter of the attribute semantics.
+ * 
+ * @param self the QBAFramework object
+ * @param closure 
+ * @return PyObject* new PyUnicode with the string semantics, new PyNone if semantics is NULL
+ */
+static PyObject *
+QBAFramework_getsemantics(QBAFrameworkObject *self, void *closure)
+{
+    if (self->semantics != NULL)
+        return PyUnicode_FromString(self->semantics);
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Getter of the attribute min_strength.
+ * 
+ * @param self the QBAFramework object
+ * @param closure 
+ * @return PyObject* new PyFloat with the min_strength
+ */
+static PyObject *
+QBAFramework_getmin_strength(QBAFrameworkObject *self, void *closure)
+{
+    return PyFloat_FromDouble(self->min_strength);
+}
+
+/**
+ * @brief Getter of the attribute max_strength.
+ * 
+ * @param self the QBAFramework object
+ * @param closure 
+ * @return PyObject* new PyFloat with the max_strength
+ */
+static PyObject *
+QBAFramework_getmax_strength(QBAFrameworkObject *self, void *closure)
+{
+    return PyFloat_FromDouble(self->max_strength);
+}
+
+static PyObject *
+QBAFramework_getallow_cycles(QBAFrameworkObject *self, void *closure)
+{
+    Py_RETURN_BOOL(self->allow_cycles);
+}
+
+static PyObject *
+QBAFramework_getmax_iterations(QBAFrameworkObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->max_iterations);
+}
+
+static PyObject *
+QBAFramework_getconvergence_threshold(QBAFrameworkObject *self, void *closure)
+{
+    return PyFloat_FromDouble(self->convergence_threshold);
+}
+
+static PyObject *
+QBAFramework_getcompress(QBAFrameworkObject *self, void *closure)
+{
+    Py_RETURN_BOOL(self->compress);
+}
+
+static int
+QBAFramework_setcompress(QBAFrameworkObject *self, PyObject *value, void *closure)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return -1;
+    }
+    if (value == NULL || !PyBool_Check(value)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "compress must be of type boolean");
+        return -1;
+    }
+
+    // The final strengths do not change, only the way they are calculated
+    self->compress = PyObject_IsTrue(value);
+    return 0;
+}
+
+static PyObject *
+QBAFramework_getincremental_tolerance(QBAFrameworkObject *self, void *closure)
+{
+    return PyFloat_FromDouble(self->incremental_tolerance);
+}
+
+static int
+QBAFramework_setincremental_tolerance(QBAFrameworkObject *self, PyObject *value, void *closure)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return -1;
+    }
+    if (value == NULL || (!PyFloat_Check(value) && !PyLong_Check(value))) {
+        PyErr_SetString(PyExc_TypeError,
+                        "incremental_tolerance must be of a numeric type (int, float)");
+        return -1;
+    }
+    double tolerance = PyFloat_AsDouble(value);
+    if (tolerance == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (!(tolerance >= 0.0)) {
+        PyErr_SetString(PyExc_ValueError, "incremental_tolerance must be greater than or equal to 0");
+        return -1;
+    }
+
+    // It only applies to the changes propagated from now on, the current bound is kept
+    self->incremental_tolerance = tolerance;
+    return 0;
+}
+
+static PyObject *
+QBAFramework_getstaleness_bound(QBAFrameworkObject *self, void *closure)
+{
+    return PyFloat_FromDouble(self->staleness_bound);
+}
+
+static PyObject *
+QBAFramework_getreject_cycles(QBAFrameworkObject *self, void *closure)
+{
+    Py_RETURN_BOOL(self->reject_cycles);
+}
+
+static int
+QBAFramework_setreject_cycles(QBAFrameworkObject *self, PyObject *value, void *closure)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return -1;
+    }
+    if (value == NULL || !PyBool_Check(value)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "reject_cycles must be of type boolean");
+        return -1;
+    }
+
+    int reject_cycles = PyObject_IsTrue(value);
+    if (reject_cycles && !self->allow_cycles) {
+        if (_QBAFramework_plan(self) == NULL) {     // It finds out whether the relations are acyclic
+            return -1;
+        }
+        if (!self->acyclic) {
+            PyErr_SetString(PyExc_ValueError,
+                            "reject_cycles cannot be True if the relations are cyclic and allow_cycles is False");
+            return -1;
+        }
+    }
+    self->reject_cycles = reject_cycles;
+    return 0;
+}
+
+static PyObject *
+QBAFramework_getfrozen(QBAFrameworkObject *self, void *closure)
+{
+    Py_RETURN_BOOL(self->frozen);
+}
+
+static PyObject *
+QBAFramework_getlast_solve_info(QBAFrameworkObject *self, void *closure)
+{
+    if (self->last_solve_info == Py_None) {
+        Py_RETURN_NONE;
+    }
+    return PyDict_Copy(self->last_solve_info);
+}
+
+/**
+ * @brief Setter of the attribute disjoint_relations.
+ * 
+ * @param self the QBAFramework object
+ * @param value PyBool value for disjoint_relations
+ * @param closure 
+ * @return int 0 if it was executed with no errors. Otherwise, -1.
+ */
+static int
+QBAFramework_setdisjoint_relations(QBAFrameworkObject *self, PyObject *value, void *closure)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return -1;
+    }
+    if (!PyBool_Check(value)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "disjoint_relations must be of type boolean");
+        return -1;
+    }
+    
+    int disjoint_relations = PyObject_IsTrue(value);
+
+    if (self->disjoint_relations == disjoint_relations) {
+        return 0;
+    }
+
+    self->disjoint_relations = disjoint_relations;
+
+    if (self->disjoint_relations) {
+        // Check attack and support relations are disjoint
+        int disjoint = _QBAFARelations_isDisjoint((QBAFARelationsObject*)self->attack_relations, (QBAFARelationsObject*)self->support_relations);
+        if (disjoint < 0) {
+            return -1;
+        }
+        if (!disjoint) {
+            PyErr_SetString(PyExc_ValueError, "attack_relations and support_relations are not disjoint");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Set the initial strength of the argument with internal id id. If the final strengths are up to date,
+ * the change is propagated incrementally when they are calculated again.
+ *
+ * @param self an instance of QBAFramework
+ * @param id the internal id of the argument
+ * @param strength the new initial strength, within range (min_strength, max_strength)
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_set_initial_strength(QBAFrameworkObject *self, Py_ssize_t id, double strength)
+{
+    // Once the final strengths are up to date, later changes of initial strengths are propagated incrementally
+    if (self->incremental == NULL && !self->modified && self->plan != NULL &&
+        QBAFIncremental_Supports((QBAFPlanObject*)self->plan)) {
+        self->incremental = QBAFIncremental_Create((QBAFPlanObject*)self->plan, self->initial_strengths, self->final_strengths);
+        if (self->incremental == NULL) {
+            return -1;
+        }
+    }
+
+    self->outside_unit += _QBAFramework_outside_unit(strength) - _QBAFramework_outside_unit(self->initial_strengths[id]);
+    self->initial_strengths[id] = strength;
+    if (self->incremental != NULL) {
+        QBAFIncremental_MarkChanged(self->incremental, id);
+    }
+    else {
+        self->stale[id] = TRUE;
+    }
+
+    self->modified = TRUE;
+    return 0;
+}
+
+/**
+ * @brief Modify the initial strength of the Argument argument.
+ * 
+ * @param self an instance of QBAFramework
+ * @param args the argument values (argument: QBAFArgument, initial_strength: float)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
+ */
+static PyObject *
+QBAFramework_modify_initial_strength(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"argument", "initial_strength", NULL};
+    PyObject *argument, *initial_strength;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
+                                     &argument, &initial_strength))
+        return NULL;
+
+    if (!PyFloat_Check(initial_strength) && !PyLong_Check(initial_strength)) {
+        PyErr_SetString(PyExc_TypeError, "initial_strength must be of a numeric type");
+        return NULL;
+    }
+
+    double strength = PyFloat_Check(initial_strength) ? PyFloat_AS_DOUBLE(initial_strength) : PyLong_AsDouble(initial_strength);
+    if (strength == -1.0 && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    // Check initial_strength is within range
+    if (strength < self->min_strength || strength > self->max_strength) {
+        char msg[100];
+        sprintf(msg, "initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
+        PyErr_SetString(PyExc_ValueError, msg);
+        return NULL;
+    }
+
+    Py_ssize_t id;
+    int contains = _QBAFramework_argument_id(self, argument, &id);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "argument must be contained in the QBAFramework");
+        return NULL;
+    }
+
+    if (_QBAFramework_set_initial_strength(self, id, strength) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Return the initial strength of the Argument argument, NULL in case of error.
+ * 
+ * @param self an instance of QBAFramework
+ * @param args the argument values (argument: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new PyFloat
+ */
+static PyObject *
+QBAFramework_initial_strength(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"argument", NULL};
+    PyObject *argument;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &argument))
+        return NULL;
+
+    double initial_strength;
+    int contains = _QBAFramework_initial_strength_of(self, argument, &initial_strength);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "argument must be contained in the QBAFramework");
+        return NULL;
+    }
+
+    return PyFloat_FromDouble(initial_strength);
+}
+
+/**
+ * @brief Add an Argument to the Framework. If it exists already it does nothing.
+ * 
+ * @param self an instance of QBAFramework
+ * @param args the argument values (argument: QBAFArgument, initial_strength: float)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
+ */
+static PyObject *
+QBAFramework_add_argument(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"argument", "initial_strength", NULL};
+    PyObject *argument, *initial_strength = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
+                                     &argument, &initial_strength))
+        return NULL;
+
+    double strength = 0.0;   // default initial strength
+
+    if (initial_strength != NULL) {
+
+        if (!PyFloat_Check(initial_strength) && !PyLong_Check(initial_strength)) {
+            PyErr_SetString(PyExc_TypeError, "initial_strength must be of a numeric type");
+            return NULL;
+        }
+
+        strength = PyFloat_Check(initial_strength) ? PyFloat_AS_DOUBLE(initial_strength) : PyLong_AsDouble(initial_strength);
+        if (strength == -1.0 && PyErr_Occurred()) {
+            return NULL;
+        }
+
+    }
+
+    int contains = PySet_Contains(self->arguments, argument);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (contains) { // If the argument already exists it does nothing
+        Py_RETURN_NONE;
+    }
+
+    // Check initial_strength is within range
+    if (strength < self->min_strength || strength > self->max_strength) {
+        char msg[100];
+        sprintf(msg, "initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
+        PyErr_SetString(PyExc_ValueError, msg);
+        return NULL;
+    }
+
+    // the new argument, initial_strength is added
+    if (_QBAFramework_insert_argument(self, argument, strength) < 0) {
+        return NULL;
+    }
+
+    if (PySet_Add(self->arguments, argument) < 0) {
+        return NULL;
+    }
+
+    _QBAFramework_structure_modified(self);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Remove an Argument from the Framework. If it does not exist already it does nothing.
+ * 
+ * @param self an instance of QBAFramework
+ * @param args the argument values (argument: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
+ */
+static PyObject *
+QBAFramework_remove_argument(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"argument", NULL};
+    PyObject *argument;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &argument))
+        return NULL;
+
+    int contains = PySet_Contains(self->arguments, argument);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) { // If the argument does not exist it does nothing
+        Py_RETURN_NONE;
+    }
+
+    // Check that the argument is not in attack relations
+    contains = QBAFARelations_contains_argument((QBAFARelationsObject*)self->attack_relations, argument);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "cannot remove argument that is contained in attack relations");
+        return NULL;
+    }
+
+    // Check that the argument is not in support relations
+    contains = QBAFARelations_contains_argument((QBAFARelationsObject*)self->support_relations, argument);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "cannot remove argument that is contained in support relations");
+        return NULL;
+    }
+
+    if (_QBAFramework_unshare_arguments(self) < 0 || PySet_Discard(self->arguments, argument) < 0) {
+        return NULL;
+    }
+
+    if (_QBAFramework_delete_argument(self, argument) < 0) {
+        return NULL;
+    }
+
+    _QBAFramework_structure_modified(self);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Add the Attack relation (attacker, attacked) to the Framework.
+ * 
+ * @param self an instance of QBAFramework
+ * @param args the argument values (attacker: QBAFArgument, attacked: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
+ */
+static PyObject *
+QBAFramework_add_attack_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"attacker", "attacked", NULL};
+    PyObject *agent, *patient;
+    int contains;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
+                                     &agent, &patient))
+        return NULL;
+
+    // The relations are bound to the ids of the framework, so the arguments are looked up once
+    Py_ssize_t agent_id = 0, patient_id = 0;
+    contains = _QBAFramework_argument_id(self, agent, &agent_id);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "argument attacker is not contained in the framework");
+        return NULL;
+    }
+
+    contains = _QBAFramework_argument_id(self, patient, &patient_id);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "argument attacked is not contained in the framework");
+        return NULL;
+    }
+
+    if (self->disjoint_relations &&
+        QBAFARelations_HasRelation((QBAFARelationsObject*) self->support_relations, agent_id, patient_id)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "attack relation already exists as support relation");
+        return NULL;
+    }
+
+    if (QBAFARelations_HasRelation((QBAFARelationsObject*) self->attack_relations, agent_id, patient_id)) {
+        Py_RETURN_NONE;
+    }
+
+    int acyclic = _QBAFramework_order_relation(self, agent, patient);
+    if (acyclic < 0) {
+        return NULL;
+    }
+    if (!acyclic && self->reject_cycles && !self->allow_cycles) {
+        PyErr_SetString(PyExc_ValueError,
+                        "attack relation would create a cycle and allow_cycles is False");
+        return NULL;
+    }
+
+    if (_QBAFARelations_add((QBAFARelationsObject*) self->attack_relations, agent, patient) < 0) {
+        return NULL;
+    }
+    if (!acyclic) {
+        self->acyclic = FALSE;
+    }
+
+    _QBAFramework_structure_modified(self);
+    if (_QBAFramework_mark_stale(self, patient) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Add the Support relation (supporter, supported) to the Framework.
+ * 
+ * @param self an instance of QBAFramework
+ * @param args the argument values (supporter: QBAFArgument, supported: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
+ */
+static PyObject *
+QBAFramework_add_support_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"supporter", "supported", NULL};
+    PyObject *agent, *patient;
+    int contains;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
+                                     &agent, &patient))
+        return NULL;
+
+    // The relations are bound to the ids of the framework, so the arguments are looked up once
+    Py_ssize_t agent_id = 0, patient_id = 0;
+    contains = _QBAFramework_argument_id(self, agent, &agent_id);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "argument supporter is not contained in the framework");
+        return NULL;
+    }
+
+    contains = _QBAFramework_argument_id(self, patient, &patient_id);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "argument supported is not contained in the framework");
+        return NULL;
+    }
+
+    if (self->disjoint_relations &&
+        QBAFARelations_HasRelation((QBAFARelationsObject*) self->attack_relations, agent_id, patient_id)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "support relation already exists as attack relation");
+        return NULL;
+    }
+
+    if (QBAFARelations_HasRelation((QBAFARelationsObject*) self->support_relations, agent_id, patient_id)) {
+        Py_RETURN_NONE;
+    }
+
+    int acyclic = _QBAFramework_order_relation(self, agent, patient);
+    if (acyclic < 0) {
+        return NULL;
+    }
+    if (!acyclic && self->reject_cycles && !self->allow_cycles) {
+        PyErr_SetString(PyExc_ValueError,
+                        "support relation would create a cycle and allow_cycles is False");
+        return NULL;
+    }
+
+    if (_QBAFARelations_add((QBAFARelationsObject*) self->support_relations, agent, patient) < 0) {
+        return NULL;
+    }
+    if (!acyclic) {
+        self->acyclic = FALSE;
+    }
+
+    _QBAFramework_structure_modified(self);
+    if (_QBAFramework_mark_stale(self, patient) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Remove the Attack relation (attacker, attacked) from the Framework.
+ * 
+ * @param self an instance of QBAFramework
+ * @param args the argument values (attacker: QBAFArgument, attacked: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
+ */
+static PyObject *
+QBAFramework_remove_attack_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"attacker", "attacked", NULL};
+    PyObject *agent, *patient;
+    int contains;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
+                                     &agent, &patient))
+        return NULL;
+
+    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->attack_relations, agent, patient);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        Py_RETURN_NONE;
+    }
+
+    if (_QBAFARelations_remove((QBAFARelationsObject*) self->attack_relations, agent, patient) < 0) {
+        return NULL;
+    }
+    if (self->acyclic == FALSE) {   // The cycle may have been broken
+        self->acyclic = -1;
+    }
+
+    _QBAFramework_structure_modified(self);
+    if (_QBAFramework_mark_stale(self, patient) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Remove the Support relation (supporter, supported) from the Framework.
+ * 
+ * @param self an instance of QBAFramework
+ * @param args the argument values (supporter: QBAFArgument, supported: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
+ */
+static PyObject *
+QBAFramework_remove_support_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"supporter", "supported", NULL};
+    PyObject *agent, *patient;
+    int contains;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
+                                     &agent, &patient))
+        return NULL;
+
+    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->support_relations, agent, patient);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        Py_RETURN_NONE;
+    }
+
+    if (_QBAFARelations_remove((QBAFARelationsObject*) self->support_relations, agent, patient) < 0) {
+        return NULL;
+    }
+    if (self->acyclic == FALSE) {   // The cycle may have been broken
+        self->acyclic = -1;
+    }
+
+    _QBAFramework_structure_modified(self);
+    if (_QBAFramework_mark_stale(self, patient) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief The relations of a set of changes, as arrays of internal ids.
+ *
+ */
+typedef struct {
+    Py_ssize_t *agents;     /* the ids of the agents */
+    Py_ssize_t *patients;   /* the ids of the patients */
+    Py_ssize_t size;        /* the number of relations */
+    uint64_t *keys;         /* the packed relations (agent in the high half), sorted */
+} QBAFRelationIds;
+
+#define QBAF_REMOVED_ATTACKS    0
+#define QBAF_REMOVED_SUPPORTS   1
+#define QBAF_ADDED_ATTACKS      2
+#define QBAF_ADDED_SUPPORTS     3
+
+/**
+ * @brief A set of changes of a Framework. They are all validated before any of them is applied,
+ * so either all of them are applied or none.
+ *
+ */
+typedef struct {
+    PyObject *arguments;            /* input: sequence of the new arguments, or NULL */
+    PyObject *strengths;            /* input: their initial strengths (buffer or sequence), or NULL for 0.0 */
+    PyObject *modified;             /* input: sequence of the arguments whose initial strength is modified, or NULL */
+    PyObject *modified_strengths;   /* input: their new initial strengths (buffer or sequence) */
+    PyObject *relations[4];         /* input: iterables of tuples (agent, patient) indexed by QBAF_REMOVED_ATTACKS... or NULL */
+
+    PyObject *new_arguments;        /* the arguments that are not in the Framework yet, with consecutive ids */
+    double *new_strengths;          /* their initial strengths */
+    PyObject *pending;              /* dictionary (argument: QBAFArgument, id: int) with the ids of new_arguments */
+    Py_ssize_t *modified_ids;       /* the ids of the arguments whose initial strength is modified */
+    double *modified_values;        /* their new initial strengths */
+    Py_ssize_t modified_size;       /* the number of modified initial strengths */
+    QBAFRelationIds ids[4];         /* the relations; the removed relations are only those that are contained */
+} QBAFChangeset;
+
+/**
+ * @brief Free the memory of the resolved changes of changeset (not its input).
+ *
+ * @param changeset a QBAFChangeset
+ */
+static void
+_QBAFChangeset_free(QBAFChangeset *changeset)
+{
+    Py_CLEAR(changeset->new_arguments);
+    Py_CLEAR(changeset->pending);
+    PyMem_Free(changeset->new_strengths);
+    PyMem_Free(changeset->modified_ids);
+    PyMem_Free(changeset->modified_values);
+    for (int index = 0; index < 4; index++) {
+        PyMem_Free(changeset->ids[index].agents);
+        PyMem_Free(changeset->ids[index].patients);
+        PyMem_Free(changeset->ids[index].keys);
+    }
+}
+
+/**
+ * @brief Compare two packed relations, for qsort and bsearch.
+ */
+static int
+_QBAFRelationIds_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Return 1 if ids contains the relation (agent, patient), 0 otherwise.
+ *
+ * @param ids a QBAFRelationIds with sorted keys
+ * @param agent the id of the agent
+ * @param patient the id of the patient
+ * @return int 1 if contained, 0 otherwise
+ */
+static inline int
+_QBAFRelationIds_contains(const QBAFRelationIds *ids, Py_ssize_t agent, Py_ssize_t patient)
+{
+    if (ids->size == 0) {
+        return FALSE;
+    }
+    uint64_t key = ((uint64_t) agent << 32) | (uint64_t) patient;
+    return bsearch(&key, ids->keys, ids->size, sizeof(uint64_t), _QBAFRelationIds_compare) != NULL;
+}
+
+/**
+ * @brief Return 1 and store the internal id of argument in id if argument is in the Framework or is one of
+ * the new arguments of changeset, 0 if it is not, -1 if an error has occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param changeset a QBAFChangeset whose new arguments have been resolved
+ * @param argument a QBAFArgument
+ * @param id a pointer where the internal id is stored
+ * @return int 1 if contained, 0 if not contained, -1 if an error occurred
+ */
+static inline int
+_QBAFChangeset_argument_id(QBAFrameworkObject *self, QBAFChangeset *changeset, PyObject *argument, Py_ssize_t *id)
+{
+    int contains = _QBAFramework_argument_id(self, argument, id);
+    if (contains != 0 || changeset->pending == NULL) {
+        return contains;
+    }
+    PyObject *pyid = PyDict_GetItemWithError(changeset->pending, argument);   // Borrowed reference
+    if (pyid == NULL) {
+        return PyErr_Occurred() ? -1 : FALSE;
+    }
+    *id = PyLong_AsSsize_t(pyid);
+    return TRUE;
+}
+
+/**
+ * @brief Store in changeset->new_arguments the arguments of changeset->arguments that are not in the Framework,
+ * and the ids they will have. Like add_argument, the arguments that are already contained are ignored.
+ *
+ * @param self an instance of QBAFramework
+ * @param changeset a QBAFChangeset
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFChangeset_resolve_arguments(QBAFrameworkObject *self, QBAFChangeset *changeset)
+{
+    PyObject *arguments = PySequence_Fast(changeset->arguments, "arguments must be a sequence");
+    if (arguments == NULL) {
+        return -1;
+    }
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(arguments), strengths_size = size;
+    double *strengths = changeset->strengths != NULL
+                        ? _QBAFramework_read_doubles(changeset->strengths, "initial_strengths", &strengths_size)
+                        : PyMem_Calloc(size + 1, sizeof(double));
+    if (strengths == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        Py_DECREF(arguments);
+        return -1;
+    }
+    if (strengths_size != size) {
+        PyErr_SetString(PyExc_ValueError, "the lengths of arguments and initial_strengths must be equal");
+        goto error;
+    }
+
+    changeset->new_arguments = PyList_New(0);
+    changeset->pending = PyDict_New();
+    changeset->new_strengths = PyMem_Malloc((size + 1) * sizeof(double));
+    if (changeset->new_arguments == NULL || changeset->pending == NULL || changeset->new_strengths == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        goto error;
+    }
+
+    Py_ssize_t next_id = PyList_GET_SIZE(self->id_arguments), id;
+    for (Py_ssize_t index = 0; index < size; index++) {
+        PyObject *argument = PySequence_Fast_GET_ITEM(arguments, index);
+        int contains = _QBAFChangeset_argument_id(self, changeset, argument, &id);
+        if (contains < 0) {
+            goto error;
+        }
+        if (contains) {     // If the argument already exists it is ignored
+            continue;
+        }
+        if (strengths[index] < self->min_strength || strengths[index] > self->max_strength) {
+            char msg[100];
+            sprintf(msg, "initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
+            PyErr_SetString(PyExc_ValueError, msg);
+            goto error;
+        }
+        PyObject *pyid = PyLong_FromSsize_t(next_id);
+        if (pyid == NULL) {
+            goto error;
+        }
+        if (PyDict_SetItem(changeset->pending, argument, pyid) < 0) {
+            Py_DECREF(pyid);
+            goto error;
+        }
+        Py_DECREF(pyid);
+        if (PyList_Append(changeset->new_arguments, argument) < 0) {
+            goto error;
+        }
+        changeset->new_strengths[next_id - PyList_GET_SIZE(self->id_arguments)] = strengths[index];
+        next_id++;
+    }
+
+    PyMem_Free(strengths);
+    Py_DECREF(arguments);
+    return 0;
+
+error:
+    PyMem_Free(strengths);
+    Py_DECREF(arguments);
+    return -1;
+}
+
+/**
+ * @brief Store in changeset the ids of changeset->modified and their new initial strengths.
+ *
+ * @param self an instance of QBAFramework
+ * @param changeset a QBAFChangeset whose new arguments have been resolved
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFChangeset_resolve_modified(QBAFrameworkObject *self, QBAFChangeset *changeset)
+{
+    PyObject *arguments = PySequence_Fast(changeset->modified, "arguments must be a sequence");
+    if (arguments == NULL) {
+        return -1;
+    }
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(arguments), strengths_size;
+    changeset->modified_values = _QBAFramework_read_doubles(changeset->modified_strengths, "initial_strengths", &strengths_size);
+    if (changeset->modified_values == NULL) {
+        Py_DECREF(arguments);
+        return -1;
+    }
+    if (strengths_size != size) {
+        Py_DECREF(arguments);
+        PyErr_SetString(PyExc_ValueError, "the lengths of arguments and initial_strengths must be equal");
+        return -1;
+    }
+    changeset->modified_ids = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (changeset->modified_ids == NULL) {
+        Py_DECREF(arguments);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (Py_ssize_t index = 0; index < size; index++) {
+        double strength = changeset->modified_values[index];
+        if (strength < self->min_strength || strength > self->max_strength) {
+            Py_DECREF(arguments);
+            char msg[100];
+            sprintf(msg, "initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
+            PyErr_SetString(PyExc_ValueError, msg);
+            return -1;
+        }
+        int contains = _QBAFChangeset_argument_id(self, changeset, PySequence_Fast_GET_ITEM(arguments, index),
+                                                  &changeset->modified_ids[index]);
+        if (contains <= 0) {
+            Py_DECREF(arguments);
+            if (contains == 0) {
+                PyErr_SetString(PyExc_ValueError, "argument must be contained in the QBAFramework");
+            }
             return -1;
         }
+    }
+    changeset->modified_size = size;
 
-        if (!PyCallable_Check(aggregation_function) || !PyCallable_Check(influence_function)) {
-            PyErr_SetString(PyExc_ValueError,
-            "aggregation_function and influence_function must be callable");
+    Py_DECREF(arguments);
+    return 0;
+}
+
+/**
+ * @brief Store in changeset->ids[kind] the ids of the relations of changeset->relations[kind], and sort their keys.
+ * The removed relations that are not contained in the Framework are ignored, like in remove_attack_relation,
+ * and the arguments of the added relations must be in the Framework or be new arguments.
+ *
+ * @param self an instance of QBAFramework
+ * @param changeset a QBAFChangeset whose new arguments have been resolved
+ * @param kind QBAF_REMOVED_ATTACKS, QBAF_REMOVED_SUPPORTS, QBAF_ADDED_ATTACKS or QBAF_ADDED_SUPPORTS
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFChangeset_resolve_relations(QBAFrameworkObject *self, QBAFChangeset *changeset, int kind)
+{
+    PyObject *relations = PySequence_Fast(changeset->relations[kind], "relations must be an iterable of tuples");
+    if (relations == NULL) {
+        return -1;
+    }
+    QBAFARelationsObject *current = (QBAFARelationsObject *) (kind % 2 == 0 ? self->attack_relations : self->support_relations);
+    QBAFRelationIds *ids = &changeset->ids[kind];
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(relations);
+    ids->agents = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    ids->patients = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    ids->keys = PyMem_Malloc((size + 1) * sizeof(uint64_t));
+    if (ids->agents == NULL || ids->patients == NULL || ids->keys == NULL) {
+        Py_DECREF(relations);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    Py_ssize_t agent = 0, patient = 0;
+    for (Py_ssize_t index = 0; index < size; index++) {
+        PyObject *item = PySequence_Fast_GET_ITEM(relations, index);
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+            Py_DECREF(relations);
+            PyErr_SetString(PyExc_TypeError, "every relation must be a tuple of size 2");
             return -1;
         }
+        int agent_contained = _QBAFChangeset_argument_id(self, changeset, PyTuple_GET_ITEM(item, 0), &agent);
+        int patient_contained = agent_contained < 0 ? -1 : _QBAFChangeset_argument_id(self, changeset, PyTuple_GET_ITEM(item, 1), &patient);
+        if (patient_contained < 0) {
+            Py_DECREF(relations);
+            return -1;
+        }
+        if (kind == QBAF_REMOVED_ATTACKS || kind == QBAF_REMOVED_SUPPORTS) {
+            if (!agent_contained || !patient_contained || !QBAFARelations_HasRelation(current, agent, patient)) {
+                continue;   // If the relation does not exist it is ignored
+            }
+        }
+        else if (!agent_contained || !patient_contained) {
+            Py_DECREF(relations);
+            PyErr_SetString(PyExc_ValueError, "the arguments of the relations must be contained in the framework");
+            return -1;
+        }
+        ids->agents[ids->size] = agent;
+        ids->patients[ids->size] = patient;
+        ids->keys[ids->size] = ((uint64_t) agent << 32) | (uint64_t) patient;
+        ids->size++;
+    }
+    qsort(ids->keys, ids->size, sizeof(uint64_t), _QBAFRelationIds_compare);
 
-        self->semantics = NULL;
-        self->influence_function = NULL;
-        self->aggregation_function = NULL;
+    Py_DECREF(relations);
+    return 0;
+}
 
-        Py_XDECREF(self->influence_function_callable);
-        Py_INCREF(influence_function);
-        self->influence_function_callable = influence_function;
+/**
+ * @brief Return 1 if the added relations of changeset are not contained in the relations of the other type,
+ * once the removed relations of changeset are removed, 0 otherwise.
+ *
+ * @param self an instance of QBAFramework
+ * @param changeset a resolved QBAFChangeset
+ * @param kind QBAF_ADDED_ATTACKS or QBAF_ADDED_SUPPORTS
+ * @return int 1 if disjoint, 0 otherwise
+ */
+static int
+_QBAFChangeset_disjoint(QBAFrameworkObject *self, QBAFChangeset *changeset, int kind)
+{
+    int other = kind == QBAF_ADDED_ATTACKS ? QBAF_ADDED_SUPPORTS : QBAF_ADDED_ATTACKS;
+    int other_removed = kind == QBAF_ADDED_ATTACKS ? QBAF_REMOVED_SUPPORTS : QBAF_REMOVED_ATTACKS;
+    QBAFARelationsObject *current = (QBAFARelationsObject *) (kind == QBAF_ADDED_ATTACKS ? self->support_relations : self->attack_relations);
+    QBAFRelationIds *ids = &changeset->ids[kind];
+
+    for (Py_ssize_t index = 0; index < ids->size; index++) {
+        Py_ssize_t agent = ids->agents[index], patient = ids->patients[index];
+        if (_QBAFRelationIds_contains(&changeset->ids[other], agent, patient) ||
+            (QBAFARelations_HasRelation(current, agent, patient) &&
+             !_QBAFRelationIds_contains(&changeset->ids[other_removed], agent, patient))) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
 
-        Py_XDECREF(self->aggregation_function_callable);
-        Py_INCREF(aggregation_function);
-        self->aggregation_function_callable = aggregation_function;
+/**
+ * @brief Return 1 if the relations of the Framework are acyclic once changeset is applied, 0 if they are cyclic,
+ * -1 if an error occurred. It sorts the arguments topologically (Kahn) without modifying the Framework.
+ *
+ * @param self an instance of QBAFramework
+ * @param changeset a resolved QBAFChangeset
+ * @return int 1 if acyclic, 0 if cyclic, -1 if an error occurred
+ */
+static int
+_QBAFChangeset_acyclic(QBAFrameworkObject *self, QBAFChangeset *changeset)
+{
+    Py_ssize_t current_size = PyList_GET_SIZE(self->id_arguments);
+    Py_ssize_t size = current_size + PyList_GET_SIZE(changeset->new_arguments);
+    QBAFARelationsObject *relations[2] = {(QBAFARelationsObject *) self->attack_relations,
+                                          (QBAFARelationsObject *) self->support_relations};
+    Py_ssize_t relations_size = QBAFARelations_Size(relations[0]) + QBAFARelations_Size(relations[1]) +
+                                changeset->ids[QBAF_ADDED_ATTACKS].size + changeset->ids[QBAF_ADDED_SUPPORTS].size;
+
+    Py_ssize_t *offsets = PyMem_Calloc(size + 1, sizeof(Py_ssize_t));
+    Py_ssize_t *in_degrees = PyMem_Calloc(size + 1, sizeof(Py_ssize_t));
+    Py_ssize_t *successors = PyMem_Malloc((relations_size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *queue = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (offsets == NULL || in_degrees == NULL || successors == NULL || queue == NULL) {
+        PyMem_Free(offsets); PyMem_Free(in_degrees); PyMem_Free(successors); PyMem_Free(queue);
+        PyErr_NoMemory();
+        return -1;
+    }
 
-        self->min_strength = min_strength;
-        self->max_strength = max_strength;
+    // Two passes over the relations: the first one counts the successors of every argument, the second one stores them
+    for (int pass = 0; pass < 2; pass++) {
+        for (int type = 0; type < 2; type++) {
+            for (Py_ssize_t agent = 0; agent < current_size; agent++) {
+                Py_ssize_t patients_size;
+                const Py_ssize_t *patients = QBAFARelations_PatientIds(relations[type], agent, &patients_size);
+                for (Py_ssize_t index = 0; index < patients_size; index++) {
+                    if (_QBAFRelationIds_contains(&changeset->ids[QBAF_REMOVED_ATTACKS + type], agent, patients[index])) {
+                        continue;
+                    }
+                    if (pass == 0) {
+                        offsets[agent + 1]++;
+                        in_degrees[patients[index]]++;
+                    }
+                    else {
+                        successors[offsets[agent]++] = patients[index];
+                    }
+                }
+            }
+            QBAFRelationIds *added = &changeset->ids[QBAF_ADDED_ATTACKS + type];
+            for (Py_ssize_t index = 0; index < added->size; index++) {
+                if (pass == 0) {
+                    offsets[added->agents[index] + 1]++;
+                    in_degrees[added->patients[index]]++;
+                }
+                else {
+                    successors[offsets[added->agents[index]]++] = added->patients[index];
+                }
+            }
+        }
+        if (pass == 0) {
+            for (Py_ssize_t id = 0; id < size; id++) {
+                offsets[id + 1] += offsets[id];
+            }
+        }
+        else {
+            // offsets[id] is now the end of the successors of id, that is the start of the successors of id + 1
+            memmove(offsets + 1, offsets, size * sizeof(Py_ssize_t));
+            offsets[0] = 0;
+        }
+    }
+
+    Py_ssize_t head = 0, tail = 0;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        if (in_degrees[id] == 0) {
+            queue[tail++] = id;
+        }
+    }
+    while (head < tail) {
+        Py_ssize_t id = queue[head++];
+        for (Py_ssize_t index = offsets[id]; index < offsets[id + 1]; index++) {
+            if (--in_degrees[successors[index]] == 0) {
+                queue[tail++] = successors[index];
+            }
+        }
+    }
+
+    PyMem_Free(offsets); PyMem_Free(in_degrees); PyMem_Free(successors); PyMem_Free(queue);
+    return tail == size;
+}
 
+/**
+ * @brief Validate changeset and apply it to the Framework: first the relations are removed, then the arguments
+ * are added, then the relations are added and finally the initial strengths are modified. If any change is not valid,
+ * an exception is raised and the Framework is not modified. The Framework is invalidated once for all the changes,
+ * and if only initial strengths are modified they are propagated incrementally.
+ *
+ * @param self an instance of QBAFramework
+ * @param changeset a QBAFChangeset with its input, the rest of members set to 0
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_apply_changeset(QBAFrameworkObject *self, QBAFChangeset *changeset)
+{
+    // Validation, nothing is modified
+    if (changeset->arguments != NULL && _QBAFChangeset_resolve_arguments(self, changeset) < 0) {
+        return -1;
+    }
+    if (changeset->new_arguments == NULL && (changeset->new_arguments = PyList_New(0)) == NULL) {
+        return -1;
+    }
+    if (changeset->modified != NULL && _QBAFChangeset_resolve_modified(self, changeset) < 0) {
+        return -1;
     }
-
-    // Assign the influence_function and aggregation_function based on the value of semantics
-    if (semantics != NULL) {
-
-        if (streq(semantics, STR_BASIC_MODEL)) {
-            self->semantics = STR_BASIC_MODEL;
-            self->aggregation_function = sum;
-            self->influence_function = simple_influence;
-            self->min_strength = -DBL_MAX;
-            self->max_strength = DBL_MAX;
-        }
-        else if (streq(semantics, STR_QUADRATICENERGY_MODEL)) {
-            self->semantics = STR_QUADRATICENERGY_MODEL;
-            self->aggregation_function = sum;
-            self->influence_function = max_2_1; // 2-Max(1)
-            self->min_strength = -DBL_MAX;
-            self->max_strength = DBL_MAX;
-        }
-        else if (streq(semantics, STR_SQUAREDDFQUAD_MODEL)) {
-            self->semantics = STR_SQUAREDDFQUAD_MODEL;
-            self->aggregation_function = product;
-            self->influence_function = max_1_1; // 1-Max(1)
-            self->min_strength = -DBL_MAX;
-            self->max_strength = DBL_MAX;
-        }
-        else if (streq(semantics, STR_EULERBASEDTOP_MODEL)) {
-            self->semantics = STR_EULERBASEDTOP_MODEL;
-            self->aggregation_function = top;
-            self->influence_function = euler_based;
-            self->min_strength = -DBL_MAX;
-            self->max_strength = DBL_MAX;
-        }
-        else if (streq(semantics, STR_EULERBASED_MODEL)) {
-            self->semantics = STR_EULERBASED_MODEL;
-            self->aggregation_function = sum;
-            self->influence_function = euler_based;
-            self->min_strength = -DBL_MAX;
-            self->max_strength = DBL_MAX;
-        }
-        else if (streq(semantics, STR_DFQUAD_MODEL)) {
-            self->semantics = STR_DFQUAD_MODEL;
-            self->aggregation_function = product;
-            self->influence_function = linear_1; // Linear(1)
-            self->min_strength = -1;
-            self->max_strength = 1;
+    Py_ssize_t added = 0, removed = 0;
+    for (int kind = 0; kind < 4; kind++) {
+        if (changeset->relations[kind] != NULL && changeset->relations[kind] != Py_None &&
+            _QBAFChangeset_resolve_relations(self, changeset, kind) < 0) {
+            return -1;
+        }
+        if (kind == QBAF_ADDED_ATTACKS || kind == QBAF_ADDED_SUPPORTS) {
+            added += changeset->ids[kind].size;
         }
         else {
-            PyErr_SetString(PyExc_ValueError, "incorrect value of semantics");
+            removed += changeset->ids[kind].size;
+        }
+    }
+    Py_ssize_t new_size = PyList_GET_SIZE(changeset->new_arguments);
+    if (added > 0 && PyList_GET_SIZE(self->id_arguments) + new_size > (Py_ssize_t) UINT32_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "too many arguments in the relations");
+        return -1;
+    }
+    if (self->disjoint_relations) {
+        if (!_QBAFChangeset_disjoint(self, changeset, QBAF_ADDED_ATTACKS)) {
+            PyErr_SetString(PyExc_ValueError, "attack relation already exists as support relation");
+            return -1;
+        }
+        if (!_QBAFChangeset_disjoint(self, changeset, QBAF_ADDED_SUPPORTS)) {
+            PyErr_SetString(PyExc_ValueError, "support relation already exists as attack relation");
+            return -1;
+        }
+    }
+    if (added > 0 && self->reject_cycles && !self->allow_cycles) {
+        int acyclic = _QBAFChangeset_acyclic(self, changeset);
+        if (acyclic < 0) {
+            return -1;
+        }
+        if (!acyclic) {
+            PyErr_SetString(PyExc_ValueError, "the relations would create a cycle and allow_cycles is False");
             return -1;
         }
+    }
 
+    // The structure is invalidated once, the changes of initial strengths alone are propagated incrementally
+    if (new_size > 0 || added > 0 || removed > 0) {
+        _QBAFramework_structure_modified(self);
     }
 
-    // Check all the initial strengths are in range (min_strength, max_strength)
-    int initial_strengths_in_minmax = _QBAFramework_initial_strengths_in_minmax(self);
-    if (initial_strengths_in_minmax < 0) {
+    QBAFARelationsObject *attack_relations = (QBAFARelationsObject *) self->attack_relations;
+    QBAFARelationsObject *support_relations = (QBAFARelationsObject *) self->support_relations;
+    QBAFRelationIds *ids = changeset->ids;
+    if (QBAFARelations_RemoveIdArrays(attack_relations, ids[QBAF_REMOVED_ATTACKS].agents, ids[QBAF_REMOVED_ATTACKS].patients,
+                                      ids[QBAF_REMOVED_ATTACKS].size) < 0 ||
+        QBAFARelations_RemoveIdArrays(support_relations, ids[QBAF_REMOVED_SUPPORTS].agents, ids[QBAF_REMOVED_SUPPORTS].patients,
+                                      ids[QBAF_REMOVED_SUPPORTS].size) < 0) {
         return -1;
     }
-    if (!initial_strengths_in_minmax) {
-        char msg[100];
-        sprintf(msg, "every initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
-        PyErr_SetString(PyExc_ValueError, msg);
-        return -1;
+    if (removed > 0 && self->acyclic == FALSE) {    // The cycles may have been broken
+        self->acyclic = -1;
     }
 
-    return 0;
-}
-
-/**
- * @brief Return the result of aggregating function in the Framework self,
- * -1.0 if an error has occurred.
- * 
- * @param self a QBAFramework
- * @param attacker_strengths PyList of attackers' final strengths
- * @param supporter_strengths PyList of supporters' final strengths
- * @return double result of the aggregation function, -1.0 if an error occurred
- */
-static inline
-double _QBAFramework_aggregation_function(QBAFrameworkObject *self, PyObject *attacker_strengths, PyObject *supporter_strengths)
-{
-    if (self->aggregation_function != NULL)
-        return self->aggregation_function(attacker_strengths, supporter_strengths);
-    
-    if (self->aggregation_function_callable != NULL) {
-        PyObject *pyfloat = PyObject_CallFunction(self->aggregation_function_callable, "OO", attacker_strengths, supporter_strengths);
-        if (pyfloat == NULL)
+    if (new_size > 0 && _QBAFramework_reserve_strengths(self, PyList_GET_SIZE(self->id_arguments) + new_size) < 0) {
+        return -1;
+    }
+    for (Py_ssize_t index = 0; index < new_size; index++) {
+        PyObject *argument = PyList_GET_ITEM(changeset->new_arguments, index);
+        if (_QBAFramework_insert_argument(self, argument, changeset->new_strengths[index]) < 0 ||
+            PySet_Add(self->arguments, argument) < 0) {
             return -1;
-        double aggregation = PyFloat_AsDouble(pyfloat);
-        Py_DECREF(pyfloat);
-        return aggregation;
+        }
     }
 
-    PyErr_BadArgument();
-    return -1.0;
-}
+    if (QBAFARelations_AddIdArrays(attack_relations, ids[QBAF_ADDED_ATTACKS].agents, ids[QBAF_ADDED_ATTACKS].patients,
+                                   ids[QBAF_ADDED_ATTACKS].size) < 0 ||
+        QBAFARelations_AddIdArrays(support_relations, ids[QBAF_ADDED_SUPPORTS].agents, ids[QBAF_ADDED_SUPPORTS].patients,
+                                   ids[QBAF_ADDED_SUPPORTS].size) < 0) {
+        return -1;
+    }
+    if (added > 0 && self->acyclic == TRUE) {   // The order is not maintained for many relations at once
+        self->acyclic = -1;
+    }
 
-/**
- * @brief Return the result of the influence function of the Framework self,
- * -1.0 in an error has occurred.
- * 
- * @param self a QBAFramework
- * @param w the initial strength
- * @param s the result of applying the aggregation function to all attackers and supporters
- * @return double the result, -1.0 if an error occurred
- */
-static inline
-double _QBAFramework_influence_function(QBAFrameworkObject *self, double w, double s)
-{
-    if (self->influence_function != NULL)
-        return self->influence_function(w, s);
-    
-    if (self->influence_function_callable != NULL) {
-        PyObject *pyfloat = PyObject_CallFunction(self->influence_function_callable, "dd", w, s);
-        if (pyfloat == NULL)
+    // The patients of the modified relations are outdated
+    for (int kind = 0; kind < 4; kind++) {
+        for (Py_ssize_t index = 0; index < ids[kind].size; index++) {
+            self->stale[ids[kind].patients[index]] = TRUE;
+        }
+    }
+
+    for (Py_ssize_t index = 0; index < changeset->modified_size; index++) {
+        if (_QBAFramework_set_initial_strength(self, changeset->modified_ids[index], changeset->modified_values[index]) < 0) {
             return -1;
-        double influence = PyFloat_AsDouble(pyfloat);
-        Py_DECREF(pyfloat);
-        return influence;
+        }
     }
 
-    PyErr_BadArgument();
-    return -1.0;
+    self->modified = TRUE;
+    return 0;
 }
 
 /**
- * @brief A list with the attributes of the class QBAFramework
- * 
- */
-static PyMemberDef QBAFramework_members[] = {
-    {NULL}  /* Sentinel */
-};
-
-/**
- * @brief Getter of the attribute arguments.
- * 
- * @param self the QBAFramework object
- * @param closure 
- * @return PyObject* copy of a set of QBAFramework
+ * @brief Validate and apply changeset, and free it. Return Py_None, NULL if an error occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param changeset a QBAFChangeset with its input
+ * @return PyObject* new Py_None, NULL in case of error
  */
 static PyObject *
-QBAFramework_getarguments(QBAFrameworkObject *self, void *closure)
+_QBAFramework_apply(QBAFrameworkObject *self, QBAFChangeset *changeset)
 {
-    return PySet_New(self->arguments);
+    int result = _QBAFramework_apply_changeset(self, changeset);
+    _QBAFChangeset_free(changeset);
+    if (result < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
 }
 
 /**
- * @brief Getter of the attribute initial_strengths.
- * 
- * @param self the QBAFramework object
- * @param closure 
- * @return PyObject* copy of a dict of (argument: QBAFArgument, initial_strength: float)
+ * @brief Add the Arguments arguments to the Framework. The arguments that exist already are ignored.
+ *
+ * @param self an instance of QBAFramework
+ * @param args the argument values (arguments: list, initial_strengths: buffer or sequence of float)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
  */
 static PyObject *
-QBAFramework_getinitial_strengths(QBAFrameworkObject *self, void *closure)
+QBAFramework_add_arguments(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    return PyDict_Copy(self->initial_strengths);
-}
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"arguments", "initial_strengths", NULL};
+    QBAFChangeset changeset = {0};
 
-/**
- * @brief Getter of the attribute attack_relations.
- * 
- * @param self the QBAFramework object
- * @param closure 
- * @return PyObject* a instance of QBAFARelations 
- */
-static PyObject *
-QBAFramework_getattack_relations(QBAFrameworkObject *self, void *closure)
-{
-    Py_INCREF(self->attack_relations);
-    return self->attack_relations;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
+                                     &changeset.arguments, &changeset.strengths))
+        return NULL;
+
+    if (changeset.strengths == Py_None) {
+        changeset.strengths = NULL;
+    }
+    return _QBAFramework_apply(self, &changeset);
 }
 
 /**
- * @brief Getter of the attribute support_relations.
- * 
- * @param self the QBAFramework object
- * @param closure 
- * @return PyObject* a instance of QBAFARelations 
+ * @brief Modify the initial strengths of the Arguments arguments.
+ *
+ * @param self an instance of QBAFramework
+ * @param args the argument values (arguments: list, initial_strengths: buffer or sequence of float)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
  */
 static PyObject *
-QBAFramework_getsupport_relations(QBAFrameworkObject *self, void *closure)
+QBAFramework_modify_initial_strengths(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    Py_INCREF(self->support_relations);
-    return self->support_relations;
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"arguments", "initial_strengths", NULL};
+    QBAFChangeset changeset = {0};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
+                                     &changeset.modified, &changeset.modified_strengths))
+        return NULL;
+
+    return _QBAFramework_apply(self, &changeset);
 }
 
 /**
- * @brief Getter of the attribute disjoint relations.
- * 
- * @param self the QBAFramework object
- * @param closure 
- * @return PyObject* a new PyBool
+ * @brief Add the Attack relations attacks and the Support relations supports to the Framework.
+ *
+ * @param self an instance of QBAFramework
+ * @param args the argument values (attacks: iterable of tuples, supports: iterable of tuples)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
  */
 static PyObject *
-QBAFramework_getdisjoint_relations(QBAFrameworkObject *self, void *closure)
+QBAFramework_add_relations(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    Py_RETURN_BOOL(self->disjoint_relations);
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"attacks", "supports", NULL};
+    QBAFChangeset changeset = {0};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist,
+                                     &changeset.relations[QBAF_ADDED_ATTACKS], &changeset.relations[QBAF_ADDED_SUPPORTS]))
+        return NULL;
+
+    return _QBAFramework_apply(self, &changeset);
 }
 
 /**
- * @brief Getter of the attribute semantics.
- * 
- * @param self the QBAFramework object
- * @param closure 
- * @return PyObject* new PyUnicode with the string semantics, new PyNone if semantics is NULL
+ * @brief Remove the Attack relations attacks and the Support relations supports from the Framework.
+ * The relations that do not exist are ignored.
+ *
+ * @param self an instance of QBAFramework
+ * @param args the argument values (attacks: iterable of tuples, supports: iterable of tuples)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
  */
 static PyObject *
-QBAFramework_getsemantics(QBAFrameworkObject *self, void *closure)
+QBAFramework_remove_relations(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    if (self->semantics != NULL)
-        return PyUnicode_FromString(self->semantics);
-    Py_RETURN_NONE;
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"attacks", "supports", NULL};
+    QBAFChangeset changeset = {0};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist,
+                                     &changeset.relations[QBAF_REMOVED_ATTACKS], &changeset.relations[QBAF_REMOVED_SUPPORTS]))
+        return NULL;
+
+    return _QBAFramework_apply(self, &changeset);
 }
 
 /**
- * @brief Getter of the attribute min_strength.
- * 
- * @param self the QBAFramework object
- * @param closure 
- * @return PyObject* new PyFloat with the min_strength
+ * @brief Apply all the changes of the dictionary changeset at once. Either all of them are applied or none.
+ *
+ * @param self an instance of QBAFramework
+ * @param args the argument values (changeset: dict)
+ * @param kwds the argument names
+ * @return PyObject* new Py_None, NULL in case of error
  */
 static PyObject *
-QBAFramework_getmin_strength(QBAFrameworkObject *self, void *closure)
+QBAFramework_apply_changes(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    return PyFloat_FromDouble(self->min_strength);
+    if (_QBAFramework_check_mutable(self) < 0) {
+        return NULL;
+    }
+    static char *kwlist[] = {"changeset", NULL};
+    static const char *relation_keys[4] = {"remove_attacks", "remove_supports", "add_attacks", "add_supports"};
+    PyObject *dict, *key, *value;
+    QBAFChangeset changeset = {0};
+    // The keys and values of add_arguments and modify_initial_strengths, and the relations
+    PyObject *lists[8] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!|", kwlist,
+                                     &PyDict_Type, &dict))
+        return NULL;
+
+    Py_ssize_t position = 0;
+    while (PyDict_Next(dict, &position, &key, &value)) {
+        int found = FALSE;
+        if (PyUnicode_Check(key)) {
+            for (int kind = 0; kind < 4; kind++) {
+                if (PyUnicode_CompareWithASCIIString(key, relation_keys[kind]) == 0) {
+                    Py_INCREF(value);
+                    Py_XSETREF(lists[4 + kind], value);
+                    found = TRUE;
+                }
+            }
+            int arguments = PyUnicode_CompareWithASCIIString(key, "add_arguments") == 0;
+            if (arguments || PyUnicode_CompareWithASCIIString(key, "modify_initial_strengths") == 0) {
+                if (!PyDict_Check(value)) {
+                    PyErr_Format(PyExc_TypeError, "%U must be a dict (argument: initial_strength)", key);
+                    goto error;
+                }
+                PyObject **pair = arguments ? lists : lists + 2;
+                Py_XSETREF(pair[0], PyDict_Keys(value));
+                Py_XSETREF(pair[1], PyDict_Values(value));
+                if (pair[0] == NULL || pair[1] == NULL) {
+                    goto error;
+                }
+                found = TRUE;
+            }
+        }
+        if (!found) {
+            PyErr_Format(PyExc_ValueError, "unknown change %R", key);
+            goto error;
+        }
+    }
+    changeset.arguments = lists[0];
+    changeset.strengths = lists[1];
+    changeset.modified = lists[2];
+    changeset.modified_strengths = lists[3];
+    for (int kind = 0; kind < 4; kind++) {
+        changeset.relations[kind] = lists[4 + kind];
+    }
+
+    PyObject *result = _QBAFramework_apply(self, &changeset);
+    for (int index = 0; index < 8; index++) {
+        Py_XDECREF(lists[index]);
+    }
+    return result;
+
+error:
+    for (int index = 0; index < 8; index++) {
+        Py_XDECREF(lists[index]);
+    }
+    return NULL;
 }
 
 /**
- * @brief Getter of the attribute max_strength.
+ * @brief Return True if the argument is contained, False if it is not, NULL if an error has occurred.
  * 
- * @param self the QBAFramework object
- * @param closure 
- * @return PyObject* new PyFloat with the max_strength
+ * @param self an instance of QBAFramework
+ * @param args the argument values (argument: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new PyBool, NULL in case of error
  */
 static PyObject *
-QBAFramework_getmax_strength(QBAFrameworkObject *self, void *closure)
+QBAFramework_contains_argument(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    return PyFloat_FromDouble(self->max_strength);
-}
+    static char *kwlist[] = {"argument", NULL};
+    PyObject *argument;
+    int contains;
 
-static PyObject *
-QBAFramework_getallow_cycles(QBAFrameworkObject *self, void *closure)
-{
-    Py_RETURN_BOOL(self->allow_cycles);
-}
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &argument))
+        return NULL;
 
-static PyObject *
-QBAFramework_getmax_iterations(QBAFrameworkObject *self, void *closure)
-{
-    return PyLong_FromSsize_t(self->max_iterations);
-}
+    contains = PySet_Contains(self->arguments, argument);
+    if (contains < 0) {
+        return NULL;
+    }
 
-static PyObject *
-QBAFramework_getconvergence_threshold(QBAFrameworkObject *self, void *closure)
-{
-    return PyFloat_FromDouble(self->convergence_threshold);
+    if (contains) {
+        Py_RETURN_TRUE;
+    }
+
+    Py_RETURN_FALSE;
 }
 
 /**
- * @brief Setter of the attribute disjoint_relations.
+ * @brief Return True if the Attack relation is contained, False if it is not, NULL if an error has occurred.
  * 
- * @param self the QBAFramework object
- * @param value PyBool value for disjoint_relations
- * @param closure 
- * @return int 0 if it was executed with no errors. Otherwise, -1.
+ * @param self an instance of QBAFramework
+ * @param args the argument values (attacker: QBAFArgument, attacked: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new PyBool, NULL in case of error
  */
-static int
-QBAFramework_setdisjoint_relations(QBAFrameworkObject *self, PyObject *value, void *closure)
+static PyObject *
+QBAFramework_contains_attack_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    if (!PyBool_Check(value)) {
-        PyErr_SetString(PyExc_TypeError,
-                        "disjoint_relations must be of type boolean");
-        return -1;
-    }
-    
-    int disjoint_relations = PyObject_IsTrue(value);
+    static char *kwlist[] = {"attacker", "attacked", NULL};
+    PyObject *agent, *patient;
+    int contains;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
+                                     &agent, &patient))
+        return NULL;
 
-    if (self->disjoint_relations == disjoint_relations) {
-        return 0;
+    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->attack_relations, agent, patient);
+    if (contains < 0) {
+        return NULL;
     }
 
-    self->disjoint_relations = disjoint_relations;
-
-    if (self->disjoint_relations) {
-        // Check attack and support relations are disjoint
-        int disjoint = _QBAFARelations_isDisjoint((QBAFARelationsObject*)self->attack_relations, (QBAFARelationsObject*)self->support_relations);
-        if (disjoint < 0) {
-            return -1;
-        }
-        if (!disjoint) {
-            PyErr_SetString(PyExc_ValueError, "attack_relations and support_relations are not disjoint");
-            return -1;
-        }
+    if (contains) {
+        Py_RETURN_TRUE;
     }
 
-    return 0;
+    Py_RETURN_FALSE;
 }
 
 /**
- * @brief Modify the initial strength of the Argument argument.
+ * @brief Return True if the Support relation is contained, False if it is not, NULL if an error has occurred.
  * 
  * @param self an instance of QBAFramework
- * @param args the argument values (argument: QBAFArgument, initial_strength: float)
+ * @param args the argument values (supporter: QBAFArgument, supported: QBAFArgument)
  * @param kwds the argument names
- * @return PyObject* new Py_None, NULL in case of error
+ * @return PyObject* new PyBool, NULL in case of error
  */
 static PyObject *
-QBAFramework_modify_initial_strengths(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_contains_support_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"argument", "initial_strength", NULL};
-    PyObject *argument, *initial_strength;
+    static char *kwlist[] = {"supporter", "supported", NULL};
+    PyObject *agent, *patient;
+    int contains;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
-                                     &argument, &initial_strength))
+                                     &agent, &patient))
         return NULL;
 
-    if (!PyFloat_Check(initial_strength) && !PyLong_Check(initial_strength)) {
-        PyErr_SetString(PyExc_TypeError, "initial_strength must be of a numeric type");
+    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->support_relations, agent, patient);
+    if (contains < 0) {
         return NULL;
     }
 
-    if (PyLong_Check(initial_strength)) {
-        // Transform the PyLong to PyFloat
-        double strength = PyLong_AsDouble(initial_strength);
-        if (strength == -1.0 && PyErr_Occurred()) {
-            return NULL;
-        }
-
-        initial_strength = PyFloat_FromDouble(strength);    // New reference
-        if (initial_strength == NULL) {
-            PyErr_SetString(PyExc_ValueError, "initial_strength could not be transformed to float");
-            return NULL;
-        }
-    } else {  
-        Py_INCREF(initial_strength);
+    if (contains) {
+        Py_RETURN_TRUE;
     }
 
-    // Check initial_strength is within range
-    int in_minmax = strength_in_minmax(initial_strength, self->min_strength, self->max_strength);
-    if (in_minmax < 0) {
-        Py_DECREF(initial_strength);
+    Py_RETURN_FALSE;
+}
+
+/**
+ * @brief Return the arguments that are attacked by the argument attacker,
+ * NULL (with the corresponding exception) if an error has occurred.
+ * 
+ * @param self 
+ * @param args the argument values (attacker: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
+ */
+static PyObject *
+QBAFramework_attackedBy(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"attacker", NULL};
+    PyObject *attacker;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &attacker))
         return NULL;
-    }
-    if (!in_minmax) {
-        char msg[100];
-        sprintf(msg, "initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
-        PyErr_SetString(PyExc_ValueError, msg);
-        Py_DECREF(initial_strength);
+
+    int contains = PySet_Contains(self->arguments, attacker);
+    if (contains < 0) {
         return NULL;
     }
-
-    if (PyDict_SetItem(self->initial_strengths, argument, initial_strength) < 0) {
-        Py_DECREF(initial_strength);
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "attacker must be an argument of the framework");
         return NULL;
     }
 
-    Py_DECREF(initial_strength);
-
-    self->modified = TRUE;
-
-    Py_RETURN_NONE;
+    return _QBAFARelations_patients((QBAFARelationsObject *)self->attack_relations, attacker);
 }
 
 /**
- * @brief Return the initial strength of the Argument argument, NULL in case of error.
+ * @brief Return the arguments that are attacking the argument attacked,
+ * NULL (with the corresponding exception) if an error has occurred.
  * 
- * @param self an instance of QBAFramework
- * @param args the argument values (argument: QBAFArgument)
+ * @param self 
+ * @param args the argument values (attacked: QBAFArgument)
  * @param kwds the argument names
- * @return PyObject* new PyFloat
+ * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
  */
 static PyObject *
-QBAFramework_initial_strength(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_attackersOf(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"argument", NULL};
-    PyObject *argument;
+    static char *kwlist[] = {"attacked", NULL};
+    PyObject *attacked;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
-                                     &argument))
+                                     &attacked))
         return NULL;
 
-    int contains = PyDict_Contains(self->initial_strengths, argument);
+    int contains = PySet_Contains(self->arguments, attacked);
     if (contains < 0) {
         return NULL;
     }
     if (!contains) {
         PyErr_SetString(PyExc_ValueError,
-                        "argument must be contained in the QBAFramework");
+                        "attacked must be an argument of the framework");
         return NULL;
     }
 
-    PyObject *initial_strength = PyDict_GetItem(self->initial_strengths, argument);
-    Py_INCREF(initial_strength);
-    return initial_strength;
+    return _QBAFARelations_agents((QBAFARelationsObject *)self->attack_relations, attacked);
 }
 
 /**
- * @brief Add an Argument to the Framework. If it exists already it does nothing.
+ * @brief Return the arguments that are supported by the argument supporter,
+ * NULL (with the corresponding exception) if an error has occurred.
  * 
- * @param self an instance of QBAFramework
- * @param args the argument values (argument: QBAFArgument, initial_strength: float)
+ * @param self 
+ * @param args the argument values (supporter: QBAFArgument)
  * @param kwds the argument names
- * @return PyObject* new Py_None, NULL in case of error
+ * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
  */
 static PyObject *
-QBAFramework_add_argument(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_supportedBy(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"argument", "initial_strength", NULL};
-    PyObject *argument, *initial_strength = NULL;
+    static char *kwlist[] = {"supporter", NULL};
+    PyObject *supporter;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
-                                     &argument, &initial_strength))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &supporter))
         return NULL;
 
-    double default_initial_strength = 0.0;
+    int contains = PySet_Contains(self->arguments, supporter);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "supporter must be an argument of the framework");
+        return NULL;
+    }
 
-    if (initial_strength == NULL) {
+    return _QBAFARelations_patients((QBAFARelationsObject *)self->support_relations, supporter);
+}
 
-        initial_strength = PyFloat_FromDouble(default_initial_strength);    // New reference
-        if (initial_strength == NULL)
-            return NULL;
+/**
+ * @brief Return the arguments that are supporting the argument supported,
+ * NULL (with the corresponding exception) if an error has occurred.
+ * 
+ * @param self 
+ * @param args the argument values (supported: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
+ */
+static PyObject *
+QBAFramework_supportersOf(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"supported", NULL};
+    PyObject *supported;
 
-    } else {
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &supported))
+        return NULL;
 
-        if (!PyFloat_Check(initial_strength) && !PyLong_Check(initial_strength)) {
-            PyErr_SetString(PyExc_TypeError, "initial_strength must be of a numeric type");
-            return NULL;
-        }
+    int contains = PySet_Contains(self->arguments, supported);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "supported must be an argument of the framework");
+        return NULL;
+    }
 
-        if (PyLong_Check(initial_strength)) {
-            // Transform the PyLong to PyFloat
-            double strength = PyLong_AsDouble(initial_strength);
-            if (strength == -1.0 && PyErr_Occurred()) {
-                return NULL;
-            }
+    return _QBAFARelations_agents((QBAFARelationsObject *)self->support_relations, supported);
+}
 
-            initial_strength = PyFloat_FromDouble(strength);    // New reference
-            if (initial_strength == NULL) {
-                PyErr_SetString(PyExc_ValueError, "initial_strength could not be transformed to float");
-                return NULL;
-            }
-        } else {  
-            Py_INCREF(initial_strength);
-        }
+/**
+ * @brief Return a read-only view of the arguments that are being attacked by the argument attacker,
+ * NULL (with the corresponding exception) if an error has occurred.
+ * 
+ * @param self 
+ * @param args the argument values (attacker: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new QBAFARelationsView, NULL if an error occurred
+ */
+static PyObject *
+QBAFramework_attacked_view(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"attacker", NULL};
+    PyObject *attacker;
 
-    }
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &attacker))
+        return NULL;
 
-    int contains = PySet_Contains(self->arguments, argument);
+    int contains = PySet_Contains(self->arguments, attacker);
     if (contains < 0) {
-        Py_DECREF(initial_strength);
         return NULL;
     }
-    if (contains) { // If the argument already exists it does nothing
-        Py_RETURN_NONE;
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "attacker must be an argument of the framework");
+        return NULL;
     }
 
-    // Check initial_strength is within range
-    int in_minmax = strength_in_minmax(initial_strength, self->min_strength, self->max_strength);
-    if (in_minmax < 0) {
-        Py_DECREF(initial_strength);
+    return QBAFARelations_View((QBAFARelationsObject *)self->attack_relations, attacker, 0);
+}
+
+/**
+ * @brief Return a read-only view of the arguments that are attacking the argument attacked,
+ * NULL (with the corresponding exception) if an error has occurred.
+ * 
+ * @param self 
+ * @param args the argument values (attacked: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new QBAFARelationsView, NULL if an error occurred
+ */
+static PyObject *
+QBAFramework_attackers_view(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"attacked", NULL};
+    PyObject *attacked;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &attacked))
         return NULL;
-    }
-    if (!in_minmax) {
-        char msg[100];
-        sprintf(msg, "initial_strength must be within range (%.2f, %.2f)", self->min_strength, self->max_strength);
-        PyErr_SetString(PyExc_ValueError, msg);
-        Py_DECREF(initial_strength);
+
+    int contains = PySet_Contains(self->arguments, attacked);
+    if (contains < 0) {
         return NULL;
     }
-
-    // the new argument, initial_strength is added
-    if (PyDict_SetItem(self->initial_strengths, argument, initial_strength) < 0) {
-        Py_DECREF(initial_strength);
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "attacked must be an argument of the framework");
         return NULL;
     }
 
-    Py_DECREF(initial_strength);
+    return QBAFARelations_View((QBAFARelationsObject *)self->attack_relations, attacked, 1);
+}
 
-    if (PySet_Add(self->arguments, argument) < 0) {
+/**
+ * @brief Return a read-only view of the arguments that are being supported by the argument supporter,
+ * NULL (with the corresponding exception) if an error has occurred.
+ * 
+ * @param self 
+ * @param args the argument values (supporter: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new QBAFARelationsView, NULL if an error occurred
+ */
+static PyObject *
+QBAFramework_supported_view(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"supporter", NULL};
+    PyObject *supporter;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &supporter))
         return NULL;
-    }
 
-    self->modified = TRUE;
+    int contains = PySet_Contains(self->arguments, supporter);
+    if (contains < 0) {
+        return NULL;
+    }
+    if (!contains) {
+        PyErr_SetString(PyExc_ValueError,
+                        "supporter must be an argument of the framework");
+        return NULL;
+    }
 
-    Py_RETURN_NONE;
+    return QBAFARelations_View((QBAFARelationsObject *)self->support_relations, supporter, 0);
 }
 
 /**
- * @brief Remove an Argument from the Framework. If it does not exist already it does nothing.
+ * @brief Return a read-only view of the arguments that are supporting the argument supported,
+ * NULL (with the corresponding exception) if an error has occurred.
  * 
- * @param self an instance of QBAFramework
- * @param args the argument values (argument: QBAFArgument)
+ * @param self 
+ * @param args the argument values (supported: QBAFArgument)
  * @param kwds the argument names
- * @return PyObject* new Py_None, NULL in case of error
+ * @return PyObject* new QBAFARelationsView, NULL if an error occurred
  */
 static PyObject *
-QBAFramework_remove_argument(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_supporters_view(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"argument", NULL};
-    PyObject *argument;
+    static char *kwlist[] = {"supported", NULL};
+    PyObject *supported;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
-                                     &argument))
-        return NULL;
-
-    int contains = PySet_Contains(self->arguments, argument);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (!contains) { // If the argument does not exist it does nothing
-        Py_RETURN_NONE;
-    }
-
-    // Check that the argument is not in attack relations
-    contains = QBAFARelations_contains_argument((QBAFARelationsObject*)self->attack_relations, argument);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (contains) {
-        PyErr_SetString(PyExc_ValueError,
-                        "cannot remove argument that is contained in attack relations");
+                                     &supported))
         return NULL;
-    }
 
-    // Check that the argument is not in support relations
-    contains = QBAFARelations_contains_argument((QBAFARelationsObject*)self->support_relations, argument);
+    int contains = PySet_Contains(self->arguments, supported);
     if (contains < 0) {
         return NULL;
     }
-    if (contains) {
+    if (!contains) {
         PyErr_SetString(PyExc_ValueError,
-                        "cannot remove argument that is contained in support relations");
-        return NULL;
-    }
-
-    if (PySet_Discard(self->arguments, argument) < 0) {
-        return NULL;
-    }
-
-    if (PyDict_DelItem(self->initial_strengths, argument) < 0) {
+                        "supported must be an argument of the framework");
         return NULL;
     }
 
-    self->modified = TRUE;
-
-    Py_RETURN_NONE;
+    return QBAFARelations_View((QBAFARelationsObject *)self->support_relations, supported, 1);
 }
 
 /**
- * @brief Add the Attack relation (attacker, attacked) to the Framework.
+ * @brief Return the number of attackers and/or supporters of argument,
+ * NULL (with the corresponding exception) if an error has occurred.
  * 
- * @param self an instance of QBAFramework
- * @param args the argument values (attacker: QBAFArgument, attacked: QBAFArgument)
+ * @param self 
+ * @param args the argument values (argument: QBAFArgument, relation: str or None)
  * @param kwds the argument names
- * @return PyObject* new Py_None, NULL in case of error
+ * @return PyObject* new PyLong, NULL if an error occurred
  */
 static PyObject *
-QBAFramework_add_attack_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_in_degree(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"attacker", "attacked", NULL};
-    PyObject *agent, *patient;
-    int contains;
+    static char *kwlist[] = {"argument", "relation", NULL};
+    PyObject *argument;
+    const char *relation = NULL;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
-                                     &agent, &patient))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|z", kwlist,
+                                     &argument, &relation))
         return NULL;
 
-    contains = PySet_Contains(self->arguments, agent);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (!contains) {
+    int attack = relation == NULL || strcmp(relation, "attack") == 0;
+    int support = relation == NULL || strcmp(relation, "support") == 0;
+    if (!attack && !support) {
         PyErr_SetString(PyExc_ValueError,
-                        "argument attacker is not contained in the framework");
+                        "relation must be 'attack', 'support' or None");
         return NULL;
     }
 
-    contains = PySet_Contains(self->arguments, patient);
+    int contains = PySet_Contains(self->arguments, argument);
     if (contains < 0) {
         return NULL;
     }
     if (!contains) {
         PyErr_SetString(PyExc_ValueError,
-                        "argument attacked is not contained in the framework");
+                        "argument must be an argument of the framework");
         return NULL;
     }
 
-    if (self->disjoint_relations) {
-        contains = _QBAFARelations_contains((QBAFARelationsObject*) self->support_relations, agent, patient);
-        if (contains < 0) {
+    Py_ssize_t degree = 0, size;
+    if (attack) {
+        size = QBAFARelations_Degree((QBAFARelationsObject *)self->attack_relations, argument, 1);
+        if (size < 0) {
             return NULL;
         }
-        if (contains) {
-            PyErr_SetString(PyExc_ValueError,
-                            "attack relation already exists as support relation");
+        degree += size;
+    }
+    if (support) {
+        size = QBAFARelations_Degree((QBAFARelationsObject *)self->support_relations, argument, 1);
+        if (size < 0) {
             return NULL;
         }
+        degree += size;
     }
-
-    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->attack_relations, agent, patient);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (contains) {
-        Py_RETURN_NONE;
-    }
-
-    if (_QBAFARelations_add((QBAFARelationsObject*) self->attack_relations, agent, patient) < 0) {
-        return NULL;
-    }
-
-    self->modified = TRUE;
-
-    Py_RETURN_NONE;
+    return PyLong_FromSsize_t(degree);
 }
 
 /**
- * @brief Add the Support relation (supporter, supported) to the Framework.
+ * @brief Return the number of arguments attacked and/or supported by argument,
+ * NULL (with the corresponding exception) if an error has occurred.
  * 
- * @param self an instance of QBAFramework
- * @param args the argument values (supporter: QBAFArgument, supported: QBAFArgument)
+ * @param self 
+ * @param args the argument values (argument: QBAFArgument, relation: str or None)
  * @param kwds the argument names
- * @return PyObject* new Py_None, NULL in case of error
+ * @return PyObject* new PyLong, NULL if an error occurred
  */
 static PyObject *
-QBAFramework_add_support_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_out_degree(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"supporter", "supported", NULL};
-    PyObject *agent, *patient;
-    int contains;
+    static char *kwlist[] = {"argument", "relation", NULL};
+    PyObject *argument;
+    const char *relation = NULL;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
-                                     &agent, &patient))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|z", kwlist,
+                                     &argument, &relation))
         return NULL;
 
-    contains = PySet_Contains(self->arguments, agent);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (!contains) {
+    int attack = relation == NULL || strcmp(relation, "attack") == 0;
+    int support = relation == NULL || strcmp(relation, "support") == 0;
+    if (!attack && !support) {
         PyErr_SetString(PyExc_ValueError,
-                        "argument supporter is not contained in the framework");
+                        "relation must be 'attack', 'support' or None");
         return NULL;
     }
 
-    contains = PySet_Contains(self->arguments, patient);
+    int contains = PySet_Contains(self->arguments, argument);
     if (contains < 0) {
         return NULL;
     }
     if (!contains) {
         PyErr_SetString(PyExc_ValueError,
-                        "argument supported is not contained in the framework");
+                        "argument must be an argument of the framework");
         return NULL;
     }
 
-    if (self->disjoint_relations) {
-        contains = _QBAFARelations_contains((QBAFARelationsObject*) self->attack_relations, agent, patient);
-        if (contains < 0) {
+    Py_ssize_t degree = 0, size;
+    if (attack) {
+        size = QBAFARelations_Degree((QBAFARelationsObject *)self->attack_relations, argument, 0);
+        if (size < 0) {
             return NULL;
         }
-        if (contains) {
-            PyErr_SetString(PyExc_ValueError,
-                            "support relation already exists as attack relation");
+        degree += size;
+    }
+    if (support) {
+        size = QBAFARelations_Degree((QBAFARelationsObject *)self->support_relations, argument, 0);
+        if (size < 0) {
             return NULL;
         }
+        degree += size;
     }
-
-    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->support_relations, agent, patient);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (contains) {
-        Py_RETURN_NONE;
-    }
-
-    if (_QBAFARelations_add((QBAFARelationsObject*) self->support_relations, agent, patient) < 0) {
-        return NULL;
-    }
-
-    self->modified = TRUE;
-
-    Py_RETURN_NONE;
+    return PyLong_FromSsize_t(degree);
 }
 
 /**
- * @brief Remove the Attack relation (attacker, attacked) from the Framework.
+ * @brief Return a shallow copy of this instance.
+ * New references are created for the copy, except for the QBAFArgument and QBAFARelations.
+ * The copy shares the arguments and the relations of self until one of them modifies them, so it takes
+ * constant time apart from copying the strengths.
  * 
- * @param self an instance of QBAFramework
- * @param args the argument values (attacker: QBAFArgument, attacked: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new Py_None, NULL in case of error
+ * @param self instance of QBAFramework
+ * @param Py_UNUSED 
+ * @return PyObject* new instance of QBAFramework
  */
-static PyObject *
-QBAFramework_remove_attack_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+PyObject *
+QBAFramework_copy(QBAFrameworkObject *self, PyObject *Py_UNUSED(ignored))
 {
-    static char *kwlist[] = {"attacker", "attacked", NULL};
-    PyObject *agent, *patient;
-    int contains;
+    PyObject *kwds = NULL;
+    PyObject *args = NULL;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
-                                     &agent, &patient))
+    QBAFrameworkObject *copy = (QBAFrameworkObject*) QBAFramework_new(Py_TYPE(self), args, kwds);
+    if (copy == NULL) {
         return NULL;
+    }
 
-    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->attack_relations, agent, patient);
-    if (contains < 0) {
+    // The arguments, their ids and the relations are shared until one of the frameworks modifies them
+    if (_QBAFramework_share_arguments(copy, self) < 0) {
+        Py_DECREF(copy);
         return NULL;
     }
-    if (!contains) {
-        Py_RETURN_NONE;
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    if (_QBAFramework_reserve_strengths(copy, size) < 0) {
+        Py_DECREF(copy);
+        return NULL;
+    }
+    if (size > 0) {
+        memcpy(copy->initial_strengths, self->initial_strengths, size * sizeof(double));
+        memcpy(copy->final_strengths, self->final_strengths, size * sizeof(double));
+        memcpy(copy->stale, self->stale, size * sizeof(char));
+        if (self->incremental != NULL) {    // The changes that have not been propagated yet
+            QBAFIncremental_MarkPending(self->incremental, copy->stale);
+        }
     }
+    copy->staleness_bound = self->staleness_bound;
+    copy->outside_unit = self->outside_unit;
+    if (size > 0) {
+        memcpy(copy->order, self->order, size * sizeof(Py_ssize_t));
+    }
+    copy->acyclic = self->acyclic;
+    copy->next_order = self->next_order;
 
-    if (_QBAFARelations_remove((QBAFARelationsObject*) self->attack_relations, agent, patient) < 0) {
+    Py_SETREF(copy->attack_relations, QBAFARelations_Share((QBAFARelationsObject*)self->attack_relations,
+                                                           copy->argument_ids, copy->id_arguments));
+    if (copy->attack_relations == NULL) {
+        Py_DECREF(copy);
+        return NULL;
+    }
+    Py_SETREF(copy->support_relations, QBAFARelations_Share((QBAFARelationsObject*)self->support_relations,
+                                                            copy->argument_ids, copy->id_arguments));
+    if (copy->support_relations == NULL) {
+        Py_DECREF(copy);
         return NULL;
     }
 
-    self->modified = TRUE;
+    copy->modified = self->modified;
+    copy->disjoint_relations = self->disjoint_relations;
 
-    Py_RETURN_NONE;
+    copy->semantics = self->semantics;
+    copy->aggregation_function = self->aggregation_function;
+    copy->influence_function = self->influence_function;
+    copy->min_strength = self->min_strength;
+    copy->max_strength = self->max_strength;
+    copy->allow_cycles = self->allow_cycles;
+    copy->max_iterations = self->max_iterations;
+    copy->convergence_threshold = self->convergence_threshold;
+    copy->compress = self->compress;
+    copy->incremental_tolerance = self->incremental_tolerance;
+    copy->reject_cycles = self->reject_cycles;
+
+    Py_XINCREF(self->aggregation_function_callable);
+    copy->aggregation_function_callable = self->aggregation_function_callable;
+    Py_XINCREF(self->influence_function_callable);
+    copy->influence_function_callable = self->influence_function_callable;
+    
+    return (PyObject*)copy;
 }
 
 /**
- * @brief Remove the Support relation (supporter, supported) from the Framework.
- * 
- * @param self an instance of QBAFramework
- * @param args the argument values (supporter: QBAFArgument, supported: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new Py_None, NULL in case of error
+ * @brief Return a 64-bit value whose bits depend on all the bits of x (the finalizer of SplitMix64).
+ *
+ * @param x a 64-bit value
+ * @return uint64_t the mixed value
  */
-static PyObject *
-QBAFramework_remove_support_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+static inline uint64_t
+_QBAFramework_mix(uint64_t x)
 {
-    static char *kwlist[] = {"supporter", "supported", NULL};
-    PyObject *agent, *patient;
-    int contains;
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
-                                     &agent, &patient))
-        return NULL;
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
 
-    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->support_relations, agent, patient);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (!contains) {
-        Py_RETURN_NONE;
+/**
+ * @brief Return the structural hash of the Framework: its arguments with their initial strengths, and its attack and
+ * support relations. It does not depend on the internal ids, so equal Frameworks have the same hash.
+ *
+ * @param self an instance of QBAFramework
+ * @return Py_hash_t the hash, -1 if an error occurred
+ */
+static Py_hash_t
+_QBAFramework_fingerprint(QBAFrameworkObject *self)
+{
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    uint64_t *hashes = PyMem_Malloc((size > 0 ? size : 1) * sizeof(uint64_t));
+    if (hashes == NULL) {
+        PyErr_NoMemory();
+        return -1;
     }
 
-    if (_QBAFARelations_remove((QBAFARelationsObject*) self->support_relations, agent, patient) < 0) {
-        return NULL;
+    // The hashes of the arguments and the relations are added, so they do not depend on their order
+    uint64_t arguments = 0, relations[2] = {0, 0};
+    for (Py_ssize_t id = 0; id < size; id++) {
+        Py_hash_t hash = PyObject_Hash(PyList_GET_ITEM(self->id_arguments, id));
+        if (hash == -1) {
+            PyMem_Free(hashes);
+            return -1;
+        }
+        hashes[id] = _QBAFramework_mix((uint64_t)hash);
+        double strength = self->initial_strengths[id] == 0.0 ? 0.0 : self->initial_strengths[id];    // -0.0 == 0.0
+        uint64_t bits;
+        memcpy(&bits, &strength, sizeof(uint64_t));
+        arguments += _QBAFramework_mix(hashes[id] ^ _QBAFramework_mix(bits));
+    }
+    QBAFARelationsObject *kinds[2] = {(QBAFARelationsObject*)self->attack_relations,
+                                      (QBAFARelationsObject*)self->support_relations};
+    for (int kind = 0; kind < 2; kind++) {
+        for (Py_ssize_t agent = 0; agent < size; agent++) {
+            Py_ssize_t patients_size;
+            const Py_ssize_t *patients = QBAFARelations_PatientIds(kinds[kind], agent, &patients_size);
+            for (Py_ssize_t index = 0; index < patients_size; index++) {
+                relations[kind] += _QBAFramework_mix(hashes[agent] + 3 * _QBAFramework_mix(hashes[patients[index]]));
+            }
+        }
     }
+    PyMem_Free(hashes);
 
-    self->modified = TRUE;
-
-    Py_RETURN_NONE;
+    uint64_t fingerprint = _QBAFramework_mix(arguments ^ _QBAFramework_mix(relations[0] + 1) ^
+                                             _QBAFramework_mix(_QBAFramework_mix(relations[1] + 2)));
+    Py_hash_t hash = (Py_hash_t)fingerprint;
+    return hash == -1 ? -2 : hash;
 }
 
 /**
- * @brief Return True if the argument is contained, False if it is not, NULL if an error has occurred.
- * 
- * @param self an instance of QBAFramework
- * @param args the argument values (argument: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new PyBool, NULL in case of error
+ * @brief Return a frozen copy of this instance, or self if it is already frozen. A frozen QBAFramework cannot be
+ * modified, its final strengths are calculated once, and it is hashable by its structural fingerprint.
+ *
+ * @param self instance of QBAFramework
+ * @param Py_UNUSED
+ * @return PyObject* new reference to a frozen QBAFramework, NULL if an error occurred
  */
 static PyObject *
-QBAFramework_contains_argument(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_freeze(QBAFrameworkObject *self, PyObject *Py_UNUSED(ignored))
 {
-    static char *kwlist[] = {"argument", NULL};
-    PyObject *argument;
-    int contains;
+    if (self->frozen) {
+        Py_INCREF(self);
+        return (PyObject*)self;
+    }
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
-                                     &argument))
+    QBAFrameworkObject *frozen = (QBAFrameworkObject*)QBAFramework_copy(self, NULL);
+    if (frozen == NULL) {
         return NULL;
-
-    contains = PySet_Contains(self->arguments, argument);
-    if (contains < 0) {
+    }
+    frozen->evaluation_lock = PyThread_allocate_lock();
+    if (frozen->evaluation_lock == NULL) {
+        Py_DECREF(frozen);
+        PyErr_NoMemory();
         return NULL;
     }
+    frozen->fingerprint = _QBAFramework_fingerprint(frozen);
+    if (frozen->fingerprint == -1) {
+        Py_DECREF(frozen);
+        return NULL;
+    }
+    frozen->frozen = TRUE;
+    return (PyObject*)frozen;
+}
 
-    if (contains) {
-        Py_RETURN_TRUE;
+/**
+ * @brief Return the hash of a frozen QBAFramework, -1 with a TypeError if it is not frozen.
+ *
+ * @param self instance of QBAFramework
+ * @return Py_hash_t the structural fingerprint of self, -1 if an error occurred
+ */
+static Py_hash_t
+QBAFramework_hash(QBAFrameworkObject *self)
+{
+    if (!self->frozen) {
+        PyErr_Format(PyExc_TypeError, "unhashable type: '%s' (freeze() returns a hashable copy)", Py_TYPE(self)->tp_name);
+        return -1;
     }
-
-    Py_RETURN_FALSE;
+    return self->fingerprint;
 }
 
 /**
- * @brief Return True if the Attack relation is contained, False if it is not, NULL if an error has occurred.
+ * @brief Return True if the relations of the Framework are acyclic, False if not,
+ * -1 if an error has occurred. It is maintained when relations are added, so it is only calculated
+ * (by building the evaluation plan) when it is not known, e.g. after removing relations of a cyclic Framework.
  * 
  * @param self an instance of QBAFramework
- * @param args the argument values (attacker: QBAFArgument, attacked: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new PyBool, NULL in case of error
+ * @return PyObject* 1 if acyclic, 0 if not acyclic, -1 if an error occurred
  */
-static PyObject *
-QBAFramework_contains_attack_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+static inline int
+_QBAFramework_isacyclic(QBAFrameworkObject *self)
 {
-    static char *kwlist[] = {"attacker", "attacked", NULL};
-    PyObject *agent, *patient;
-    int contains;
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
-                                     &agent, &patient))
-        return NULL;
-
-    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->attack_relations, agent, patient);
-    if (contains < 0) {
-        return NULL;
-    }
-
-    if (contains) {
-        Py_RETURN_TRUE;
+    if (self->acyclic < 0 && _QBAFramework_plan(self) == NULL) {
+        return -1;
     }
-
-    Py_RETURN_FALSE;
+    return self->acyclic;
 }
 
 /**
- * @brief Return True if the Support relation is contained, False if it is not, NULL if an error has occurred.
+ * @brief Return True if the relations of the Framework are acyclic, False if not,
+ * NULL if an error has occurred.
  * 
  * @param self an instance of QBAFramework
- * @param args the argument values (supporter: QBAFArgument, supported: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new PyBool, NULL in case of error
+ * @param Py_UNUSED 
+ * @return PyObject* new PyBool.
  */
 static PyObject *
-QBAFramework_contains_support_relation(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_isacyclic(QBAFrameworkObject *self, PyObject *Py_UNUSED(ignored))
 {
-    static char *kwlist[] = {"supporter", "supported", NULL};
-    PyObject *agent, *patient;
-    int contains;
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|", kwlist,
-                                     &agent, &patient))
-        return NULL;
-
-    contains = _QBAFARelations_contains((QBAFARelationsObject*) self->support_relations, agent, patient);
-    if (contains < 0) {
+    int isacyclic = _QBAFramework_isacyclic(self);
+    if (isacyclic < 0) {
         return NULL;
     }
 
-    if (contains) {
+    if (isacyclic)
         Py_RETURN_TRUE;
-    }
-
+        
     Py_RETURN_FALSE;
 }
 
 /**
- * @brief Return the arguments that are attacked by the argument attacker,
- * NULL (with the corresponding exception) if an error has occurred.
- * 
- * @param self 
- * @param args the argument values (attacker: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
+ * @brief Return an immutable evaluation plan of the current structure of the Framework, NULL if an error occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param args the argument values (ordering: str, optional)
+ * @param kwds the names of the arguments
+ * @return PyObject* new reference to a QBAFPlan, NULL if an error occurred
  */
 static PyObject *
-QBAFramework_attackedBy(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_compile(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"attacker", NULL};
-    PyObject *attacker;
+    static char *kwlist[] = {"ordering", NULL};
+    const char *ordering = "natural";
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
-                                     &attacker))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|s", kwlist, &ordering))
         return NULL;
 
-    int contains = PySet_Contains(self->arguments, attacker);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (!contains) {
-        PyErr_SetString(PyExc_ValueError,
-                        "attacker must be an argument of the framework");
+    QBAFPlanObject *plan = _QBAFramework_plan(self);
+    if (plan == NULL) {
         return NULL;
     }
-
-    return _QBAFARelations_patients((QBAFARelationsObject *)self->attack_relations, attacker);
+    return QBAFPlan_Reorder(plan, ordering);
 }
 
 /**
- * @brief Return the arguments that are attacking the argument attacked,
- * NULL (with the corresponding exception) if an error has occurred.
- * 
- * @param self 
- * @param args the argument values (attacked: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
+ * @brief Return the weakly connected components of the Framework, NULL if an error occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param Py_UNUSED
+ * @return PyObject* a new PyList of PySet of QBAFArgument, NULL if an error occurred
  */
 static PyObject *
-QBAFramework_attackersOf(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_connected_components(QBAFrameworkObject *self, PyObject *Py_UNUSED(ignored))
 {
-    static char *kwlist[] = {"attacked", NULL};
-    PyObject *attacked;
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
-                                     &attacked))
+    QBAFPlanObject *plan = _QBAFramework_plan(self);
+    if (plan == NULL || QBAFPlan_EnsureComponents(plan) < 0) {
         return NULL;
+    }
 
-    int contains = PySet_Contains(self->arguments, attacked);
-    if (contains < 0) {
+    PyObject *components = PyList_New(plan->components_size);
+    if (components == NULL) {
         return NULL;
     }
-    if (!contains) {
-        PyErr_SetString(PyExc_ValueError,
-                        "attacked must be an argument of the framework");
-        return NULL;
+    for (Py_ssize_t component = 0; component < plan->components_size; component++) {
+        PyObject *set = PySet_New(NULL);
+        if (set == NULL) {
+            Py_DECREF(components);
+            return NULL;
+        }
+        PyList_SET_ITEM(components, component, set);
+        for (Py_ssize_t member = plan->component_offsets[component]; member < plan->component_offsets[component+1]; member++) {
+            if (PySet_Add(set, PyTuple_GET_ITEM(plan->arguments, plan->component_members[member])) < 0) {
+                Py_DECREF(components);
+                return NULL;
+            }
+        }
     }
-
-    return _QBAFARelations_agents((QBAFARelationsObject *)self->attack_relations, attacked);
+    return components;
 }
 
+
 /**
- * @brief Return the arguments that are supported by the argument supporter,
- * NULL (with the corresponding exception) if an error has occurred.
- * 
- * @param self 
- * @param args the argument values (supporter: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
+ * @brief Return the final strengths of the Framework under several semantics in a single traversal,
+ * NULL if an error occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param args the argument values (semantics: list of str)
+ * @param kwds the names of the arguments
+ * @return PyObject* a new PyDict (semantics: str, final_strengths: dict), NULL if an error occurred
  */
 static PyObject *
-QBAFramework_supportedBy(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+QBAFramework_final_strengths_by_semantics(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"supporter", NULL};
-    PyObject *supporter;
+    static char *kwlist[] = {"semantics", NULL};
+    PyObject *semantics_names;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
-                                     &supporter))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &semantics_names))
         return NULL;
 
-    int contains = PySet_Contains(self->arguments, supporter);
-    if (contains < 0) {
+    PyObject *names = PySequence_Fast(semantics_names, "semantics must be a list of str");
+    if (names == NULL) {
         return NULL;
     }
-    if (!contains) {
-        PyErr_SetString(PyExc_ValueError,
-                        "supporter must be an argument of the framework");
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(names);
+
+    QBAFSemantics *semantics = PyMem_Malloc((count + 1) * sizeof(QBAFSemantics));
+    if (semantics == NULL) {
+        Py_DECREF(names);
+        PyErr_NoMemory();
         return NULL;
     }
 
-    return _QBAFARelations_patients((QBAFARelationsObject *)self->support_relations, supporter);
-}
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    for (Py_ssize_t k = 0; k < count; k++) {
+        PyObject *name = PySequence_Fast_GET_ITEM(names, k);
+        if (!PyUnicode_Check(name)) {
+            PyErr_SetString(PyExc_TypeError, "semantics must be a list of str");
+            Py_DECREF(names); PyMem_Free(semantics);
+            return NULL;
+        }
+        const char *str = PyUnicode_AsUTF8(name);
+        if (str == NULL) {
+            Py_DECREF(names); PyMem_Free(semantics);
+            return NULL;
+        }
+        if (!_QBAFramework_lookup_semantics(str, &semantics[k])) {
+            PyErr_SetString(PyExc_ValueError, "incorrect value of semantics");
+            Py_DECREF(names); PyMem_Free(semantics);
+            return NULL;
+        }
+        for (Py_ssize_t id = 0; id < size; id++) {
+            if (self->initial_strengths[id] < semantics[k].min_strength || self->initial_strengths[id] > semantics[k].max_strength) {
+                PyErr_Format(PyExc_ValueError, "every initial_strength must be within range (%.2f, %.2f) of %s",
+                             semantics[k].min_strength, semantics[k].max_strength, semantics[k].semantics);
+                Py_DECREF(names); PyMem_Free(semantics);
+                return NULL;
+            }
+        }
+    }
+    Py_DECREF(names);
 
-/**
- * @brief Return the arguments that are supporting the argument supported,
- * NULL (with the corresponding exception) if an error has occurred.
- * 
- * @param self 
- * @param args the argument values (supported: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
- */
-static PyObject *
-QBAFramework_supportersOf(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
-{
-    static char *kwlist[] = {"supported", NULL};
-    PyObject *supported;
+    QBAFPlanObject *plan = _QBAFramework_plan(self);
+    if (plan == NULL) {
+        PyMem_Free(semantics);
+        return NULL;
+    }
+    int cyclic = plan->schedule == NULL;
+    if (cyclic && !self->allow_cycles) {
+        PyErr_SetString(PyExc_NotImplementedError, "calculate final strengths of cyclic framework requires allow_cycles=True");
+        PyMem_Free(semantics);
+        return NULL;
+    }
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
-                                     &supported))
+    double *final_strengths = PyMem_Malloc((size * count + 1) * sizeof(double));
+    double *work_strengths = PyMem_Malloc((cyclic ? 2 * size * count + 1 : 1) * sizeof(double));
+    char *converged = PyMem_Malloc(count + 1);
+    double *buffer = PyMem_Malloc((plan->max_dependencies * count + 1) * sizeof(double));
+    if (final_strengths == NULL || work_strengths == NULL || converged == NULL || buffer == NULL) {
+        PyMem_Free(final_strengths); PyMem_Free(work_strengths); PyMem_Free(converged); PyMem_Free(buffer);
+        PyMem_Free(semantics);
+        PyErr_NoMemory();
         return NULL;
+    }
 
-    int contains = PySet_Contains(self->arguments, supported);
-    if (contains < 0) {
+    // The GIL is kept: the plan and the initial strengths belong to the Framework, which another thread could modify
+    int result = QBAFPlan_EvaluateMultiple(plan, semantics, count, self->initial_strengths, final_strengths,
+                                           work_strengths, converged, buffer);
+    PyMem_Free(work_strengths); PyMem_Free(converged); PyMem_Free(buffer);
+
+    if (result != 0) {
+        PyErr_Format(PyExc_RuntimeError, "cyclic framework did not converge within %zd iterations", self->max_iterations);
+        PyMem_Free(final_strengths); PyMem_Free(semantics);
         return NULL;
     }
-    if (!contains) {
-        PyErr_SetString(PyExc_ValueError,
-                        "supported must be an argument of the framework");
+
+    PyObject *strengths_by_semantics = PyDict_New();
+    if (strengths_by_semantics == NULL) {
+        PyMem_Free(final_strengths); PyMem_Free(semantics);
         return NULL;
     }
+    for (Py_ssize_t k = 0; k < count; k++) {
+        PyObject *strengths = _QBAFramework_strided_strengths_dict(self, final_strengths + k, count);
+        if (strengths == NULL) {
+            Py_DECREF(strengths_by_semantics); PyMem_Free(final_strengths); PyMem_Free(semantics);
+            return NULL;
+        }
+        if (PyDict_SetItemString(strengths_by_semantics, semantics[k].semantics, strengths) < 0) {
+            Py_DECREF(strengths); Py_DECREF(strengths_by_semantics);
+            PyMem_Free(final_strengths); PyMem_Free(semantics);
+            return NULL;
+        }
+        Py_DECREF(strengths);
+    }
 
-    return _QBAFARelations_agents((QBAFARelationsObject *)self->support_relations, supported);
+    PyMem_Free(final_strengths); PyMem_Free(semantics);
+    return strengths_by_semantics;
 }
 
+
 /**
- * @brief Return a shallow copy of this instance.
- * New references are created for the copy, except for the QBAFArgument and QBAFARelations.
- * 
- * @param self instance of QBAFramework
- * @param Py_UNUSED 
- * @return PyObject* new instance of QBAFramework
+ * @brief Return the value of a monotonic clock in seconds.
+ *
+ * @return double the current time in seconds
  */
-PyObject *
-QBAFramework_copy(QBAFrameworkObject *self, PyObject *Py_UNUSED(ignored))
+static inline double
+_QBAFramework_monotonic_seconds(void)
 {
-    PyObject *kwds = NULL;
-    PyObject *args = NULL;
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
 
-    QBAFrameworkObject *copy = (QBAFrameworkObject*) QBAFramework_new(Py_TYPE(self), args, kwds);
-    if (copy == NULL) {
-        return NULL;
-    }
 
-    Py_DECREF(copy->arguments);
-    copy->arguments = PySet_New(self->arguments);
-    if (copy->arguments == NULL) {
-        Py_DECREF(copy);
-        return NULL;
-    }
+/**
+ * @brief Return a list of (argument, residual) with the SOLVE_INFO_TOP_ARGUMENTS arguments
+ * that changed the most between previous_strengths and updated_strengths, sorted in descending order.
+ * Return NULL if an error occurred.
+ *
+ * @param self an instance of QBAFramework
+ * @param previous_strengths strengths from the previous iteration
+ * @param updated_strengths strengths from the last iteration
+ * @return PyObject* a new PyList of tuples (QBAFArgument, float), NULL if an error occurred
+ */
+static PyObject *
+_QBAFramework_largest_residuals(QBAFrameworkObject *self, const double *previous_strengths, const double *updated_strengths)
+{
+    Py_ssize_t top_ids[SOLVE_INFO_TOP_ARGUMENTS];
+    double top_residuals[SOLVE_INFO_TOP_ARGUMENTS];
+    Py_ssize_t top_size = 0;
 
-    Py_DECREF(copy->initial_strengths);
-    copy->initial_strengths = PyDict_Copy(self->initial_strengths);
-    if (copy->initial_strengths == NULL) {
-        Py_DECREF(copy);
-        return NULL;
-    }
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    for (Py_ssize_t id = 0; id < size; id++) {
+        double residual = fabs(updated_strengths[id] - previous_strengths[id]);
 
-    Py_DECREF(copy->attack_relations);
-    copy->attack_relations = QBAFARelations_copy((QBAFARelationsObject*)self->attack_relations, NULL);
-    if (copy->attack_relations == NULL) {
-        Py_DECREF(copy);
-        return NULL;
+        // Insertion into the (small) sorted array of largest residuals
+        Py_ssize_t position = top_size;
+        while (position > 0 && !(top_residuals[position-1] >= residual)) {
+            position--;
+        }
+        if (position >= SOLVE_INFO_TOP_ARGUMENTS) {
+            continue;
+        }
+        Py_ssize_t last = top_size < SOLVE_INFO_TOP_ARGUMENTS ? top_size : SOLVE_INFO_TOP_ARGUMENTS - 1;
+        for (Py_ssize_t index = last; index > position; index--) {
+            top_ids[index] = top_ids[index-1];
+            top_residuals[index] = top_residuals[index-1];
+        }
+        top_ids[position] = id;
+        top_residuals[position] = residual;
+        if (top_size < SOLVE_INFO_TOP_ARGUMENTS) {
+            top_size++;
+        }
     }
 
-    Py_DECREF(copy->support_relations);
-    copy->support_relations = QBAFARelations_copy((QBAFARelationsObject*)self->support_relations, NULL);
-    if (copy->support_relations == NULL) {
-        Py_DECREF(copy);
+    PyObject *largest_residuals = PyList_New(top_size);
+    if (largest_residuals == NULL) {
         return NULL;
     }
-
-    if (!self->modified) {
-        Py_DECREF(copy->final_strengths);
-        copy->final_strengths = PyDict_Copy(self->final_strengths);
-        if (copy->final_strengths == NULL) {
-            Py_DECREF(copy);
+    for (Py_ssize_t index = 0; index < top_size; index++) {
+        PyObject *tuple = Py_BuildValue("(Od)", PyList_GET_ITEM(self->id_arguments, top_ids[index]), top_residuals[index]);
+        if (tuple == NULL) {
+            Py_DECREF(largest_residuals);
             return NULL;
         }
+        PyList_SET_ITEM(largest_residuals, index, tuple);
     }
+    return largest_residuals;
+}
 
-    copy->modified = self->modified;
-    copy->disjoint_relations = self->disjoint_relations;
 
-    copy->semantics = self->semantics;
-    copy->aggregation_function = self->aggregation_function;
-    copy->influence_function = self->influence_function;
-    copy->min_strength = self->min_strength;
-    copy->max_strength = self->max_strength;
-    copy->allow_cycles = self->allow_cycles;
-    copy->max_iterations = self->max_iterations;
-    copy->convergence_threshold = self->convergence_threshold;
+/**
+ * @brief Store the telemetry of the last calculation of the final strengths in self->last_solve_info.
+ * It steals the references to residuals and largest_residuals.
+ *
+ * @param self an instance of QBAFramework
+ * @param update_scheme the name of the update scheme that was used
+ * @param converged 1 if the calculation converged, 0 otherwise
+ * @param iterations the number of iterations that were used
+ * @param final_residual the maximum residual of the last iteration
+ * @param residuals a PyList with the maximum residual of the sampled iterations (stolen)
+ * @param residual_stride the number of iterations between two consecutive items of residuals
+ * @param largest_residuals a PyList of (argument, residual) (stolen)
+ * @param wall_time the elapsed time in seconds
+ * @param recalculated_arguments the number of arguments whose final strength was calculated
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_set_solve_info(QBAFrameworkObject *self, const char *update_scheme, int converged,
+                             Py_ssize_t iterations, double final_residual,
+                             PyObject *residuals, Py_ssize_t residual_stride,
+                             PyObject *largest_residuals, double wall_time, Py_ssize_t recalculated_arguments)
+{
+    PyObject *solve_info = Py_BuildValue("{s:s,s:N,s:n,s:n,s:d,s:d,s:N,s:n,s:N,s:d,s:n}",
+                                         "update_scheme", update_scheme,
+                                         "converged", PyBool_FromLong(converged),
+                                         "iterations", iterations,
+                                         "max_iterations", self->max_iterations,
+                                         "convergence_threshold", self->convergence_threshold,
+                                         "final_residual", final_residual,
+                                         "residuals", residuals,
+                                         "residual_stride", residual_stride,
+                                         "largest_residuals", largest_residuals,
+                                         "wall_time", wall_time,
+                                         "recalculated_arguments", recalculated_arguments);
+    if (solve_info == NULL) {
+        return -1;
+    }
+    Py_SETREF(self->last_solve_info, solve_info);
+    return 0;
+}
+
+
+/**
+ * @brief Return a new PyList with the sampled residuals of trace, NULL if an error occurred.
+ *
+ * @param trace a QBAFSolveTrace
+ * @return PyObject* a new PyList of PyFloat, NULL if an error occurred
+ */
+static PyObject *
+_QBAFramework_trace_residuals(const QBAFSolveTrace *trace)
+{
+    PyObject *residuals = PyList_New(trace->residuals_size);
+    if (residuals == NULL) {
+        return NULL;
+    }
+    for (Py_ssize_t index = 0; index < trace->residuals_size; index++) {
+        PyObject *pyfloat = PyFloat_FromDouble(trace->residuals[index]);
+        if (pyfloat == NULL) {
+            Py_DECREF(residuals);
+            return NULL;
+        }
+        PyList_SET_ITEM(residuals, index, pyfloat);
+    }
+    return residuals;
+}
 
-    Py_XINCREF(self->aggregation_function_callable);
-    copy->aggregation_function_callable = self->aggregation_function_callable;
-    Py_XINCREF(self->influence_function_callable);
-    copy->influence_function_callable = self->influence_function_callable;
-    
-    return (PyObject*)copy;
+
+/**
+ * @brief Raise a RuntimeError because a cyclic framework did not converge.
+ * PyErr_Format does not format doubles, so the residual is formatted beforehand.
+ *
+ * @param self the QBAFramework
+ * @param final_residual the maximum change of a strength in the last iteration
+ */
+static void
+_QBAFramework_raise_not_converged(QBAFrameworkObject *self, double final_residual)
+{
+    char residual[32];
+    snprintf(residual, sizeof(residual), "%g", final_residual);
+    PyErr_Format(PyExc_RuntimeError, "cyclic framework did not converge within %zd iterations (final residual %s)",
+                 self->max_iterations, residual);
 }
 
 /**
- * @brief Return 1 if argument reaches a cycle through attack/support relations, 0 if not,
- * -1 if an error has occurred.
- * 
- * @param self an instance of QBAFramework
- * @param argument an instance of QBAFArgument
- * @param not_visited a PySet of QBAFArgument that have not been visited yet (this set is modified in this function)
- * @param visiting a PySet of QBAFArgument that are being visited within this function
- * @return int 1 if a cycle is found, 0 if not, -1 if an error occurred
+ * @brief Calculate final strengths for cyclic frameworks by synchronous fixed-point iteration.
+ * The telemetry of the calculation is stored in self->last_solve_info, even if it does not converge.
+ *
+ * @param self the QBAFramework
+ * @param plan the evaluation plan of the Framework
+ * @param ids the ids of the members of the components to iterate, NULL to iterate all the arguments
+ * @param ids_size the number of ids (the number of arguments if ids is NULL)
+ * @param buffer scratch space with room for plan->max_dependencies doubles
+ * @return int 0 if successful, -1 if an error occurred
  */
 static int
-_QBAFramework_has_cycle_from(QBAFrameworkObject *self, PyObject *argument, PyObject *not_visited, PyObject *visiting)
+_QBAFramework_calculate_cyclic_final_strengths(QBAFrameworkObject *self, QBAFPlanObject *plan,
+                                               const Py_ssize_t *ids, Py_ssize_t ids_size, double *buffer)
 {
-    int contains = PySet_Contains(visiting, argument);
-    if (contains < 0) {
+    double start_time = _QBAFramework_monotonic_seconds();
+
+    QBAFSolveTrace *trace = PyMem_Malloc(sizeof(QBAFSolveTrace));
+    double *previous_strengths = PyMem_Malloc((plan->size + 1) * sizeof(double));
+    if (trace == NULL || previous_strengths == NULL) {
+        PyMem_Free(trace); PyMem_Free(previous_strengths);
+        PyErr_NoMemory();
         return -1;
     }
-    if (contains) {// If argument is being visited, a cycle was found
-        return 1;
+    // The arguments that are not iterated keep their final strengths, so their residual is 0
+    if (ids != NULL && plan->size > 0) {
+        memcpy(previous_strengths, self->final_strengths, plan->size * sizeof(double));
     }
 
-    if (PySet_Add(visiting, argument) < 0) { // We add the argument to visiting
+    int result = QBAFPlan_EvaluateIterative(plan, ids, ids_size, self->initial_strengths, self->final_strengths,
+                                            previous_strengths, buffer, trace);
+    if (result < 0) {
+        PyMem_Free(trace); PyMem_Free(previous_strengths);
         return -1;
     }
-    PyObject *attack_patients, *support_patients;
-    PyObject *patients;
 
-    attack_patients = _QBAFARelations_patients((QBAFARelationsObject*)self->attack_relations, argument);
-    if (attack_patients == NULL) {
+    PyObject *residuals = _QBAFramework_trace_residuals(trace);
+    PyObject *largest_residuals = _QBAFramework_largest_residuals(self, previous_strengths, self->final_strengths);
+    PyMem_Free(previous_strengths);
+    if (residuals == NULL || largest_residuals == NULL) {
+        Py_XDECREF(residuals); Py_XDECREF(largest_residuals);
+        PyMem_Free(trace);
         return -1;
     }
-    support_patients = _QBAFARelations_patients((QBAFARelationsObject*)self->support_relations, argument);
-    if (support_patients == NULL) {
-        Py_DECREF(attack_patients);
+
+    double wall_time = _QBAFramework_monotonic_seconds() - start_time;
+    double final_residual = trace->final_residual;
+    result = _QBAFramework_set_solve_info(self, STR_JACOBI_SCHEME, trace->converged, trace->iterations, final_residual,
+                                          residuals, trace->residual_stride, largest_residuals, wall_time, ids_size);
+    int converged = trace->converged;
+    PyMem_Free(trace);
+    if (result < 0) {
         return -1;
     }
 
-    patients = PyList_Concat(attack_patients, support_patients);
-    Py_DECREF(attack_patients);
-    Py_DECREF(support_patients);
-    if (patients == NULL) {
+    if (!converged) {
+        _QBAFramework_raise_not_converged(self, final_residual);
         return -1;
     }
 
-    PyObject *iterator = PyObject_GetIter(patients);
-    PyObject *item;
+    return 0;
+}
 
-    if (iterator == NULL) {
-        Py_DECREF(patients);
+/**
+ * @brief Calculate the final strengths of all the arguments of the Framework by evaluating one representative
+ * of every class of strength-equivalent arguments and copying its final strength to the rest of the class.
+ * The telemetry of the calculation is stored in self->last_solve_info, even if it does not converge.
+ *
+ * @param self the QBAFramework
+ * @param plan the evaluation plan of the Framework
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFramework_calculate_compressed_final_strengths(QBAFrameworkObject *self, QBAFPlanObject *plan)
+{
+    double start_time = _QBAFramework_monotonic_seconds();
+    Py_ssize_t size = plan->size;
+
+    Py_ssize_t *classes = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (classes == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    QBAFPlanObject *quotient = (QBAFPlanObject *) QBAFPlan_Compress(plan, self->initial_strengths, classes);
+    if (quotient == NULL) {
+        PyMem_Free(classes);
         return -1;
     }
 
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        contains = PySet_Contains(not_visited, item);
-        if (contains < 0) {
-            Py_DECREF(patients);
-            Py_DECREF(iterator); Py_DECREF(item);
-            return -1;
-        }
-
-        if (contains) {
-            int has_cycle = _QBAFramework_has_cycle_from(self, item, not_visited, visiting);
-            if (has_cycle < 0) {
-                Py_DECREF(patients);
-                Py_DECREF(iterator); Py_DECREF(item);
-                return -1;
-            }
-            if (has_cycle) {
-                Py_DECREF(patients);
-                Py_DECREF(iterator); Py_DECREF(item);
-                return 1;
-            }
-        }
+    Py_ssize_t classes_size = quotient->size;
+    QBAFSolveTrace *trace = PyMem_Malloc(sizeof(QBAFSolveTrace));
+    double *class_strengths = PyMem_Malloc((3 * classes_size + 1) * sizeof(double));
+    double *previous_strengths = PyMem_Malloc((size + 1) * sizeof(double));
+    double *buffer = PyMem_Malloc((quotient->max_dependencies + 1) * sizeof(double));
+    if (trace == NULL || class_strengths == NULL || previous_strengths == NULL || buffer == NULL) {
+        PyMem_Free(classes); PyMem_Free(trace); PyMem_Free(class_strengths); PyMem_Free(previous_strengths); PyMem_Free(buffer);
+        Py_DECREF(quotient);
+        PyErr_NoMemory();
+        return -1;
+    }
+    double *class_initial = class_strengths;
+    double *class_final = class_initial + classes_size;
+    double *class_previous = class_final + classes_size;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        class_initial[classes[id]] = self->initial_strengths[id];
+    }
+
+    int acyclic = quotient->schedule != NULL;
+    int result;
+    if (acyclic) {
+        result = QBAFPlan_EvaluateAcyclic(quotient, class_initial, class_final, buffer);
+        trace->iterations = 1;
+        trace->converged = 1;
+        trace->final_residual = 0.0;
+        trace->residuals_size = 0;
+        trace->residual_stride = 1;
+    }
+    else {
+        result = QBAFPlan_EvaluateIterative(quotient, NULL, 0, class_initial, class_final, class_previous, buffer, trace);
+    }
+    Py_DECREF(quotient);
+    PyMem_Free(buffer);
+    if (result < 0) {
+        PyMem_Free(classes); PyMem_Free(trace); PyMem_Free(class_strengths); PyMem_Free(previous_strengths);
+        return -1;
+    }
 
-        Py_DECREF(item);
+    // Every member of a class has the final strength of its representative
+    for (Py_ssize_t id = 0; id < size; id++) {
+        self->final_strengths[id] = class_final[classes[id]];
+        previous_strengths[id] = class_previous[classes[id]];
     }
+    PyMem_Free(classes);
+    PyMem_Free(class_strengths);
 
-    Py_DECREF(iterator);
-    Py_DECREF(patients);
+    PyObject *residuals = _QBAFramework_trace_residuals(trace);
+    PyObject *largest_residuals = acyclic ? PyList_New(0) :
+                                  _QBAFramework_largest_residuals(self, previous_strengths, self->final_strengths);
+    PyMem_Free(previous_strengths);
+    if (residuals == NULL || largest_residuals == NULL) {
+        Py_XDECREF(residuals); Py_XDECREF(largest_residuals);
+        PyMem_Free(trace);
+        return -1;
+    }
 
-    if (PySet_Discard(not_visited, argument) < 0) { // We remove the argument from not visited
+    double wall_time = _QBAFramework_monotonic_seconds() - start_time;
+    double final_residual = trace->final_residual;
+    int converged = trace->converged;
+    result = _QBAFramework_set_solve_info(self, acyclic ? STR_TOPOLOGICAL_SCHEME : STR_JACOBI_SCHEME, converged,
+                                          trace->iterations, final_residual, residuals, trace->residual_stride,
+                                          largest_residuals, wall_time, classes_size);
+    PyMem_Free(trace);
+    if (result < 0) {
+        return -1;
+    }
+    PyObject *compression_ratio = PyFloat_FromDouble(classes_size > 0 ? (double) size / classes_size : 1.0);
+    if (compression_ratio == NULL) {
+        return -1;
+    }
+    result = PyDict_SetItemString(self->last_solve_info, "compression_ratio", compression_ratio);
+    Py_DECREF(compression_ratio);
+    if (result < 0) {
         return -1;
     }
 
-    if (PySet_Discard(visiting, argument) < 0) { // We remove the argument from visiting
+    if (!converged) {
+        _QBAFramework_raise_not_converged(self, final_residual);
         return -1;
     }
 
@@ -1667,628 +4378,1130 @@ _QBAFramework_has_cycle_from(QBAFrameworkObject *self, PyObject *argument, PyObj
 }
 
 /**
- * @brief Return True if the relations of the Framework are acyclic, False if not,
- * -1 if an error has occurred.
- * 
- * @param self an instance of QBAFramework
- * @return PyObject* 1 if acyclic, 0 if not acyclic, -1 if an error occurred
+ * @brief Return a new array with the connected components of plan that have an argument marked as stale,
+ * NULL if an error occurred.
+ *
+ * @param plan the evaluation plan of the Framework with its components built
+ * @param stale the stale flag of every id
+ * @param components_size a pointer where the number of stale components is stored
+ * @param members_size a pointer where the number of arguments of the stale components is stored
+ * @return Py_ssize_t* the stale components in increasing order (it must be freed with PyMem_Free), NULL if an error occurred
  */
-static inline int
-_QBAFramework_isacyclic(QBAFrameworkObject *self)
+static Py_ssize_t *
+_QBAFramework_stale_components(QBAFPlanObject *plan, const char *stale,
+                               Py_ssize_t *components_size, Py_ssize_t *members_size)
 {
-    PyObject *not_visited, *visiting;
-
-    visiting = PySet_New(NULL); // New empty set
-    if (visiting == NULL)
-        return -1;
-
-    not_visited = PySet_New(self->arguments);   // Copy of self->arguments
-    if (not_visited == NULL) {
-        Py_DECREF(visiting);
-        return -1;
+    char *is_stale = PyMem_Calloc(plan->components_size + 1, sizeof(char));
+    Py_ssize_t *components = PyMem_Malloc((plan->components_size + 1) * sizeof(Py_ssize_t));
+    if (is_stale == NULL || components == NULL) {
+        PyMem_Free(is_stale); PyMem_Free(components);
+        PyErr_NoMemory();
+        return NULL;
     }
 
-    PyObject *argument;
-
-    while (PySet_GET_SIZE(not_visited) > 0) {
-        argument = PySet_Pop(not_visited);  // New reference. Unchecked errors
-        PySet_Add(not_visited, argument);   // We return the argument to the set
-        int has_cycle = _QBAFramework_has_cycle_from(self, argument, not_visited, visiting);
-        Py_DECREF(argument);
-        if (has_cycle < 0) {
-            Py_DECREF(visiting); Py_DECREF(not_visited);
-            return -1;
+    for (Py_ssize_t id = 0; id < plan->size; id++) {
+        if (stale[id]) {
+            is_stale[plan->components[id]] = TRUE;
         }
-        if (has_cycle) { // If detected cycle
-            Py_DECREF(visiting); Py_DECREF(not_visited);
-            return 0; // Return False
+    }
+    *components_size = 0;
+    *members_size = 0;
+    for (Py_ssize_t component = 0; component < plan->components_size; component++) {
+        if (is_stale[component]) {
+            components[(*components_size)++] = component;
+            *members_size += plan->component_offsets[component+1] - plan->component_offsets[component];
         }
     }
-
-    Py_DECREF(visiting);
-    Py_DECREF(not_visited);
-
-    return 1;   // Return True
+    PyMem_Free(is_stale);
+    return components;
 }
 
 /**
- * @brief Return True if the relations of the Framework are acyclic, False if not,
- * NULL if an error has occurred.
+ * @brief Calculate the final strengths of the arguments of the Framework whose connected component has changed.
+ * It stores all the calculated final strengths in self->final_strengths; the final strengths of the other
+ * components are kept, since they do not depend on the changed ones.
  * 
- * @param self an instance of QBAFramework
- * @param Py_UNUSED 
- * @return PyObject* new PyBool.
+ * @param self the QBAFramework
+ * @return int 0 if succesful, -1 if an error occurred
  */
-static PyObject *
-QBAFramework_isacyclic(QBAFrameworkObject *self, PyObject *Py_UNUSED(ignored))
+static int
+_QBAFRamework_calculate_final_strengths(QBAFrameworkObject *self)
 {
-    int isacyclic = _QBAFramework_isacyclic(self);
-    if (isacyclic < 0) {
-        return NULL;
+    Py_SETREF(self->last_solve_info, Py_NewRef(Py_None));
+
+    double start_time = _QBAFramework_monotonic_seconds();
+
+    if (self->incremental != NULL) {
+        // The GIL is kept: the update modifies the state of the Framework, which another thread could modify too
+        Py_ssize_t recalculated = QBAFIncremental_Update(self->incremental, self->initial_strengths, self->final_strengths,
+                                                         self->incremental_tolerance, &self->staleness_bound);
+        PyObject *residuals = PyList_New(0);
+        PyObject *largest_residuals = PyList_New(0);
+        if (residuals == NULL || largest_residuals == NULL) {
+            Py_XDECREF(residuals); Py_XDECREF(largest_residuals);
+            return -1;
+        }
+        double wall_time = _QBAFramework_monotonic_seconds() - start_time;
+        return _QBAFramework_set_solve_info(self, STR_INCREMENTAL_SCHEME, TRUE, 1, 0.0,
+                                            residuals, 1, largest_residuals, wall_time, recalculated);
     }
 
-    if (isacyclic)
-        Py_RETURN_TRUE;
-        
-    Py_RETURN_FALSE;
-}
+    QBAFPlanObject *plan = _QBAFramework_plan(self);
+    if (plan == NULL) {
+        return -1;
+    }
+    if (plan->schedule == NULL && !self->allow_cycles) {
+        PyErr_SetString(PyExc_NotImplementedError, "calculate final strengths of cyclic framework requires allow_cycles=True");
+        return -1;
+    }
+    if (self->compress) {
+        if (_QBAFramework_calculate_compressed_final_strengths(self, plan) < 0) {
+            return -1;
+        }
+        if (plan->size > 0) {
+            memset(self->stale, FALSE, plan->size * sizeof(char));
+        }
+        self->staleness_bound = 0.0;
+        return 0;
+    }
+    if (QBAFPlan_EnsureComponents(plan) < 0) {
+        return -1;
+    }
 
-/**
- * @brief Append argument to argument_stack.
- *
- * @param argument_stack a PyList used as a stack
- * @param argument the argument to push
- * @return int 0 if successful, -1 otherwise
- */
-static int
-_QBAFramework_argument_stack_push(PyObject *argument_stack, PyObject *argument)
-{
-    return PyList_Append(argument_stack, argument);
-}
+    Py_ssize_t components_size, members_size;
+    Py_ssize_t *components = _QBAFramework_stale_components(plan, self->stale, &components_size, &members_size);
+    double *buffer = PyMem_Malloc((plan->max_dependencies + 1) * sizeof(double));
+    if (components == NULL || buffer == NULL) {
+        PyMem_Free(components); PyMem_Free(buffer);
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        return -1;
+    }
 
+    int result;
+    if (plan->schedule == NULL) {
+        // Iterating every argument is the same as iterating all the components at once
+        Py_ssize_t *ids = NULL;
+        if (members_size < plan->size) {
+            ids = PyMem_Malloc((members_size + 1) * sizeof(Py_ssize_t));
+            if (ids == NULL) {
+                PyMem_Free(components); PyMem_Free(buffer);
+                PyErr_NoMemory();
+                return -1;
+            }
+            Py_ssize_t ids_size = 0;
+            for (Py_ssize_t index = 0; index < components_size; index++) {
+                Py_ssize_t component = components[index];
+                for (Py_ssize_t member = plan->component_offsets[component]; member < plan->component_offsets[component+1]; member++) {
+                    ids[ids_size++] = plan->component_members[member];
+                }
+            }
+        }
+        result = _QBAFramework_calculate_cyclic_final_strengths(self, plan, ids, members_size, buffer);
+        PyMem_Free(ids);
+    }
+    else {
+        result = QBAFPlan_EvaluateComponents(plan, components, components_size,
+                                             self->initial_strengths, self->final_strengths, buffer);
+        if (result == 0) {
+            PyObject *residuals = PyList_New(0);
+            PyObject *largest_residuals = PyList_New(0);
+            if (residuals == NULL || largest_residuals == NULL) {
+                Py_XDECREF(residuals); Py_XDECREF(largest_residuals);
+                result = -1;
+            }
+            else {
+                double wall_time = _QBAFramework_monotonic_seconds() - start_time;
+                result = _QBAFramework_set_solve_info(self, STR_TOPOLOGICAL_SCHEME, TRUE, 1, 0.0,
+                                                      residuals, 1, largest_residuals, wall_time, members_size);
+            }
+        }
+    }
+    PyMem_Free(components);
+    PyMem_Free(buffer);
+    if (result < 0) {
+        return -1;
+    }
 
-/**
- * @brief Remove the top item from argument_stack.
- *
- * @param argument_stack a PyList used as a stack
- * @return int 0 if successful, -1 otherwise
- */
-static int
-_QBAFramework_argument_stack_pop(PyObject *argument_stack)
-{
-    Py_ssize_t last_argument_index = PyList_GET_SIZE(argument_stack) - 1;
-    return PySequence_DelItem(argument_stack, last_argument_index);
+    if (plan->size > 0) {
+        memset(self->stale, FALSE, plan->size * sizeof(char));
+    }
+    if (members_size == plan->size) {   // No final strength is left from an approximate update
+        self->staleness_bound = 0.0;
+    }
+    return 0;
 }
 
 
 /**
- * @brief Return the top item from argument_stack.
+ * @brief Append a new PyUnicode built from format to the PyList rationale.
  *
- * @param argument_stack a PyList used as a stack
- * @return PyObject* borrowed reference to the top argument
+ * @param rationale a PyList
+ * @param format a format string for PyUnicode_FromFormatV
+ * @return int 0 if successful, -1 if an error occurred
  */
-static PyObject *
-_QBAFramework_argument_stack_top(PyObject *argument_stack)
+static int
+_QBAFramework_append_rationale(PyObject *rationale, const char *format, ...)
 {
-    Py_ssize_t last_argument_index = PyList_GET_SIZE(argument_stack) - 1;
-    return PyList_GET_ITEM(argument_stack, last_argument_index);
+    va_list vargs;
+    va_start(vargs, format);
+    PyObject *reason = PyUnicode_FromFormatV(format, vargs);
+    va_end(vargs);
+    if (reason == NULL) {
+        return -1;
+    }
+    int result = PyList_Append(rationale, reason);
+    Py_DECREF(reason);
+    return result;
 }
 
-
 /**
- * @brief Add any dependency of current_argument without a calculated final strength to argument_stack.
+ * @brief Return a PyDict with the strategy chosen to calculate the final strengths of the Framework
+ * from the statistics of its structure, and the reasons of every choice. NULL if an error occurred.
  *
  * @param self an instance of QBAFramework
- * @param current_argument the argument whose dependencies are inspected
- * @param argument_stack a PyList used as a stack
- * @param arguments_on_stack a PySet with arguments currently on the stack
- * @return int 0 if successful, -1 otherwise
+ * @param Py_UNUSED
+ * @return PyObject* a new PyDict, NULL if an error occurred
  */
-static int
-_QBAFramework_push_unresolved_dependencies(QBAFrameworkObject *self, PyObject *current_argument,
-                                           PyObject *argument_stack, PyObject *arguments_on_stack)
+static PyObject *
+QBAFramework_explain_plan(QBAFrameworkObject *self, PyObject *Py_UNUSED(ignored))
 {
-    PyObject *attackers = _QBAFARelations_agents((QBAFARelationsObject*)self->attack_relations, current_argument);
-    if (attackers == NULL) {
-        return -1;
+    QBAFPlanObject *plan = _QBAFramework_plan(self);
+    if (plan == NULL) {
+        return NULL;
     }
-
-    PyObject *supporters = _QBAFARelations_agents((QBAFARelationsObject*)self->support_relations, current_argument);
-    if (supporters == NULL) {
-        Py_DECREF(attackers);
-        return -1;
+    QBAFPlanStatistics statistics;
+    if (QBAFPlan_Statistics(plan, &statistics) < 0) {
+        return NULL;
     }
 
-    PyObject *dependencies = PyList_Concat(attackers, supporters);
-    Py_DECREF(attackers);
-    Py_DECREF(supporters);
-    if (dependencies == NULL) {
-        return -1;
+    // The arguments that the next calculation has to evaluate, including the changes known only by self->incremental
+    Py_ssize_t size = plan->size;
+    char *stale = PyMem_Malloc((size + 1) * sizeof(char));
+    if (stale == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    if (size > 0) {
+        memcpy(stale, self->stale, size * sizeof(char));
+    }
+    if (self->incremental != NULL) {
+        QBAFIncremental_MarkPending(self->incremental, stale);
     }
+    Py_ssize_t stale_components, stale_arguments;
+    Py_ssize_t *components = _QBAFramework_stale_components(plan, stale, &stale_components, &stale_arguments);
+    PyMem_Free(stale);
+    if (components == NULL) {
+        return NULL;
+    }
+    PyMem_Free(components);
 
-    PyObject *dependency_iterator = PyObject_GetIter(dependencies);
-    if (dependency_iterator == NULL) {
-        Py_DECREF(dependencies);
-        return -1;
+    int acyclic = plan->schedule != NULL;
+    int native = QBAFPlan_IsNative(plan);
+    const char *update_scheme = self->incremental != NULL ? STR_INCREMENTAL_SCHEME :
+                                acyclic ? STR_TOPOLOGICAL_SCHEME : self->allow_cycles ? STR_JACOBI_SCHEME : NULL;
+    Py_ssize_t threads = 1;
+    if (self->incremental == NULL && !self->compress) {
+        threads = QBAFPlan_ComponentThreads(plan, stale_components, stale_arguments);
     }
+    Py_ssize_t hub_threads = QBAFPlan_HubThreads(plan, statistics.max_in_degree);
 
-    PyObject *dependency_argument;
-    while ((dependency_argument = PyIter_Next(dependency_iterator))) {
-        int dependency_has_calculated_strength = PyDict_Contains(self->final_strengths, dependency_argument);
-        if (dependency_has_calculated_strength < 0) {
-            Py_DECREF(dependency_argument);
-            Py_DECREF(dependency_iterator);
-            Py_DECREF(dependencies);
-            return -1;
+    PyObject *rationale = PyList_New(0);
+    if (rationale == NULL) {
+        return NULL;
+    }
+    if (acyclic) {
+        if (_QBAFramework_append_rationale(rationale,
+                "acyclic: every argument is evaluated once in topological order (%zd levels, the widest with %zd arguments)",
+                statistics.levels, statistics.max_level_width) < 0) {
+            goto error;
+        }
+    }
+    else if (self->allow_cycles) {
+        if (_QBAFramework_append_rationale(rationale,
+                "cyclic: synchronous fixed-point iteration, %zd arguments are in %zd cycles (the largest with %zd arguments)",
+                statistics.arguments_in_cycles, statistics.cycles, statistics.largest_cycle) < 0) {
+            goto error;
         }
+    }
+    else {
+        if (_QBAFramework_append_rationale(rationale,
+                "cyclic: the final strengths cannot be calculated unless allow_cycles is True") < 0) {
+            goto error;
+        }
+    }
 
-        if (!dependency_has_calculated_strength) {
-            int dependency_is_on_stack = PySet_Contains(arguments_on_stack, dependency_argument);
-            if (dependency_is_on_stack < 0) {
-                Py_DECREF(dependency_argument);
-                Py_DECREF(dependency_iterator);
-                Py_DECREF(dependencies);
-                return -1;
-            }
-            if (dependency_is_on_stack) {
-                Py_DECREF(dependency_argument);
-                Py_DECREF(dependency_iterator);
-                Py_DECREF(dependencies);
-                PyErr_SetString(PyExc_RuntimeError,
-                                "encountered a dependency cycle while calculating final strengths");
-                return -1;
+    if (!self->modified) {
+        if (_QBAFramework_append_rationale(rationale,
+                "the final strengths are up to date: nothing is evaluated until the framework is modified") < 0) {
+            goto error;
+        }
+    }
+    else if (self->incremental != NULL) {
+        if (_QBAFramework_append_rationale(rationale,
+                "only initial strengths changed: the changes are propagated to the arguments they reach") < 0) {
+            goto error;
+        }
+    }
+    else if (self->compress) {
+        if (_QBAFramework_append_rationale(rationale,
+                "compress is True: strength-equivalent arguments are merged and every class is evaluated once") < 0) {
+            goto error;
+        }
+    }
+    else {
+        if (_QBAFramework_append_rationale(rationale,
+                "%zd of %zd weakly connected components changed: only their %zd arguments are evaluated",
+                stale_components, statistics.components, stale_arguments) < 0) {
+            goto error;
+        }
+    }
+    if (acyclic && QBAFIncremental_Supports(plan)) {
+        if (_QBAFramework_append_rationale(rationale,
+                "later changes of initial strengths are propagated incrementally (native %s aggregation)",
+                self->semantics != NULL ? self->semantics : "custom") < 0) {
+            goto error;
+        }
+        if (self->incremental_tolerance > 0.0) {
+            char tolerance[32], bound[32];   // PyUnicode_FromFormat does not support %g
+            snprintf(tolerance, sizeof(tolerance), "%g", self->incremental_tolerance);
+            snprintf(bound, sizeof(bound), "%g", self->staleness_bound);
+            if (_QBAFramework_append_rationale(rationale,
+                    "changes smaller than incremental_tolerance=%s are not propagated (current staleness bound %s)",
+                    tolerance, bound) < 0) {
+                goto error;
             }
+        }
+    }
 
-            if (_QBAFramework_argument_stack_push(argument_stack, dependency_argument) < 0) {
-                Py_DECREF(dependency_argument);
-                Py_DECREF(dependency_iterator);
-                Py_DECREF(dependencies);
-                return -1;
-            }
+    if (threads > 1) {
+        if (_QBAFramework_append_rationale(rationale,
+                "the changed components are split across %zd threads (%zd processors)", threads, QBAFPlan_Processors()) < 0) {
+            goto error;
+        }
+    }
+    else if (!native) {
+        if (_QBAFramework_append_rationale(rationale,
+                "single thread: the custom aggregation and influence functions need the GIL") < 0) {
+            goto error;
+        }
+    }
+    else if (self->incremental == NULL && !self->compress && acyclic && stale_components > 1) {
+        if (_QBAFramework_append_rationale(rationale,
+                "single thread: %zd arguments are below the %d needed to split the components across threads",
+                stale_arguments, PLAN_PARALLEL_MIN_COMPONENT_ARGUMENTS) < 0) {
+            goto error;
         }
+    }
+    if (hub_threads > 1) {
+        if (_QBAFramework_append_rationale(rationale,
+                "arguments with %zd attackers and supporters aggregate them with %zd threads",
+                statistics.max_in_degree, hub_threads) < 0) {
+            goto error;
+        }
+    }
+    PyObject *pystatistics = Py_BuildValue("{s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n}",
+                                           "arguments", size,
+                                           "relations", statistics.relations,
+                                           "max_in_degree", statistics.max_in_degree,
+                                           "components", statistics.components,
+                                           "largest_component", statistics.largest_component,
+                                           "levels", statistics.levels,
+                                           "max_level_width", statistics.max_level_width,
+                                           "cycles", statistics.cycles,
+                                           "largest_cycle", statistics.largest_cycle,
+                                           "arguments_in_cycles", statistics.arguments_in_cycles);
+    if (pystatistics == NULL) {
+        Py_DECREF(rationale);
+        return NULL;
+    }
+
+    return Py_BuildValue("{s:z,s:s,s:z,s:N,s:N,s:n,s:n,s:n,s:n,s:n,s:N,s:N}",
+                         "update_scheme", update_scheme,
+                         "kernel", acyclic ? STR_TOPOLOGICAL_SCHEME : STR_JACOBI_SCHEME,
+                         "semantics", plan->settings.semantics,
+                         "native", PyBool_FromLong(native),
+                         "compress", PyBool_FromLong(self->compress),
+                         "stale_components", self->modified ? stale_components : 0,
+                         "stale_arguments", self->modified ? stale_arguments : 0,
+                         "processors", QBAFPlan_Processors(),
+                         "threads", threads,
+                         "hub_threads", hub_threads,
+                         "statistics", pystatistics,
+                         "rationale", rationale);
+
+error:
+    Py_DECREF(rationale);
+    return NULL;
+}
+
+
+/**
+ * @brief Acquire the lock held while the final strengths of a frozen Framework are calculated. The custom aggregation
+ * and influence functions let other threads run during the calculation, and they wait here for it.
+ *
+ * @param self a frozen QBAFramework
+ */
+static inline void
+_QBAFramework_lock_evaluation(QBAFrameworkObject *self)
+{
+    if (!PyThread_acquire_lock(self->evaluation_lock, NOWAIT_LOCK)) {
+        Py_BEGIN_ALLOW_THREADS
+        PyThread_acquire_lock(self->evaluation_lock, WAIT_LOCK);
+        Py_END_ALLOW_THREADS
+    }
+}
 
-        Py_DECREF(dependency_argument);
+/**
+ * @brief Calculate the final strengths if the Framework has been modified since the last time they were calculated.
+ * The final strengths of a frozen Framework are calculated by the first thread that needs them, while the rest wait
+ * for them; afterwards they are only read.
+ *
+ * @param self the QBAFramework
+ * @return int 0 if succesful, -1 if an error occurred
+ */
+static inline int
+_QBAFramework_update_final_strengths(QBAFrameworkObject *self)
+{
+    if (!self->modified) {
+        return 0;
+    }
+    if (self->frozen) {     // Another thread may be calculating them
+        _QBAFramework_lock_evaluation(self);
+        int result = 0;
+        if (self->modified) {
+            result = _QBAFRamework_calculate_final_strengths(self);
+            if (result == 0) {
+                self->modified = FALSE;
+            }
+        }
+        PyThread_release_lock(self->evaluation_lock);
+        return result;
     }
 
-    Py_DECREF(dependency_iterator);
-    Py_DECREF(dependencies);
+    // Calculate final strengths if the framework has been modified
+    if (_QBAFRamework_calculate_final_strengths(self) < 0) {
+        return -1;
+    }
+    self->modified = FALSE;
     return 0;
 }
 
-
 /**
- * @brief Return the calculated final strengths of all arguments in arguments.
- * Return NULL if any argument does not have a calculated final strength yet or if an error occurred.
+ * @brief Calculate again the final strengths of every argument of the Framework, discarding the ones
+ * that were updated approximately, and reset the staleness bound. Return None, NULL if an error occurred.
  *
- * @param self an instance of QBAFramework
- * @param arguments a list of QBAFArgument
- * @return PyObject* a new PyList of PyFloat
+ * @param self the QBAFramework
+ * @param Py_UNUSED
+ * @return PyObject* None, NULL if an error occurred
  */
 static PyObject *
-_QBAFramework_retrieve_computed_strengths(PyObject *strengths_by_argument, PyObject *arguments)
+QBAFramework_refresh(QBAFrameworkObject *self, PyObject *Py_UNUSED(ignored))
 {
-    Py_ssize_t number_of_arguments = PyObject_Size(arguments);
-    if (number_of_arguments == -1) {
+    if (_QBAFramework_check_mutable(self) < 0) {
         return NULL;
     }
-
-    PyObject *calculated_strengths = PyList_New(number_of_arguments);
-    if (calculated_strengths == NULL) {
-        return NULL;
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    if (size > 0) {
+        memset(self->stale, TRUE, size * sizeof(char));
     }
+    QBAFIncremental_Free(self->incremental);
+    self->incremental = NULL;
+    self->modified = TRUE;
 
-    PyObject *argument_iterator = PyObject_GetIter(arguments);
-    PyObject *current_argument;
-    if (argument_iterator == NULL) {
-        Py_DECREF(calculated_strengths);
+    if (_QBAFramework_update_final_strengths(self) < 0) {
         return NULL;
     }
+    Py_RETURN_NONE;
+}
 
-    Py_ssize_t argument_index = 0;
-    while ((current_argument = PyIter_Next(argument_iterator))) {
-        int has_calculated_strength = PyDict_Contains(strengths_by_argument, current_argument);
-        if (has_calculated_strength < 0) {
-            Py_DECREF(current_argument);
-            Py_DECREF(argument_iterator);
-            Py_DECREF(calculated_strengths);
-            return NULL;
-        }
-        if (!has_calculated_strength) {
-            Py_DECREF(current_argument);
-            Py_DECREF(argument_iterator);
-            Py_DECREF(calculated_strengths);
-            PyErr_SetString(PyExc_RuntimeError, "missing calculated final strength for dependency");
-            return NULL;
-        }
+/**
+ * @brief Return 1 if self and base calculate final strengths the same way (semantics and convergence settings),
+ * 0 otherwise.
+ *
+ * @param self an instance of QBAFramework
+ * @param base an instance of QBAFramework
+ * @return int 1 if they have the same settings, 0 otherwise
+ */
+static inline int
+_QBAFramework_same_settings(QBAFrameworkObject *self, QBAFrameworkObject *base)
+{
+    return self->semantics == base->semantics &&
+           self->aggregation_function == base->aggregation_function &&
+           self->influence_function == base->influence_function &&
+           self->aggregation_function_callable == base->aggregation_function_callable &&
+           self->influence_function_callable == base->influence_function_callable &&
+           self->allow_cycles == base->allow_cycles &&
+           self->max_iterations == base->max_iterations &&
+           self->convergence_threshold == base->convergence_threshold;
+}
 
-        double current_strength = PyFloat_AsDouble(PyDict_GetItem(strengths_by_argument, current_argument));
-        Py_DECREF(current_argument);
-        if (current_strength == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(argument_iterator);
-            Py_DECREF(calculated_strengths);
-            return NULL;
+/**
+ * @brief Return 1 if relations contains every relation of base_relations, 0 if not, -1 if an error occurred.
+ * The patient id of every relation of relations that is not in base_relations is appended to seeds.
+ *
+ * @param self an instance of QBAFramework
+ * @param relations the attack or support relations of self
+ * @param base_relations the same relations of the base
+ * @param seeds an array with room for the number of relations of relations
+ * @param seeds_size a pointer to the number of items of seeds
+ * @return int 1 if base_relations is a subset of relations, 0 if not, -1 if an error occurred
+ */
+static int
+_QBAFramework_expanded_relations(QBAFrameworkObject *self, QBAFARelationsObject *relations,
+                                 QBAFARelationsObject *base_relations, Py_ssize_t *seeds, Py_ssize_t *seeds_size)
+{
+    if (QBAFARelations_Size(base_relations) > QBAFARelations_Size(relations)) {
+        return FALSE;
+    }
+
+    Py_ssize_t base_size = PyList_GET_SIZE(base_relations->id_arguments);
+    for (Py_ssize_t agent = 0; agent < base_size; agent++) {
+        Py_ssize_t patients_size;
+        const Py_ssize_t *patients = QBAFARelations_PatientIds(base_relations, agent, &patients_size);
+        for (Py_ssize_t index = 0; index < patients_size; index++) {
+            int contains = QBAFARelations_ContainsIds(relations, base_relations, agent, patients[index]);
+            if (contains <= 0) {
+                return contains;
+            }
         }
+    }
 
-        PyObject *current_strength_object = PyFloat_FromDouble(current_strength);
-        if (current_strength_object == NULL) {
-            Py_DECREF(argument_iterator);
-            Py_DECREF(calculated_strengths);
-            return NULL;
+    if (QBAFARelations_Size(base_relations) == QBAFARelations_Size(relations)) {
+        return TRUE;    // Both have the same relations
+    }
+    // The relations are bound to the ids of self
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    for (Py_ssize_t agent = 0; agent < size; agent++) {
+        Py_ssize_t patients_size;
+        const Py_ssize_t *patients = QBAFARelations_PatientIds(relations, agent, &patients_size);
+        for (Py_ssize_t index = 0; index < patients_size; index++) {
+            int contains = QBAFARelations_ContainsIds(base_relations, relations, agent, patients[index]);
+            if (contains < 0) {
+                return -1;
+            }
+            if (!contains) {
+                seeds[(*seeds_size)++] = patients[index];
+            }
         }
-
-        PyList_SET_ITEM(calculated_strengths, argument_index, current_strength_object);
-        argument_index++;
     }
-
-    Py_DECREF(argument_iterator);
-    return calculated_strengths;
+    return TRUE;
 }
 
-
 /**
- * @brief Calculate and store the final strength of current_argument from already-calculated dependencies.
+ * @brief Calculate the final strengths of self, a normal expansion of base (it has every argument and relation
+ * of base, and the arguments of base keep their initial strengths), from the final strengths of base.
+ * Only the arguments reached from the new arguments and relations are evaluated, the rest take
+ * the final strength they have in base. Return None, NULL if an error occurred.
  *
  * @param self an instance of QBAFramework
- * @param current_argument the argument whose final strength is calculated
- * @return int 0 if successful, -1 otherwise
+ * @param args the argument values (base: QBAFramework)
+ * @param kwds the names of the arguments
+ * @return PyObject* None, NULL if an error occurred
  */
-static int
-_QBAFramework_apply_semantics(QBAFrameworkObject *self, PyObject *current_argument,
-                              PyObject *dependency_strengths_by_argument, PyObject *strengths_to_update)
+static PyObject *
+QBAFramework_evaluate_expansion(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    PyObject *attackers = _QBAFARelations_agents((QBAFARelationsObject*)self->attack_relations, current_argument);
-    if (attackers == NULL) {
-        return -1;
-    }
+    static char *kwlist[] = {"base", NULL};
+    PyObject *base_object;
 
-    PyObject *supporters = _QBAFARelations_agents((QBAFARelationsObject*)self->support_relations, current_argument);
-    if (supporters == NULL) {
-        Py_DECREF(attackers);
-        return -1;
-    }
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist, &base_object))
+        return NULL;
 
-    PyObject *attacker_strengths = _QBAFramework_retrieve_computed_strengths(dependency_strengths_by_argument, attackers);
-    if (attacker_strengths == NULL) {
-        Py_DECREF(attackers);
-        Py_DECREF(supporters);
-        return -1;
+    if (!PyObject_TypeCheck(base_object, Py_TYPE(self))) {
+        PyErr_SetString(PyExc_TypeError, "base must be an instance of QBAFramework");
+        return NULL;
     }
-
-    PyObject *supporter_strengths = _QBAFramework_retrieve_computed_strengths(dependency_strengths_by_argument, supporters);
-    Py_DECREF(attackers);
-    Py_DECREF(supporters);
-    if (supporter_strengths == NULL) {
-        Py_DECREF(attacker_strengths);
-        return -1;
+    QBAFrameworkObject *base = (QBAFrameworkObject*)base_object;
+    if (!_QBAFramework_same_settings(self, base)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "base must have the same semantics, allow_cycles, max_iterations and convergence_threshold");
+        return NULL;
     }
-
-    double aggregation = _QBAFramework_aggregation_function(self, attacker_strengths, supporter_strengths);
-    Py_DECREF(attacker_strengths);
-    Py_DECREF(supporter_strengths);
-    if (aggregation == -1.0 && PyErr_Occurred()) {
-        return -1;
+    if (_QBAFramework_update_final_strengths(base) < 0) {
+        return NULL;
     }
 
-    double initial_strength = PyFloat_AsDouble(PyDict_GetItem(self->initial_strengths, current_argument));
-    if (initial_strength == -1.0 && PyErr_Occurred()) {
-        return -1;
+    double start_time = _QBAFramework_monotonic_seconds();
+    QBAFPlanObject *plan = _QBAFramework_plan(self);
+    if (plan == NULL) {
+        return NULL;
+    }
+    if (plan->schedule == NULL && !self->allow_cycles) {
+        PyErr_SetString(PyExc_NotImplementedError, "calculate final strengths of cyclic framework requires allow_cycles=True");
+        return NULL;
+    }
+    if (QBAFPlan_EnsureSuccessors(plan) < 0) {
+        return NULL;
     }
 
-    double final_strength = _QBAFramework_influence_function(self, initial_strength, aggregation);
-    if (final_strength == -1.0 && PyErr_Occurred()) {
-        return -1;
+    Py_ssize_t size = plan->size;
+    Py_ssize_t base_size = PyList_GET_SIZE(base->id_arguments);
+    Py_ssize_t relations_size = QBAFARelations_Size((QBAFARelationsObject*)self->attack_relations) +
+                                QBAFARelations_Size((QBAFARelationsObject*)self->support_relations);
+    Py_ssize_t *base_ids = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *cone = PyMem_Malloc((size + relations_size + 1) * sizeof(Py_ssize_t));
+    char *in_cone = PyMem_Calloc(size + 1, sizeof(char));
+    double *buffer = PyMem_Malloc((plan->max_dependencies + 1) * sizeof(double));
+    QBAFOrderedId *ordered = NULL;
+    PyObject *result = NULL;
+    int locked = FALSE;
+    if (base_ids == NULL || cone == NULL || in_cone == NULL || buffer == NULL) {
+        PyErr_NoMemory();
+        goto end;
     }
 
-    PyObject *final_strength_object = PyFloat_FromDouble(final_strength);
-    if (final_strength_object == NULL) {
-        return -1;
+    // Map the arguments of base, which must keep their initial strengths
+    int expansion = base_size <= size;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        base_ids[id] = -1;
     }
-    if (PyDict_SetItem(strengths_to_update, current_argument, final_strength_object) < 0) {
-        Py_DECREF(final_strength_object);
-        return -1;
+    for (Py_ssize_t base_id = 0; expansion && base_id < base_size; base_id++) {
+        Py_ssize_t id;
+        int contains = _QBAFramework_argument_id(self, PyList_GET_ITEM(base->id_arguments, base_id), &id);
+        if (contains < 0) {
+            goto end;
+        }
+        expansion = contains && self->initial_strengths[id] == base->initial_strengths[base_id];
+        if (expansion) {
+            base_ids[id] = base_id;
+        }
     }
-    Py_DECREF(final_strength_object);
-    return 0;
-}
 
-
-/**
- * @brief Return the final strength of a specific argument, -1.0 if an error occurred.
- * This function evaluates dependencies iteratively. So, it only works with acyclic arguments.
- * It stores all the calculated final strengths in self.__final_strengths.
- * 
- * @param self an instance of QBAFramework
- * @param argument the QBAFArgument
- * @return PyObject* borrowed PyFloat reference, -1.0 if an error has occurrred
- */
-static double
-_QBAFramework_calculate_final_strength(QBAFrameworkObject *self, PyObject *argument)
-{
-    int contains = PyDict_Contains(self->final_strengths, argument); // Check if it has been calculated already
-    if (contains < 0) {
-        return -1.0;
+    // The new arguments and the patients of the new relations are the seeds of the cone
+    Py_ssize_t cone_size = 0;
+    for (Py_ssize_t id = 0; expansion && id < size; id++) {
+        if (base_ids[id] < 0) {
+            cone[cone_size++] = id;
+        }
     }
-    if (contains) {
-        return PyFloat_AsDouble(PyDict_GetItem(self->final_strengths, argument));
+    if (expansion) {
+        expansion = _QBAFramework_expanded_relations(self, (QBAFARelationsObject*)self->attack_relations,
+                                                     (QBAFARelationsObject*)base->attack_relations, cone, &cone_size);
     }
-
-    PyObject *argument_stack = PyList_New(0);
-    PyObject *arguments_on_stack = PySet_New(NULL);
-    if (argument_stack == NULL || arguments_on_stack == NULL) {
-        Py_XDECREF(argument_stack); Py_XDECREF(arguments_on_stack);
-        return -1.0;
+    if (expansion > 0) {
+        expansion = _QBAFramework_expanded_relations(self, (QBAFARelationsObject*)self->support_relations,
+                                                     (QBAFARelationsObject*)base->support_relations, cone, &cone_size);
     }
-
-    if (_QBAFramework_argument_stack_push(argument_stack, argument) < 0) {
-        Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-        return -1.0;
+    if (expansion < 0) {
+        goto end;
+    }
+    if (!expansion) {
+        PyErr_SetString(PyExc_ValueError, "the QBAFramework must be a normal expansion of base");
+        goto end;
     }
 
-    while (PyList_GET_SIZE(argument_stack) > 0) {
-        PyObject *current_argument = _QBAFramework_argument_stack_top(argument_stack);
+    // The final strengths of a frozen Framework are calculated only once
+    if (self->frozen) {
+        _QBAFramework_lock_evaluation(self);
+        locked = TRUE;
+        if (!self->modified) {
+            result = Py_NewRef(Py_None);
+            goto end;
+        }
+    }
 
-        contains = PyDict_Contains(self->final_strengths, current_argument);
-        if (contains < 0) {
-            Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-            return -1.0;
+    // Everything reached from the seeds, the rest of the arguments keep the final strengths of base
+    Py_ssize_t seeds_size = cone_size;
+    cone_size = 0;
+    for (Py_ssize_t index = 0; index < seeds_size; index++) {
+        if (!in_cone[cone[index]]) {
+            in_cone[cone[index]] = TRUE;
+            cone[cone_size++] = cone[index];
         }
-        if (contains) {
-            if (_QBAFramework_argument_stack_pop(argument_stack) < 0) {
-                Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-                return -1.0;
-            }
-            if (PySet_Discard(arguments_on_stack, current_argument) < 0) {
-                Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-                return -1.0;
+    }
+    for (Py_ssize_t index = 0; index < cone_size; index++) {
+        Py_ssize_t id = cone[index];
+        for (Py_ssize_t successor = plan->successor_offsets[id]; successor < plan->successor_offsets[id+1]; successor++) {
+            Py_ssize_t successor_id = plan->successors[successor];
+            if (!in_cone[successor_id]) {
+                in_cone[successor_id] = TRUE;
+                cone[cone_size++] = successor_id;
             }
-            continue;
         }
-
-        int argument_is_on_stack = PySet_Contains(arguments_on_stack, current_argument);
-        if (argument_is_on_stack < 0) {
-            Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-            return -1.0;
+    }
+    for (Py_ssize_t id = 0; id < size; id++) {
+        if (!in_cone[id]) {
+            self->final_strengths[id] = base->final_strengths[base_ids[id]];
         }
+    }
 
-        // On first visit push dependencies. On second visit calculate final strength.
-        if (!argument_is_on_stack) {
-            if (PySet_Add(arguments_on_stack, current_argument) < 0) {
-                Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-                return -1.0;
-            }
-
-            if (_QBAFramework_push_unresolved_dependencies(self, current_argument, argument_stack, arguments_on_stack) < 0) {
-                Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-                return -1.0;
+    QBAFIncremental_Free(self->incremental);
+    self->incremental = NULL;
+    self->modified = TRUE;
+    Py_SETREF(self->last_solve_info, Py_NewRef(Py_None));
+    if (plan->schedule == NULL) {
+        if (_QBAFramework_calculate_cyclic_final_strengths(self, plan, cone, cone_size, buffer) < 0) {
+            goto error;
+        }
+    }
+    else {
+        ordered = PyMem_Malloc((cone_size + 1) * sizeof(QBAFOrderedId));
+        if (ordered == NULL) {
+            PyErr_NoMemory();
+            goto error;
+        }
+        for (Py_ssize_t index = 0; index < cone_size; index++) {
+            ordered[index].id = cone[index];
+            ordered[index].order = plan->ranks[cone[index]];
+        }
+        qsort(ordered, cone_size, sizeof(QBAFOrderedId), _QBAFOrderedId_compare);
+        for (Py_ssize_t index = 0; index < cone_size; index++) {
+            if (QBAFPlan_EvaluateArgument(plan, ordered[index].id, self->initial_strengths,
+                                          self->final_strengths, buffer) < 0) {
+                goto error;
             }
-            continue;
         }
 
-        if (_QBAFramework_apply_semantics(self, current_argument, self->final_strengths, self->final_strengths) < 0) {
-            Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-            return -1.0;
-        }
-        if (_QBAFramework_argument_stack_pop(argument_stack) < 0) {
-            Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-            return -1.0;
+        PyObject *residuals = PyList_New(0);
+        PyObject *largest_residuals = PyList_New(0);
+        if (residuals == NULL || largest_residuals == NULL) {
+            Py_XDECREF(residuals); Py_XDECREF(largest_residuals);
+            goto error;
         }
-        if (PySet_Discard(arguments_on_stack, current_argument) < 0) {
-            Py_DECREF(argument_stack); Py_DECREF(arguments_on_stack);
-            return -1.0;
+        double wall_time = _QBAFramework_monotonic_seconds() - start_time;
+        if (_QBAFramework_set_solve_info(self, STR_TOPOLOGICAL_SCHEME, TRUE, 1, 0.0,
+                                         residuals, 1, largest_residuals, wall_time, cone_size) < 0) {
+            goto error;
         }
     }
-    Py_DECREF(argument_stack);
-    Py_DECREF(arguments_on_stack);
-    return PyFloat_AsDouble(PyDict_GetItem(self->final_strengths, argument));
-}
 
+    if (size > 0) {
+        memset(self->stale, FALSE, size * sizeof(char));
+    }
+    self->staleness_bound = base->staleness_bound;
+    self->modified = FALSE;
+    result = Py_NewRef(Py_None);
+    goto end;
+
+error:
+    // The final strengths may have been partially overwritten
+    if (size > 0) {
+        memset(self->stale, TRUE, size * sizeof(char));
+    }
+    self->modified = TRUE;
+end:
+    if (locked) {
+        PyThread_release_lock(self->evaluation_lock);
+    }
+    PyMem_Free(base_ids); PyMem_Free(cone); PyMem_Free(in_cone); PyMem_Free(buffer); PyMem_Free(ordered);
+    return result;
+}
 
 /**
- * @brief Calculate one synchronous update of all argument strengths from dependency_strengths_by_argument.
- *
- * @param self an instance of QBAFramework
- * @param dependency_strengths_by_argument strengths used as the read-only source for this iteration
- * @return PyObject* a new PyDict with updated strengths, NULL if an error occurred
+ * @brief Return the final strengths of arguments of the Framework, NULL if an error occurred.
+ * If the framework has been modified from the last time they were calculated
+ * they are calculated again. Otherwise, it returns the already calculated final strengths.
+ * 
+ * @param self the QBAFramework
+ * @param closure 
+ * @return PyObject* a new PyDict, NULL if an error occurred
  */
 static PyObject *
-_QBAFramework_calculate_next_strengths(QBAFrameworkObject *self, PyObject *dependency_strengths_by_argument)
+QBAFramework_getfinal_strengths(QBAFrameworkObject *self, void *closure)
 {
-    PyObject *updated_strengths = PyDict_New();
-    if (updated_strengths == NULL) {
+    if (_QBAFramework_update_final_strengths(self) < 0) {
         return NULL;
     }
 
-    PyObject *argument_iterator = PyObject_GetIter(self->arguments);
-    if (argument_iterator == NULL) {
-        Py_DECREF(updated_strengths);
-        return NULL;
-    }
+    return _QBAFramework_strengths_dict(self, self->final_strengths);
+}
 
-    PyObject *current_argument;
-    while ((current_argument = PyIter_Next(argument_iterator))) {
-        if (_QBAFramework_apply_semantics(self, current_argument, dependency_strengths_by_argument, updated_strengths) < 0) {
-            Py_DECREF(current_argument); Py_DECREF(argument_iterator); Py_DECREF(updated_strengths);
-            return NULL;
-        }
-        Py_DECREF(current_argument);
+/**
+ * @brief Return 1 and store the final strength of argument in strength if argument is in the Framework,
+ * 0 if it is not, -1 if an error has occurred. The final strengths must be up to date.
+ *
+ * @param self an instance of QBAFramework
+ * @param argument a QBAFArgument
+ * @param strength a pointer where the final strength is stored
+ * @return int 1 if contained, 0 if not contained, -1 if an error occurred
+ */
+static inline int
+_QBAFramework_final_strength_of(QBAFrameworkObject *self, PyObject *argument, double *strength)
+{
+    Py_ssize_t id;
+    int contains = _QBAFramework_argument_id(self, argument, &id);
+    if (contains > 0) {
+        *strength = self->final_strengths[id];
     }
-
-    Py_DECREF(argument_iterator);
-    return updated_strengths;
+    return contains;
 }
 
+/**
+ * @brief Struct with an argument of the backward cone of a topic argument.
+ * Its attackers are edges[attackers_start:supporters_start] and its supporters edges[supporters_start:end].
+ *
+ */
+typedef struct {
+    Py_ssize_t id;                  /* internal id of the argument */
+    Py_ssize_t depth;               /* the least number of relations from the argument to the topic */
+    Py_ssize_t attackers_start;
+    Py_ssize_t supporters_start;
+    Py_ssize_t end;
+    int        cut;                 /* 1 if its attackers and supporters are beyond the cone, 0 otherwise */
+} QBAFConeArgument;
 
 /**
- * @brief Return 1 if previous_strengths and updated_strengths differ by at most convergence_threshold for every argument.
+ * @brief Append to edges the indexes in the cone of the agents of the argument id through relations,
+ * adding to the cone (with the given depth) the agents that are not in it yet.
  *
  * @param self an instance of QBAFramework
- * @param previous_strengths strengths from the previous iteration
- * @param updated_strengths strengths from the current iteration
- * @return int 1 if converged, 0 if not converged, -1 if an error occurred
+ * @param relations an instance of QBAFARelations
+ * @param id the id of a QBAFArgument
+ * @param depth the depth of the agents that are added to the cone
+ * @param indexes a PyDict (argument: QBAFArgument, index: int) with the index of the arguments of the cone
+ * @param cone a pointer to the arguments of the cone, it may be reallocated
+ * @param cone_size a pointer to the number of items of cone
+ * @param cone_capacity a pointer to the capacity of cone
+ * @param edges a pointer to the edges of the cone, it may be reallocated
+ * @param edges_size a pointer to the number of items of edges
+ * @param edges_capacity a pointer to the capacity of edges
+ * @return int 0 if successful, -1 if an error occurred
  */
 static int
-_QBAFramework_strengths_have_converged(QBAFrameworkObject *self, PyObject *previous_strengths, PyObject *updated_strengths)
+_QBAFramework_cone_agents(QBAFrameworkObject *self, QBAFARelationsObject *relations, Py_ssize_t id, Py_ssize_t depth,
+                          PyObject *indexes, QBAFConeArgument **cone, Py_ssize_t *cone_size, Py_ssize_t *cone_capacity,
+                          Py_ssize_t **edges, Py_ssize_t *edges_size, Py_ssize_t *edges_capacity)
 {
-    PyObject *argument_iterator = PyObject_GetIter(self->arguments);
-    if (argument_iterator == NULL) {
-        return -1;
-    }
-
-    PyObject *current_argument;
-    while ((current_argument = PyIter_Next(argument_iterator))) {
-        double previous_strength = PyFloat_AsDouble(PyDict_GetItem(previous_strengths, current_argument));
-        if (previous_strength == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(current_argument); Py_DECREF(argument_iterator);
-            return -1;
-        }
-
-        double updated_strength = PyFloat_AsDouble(PyDict_GetItem(updated_strengths, current_argument));
-        if (updated_strength == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(current_argument); Py_DECREF(argument_iterator);
-            return -1;
+    Py_ssize_t agents_size;
+    const Py_ssize_t *agents = QBAFARelations_AgentIds(relations, id, &agents_size);
+    for (Py_ssize_t position = 0; position < agents_size; position++) {
+        PyObject *agent = PyList_GET_ITEM(self->id_arguments, agents[position]);
+        Py_ssize_t index;
+        PyObject *pyindex = PyDict_GetItemWithError(indexes, agent);    // Borrowed reference
+        if (pyindex != NULL) {
+            index = PyLong_AsSsize_t(pyindex);
         }
-
-        double strength_difference = updated_strength - previous_strength;
-        if (strength_difference < 0.0) {
-            strength_difference = -strength_difference;
+        else {
+            if (PyErr_Occurred()) {
+                return -1;
+            }
+            if (*cone_size == *cone_capacity) {
+                QBAFConeArgument *new_cone = PyMem_Realloc(*cone, 2 * *cone_capacity * sizeof(QBAFConeArgument));
+                if (new_cone == NULL) {
+                    PyErr_NoMemory();
+                    return -1;
+                }
+                *cone = new_cone;
+                *cone_capacity *= 2;
+            }
+            index = *cone_size;
+            pyindex = PyLong_FromSsize_t(index);
+            if (pyindex == NULL || PyDict_SetItem(indexes, agent, pyindex) < 0) {
+                Py_XDECREF(pyindex);
+                return -1;
+            }
+            Py_DECREF(pyindex);
+            (*cone)[index].id = agents[position];
+            (*cone)[index].depth = depth;
+            (*cone)[index].cut = FALSE;
+            (*cone_size)++;
         }
-        Py_DECREF(current_argument);
 
-        if (strength_difference > self->convergence_threshold) {
-            Py_DECREF(argument_iterator);
-            return FALSE;
+        if (*edges_size == *edges_capacity) {
+            Py_ssize_t *new_edges = PyMem_Realloc(*edges, 2 * *edges_capacity * sizeof(Py_ssize_t));
+            if (new_edges == NULL) {
+                PyErr_NoMemory();
+                return -1;
+            }
+            *edges = new_edges;
+            *edges_capacity *= 2;
         }
+        (*edges)[(*edges_size)++] = index;
     }
-
-    Py_DECREF(argument_iterator);
-    return TRUE;
+    return 0;
 }
 
-
 /**
- * @brief Calculate final strengths for cyclic frameworks by synchronous fixed-point iteration.
+ * @brief Return 1 if the argument id has attackers or supporters, 0 if it does not.
  *
- * @param self the QBAFramework
- * @return int 0 if successful, -1 if an error occurred
+ * @param self an instance of QBAFramework
+ * @param id the id of a QBAFArgument
+ * @return int 1 if the argument has attackers or supporters, 0 if not
  */
 static int
-_QBAFramework_calculate_cyclic_final_strengths(QBAFrameworkObject *self)
+_QBAFramework_has_agents(QBAFrameworkObject *self, Py_ssize_t id)
 {
-    PyObject *previous_strengths = PyDict_Copy(self->initial_strengths);
-    if (previous_strengths == NULL) {
-        return -1;
-    }
+    Py_ssize_t attackers_size, supporters_size;
+    QBAFARelations_AgentIds((QBAFARelationsObject*)self->attack_relations, id, &attackers_size);
+    QBAFARelations_AgentIds((QBAFARelationsObject*)self->support_relations, id, &supporters_size);
+    return attackers_size > 0 || supporters_size > 0;
+}
 
-    for (Py_ssize_t iteration = 0; iteration < self->max_iterations; iteration++) {
-        PyObject *updated_strengths = _QBAFramework_calculate_next_strengths(self, previous_strengths);
-        if (updated_strengths == NULL) {
-            Py_DECREF(previous_strengths);
-            return -1;
-        }
+/**
+ * @brief Calculate the bounds of the final strength of the argument id from the bounds of its attackers and supporters.
+ * The built-in semantics are monotonic: the final strength decreases with the strengths of the attackers
+ * and increases with the strengths of the supporters.
+ *
+ * @param self an instance of QBAFramework with one of the built-in semantics
+ * @param node an argument of the cone
+ * @param edges the edges of the cone
+ * @param lower the lower bounds indexed by cone index
+ * @param upper the upper bounds indexed by cone index
+ * @param buffer scratch space with room for the attackers and supporters of node
+ * @param new_lower where the lower bound is stored
+ * @param new_upper where the upper bound is stored
+ */
+static inline void
+_QBAFramework_cone_bounds(QBAFrameworkObject *self, const QBAFConeArgument *node, const Py_ssize_t *edges,
+                          const double *lower, const double *upper, double *buffer, double *new_lower, double *new_upper)
+{
+    Py_ssize_t attackers_size = node->supporters_start - node->attackers_start;
+    Py_ssize_t supporters_size = node->end - node->supporters_start;
+    double initial_strength = self->initial_strengths[node->id];
 
-        int strengths_have_converged = _QBAFramework_strengths_have_converged(self, previous_strengths, updated_strengths);
-        Py_DECREF(previous_strengths);
-        if (strengths_have_converged < 0) {
-            Py_DECREF(updated_strengths);
-            return -1;
-        }
-        if (strengths_have_converged) {
-            Py_CLEAR(self->final_strengths);
-            self->final_strengths = updated_strengths;
-            return 0;
-        }
-        previous_strengths = updated_strengths;
+    for (Py_ssize_t edge = node->attackers_start; edge < node->end; edge++) {
+        buffer[edge - node->attackers_start] = edge < node->supporters_start ? upper[edges[edge]] : lower[edges[edge]];
     }
-    Py_DECREF(previous_strengths);
-    PyErr_Format(PyExc_RuntimeError, "cyclic framework did not converge within %zd iterations", self->max_iterations);
-    return -1;
-}
+    *new_lower = self->influence_function(initial_strength,
+                                          self->aggregation_function(buffer, attackers_size, buffer + attackers_size, supporters_size));
 
+    for (Py_ssize_t edge = node->attackers_start; edge < node->end; edge++) {
+        buffer[edge - node->attackers_start] = edge < node->supporters_start ? lower[edges[edge]] : upper[edges[edge]];
+    }
+    *new_upper = self->influence_function(initial_strength,
+                                          self->aggregation_function(buffer, attackers_size, buffer + attackers_size, supporters_size));
+}
 
 /**
- * @brief Calculate the final strengths of all the arguments of the Framework.
- * It stores all the calculated final strengths in self.__final_strengths.
- * 
- * @param self the QBAFramework
- * @return int 0 if succesful, -1 if an error occurred
+ * @brief Bound the final strength of argument evaluating only its backward cone of depth max_depth: the arguments
+ * from which it is reached through at most max_depth attack and support relations. The final strengths of the arguments
+ * at the cut (depth max_depth, with attackers or supporters) are only known to be within the range of the semantics,
+ * and the bounds are propagated to argument in topological order (or iteratively if the cone is cyclic).
+ * Its cost depends on the size of the cone, not on the size of the Framework.
+ *
+ * @param self an instance of QBAFramework with one of the built-in semantics
+ * @param argument a QBAFArgument contained in the Framework
+ * @param max_depth the depth of the cone
+ * @param lower where the lower bound is stored
+ * @param upper where the upper bound is stored
+ * @return int 0 if successful, -1 if an error occurred
  */
 static int
-_QBAFRamework_calculate_final_strengths(QBAFrameworkObject *self)
+_QBAFramework_depth_bounds(QBAFrameworkObject *self, PyObject *argument, Py_ssize_t max_depth, double *lower, double *upper)
 {
-    int isacyclic = _QBAFramework_isacyclic(self);
-    if (isacyclic < 0) {
+    Py_ssize_t id = 0;
+    if (_QBAFramework_argument_id(self, argument, &id) < 0) {
         return -1;
     }
-    if (!isacyclic) {
-        if (!self->allow_cycles) {
-            PyErr_SetString(PyExc_NotImplementedError, "calculate final strengths of cyclic framework requires allow_cycles=True");
-            return -1;
+
+    Py_ssize_t cone_size = 1, cone_capacity = 16, edges_size = 0, edges_capacity = 16;
+    QBAFConeArgument *cone = PyMem_Malloc(cone_capacity * sizeof(QBAFConeArgument));
+    Py_ssize_t *edges = PyMem_Malloc(edges_capacity * sizeof(Py_ssize_t));
+    PyObject *indexes = PyDict_New();
+    PyObject *pyindex = PyLong_FromSsize_t(0);
+    Py_ssize_t *postorder = NULL, *stack = NULL, *cursors = NULL;
+    char *states = NULL;
+    double *lower_bounds = NULL, *upper_bounds = NULL, *buffer = NULL;
+    int result = -1;
+    if (cone == NULL || edges == NULL || indexes == NULL || pyindex == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        goto end;
+    }
+    if (PyDict_SetItem(indexes, argument, pyindex) < 0) {
+        goto end;
+    }
+    cone[0].id = id;
+    cone[0].depth = 0;
+    cone[0].cut = FALSE;
+
+    // Breadth-first search of the cone, so every argument gets its least depth
+    Py_ssize_t max_dependencies = 0;
+    int has_cut = FALSE;
+    for (Py_ssize_t index = 0; index < cone_size; index++) {
+        Py_ssize_t depth = cone[index].depth;
+        cone[index].attackers_start = edges_size;
+        if (depth < max_depth &&
+            _QBAFramework_cone_agents(self, (QBAFARelationsObject*)self->attack_relations, cone[index].id, depth + 1, indexes,
+                                      &cone, &cone_size, &cone_capacity, &edges, &edges_size, &edges_capacity) < 0) {
+            goto end;
+        }
+        cone[index].supporters_start = edges_size;
+        if (depth < max_depth &&
+            _QBAFramework_cone_agents(self, (QBAFARelationsObject*)self->support_relations, cone[index].id, depth + 1, indexes,
+                                      &cone, &cone_size, &cone_capacity, &edges, &edges_size, &edges_capacity) < 0) {
+            goto end;
+        }
+        cone[index].end = edges_size;
+        if (depth == max_depth) {
+            int cut = _QBAFramework_has_agents(self, cone[index].id);
+            cone[index].cut = cut;
+            has_cut = has_cut || cut;
+        }
+        if (cone[index].end - cone[index].attackers_start > max_dependencies) {
+            max_dependencies = cone[index].end - cone[index].attackers_start;
+        }
+    }
+
+    int basic_model = streq(self->semantics, STR_BASIC_MODEL);
+    double min_strength = basic_model ? -INFINITY : 0.0;
+    double max_strength = basic_model ? INFINITY : 1.0;
+
+    // Depth-first postorder: the attackers and supporters of an argument precede it unless the cone is cyclic
+    postorder = PyMem_Malloc(cone_size * sizeof(Py_ssize_t));
+    stack = PyMem_Malloc(cone_size * sizeof(Py_ssize_t));
+    cursors = PyMem_Malloc(cone_size * sizeof(Py_ssize_t));
+    states = PyMem_Calloc(cone_size, sizeof(char));
+    lower_bounds = PyMem_Malloc(cone_size * sizeof(double));
+    upper_bounds = PyMem_Malloc(cone_size * sizeof(double));
+    buffer = PyMem_Malloc((max_dependencies + 1) * sizeof(double));
+    if (postorder == NULL || stack == NULL || cursors == NULL || states == NULL ||
+        lower_bounds == NULL || upper_bounds == NULL || buffer == NULL) {
+        PyErr_NoMemory();
+        goto end;
+    }
+    Py_ssize_t postorder_size = 0, stack_size = 1;
+    int cyclic = FALSE;
+    stack[0] = 0;
+    cursors[0] = cone[0].attackers_start;
+    states[0] = 1;      // 1 while it is in the stack, 2 once it is in postorder
+    while (stack_size > 0) {
+        Py_ssize_t index = stack[stack_size - 1];
+        if (cursors[index] == cone[index].end) {
+            states[index] = 2;
+            postorder[postorder_size++] = index;
+            stack_size--;
+            continue;
+        }
+        Py_ssize_t next = edges[cursors[index]++];
+        if (states[next] == 1) {
+            cyclic = TRUE;
+        }
+        else if (states[next] == 0) {
+            states[next] = 1;
+            cursors[next] = cone[next].attackers_start;
+            stack[stack_size++] = next;
         }
-        return _QBAFramework_calculate_cyclic_final_strengths(self);
     }
-
-    Py_CLEAR(self->final_strengths);
-    self->final_strengths = PyDict_New();
-
-    PyObject *iterator = PyObject_GetIter(self->arguments);
-    if (iterator == NULL) {
-        return -1;
+    if (cyclic && !self->allow_cycles) {
+        PyErr_SetString(PyExc_NotImplementedError, "calculate final strengths of cyclic framework requires allow_cycles=True");
+        goto end;
+    }
+    // The built-in semantics other than the basic model keep the final strengths within [0, 1]
+    // and are monotonic while the initial strengths are within [0, 1]. Both the cut and the iterations
+    // of a cyclic cone start from those bounds
+    if ((has_cut || cyclic) && !basic_model && self->outside_unit > 0) {
+        PyErr_SetString(PyExc_ValueError, "max_depth requires every initial strength to be within [0, 1]");
+        goto end;
     }
 
-    PyObject *item;
-    while ((item = PyIter_Next(iterator))) { // PyIter_Next returns a new reference
-        if (_QBAFramework_calculate_final_strength(self, item) == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(item);
-            Py_DECREF(iterator);
-            return -1;
-        }
-        Py_DECREF(item);
+    for (Py_ssize_t index = 0; index < cone_size; index++) {
+        lower_bounds[index] = min_strength;
+        upper_bounds[index] = max_strength;
     }
-    Py_DECREF(iterator);
-    return 0;
+    Py_ssize_t sweeps = cyclic ? self->max_iterations : 1;
+    for (Py_ssize_t sweep = 0; sweep < sweeps; sweep++) {
+        double change = 0.0;
+        for (Py_ssize_t position = 0; position < postorder_size; position++) {
+            Py_ssize_t index = postorder[position];
+            if (cone[index].cut) {
+                continue;
+            }
+            double new_lower, new_upper;
+            _QBAFramework_cone_bounds(self, &cone[index], edges, lower_bounds, upper_bounds, buffer, &new_lower, &new_upper);
+            if (cyclic) {   // Every sweep keeps the final strengths within the bounds, so they only get tighter
+                new_lower = fmax(new_lower, lower_bounds[index]);
+                new_upper = fmin(new_upper, upper_bounds[index]);
+                change = fmax(change, fmax(new_lower - lower_bounds[index], upper_bounds[index] - new_upper));
+            }
+            lower_bounds[index] = new_lower;
+            upper_bounds[index] = new_upper;
+        }
+        if (change < self->convergence_threshold) {
+            break;
+        }
+    }
+
+    *lower = lower_bounds[0];
+    *upper = upper_bounds[0];
+    result = 0;
+
+end:
+    PyMem_Free(cone);
+    PyMem_Free(edges);
+    Py_XDECREF(indexes);
+    Py_XDECREF(pyindex);
+    PyMem_Free(postorder);
+    PyMem_Free(stack);
+    PyMem_Free(cursors);
+    PyMem_Free(states);
+    PyMem_Free(lower_bounds);
+    PyMem_Free(upper_bounds);
+    PyMem_Free(buffer);
+    return result;
 }
 
-
 /**
- * @brief Return the final strengths of arguments of the Framework, NULL if an error occurred.
- * If the framework has been modified from the last time they were calculated
- * they are calculated again. Otherwise, it returns the already calculated final strengths.
+ * @brief Return the final strength of the Argument argument, NULL in case of error.
+ * With max_depth, return its bounds from its backward cone of that depth unless the final strengths are up to date.
  * 
- * @param self the QBAFramework
- * @param closure 
- * @return PyObject* a new PyDict, NULL if an error occurred
+ * @param self an instance of QBAFramework
+ * @param args the argument values (argument: QBAFArgument, max_depth: int or None)
+ * @param kwds the argument names
+ * @return PyObject* new PyFloat, or a new PyTuple (lower bound, upper bound) if the bounds are not equal
  */
 static PyObject *
-QBAFramework_getfinal_strengths(QBAFrameworkObject *self, void *closure)
+QBAFramework_final_strength(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
 {
-    if (self->modified) {   // Calculate final strengths if the framework has been modified
-        if (_QBAFRamework_calculate_final_strengths(self) < 0) {
+    static char *kwlist[] = {"argument", "max_depth", NULL};
+    PyObject *argument;
+    PyObject *max_depth = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
+                                     &argument, &max_depth))
+        return NULL;
+
+    Py_ssize_t depth = -1;
+    if (max_depth != Py_None) {
+        if (!PyLong_Check(max_depth)) {
+            PyErr_SetString(PyExc_TypeError, "max_depth must be of type int or None");
+            return NULL;
+        }
+        depth = PyLong_AsSsize_t(max_depth);
+        if (depth == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (depth < 0) {
+            PyErr_SetString(PyExc_ValueError, "max_depth must be greater than or equal to 0");
             return NULL;
         }
-        self->modified = FALSE;
     }
 
-    return PyDict_Copy(self->final_strengths);
-}
+    // Up-to-date final strengths are exact, so the cone is only evaluated when they would have to be calculated
+    if (depth >= 0 && (self->modified || self->staleness_bound > 0.0)) {
+        if (self->semantics == NULL) {
+            PyErr_SetString(PyExc_NotImplementedError, "max_depth requires one of the built-in semantics");
+            return NULL;
+        }
+        int contains = PyDict_Contains(self->argument_ids, argument);
+        if (contains < 0) {
+            return NULL;
+        }
+        if (!contains) {
+            PyErr_SetString(PyExc_ValueError,
+                            "argument must be contained in the QBAFramework");
+            return NULL;
+        }
 
-/**
- * @brief Return the final strength of the Argument argument, NULL in case of error.
- * 
- * @param self an instance of QBAFramework
- * @param argument the QBAFArgument
- * @return PyObject* borrowed PyFloat
- */
-static PyObject *
-_QBAFramework_final_strength(QBAFrameworkObject *self, PyObject *argument)
-{
-    if (self->modified) {   // Calculate final strengths if the framework has been modified
-        if (_QBAFRamework_calculate_final_strengths(self) < 0) {
+        double lower, upper;
+        if (_QBAFramework_depth_bounds(self, argument, depth, &lower, &upper) < 0) {
             return NULL;
         }
-        self->modified = FALSE;
+        if (lower == upper) {
+            return PyFloat_FromDouble(lower);
+        }
+        return Py_BuildValue("(dd)", lower, upper);
+    }
+
+    if (_QBAFramework_update_final_strengths(self) < 0) {
+        return NULL;
     }
 
-    int contains = PyDict_Contains(self->final_strengths, argument);
+    double final_strength;
+    int contains = _QBAFramework_final_strength_of(self, argument, &final_strength);
     if (contains < 0) {
         return NULL;
     }
@@ -2298,30 +5511,58 @@ _QBAFramework_final_strength(QBAFrameworkObject *self, PyObject *argument)
         return NULL;
     }
 
-    return PyDict_GetItem(self->final_strengths, argument);
+    return PyFloat_FromDouble(final_strength);
 }
 
 /**
- * @brief Return the final strength of the Argument argument, NULL in case of error.
- * 
- * @param self an instance of QBAFramework
- * @param args the argument values (argument: QBAFArgument)
- * @param kwds the argument names
- * @return PyObject* new PyFloat
+ * @brief Store in order the comparison of the final strengths of arg1 and arg2: -1 if the final strength of arg1 is lower,
+ * 1 if it is greater, 0 if they are equal. If the final strengths would have to be calculated and the Framework is acyclic,
+ * the bounds of the backward cones of depth CONSISTENCY_BOUNDS_DEPTH of both arguments are tried first, and the final
+ * strengths are only calculated if the bounds overlap. A cyclic Framework always calculates them, so it raises the same
+ * errors as when its final strengths are requested.
+ *
+ * @param self instance of QBAFramework
+ * @param arg1 an instance of QBAFArgument contained in the Framework
+ * @param arg2 an instance of QBAFArgument contained in the Framework
+ * @param order where the comparison is stored
+ * @return int 0 if successful, -1 if an error occurred
  */
-static PyObject *
-QBAFramework_final_strength(QBAFrameworkObject *self, PyObject *args, PyObject *kwds)
+static int
+_QBAFramework_strength_order(QBAFrameworkObject *self, PyObject *arg1, PyObject *arg2, int *order)
 {
-    static char *kwlist[] = {"argument", NULL};
-    PyObject *argument;
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
-                                     &argument))
-        return NULL;
+    int bounds = (self->modified || self->staleness_bound > 0.0) && self->semantics != NULL &&
+                 (streq(self->semantics, STR_BASIC_MODEL) || self->outside_unit == 0);
+    if (bounds && self->acyclic < 0 && _QBAFramework_plan(self) == NULL) {     // It finds out whether the relations are acyclic
+        return -1;
+    }
+    if (bounds && self->acyclic == TRUE) {
+        double lower1, upper1, lower2, upper2;
+        if (_QBAFramework_depth_bounds(self, arg1, CONSISTENCY_BOUNDS_DEPTH, &lower1, &upper1) < 0 ||
+            _QBAFramework_depth_bounds(self, arg2, CONSISTENCY_BOUNDS_DEPTH, &lower2, &upper2) < 0) {
+            return -1;
+        }
+        // The calculated final strengths may differ from the bounds by rounding errors
+        double margin = self->convergence_threshold;
+        if (upper1 + margin < lower2) {
+            *order = -1;
+            return 0;
+        }
+        if (upper2 + margin < lower1) {
+            *order = 1;
+            return 0;
+        }
+    }
 
-    PyObject *final_strength = _QBAFramework_final_strength(self, argument); // Borrowed reference
-    Py_XINCREF(final_strength);
-    return final_strength;
+    if (_QBAFramework_update_final_strengths(self) < 0) {
+        return -1;
+    }
+    double final_strength1 = 0.0, final_strength2 = 0.0;
+    if (_QBAFramework_final_strength_of(self, arg1, &final_strength1) < 0 ||
+        _QBAFramework_final_strength_of(self, arg2, &final_strength2) < 0) {
+        return -1;
+    }
+    *order = (final_strength1 > final_strength2) - (final_strength1 < final_strength2);
+    return 0;
 }
 
 /**
@@ -2337,21 +5578,8 @@ QBAFramework_final_strength(QBAFrameworkObject *self, PyObject *args, PyObject *
 static inline int
 _QBAFramework_are_strength_consistent(QBAFrameworkObject *self, QBAFrameworkObject *other, PyObject *arg1, PyObject *arg2)
 {
-    if (self->modified) {   // Calculate final strengths if the framework has been modified
-        if (_QBAFRamework_calculate_final_strengths(self) < 0) {
-            return -1;
-        }
-        self->modified = FALSE;
-    }
-    if (other->modified) {   // Calculate final strengths if the framework has been modified
-        if (_QBAFRamework_calculate_final_strengths(other) < 0) {
-            return -1;
-        }
-        other->modified = FALSE;
-    }
-
     // Check that the arguments are contained in both frameworks
-    int contains = PyDict_Contains(self->final_strengths, arg1);
+    int contains = PyDict_Contains(self->argument_ids, arg1);
     if (contains < 0) {
         return -1;
     }
@@ -2359,7 +5587,7 @@ _QBAFramework_are_strength_consistent(QBAFrameworkObject *self, QBAFrameworkObje
         PyErr_SetString(PyExc_ValueError, "arg1 must be an argument of this QBAFramework");
         return -1;
     }
-    contains = PyDict_Contains(self->final_strengths, arg2);
+    contains = PyDict_Contains(self->argument_ids, arg2);
     if (contains < 0) {
         return -1;
     }
@@ -2367,7 +5595,7 @@ _QBAFramework_are_strength_consistent(QBAFrameworkObject *self, QBAFrameworkObje
         PyErr_SetString(PyExc_ValueError, "arg2 must be an argument of this QBAFramework");
         return -1;
     }
-    contains = PyDict_Contains(other->final_strengths, arg1);
+    contains = PyDict_Contains(other->argument_ids, arg1);
     if (contains < 0) {
         return -1;
     }
@@ -2375,7 +5603,7 @@ _QBAFramework_are_strength_consistent(QBAFrameworkObject *self, QBAFrameworkObje
         PyErr_SetString(PyExc_ValueError, "arg1 must be an argument of the QBAFramework other");
         return -1;
     }
-    contains = PyDict_Contains(other->final_strengths, arg2);
+    contains = PyDict_Contains(other->argument_ids, arg2);
     if (contains < 0) {
         return -1;
     }
@@ -2384,16 +5612,12 @@ _QBAFramework_are_strength_consistent(QBAFrameworkObject *self, QBAFrameworkObje
         return -1;
     }
 
-    double self_final_strength_arg1 = PyFloat_AS_DOUBLE(PyDict_GetItem(self->final_strengths, arg1));
-    double self_final_strength_arg2 = PyFloat_AS_DOUBLE(PyDict_GetItem(self->final_strengths, arg2));
-    double other_final_strength_arg1 = PyFloat_AS_DOUBLE(PyDict_GetItem(other->final_strengths, arg1));
-    double other_final_strength_arg2 = PyFloat_AS_DOUBLE(PyDict_GetItem(other->final_strengths, arg2));
-
-    if (self_final_strength_arg1 < self_final_strength_arg2)
-        return other_final_strength_arg1 < other_final_strength_arg2;
-    if (self_final_strength_arg1 > self_final_strength_arg2)
-        return other_final_strength_arg1 > other_final_strength_arg2;
-    return other_final_strength_arg1 == other_final_strength_arg2;
+    int self_order, other_order;
+    if (_QBAFramework_strength_order(self, arg1, arg2, &self_order) < 0 ||
+        _QBAFramework_strength_order(other, arg1, arg2, &other_order) < 0) {
+        return -1;
+    }
+    return self_order == other_order;
 }
 
 /**
@@ -2431,71 +5655,78 @@ QBAFramework_are_strength_consistent(QBAFrameworkObject *self, PyObject *args, P
 }
 
 /**
- * @brief Return a new QBAFramework copying the settings of self (disjoint_relations and semantics).
- * 
- * @param self instance of QBAFramework
- * @return PyObject* new instance of QBAFramework, NULL if an error has occurred
+ * @brief Replace the relations of reversal (a copy of self) whose agents are in set by those of other:
+ * the relations of self to arguments of other are removed, and the relations of other to arguments of reversal
+ * are added. The patients of the modified relations are marked as stale.
+ *
+ * @param reversal the QBAFramework that is being built, with the arguments of set that are in other
+ * @param relations the attack or the support relations of reversal
+ * @param self the QBAFramework that is reversed
+ * @param self_relations the relations of self of the same kind
+ * @param other the QBAFramework that self is reversed into
+ * @param other_relations the relations of other of the same kind
+ * @param set the set of QBAFArgument that are reversed
+ * @param added where the number of added relations is accumulated
+ * @param removed where the number of removed relations is accumulated
+ * @return int 0 if successful, -1 if an error occurred
  */
-static inline PyObject *
-_QBAFramework_copy_settings(QBAFrameworkObject *self)
+static int
+_QBAFramework_reverse_relations(QBAFrameworkObject *reversal, PyObject *relations,
+                                QBAFrameworkObject *self, PyObject *self_relations,
+                                QBAFrameworkObject *other, PyObject *other_relations,
+                                PyObject *set, Py_ssize_t *added, Py_ssize_t *removed)
 {
-    PyObject *kwds = NULL;
-    PyObject *args = NULL;
-
-    QBAFrameworkObject *copy = (QBAFrameworkObject*) QBAFramework_new(Py_TYPE(self), args, kwds);
-    if (copy == NULL) {
-        return NULL;
-    }
-
-    Py_DECREF(copy->arguments);
-    copy->arguments = PySet_New(NULL);
-    if (copy->arguments == NULL) {
-        Py_DECREF(copy);
-        return NULL;
+    PyObject *iterator = PyObject_GetIter(set);
+    if (iterator == NULL) {
+        return -1;
     }
 
-    Py_DECREF(copy->initial_strengths);
-    copy->initial_strengths = PyDict_New();
-    if (copy->initial_strengths == NULL) {
-        Py_DECREF(copy);
-        return NULL;
-    }
+    PyObject *arg, *patient;
+    Py_ssize_t id, size;
+    const Py_ssize_t *patients;
+    while ((arg = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
+        // for patient in self.relations.patients(arg).intersection(other.arguments): relations.remove(arg, patient)
+        int contains = _QBAFramework_argument_id(self, arg, &id);
+        patients = contains > 0 ? QBAFARelations_PatientIds((QBAFARelationsObject*)self_relations, id, &size) : NULL;
+        for (Py_ssize_t index = 0; patients != NULL && contains >= 0 && index < size; index++) {
+            patient = PyList_GET_ITEM(self->id_arguments, patients[index]);
+            contains = PySet_Contains(other->arguments, patient);
+            if (contains > 0) {
+                if (_QBAFARelations_remove((QBAFARelationsObject*)relations, arg, patient) < 0 ||
+                    _QBAFramework_mark_stale(reversal, patient) < 0) {
+                    contains = -1;
+                }
+                (*removed)++;
+            }
+        }
 
-    Py_DECREF(copy->attack_relations);
-    copy->attack_relations = QBAFARelations_Create(NULL);
-    if (copy->attack_relations == NULL) {
-        Py_DECREF(copy);
-        return NULL;
-    }
+        // for patient in other.relations.patients(arg).intersection(reversal.arguments): relations.add(arg, patient)
+        if (contains >= 0) {
+            contains = _QBAFramework_argument_id(other, arg, &id);
+        }
+        patients = contains > 0 ? QBAFARelations_PatientIds((QBAFARelationsObject*)other_relations, id, &size) : NULL;
+        for (Py_ssize_t index = 0; patients != NULL && contains >= 0 && index < size; index++) {
+            patient = PyList_GET_ITEM(other->id_arguments, patients[index]);
+            contains = PySet_Contains(reversal->arguments, patient);
+            if (contains > 0) {
+                if (_QBAFARelations_add((QBAFARelationsObject*)relations, arg, patient) < 0 ||
+                    _QBAFramework_mark_stale(reversal, patient) < 0) {
+                    contains = -1;
+                }
+                (*added)++;
+            }
+        }
 
-    Py_DECREF(copy->support_relations);
-    copy->support_relations = QBAFARelations_Create(NULL);
-    if (copy->support_relations == NULL) {
-        Py_DECREF(copy);
-        return NULL;
+        Py_DECREF(arg);
+        if (contains < 0) {
+            Py_DECREF(iterator);
+            return -1;
+        }
     }
-
-    copy->modified = TRUE;
-    copy->disjoint_relations = self->disjoint_relations;
-
-    copy->semantics = self->semantics;
-    copy->aggregation_function = self->aggregation_function;
-    copy->influence_function = self->influence_function;
-    copy->min_strength = self->min_strength;
-    copy->max_strength = self->max_strength;
-    copy->allow_cycles = self->allow_cycles;
-    copy->max_iterations = self->max_iterations;
-    copy->convergence_threshold = self->convergence_threshold;
-
-    Py_XINCREF(self->aggregation_function_callable);
-    copy->aggregation_function_callable = self->aggregation_function_callable;
-    Py_XINCREF(self->influence_function_callable);
-    copy->influence_function_callable = self->influence_function_callable;
-    
-    return (PyObject*)copy;
+    Py_DECREF(iterator);
+    return PyErr_Occurred() ? -1 : 0;
 }
 
-
 /**
  * @brief Return the reversal framework of self to other w.r.t. set, NULL if an error is encountered.
  * The Set set must be a subset of self->arguments UNION other->arguments.
@@ -2508,271 +5739,141 @@ _QBAFramework_copy_settings(QBAFrameworkObject *self)
 static PyObject *
 _QBAFramework_reversal(QBAFrameworkObject *self, QBAFrameworkObject *other, PyObject* set)
 {
-    PyObject *arguments_union = PySet_Union(self->arguments, other->arguments);
-    if (arguments_union == NULL) {
-        return NULL;
-    }
+    PyObject *iterator, *arg;
+    int contains;
 
-    // Check that set.issubset(self.arguments.union(other.arguments)) 
-    int issubset = PySet_IsSubset(set, arguments_union);
-    if (issubset < 0) {
-        Py_DECREF(arguments_union);
+    // Check that set.issubset(self.arguments.union(other.arguments))
+    iterator = PyObject_GetIter(set);
+    if (iterator == NULL) {
         return NULL;
     }
-    if (!issubset) {
-        Py_DECREF(arguments_union);
-        PyErr_SetString(PyExc_ValueError,
-                        "argument set must be a subset of the union of the arguments of both frameworks");
+    while ((arg = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
+        contains = PySet_Contains(self->arguments, arg);
+        if (contains == 0) {
+            contains = PySet_Contains(other->arguments, arg);
+        }
+        Py_DECREF(arg);
+        if (contains <= 0) {
+            Py_DECREF(iterator);
+            if (contains == 0) {
+                PyErr_SetString(PyExc_ValueError,
+                                "argument set must be a subset of the union of the arguments of both frameworks");
+            }
+            return NULL;
+        }
+    }
+    Py_DECREF(iterator);
+    if (PyErr_Occurred()) {
         return NULL;
     }
-    Py_DECREF(arguments_union);
 
-    // Copy this framework settings
-    QBAFrameworkObject *reversal = (QBAFrameworkObject*)_QBAFramework_copy_settings(self);
+    // The reversal is a copy of self where only the arguments of set and their relations are modified
+    QBAFrameworkObject *reversal = (QBAFrameworkObject*)QBAFramework_copy(self, NULL);
     if (reversal == NULL) {
         return NULL;
     }
 
-    // Modify arguments
-    PyObject *self_arguments_union_set = PySet_Union(self->arguments, set);
-    if (self_arguments_union_set == NULL) {
+    // The arguments of set that are in other take their initial strength from other
+    iterator = PyObject_GetIter(set);
+    if (iterator == NULL) {
         Py_DECREF(reversal);
         return NULL;
     }
-    PyObject *set_difference_other_arguments = PySet_Difference(set, other->arguments);
-    if (set_difference_other_arguments == NULL) {
+    double initial_strength;
+    while ((arg = PyIter_Next(iterator))) {
+        contains = PySet_Contains(other->arguments, arg);
+        if (contains > 0) {
+            contains = _QBAFramework_initial_strength_of(other, arg, &initial_strength);
+            if (contains > 0 && (_QBAFramework_insert_argument(reversal, arg, initial_strength) < 0 ||
+                                 PySet_Add(reversal->arguments, arg) < 0)) {
+                contains = -1;
+            }
+        }
+        Py_DECREF(arg);
+        if (contains < 0) {
+            Py_DECREF(reversal); Py_DECREF(iterator);
+            return NULL;
+        }
+    }
+    Py_DECREF(iterator);
+    if (PyErr_Occurred()) {
         Py_DECREF(reversal);
-        Py_DECREF(self_arguments_union_set);
         return NULL;
     }
-    Py_DECREF(reversal->arguments);
-    reversal->arguments = PySet_Difference(self_arguments_union_set, set_difference_other_arguments);
-    Py_DECREF(self_arguments_union_set);
-    Py_DECREF(set_difference_other_arguments);
-    if (reversal->arguments == NULL) {
+
+    // The relations of the arguments of set are those of other
+    Py_ssize_t added = 0, removed = 0;
+    if (_QBAFramework_reverse_relations(reversal, reversal->attack_relations, self, self->attack_relations,
+                                        other, other->attack_relations, set, &added, &removed) < 0 ||
+        _QBAFramework_reverse_relations(reversal, reversal->support_relations, self, self->support_relations,
+                                        other, other->support_relations, set, &added, &removed) < 0) {
         Py_DECREF(reversal);
         return NULL;
     }
 
-    PyObject *set_iterator;
-    PyObject *arg; // item
-    PyObject *iterator, *attacked, *supported, *patients;
-    PyObject *patients_intersection_other_arguments;
-    PyObject *patients_intersection_reversal_arguments;
-
-    // Modify attack relations
-    Py_DECREF(reversal->attack_relations);
-    reversal->attack_relations = QBAFARelations_copy((QBAFARelationsObject*)self->attack_relations, NULL);
-    if (reversal->attack_relations == NULL) {
+    // The arguments of set that are not in other are removed, with their relations
+    PyObject *set_difference_other_arguments = PySet_Difference(set, other->arguments);
+    if (set_difference_other_arguments == NULL) {
         Py_DECREF(reversal);
         return NULL;
     }
-    set_iterator = PyObject_GetIter(set);
-    if (set_iterator == NULL) {
-        Py_DECREF(reversal);
+    QBAFARelationsObject *relations[2] = {(QBAFARelationsObject*)reversal->attack_relations,
+                                          (QBAFARelationsObject*)reversal->support_relations};
+    Py_ssize_t relations_size = QBAFARelations_Size(relations[0]) + QBAFARelations_Size(relations[1]);
+    iterator = PyObject_GetIter(set_difference_other_arguments);
+    if (iterator == NULL) {
+        Py_DECREF(reversal); Py_DECREF(set_difference_other_arguments);
         return NULL;
     }
-    while ((arg = PyIter_Next(set_iterator))) {    // PyIter_Next returns a new reference
-        // for attacked in self.__attack_relations.patients(arg).intersection(other): att.remove(arg, attacked)
-        patients = _QBAFARelations_patients_set((QBAFARelationsObject*)self->attack_relations, arg); // borrowed reference
-        if (patients == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-            return NULL;
-        }
-        patients_intersection_other_arguments = PySet_Intersection(patients, other->arguments);
-        if (patients_intersection_other_arguments == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-            return NULL;
-        }
-        iterator = PyObject_GetIter(patients_intersection_other_arguments);
-        if (iterator == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator); Py_DECREF(patients_intersection_other_arguments);
-            return NULL;
-        }
-        while ((attacked = PyIter_Next(iterator))) {
-            if (_QBAFARelations_remove((QBAFARelationsObject*)reversal->attack_relations, arg, attacked) < 0) {
-                Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-                Py_DECREF(attacked); Py_DECREF(iterator); Py_DECREF(patients_intersection_other_arguments);
-                return NULL;
+    while ((arg = PyIter_Next(iterator))) {
+        Py_ssize_t id, size;
+        contains = _QBAFramework_argument_id(reversal, arg, &id);
+        for (int kind = 0; contains > 0 && kind < 2; kind++) {
+            const Py_ssize_t *patients = QBAFARelations_PatientIds(relations[kind], id, &size);
+            for (Py_ssize_t index = 0; index < size; index++) {
+                reversal->stale[patients[index]] = TRUE;
             }
-            Py_DECREF(attacked);
         }
-        Py_DECREF(patients_intersection_other_arguments);
-        Py_DECREF(iterator);
-
-        // for attacked in other.__attack_relations.patients(arg).intersection(args): att.add_relation(arg, attacked)
-        patients = _QBAFARelations_patients_set((QBAFARelationsObject*)other->attack_relations, arg); // borrowed reference
-        if (patients == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-            return NULL;
-        }
-        patients_intersection_reversal_arguments = PySet_Intersection(patients, reversal->arguments);
-        if (patients_intersection_reversal_arguments == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-            return NULL;
-        }
-        iterator = PyObject_GetIter(patients_intersection_reversal_arguments);
-        if (iterator == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator); Py_DECREF(patients_intersection_reversal_arguments);
+        Py_DECREF(arg);
+        if (contains < 0) {
+            Py_DECREF(reversal); Py_DECREF(iterator); Py_DECREF(set_difference_other_arguments);
             return NULL;
         }
-        while ((attacked = PyIter_Next(iterator))) {
-            if (_QBAFARelations_add((QBAFARelationsObject*)reversal->attack_relations, arg, attacked) < 0) {
-                Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-                Py_DECREF(attacked); Py_DECREF(iterator); Py_DECREF(patients_intersection_reversal_arguments);
-                return NULL;
-            }
-            Py_DECREF(attacked);
-        }
-        Py_DECREF(patients_intersection_reversal_arguments);
-        Py_DECREF(iterator);
-        
-        // Decref arg
-        Py_DECREF(arg);
     }
-    Py_DECREF(set_iterator);
-
-    // Modify support relations
-    Py_DECREF(reversal->support_relations);
-    reversal->support_relations = QBAFARelations_copy((QBAFARelationsObject*)self->support_relations, NULL);
-    if (reversal->support_relations == NULL) {
-        Py_DECREF(reversal);
+    Py_DECREF(iterator);
+    if (PyErr_Occurred() ||
+        _QBAFARelations_remove_arguments(relations[0], set_difference_other_arguments) < 0 ||
+        _QBAFARelations_remove_arguments(relations[1], set_difference_other_arguments) < 0) {
+        Py_DECREF(reversal); Py_DECREF(set_difference_other_arguments);
         return NULL;
     }
-    set_iterator = PyObject_GetIter(set);
-    if (set_iterator == NULL) {
+    removed += relations_size - QBAFARelations_Size(relations[0]) - QBAFARelations_Size(relations[1]);
+    iterator = PyObject_GetIter(set_difference_other_arguments);
+    Py_DECREF(set_difference_other_arguments);
+    if (iterator == NULL) {
         Py_DECREF(reversal);
         return NULL;
     }
-    while ((arg = PyIter_Next(set_iterator))) {    // PyIter_Next returns a new reference
-        // for supported in self.__support_relations.patients(arg).intersection(other): supp.remove(arg, supported)
-        patients = _QBAFARelations_patients_set((QBAFARelationsObject*)self->support_relations, arg); // borrowed reference
-        if (patients == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-            return NULL;
-        }
-        patients_intersection_other_arguments = PySet_Intersection(patients, other->arguments);
-        if (patients_intersection_other_arguments == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-            return NULL;
-        }
-        iterator = PyObject_GetIter(patients_intersection_other_arguments);
-        if (iterator == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator); Py_DECREF(patients_intersection_other_arguments);
-            return NULL;
-        }
-        while ((supported = PyIter_Next(iterator))) {
-            if (_QBAFARelations_remove((QBAFARelationsObject*)reversal->support_relations, arg, supported) < 0) {
-                Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-                Py_DECREF(supported); Py_DECREF(iterator); Py_DECREF(patients_intersection_other_arguments);
-                return NULL;
-            }
-            Py_DECREF(supported);
-        }
-        Py_DECREF(patients_intersection_other_arguments);
-        Py_DECREF(iterator);
-
-        // for supported in other.__support_relations.patients(arg).intersection(args): supp.add_relation(arg, supported)
-        patients = _QBAFARelations_patients_set((QBAFARelationsObject*)other->support_relations, arg); // borrowed reference
-        if (patients == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-            return NULL;
-        }
-        patients_intersection_reversal_arguments = PySet_Intersection(patients, reversal->arguments);
-        if (patients_intersection_reversal_arguments == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
+    while ((arg = PyIter_Next(iterator))) {
+        if (_QBAFramework_delete_argument(reversal, arg) < 0 || PySet_Discard(reversal->arguments, arg) < 0) {
+            Py_DECREF(reversal); Py_DECREF(iterator); Py_DECREF(arg);
             return NULL;
         }
-        iterator = PyObject_GetIter(patients_intersection_reversal_arguments);
-        if (iterator == NULL) {
-            Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator); Py_DECREF(patients_intersection_reversal_arguments);
-            return NULL;
-        }
-        while ((supported = PyIter_Next(iterator))) {
-            if (_QBAFARelations_add((QBAFARelationsObject*)reversal->support_relations, arg, supported) < 0) {
-                Py_DECREF(reversal); Py_DECREF(arg); Py_DECREF(set_iterator);
-                Py_DECREF(supported); Py_DECREF(iterator); Py_DECREF(patients_intersection_reversal_arguments);
-                return NULL;
-            }
-            Py_DECREF(supported);
-        }
-        Py_DECREF(patients_intersection_reversal_arguments);
-        Py_DECREF(iterator);
-        
-        // Decref arg
         Py_DECREF(arg);
     }
-    Py_DECREF(set_iterator);
-
-    // Remove the attack/support relations that are not in Args*xArgs*
-    PyObject *self_union_other_arguments = PySet_Union(self->arguments, other->arguments);
-    if (self_union_other_arguments == NULL) {
-        Py_DECREF(reversal);
-        return NULL;
-    }
-    PyObject *self_union_other_difference_reversal_arguments = PySet_Difference(self_union_other_arguments, reversal->arguments);
-    Py_DECREF(self_union_other_arguments);
-    if (self_union_other_difference_reversal_arguments == NULL) {
+    Py_DECREF(iterator);
+    if (PyErr_Occurred()) {
         Py_DECREF(reversal);
         return NULL;
     }
-    if (_QBAFARelations_remove_arguments((QBAFARelationsObject*)reversal->attack_relations, self_union_other_difference_reversal_arguments) < 0) {
-        Py_DECREF(reversal); Py_DECREF(self_union_other_difference_reversal_arguments);
-        return NULL;
-    }
-    if (_QBAFARelations_remove_arguments((QBAFARelationsObject*)reversal->support_relations, self_union_other_difference_reversal_arguments) < 0) {
-        Py_DECREF(reversal); Py_DECREF(self_union_other_difference_reversal_arguments);
-        return NULL;
-    }
-    Py_DECREF(self_union_other_difference_reversal_arguments);
 
-    // Modify initial strengths
-    if (reversal->initial_strengths == NULL) { // It should be an empty PyDict
-        return NULL;
-    }
-    iterator = PyObject_GetIter(reversal->arguments);
-    if (iterator == NULL) {
-        Py_DECREF(reversal);
-        return NULL;
-    }
-    PyObject *other_arguments_intersection_set = PySet_Intersection(other->arguments, set);
-    if (other_arguments_intersection_set == NULL) {
-        Py_DECREF(reversal); Py_DECREF(iterator);
-        return NULL;
+    if (added > 0 && reversal->acyclic == TRUE) {     // The order is not maintained for many relations at once
+        reversal->acyclic = -1;
     }
-    PyObject *initial_strength;
-    while ((arg = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        int contains = PySet_Contains(other_arguments_intersection_set, arg);
-        if (contains < 0) {
-            Py_DECREF(reversal); Py_DECREF(iterator);
-            Py_DECREF(arg); Py_DECREF(other_arguments_intersection_set);
-            return NULL;
-        }
-        if (contains) {
-            initial_strength = PyDict_GetItem(other->initial_strengths, arg);
-        } else {
-            initial_strength = PyDict_GetItem(self->initial_strengths, arg);
-        }
-        if (initial_strength == NULL) {
-            Py_DECREF(reversal); Py_DECREF(iterator);
-            Py_DECREF(arg); Py_DECREF(other_arguments_intersection_set);
-            return NULL;
-        }
-        if (PyDict_SetItem(reversal->initial_strengths, arg, initial_strength) < 0) {
-            Py_DECREF(reversal); Py_DECREF(iterator);
-            Py_DECREF(arg); Py_DECREF(other_arguments_intersection_set);
-            return NULL;
-        }
-
-        Py_DECREF(arg);
+    if (removed > 0 && reversal->acyclic == FALSE) {  // The cycles may have been broken
+        reversal->acyclic = -1;
     }
-    Py_DECREF(iterator);
-    Py_DECREF(other_arguments_intersection_set);
-
-    // Remove calculated final strengths
-    Py_CLEAR(reversal->final_strengths);
-    reversal->final_strengths = PyDict_New();
-    reversal->modified = TRUE;
+    _QBAFramework_structure_modified(reversal);
 
     // Return
     return (PyObject*) reversal;
@@ -2860,7 +5961,12 @@ _QBAFramework_isSSIExplanation(QBAFrameworkObject *self, QBAFrameworkObject *oth
         return -1;
     }
 
-    if (!_QBAFramework_isacyclic((QBAFrameworkObject *)reversal)) {
+    int isacyclic = _QBAFramework_isacyclic((QBAFrameworkObject *)reversal);
+    if (isacyclic < 0) {
+        Py_DECREF(reversal);
+        return -1;
+    }
+    if (!isacyclic) {
         PyErr_WarnEx(PyExc_Warning, "Acyclic reversal of a QBAF was found when checking if it was a SSI Explanation. "
                                     "False was returned instead.", 1);
         Py_DECREF(reversal);
@@ -2895,7 +6001,12 @@ _QBAFramework_isCSIExplanation(QBAFrameworkObject *self, QBAFrameworkObject *oth
         return -1;
     }
 
-    if (!_QBAFramework_isacyclic((QBAFrameworkObject *)reversal)) {
+    int isacyclic = _QBAFramework_isacyclic((QBAFrameworkObject *)reversal);
+    if (isacyclic < 0) {
+        Py_DECREF(reversal);
+        return -1;
+    }
+    if (!isacyclic) {
         PyErr_WarnEx(PyExc_Warning, "Acyclic reversal of a QBAF was found when checking if it was a CSI Explanation. "
                                     "False was returned instead.", 1);
         Py_DECREF(reversal);
@@ -3286,139 +6397,28 @@ QBAFramework_isNSIExplanation(QBAFrameworkObject *self, PyObject *args, PyObject
     contains = PySet_Contains(self_arguments_intersection_other_arguments, arg2);
     if (contains < 0) {
         Py_DECREF(set); Py_DECREF(self_arguments_intersection_other_arguments);
-        return NULL;
-    }
-    if (!contains) {
-        Py_DECREF(set); Py_DECREF(self_arguments_intersection_other_arguments);
-        PyErr_SetString(PyExc_ValueError, "arg2 must be contained in self.arguments INTERSECTION other.arguments");
-        return NULL;
-    }
-    Py_DECREF(self_arguments_intersection_other_arguments);
-
-    int isNSIExplanation = _QBAFramework_isNSIExplanation(self, (QBAFrameworkObject*)other, set, arg1, arg2);
-    Py_DECREF(set);
-    if (isNSIExplanation < 0) {
-        return NULL;
-    }
-
-    Py_RETURN_BOOL(isNSIExplanation);
-}
-
-/**
- * @brief Return a list with the arguments that are attacking/supporting Argument argument directly or indirectly,
- * NULL if an error has occurred.
- * 
- * @param self an instance of QBAFramework
- * @param argument an instance of QBAFArgument
- * @param not_visited a PySet of QBAFArgument that have not been visited yet (this set is modified in this function)
- * @param visiting a PySet of QBAFArgument that are being visited within this function
- * @return PyObject* a new PyList of QBAFArgument objects 
- */
-static PyObject *
-_QBAFramework_influential_arguments(QBAFrameworkObject *self, PyObject *argument, PyObject *not_visited, PyObject *visiting)
-{
-    int contains = PySet_Contains(visiting, argument);
-    if (contains < 0) {
-        return NULL;
-    }
-    if (contains) { // If argument is being visited, do not visit it again but return it
-        PyObject *list = PyList_New(1);
-        if (list == NULL)
-            return NULL;
-        Py_INCREF(argument);
-        PyList_SET_ITEM(list, 0, argument);
-        return list;
-    }
-
-    if (PySet_Add(visiting, argument) < 0) {    // We add the argument to visiting
-        return NULL;
-    }
-    PyObject *attack_agents, *support_agents;
-    PyObject *agents, *result, *previous_result, *influential_arguments;
-
-    attack_agents = _QBAFARelations_agents((QBAFARelationsObject*)self->attack_relations, argument);
-    if (attack_agents == NULL) {
-        return NULL;
-    }
-    support_agents = _QBAFARelations_agents((QBAFARelationsObject*)self->support_relations, argument);
-    if (support_agents == NULL) {
-        Py_DECREF(attack_agents);
-    }
-
-    agents = PyList_Concat(attack_agents, support_agents);
-    Py_DECREF(attack_agents);
-    Py_DECREF(support_agents);
-    if (agents == NULL) {
-        return NULL;
-    }
-
-    // result = [argument]
-    result = PyList_New(1);
-    if (result == NULL) {
-        Py_DECREF(agents);
-        return NULL;
-    }
-    Py_INCREF(argument);
-    PyList_SET_ITEM(result, 0, argument);
-
-    PyObject *iterator = PyObject_GetIter(agents);
-    PyObject *item;
-
-    if (iterator == NULL) {
-        Py_DECREF(agents);
-        Py_DECREF(result);
-        return NULL;
-    }
-
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        contains = PySet_Contains(not_visited, item);
-        if (contains < 0) {
-            Py_DECREF(agents); Py_DECREF(result);
-            Py_DECREF(iterator); Py_DECREF(item);
-            return NULL;
-        }
-
-        if (contains) {
-            previous_result = result;
-            influential_arguments = _QBAFramework_influential_arguments(self, item, not_visited, visiting);
-            if (influential_arguments == NULL) {
-                Py_DECREF(agents); Py_DECREF(previous_result);
-                Py_DECREF(iterator); Py_DECREF(item);
-                return NULL;
-            }
-
-            result = PyList_Concat(previous_result, influential_arguments);
-            Py_DECREF(previous_result);
-            Py_DECREF(influential_arguments);
-            if (result == NULL) {
-                Py_DECREF(agents);
-                Py_DECREF(iterator); Py_DECREF(item);
-                return NULL;
-            }
-        }
-
-        Py_DECREF(item);
+        return NULL;
     }
-
-    Py_DECREF(iterator);
-    Py_DECREF(agents);
-
-    if (PySet_Discard(not_visited, argument) < 0) { // We remove the argument from not visited
-        Py_DECREF(result);
+    if (!contains) {
+        Py_DECREF(set); Py_DECREF(self_arguments_intersection_other_arguments);
+        PyErr_SetString(PyExc_ValueError, "arg2 must be contained in self.arguments INTERSECTION other.arguments");
         return NULL;
     }
+    Py_DECREF(self_arguments_intersection_other_arguments);
 
-    if (PySet_Discard(visiting, argument) < 0) { // We remove the argument from visiting
-        Py_DECREF(result);
+    int isNSIExplanation = _QBAFramework_isNSIExplanation(self, (QBAFrameworkObject*)other, set, arg1, arg2);
+    Py_DECREF(set);
+    if (isNSIExplanation < 0) {
         return NULL;
     }
 
-    return result;
+    Py_RETURN_BOOL(isNSIExplanation);
 }
 
 /**
  * @brief Return a set with the arguments that are attacking/supporting Argument arg1 or Argument arg2
  * directly or indirectly, NULL if an error has been encountered.
+ * The search reads the snapshots of the attack and support relations.
  * 
  * @param self an instance of QBAFramework
  * @param arg1 an instance of QBAFArgument
@@ -3428,50 +6428,61 @@ _QBAFramework_influential_arguments(QBAFrameworkObject *self, PyObject *argument
 static inline PyObject *
 _QBAFramework_influential_arguments_set(QBAFrameworkObject *self, PyObject *arg1, PyObject *arg2)
 {
-    PyObject *not_visited = PySet_New(self->arguments); // New reference (copy)
-    if (not_visited == NULL) {
-        return NULL;
-    }
-
-    PyObject *visiting = PySet_New(NULL);
-    if (visiting == NULL) {
-        Py_DECREF(not_visited);
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    const QBAFAdjacency *adjacency[2] = {
+        QBAFARelations_Adjacency((QBAFARelationsObject*)self->attack_relations, size),
+        QBAFARelations_Adjacency((QBAFARelationsObject*)self->support_relations, size)
+    };
+    if (adjacency[0] == NULL || adjacency[1] == NULL) {
         return NULL;
     }
 
-    PyObject *influential_arg1 = _QBAFramework_influential_arguments(self, arg1, not_visited, visiting);
-    if (influential_arg1 == NULL) {
-        Py_DECREF(not_visited); Py_DECREF(visiting);
-        return NULL;
-    }
-
-    PyObject *influential_arg2 = _QBAFramework_influential_arguments(self, arg2, not_visited, visiting);
-    if (influential_arg2 == NULL) {
-        Py_DECREF(not_visited); Py_DECREF(visiting);
-        Py_DECREF(influential_arg1);
+    PyObject *set = PySet_New(NULL);
+    char *visited = PyMem_Calloc(size + 1, sizeof(char));
+    Py_ssize_t *queue = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (set == NULL || visited == NULL || queue == NULL) {
+        Py_XDECREF(set); PyMem_Free(visited); PyMem_Free(queue);
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
         return NULL;
     }
 
-    Py_DECREF(not_visited);
-    Py_DECREF(visiting);
-
-    PyObject *influential_arguments = PyList_Concat(influential_arg1, influential_arg2);
-    if (influential_arguments == NULL) {
-        Py_DECREF(influential_arg1); Py_DECREF(influential_arg2);
-        return NULL;
+    // The arguments themselves are influential even if they are not in the Framework
+    Py_ssize_t queue_size = 0;
+    PyObject *arguments[2] = {arg1, arg2};
+    for (int index = 0; index < 2; index++) {
+        Py_ssize_t id = 0;
+        PyObject *pyid = PyDict_GetItemWithError(self->argument_ids, arguments[index]);   // Borrowed reference
+        if ((pyid == NULL && PyErr_Occurred()) || PySet_Add(set, arguments[index]) < 0) {
+            Py_DECREF(set); PyMem_Free(visited); PyMem_Free(queue);
+            return NULL;
+        }
+        if (pyid != NULL && !visited[id = PyLong_AsSsize_t(pyid)]) {
+            visited[id] = TRUE;
+            queue[queue_size++] = id;
+        }
     }
 
-    Py_DECREF(influential_arg1);
-    Py_DECREF(influential_arg2);
-
-    PyObject *set = PySet_New(influential_arguments);
-    if (set == NULL) {
-        Py_DECREF(influential_arguments);
-        return NULL;
+    for (Py_ssize_t position = 0; position < queue_size; position++) {
+        Py_ssize_t id = queue[position];
+        if (PySet_Add(set, PyList_GET_ITEM(self->id_arguments, id)) < 0) {
+            Py_DECREF(set); PyMem_Free(visited); PyMem_Free(queue);
+            return NULL;
+        }
+        for (int kind = 0; kind < 2; kind++) {
+            for (Py_ssize_t edge = adjacency[kind]->agent_offsets[id]; edge < adjacency[kind]->agent_offsets[id + 1]; edge++) {
+                Py_ssize_t agent = adjacency[kind]->agents[edge];
+                if (!visited[agent]) {
+                    visited[agent] = TRUE;
+                    queue[queue_size++] = agent;
+                }
+            }
+        }
     }
 
-    Py_DECREF(influential_arguments);
-
+    PyMem_Free(visited);
+    PyMem_Free(queue);
     return set;
 }
 
@@ -3502,16 +6513,12 @@ _QBAFramework_candidate_argument(QBAFrameworkObject *self, QBAFrameworkObject *o
     }
 
     // if self.initial_strengths[argument] != other.initial_strengths[argument]: return True
-    PyObject *self_initial = PyDict_GetItemWithError(self->initial_strengths, argument); // Borrowed reference
-    if (self_initial == NULL)
+    double self_initial, other_initial;
+    if (_QBAFramework_initial_strength_of(self, argument, &self_initial) <= 0)
         return -1;
-    PyObject *other_initial = PyDict_GetItemWithError(other->initial_strengths, argument); // Borrowed reference
-    if (other_initial == NULL)
+    if (_QBAFramework_initial_strength_of(other, argument, &other_initial) <= 0)
         return -1;
-    int equals = PyObject_RichCompareBool(self_initial, other_initial, Py_EQ);
-    if (equals < 0)
-        return -1;
-    if (!equals) {
+    if (self_initial != other_initial) {
         return TRUE;
     }
 
@@ -4149,25 +7156,13 @@ _QBAFramework_change_info(QBAFrameworkObject *self, QBAFrameworkObject *other, P
 
         // Update modified_strength_arguments, added_arguments and removed_arguments
         if (self_contains_argument && other_contains_argument) {
-            PyObject *self_initial_strength = PyDict_GetItem(self->initial_strengths, argument);
-            if (self_initial_strength == NULL) {
-                Py_DECREF(tuple); Py_DECREF(iterator);
-                return NULL;
-            }
-            PyObject *other_initial_strength = PyDict_GetItem(other->initial_strengths, argument);
-            if (other_initial_strength == NULL) {
-                Py_DECREF(tuple); Py_DECREF(iterator);
-                Py_DECREF(self_initial_strength);
-                return NULL;
-            }
-            int equal_strength = PyObject_RichCompareBool(self_initial_strength, other_initial_strength, Py_EQ);
-            Py_DECREF(self_initial_strength);
-            Py_DECREF(other_initial_strength);
-            if (equal_strength < 0) {
+            double self_initial_strength, other_initial_strength;
+            if (_QBAFramework_initial_strength_of(self, argument, &self_initial_strength) <= 0 ||
+                _QBAFramework_initial_strength_of(other, argument, &other_initial_strength) <= 0) {
                 Py_DECREF(tuple); Py_DECREF(iterator);
                 return NULL;
             }
-            if (!equal_strength) {
+            if (self_initial_strength != other_initial_strength) {
                 if (PyList_Append(modified_strength_arguments, argument) < 0) {
                     Py_DECREF(tuple); Py_DECREF(iterator);
                     return NULL;
@@ -4186,20 +7181,24 @@ _QBAFramework_change_info(QBAFrameworkObject *self, QBAFrameworkObject *other, P
         }
         
         // Update added_attack_relations and removed_attack_relations
-        PyObject *self_attacked = _QBAFARelations_patients_set((QBAFARelationsObject*)self->attack_relations, argument); // Borrowed reference
+        PyObject *self_attacked = _QBAFARelations_patients_set((QBAFARelationsObject*)self->attack_relations, argument); // New reference
         if (self_attacked == NULL) {
             Py_DECREF(tuple); Py_DECREF(iterator);
             return NULL;
         }
-        PyObject *other_attacked = _QBAFARelations_patients_set((QBAFARelationsObject*)other->attack_relations, argument); // Borrowed reference
+        PyObject *other_attacked = _QBAFARelations_patients_set((QBAFARelationsObject*)other->attack_relations, argument); // New reference
         if (other_attacked == NULL) {
-            Py_DECREF(tuple); Py_DECREF(iterator);
+            Py_DECREF(tuple); Py_DECREF(iterator); Py_DECREF(self_attacked);
             return NULL;
         }
         
         PyObject *added_attacked_arguments = PySet_Difference(self_attacked, other_attacked);
-        if (added_attacked_arguments == NULL) {
+        PyObject *removed_attacked_arguments = PySet_Difference(other_attacked, self_attacked);
+        Py_DECREF(self_attacked);
+        Py_DECREF(other_attacked);
+        if (added_attacked_arguments == NULL || removed_attacked_arguments == NULL) {
             Py_DECREF(tuple); Py_DECREF(iterator);
+            Py_XDECREF(added_attacked_arguments); Py_XDECREF(removed_attacked_arguments);
             return NULL;
         }
 
@@ -4234,12 +7233,6 @@ _QBAFramework_change_info(QBAFrameworkObject *self, QBAFrameworkObject *other, P
         Py_DECREF(attacked_iterator);
         Py_DECREF(added_attacked_arguments);
 
-        PyObject *removed_attacked_arguments = PySet_Difference(other_attacked, self_attacked);
-        if (removed_attacked_arguments == NULL) {
-            Py_DECREF(tuple); Py_DECREF(iterator);
-            return NULL;
-        }
-
         attacked_iterator = PyObject_GetIter(removed_attacked_arguments);
 
         if (attacked_iterator == NULL) {
@@ -4271,20 +7264,24 @@ _QBAFramework_change_info(QBAFrameworkObject *self, QBAFrameworkObject *other, P
         Py_DECREF(removed_attacked_arguments);
         
         // Update added_support_relations and removed_support_relations
-        PyObject *self_supported = _QBAFARelations_patients_set((QBAFARelationsObject*)self->support_relations, argument); // Borrowed reference
+        PyObject *self_supported = _QBAFARelations_patients_set((QBAFARelationsObject*)self->support_relations, argument); // New reference
         if (self_supported == NULL) {
             Py_DECREF(tuple); Py_DECREF(iterator);
             return NULL;
         }
-        PyObject *other_supported = _QBAFARelations_patients_set((QBAFARelationsObject*)other->support_relations, argument); // Borrowed reference
+        PyObject *other_supported = _QBAFARelations_patients_set((QBAFARelationsObject*)other->support_relations, argument); // New reference
         if (other_supported == NULL) {
-            Py_DECREF(tuple); Py_DECREF(iterator);
+            Py_DECREF(tuple); Py_DECREF(iterator); Py_DECREF(self_supported);
             return NULL;
         }
         
         PyObject *added_supported_arguments = PySet_Difference(self_supported, other_supported);
-        if (added_supported_arguments == NULL) {
+        PyObject *removed_supported_arguments = PySet_Difference(other_supported, self_supported);
+        Py_DECREF(self_supported);
+        Py_DECREF(other_supported);
+        if (added_supported_arguments == NULL || removed_supported_arguments == NULL) {
             Py_DECREF(tuple); Py_DECREF(iterator);
+            Py_XDECREF(added_supported_arguments); Py_XDECREF(removed_supported_arguments);
             return NULL;
         }
 
@@ -4319,12 +7316,6 @@ _QBAFramework_change_info(QBAFrameworkObject *self, QBAFrameworkObject *other, P
         Py_DECREF(supported_iterator);
         Py_DECREF(added_supported_arguments);
 
-        PyObject *removed_supported_arguments = PySet_Difference(other_supported, self_supported);
-        if (removed_supported_arguments == NULL) {
-            Py_DECREF(tuple); Py_DECREF(iterator);
-            return NULL;
-        }
-
         supported_iterator = PyObject_GetIter(removed_supported_arguments);
 
         if (supported_iterator == NULL) {
@@ -4461,11 +7452,17 @@ QBAFramework_richcompare(QBAFrameworkObject *self, PyObject *other, int op)
     if (!equals)
         Py_RETURN_BOOL(op != Py_EQ);
 
-    equals = PyObject_RichCompareBool(self->initial_strengths, ((QBAFrameworkObject *)other)->initial_strengths, Py_EQ);
-    if (equals < 0)
-        return NULL;
-    if (!equals)
-        Py_RETURN_BOOL(op != Py_EQ);
+    // Both frameworks have the same arguments, so compare the initial strengths id by id
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    for (Py_ssize_t id = 0; id < size; id++) {
+        double other_initial_strength;
+        equals = _QBAFramework_initial_strength_of((QBAFrameworkObject *)other, PyList_GET_ITEM(self->id_arguments, id),
+                                                   &other_initial_strength);
+        if (equals < 0)
+            return NULL;
+        if (!equals || self->initial_strengths[id] != other_initial_strength)
+            Py_RETURN_BOOL(op != Py_EQ);
+    }
 
     equals = PyObject_RichCompareBool(self->attack_relations, ((QBAFrameworkObject *)other)->attack_relations, Py_EQ);
     if (equals < 0)
@@ -4583,6 +7580,77 @@ PyDoc_STRVAR(convergence_threshold_doc,
 "Type: float\n"
 );
 
+PyDoc_STRVAR(compress_doc,
+"True if arguments with the same initial strength whose attackers and supporters are strength-equivalent\n"
+"are merged before calculating the final strengths, so every class of equivalent arguments is evaluated once.\n"
+"The ratio between the number of arguments and the number of classes is reported as compression_ratio\n"
+"in last_solve_info. It pays off on generated frameworks with many interchangeable arguments.\n"
+"\n"
+"Getter: Return whether strength-equivalent arguments are merged.\n"
+"\n"
+"Setter: Set whether strength-equivalent arguments are merged.\n"
+"\n"
+"Type: bool\n"
+);
+
+PyDoc_STRVAR(incremental_tolerance_doc,
+"The smallest change of a final strength that is propagated when initial strengths are updated incrementally.\n"
+"Smaller changes are not propagated to the attacked and supported arguments, so their final strengths may be\n"
+"slightly stale; the worst-case error is accumulated in staleness_bound. 0 propagates every change.\n"
+"\n"
+"Getter: Return the incremental tolerance.\n"
+"\n"
+"Setter: Set the incremental tolerance, it must be greater than or equal to 0.\n"
+"\n"
+"Type: float\n"
+);
+
+PyDoc_STRVAR(staleness_bound_doc,
+"An upper bound of the error of any final strength caused by the changes that were not propagated\n"
+"because of incremental_tolerance. It assumes a semantics that does not amplify changes, which holds\n"
+"for the basic model and for the other semantics while the initial strengths are within [0, 1];\n"
+"otherwise it is inf. It is reset to 0 when every final strength is calculated again (e.g. by refresh()).\n"
+"\n"
+"Getter: Return the staleness bound.\n"
+"\n"
+"Type: float\n"
+);
+
+PyDoc_STRVAR(reject_cycles_doc,
+"True if adding an attack or support relation that would create a cycle raises a ValueError (and the relation\n"
+"is not added) when allow_cycles is False, instead of failing when the final strengths are calculated.\n"
+"The order of the arguments is maintained incrementally, so only the arguments between the two arguments\n"
+"of the new relation in that order are visited.\n"
+"\n"
+"Getter: Return whether relations that create a cycle are rejected.\n"
+"\n"
+"Setter: Set whether relations that create a cycle are rejected, the relations must be acyclic to set it to True.\n"
+"\n"
+"Type: bool\n"
+);
+
+PyDoc_STRVAR(last_solve_info_doc,
+"The telemetry of the last calculation of the final strengths, None if they have not been calculated yet.\n"
+"It contains the keys: update_scheme ('topological', 'jacobi' or 'incremental'), converged, iterations, max_iterations,\n"
+"convergence_threshold, final_residual, residuals (the maximum change of a strength per iteration, sampled every\n"
+"residual_stride iterations), residual_stride, largest_residuals (the arguments with the largest change\n"
+"in the last iteration as (argument, residual) tuples), wall_time (in seconds) and recalculated_arguments\n"
+"(the number of arguments whose final strength was calculated, only those affected by the modifications).\n"
+"If compress is True it also contains compression_ratio (the number of arguments per class of equivalent arguments).\n"
+"\n"
+"Getter: Return a copy of the telemetry of the last solve.\n"
+"\n"
+"Type: dict or None\n"
+);
+
+PyDoc_STRVAR(frozen_doc,
+"True if the framework was returned by freeze(). A frozen framework cannot be modified and is hashable.\n"
+"\n"
+"Getter: Return whether the framework is frozen.\n"
+"\n"
+"Type: bool\n"
+);
+
 /**
  * @brief A list with the setters and getters of the class QBAFramework
  * 
@@ -4612,6 +7680,18 @@ static PyGetSetDef QBAFramework_getsetters[] = {
      max_iterations_doc, NULL},
     {"convergence_threshold", (getter) QBAFramework_getconvergence_threshold, NULL,
      convergence_threshold_doc, NULL},
+    {"compress", (getter) QBAFramework_getcompress, (setter) QBAFramework_setcompress,
+     compress_doc, NULL},
+    {"incremental_tolerance", (getter) QBAFramework_getincremental_tolerance, (setter) QBAFramework_setincremental_tolerance,
+     incremental_tolerance_doc, NULL},
+    {"staleness_bound", (getter) QBAFramework_getstaleness_bound, NULL,
+     staleness_bound_doc, NULL},
+    {"reject_cycles", (getter) QBAFramework_getreject_cycles, (setter) QBAFramework_setreject_cycles,
+     reject_cycles_doc, NULL},
+    {"last_solve_info", (getter) QBAFramework_getlast_solve_info, NULL,
+     last_solve_info_doc, NULL},
+    {"frozen", (getter) QBAFramework_getfrozen, NULL,
+     frozen_doc, NULL},
     {NULL}  /* Sentinel */
 };
 
@@ -4640,18 +7720,29 @@ PyDoc_STRVAR(initial_strength_doc,
 );
 
 PyDoc_STRVAR(final_strength_doc,
-"final_strength(self, argument)\n"
+"final_strength(self, argument, max_depth=None)\n"
 "--\n"
 "\n"
 "Return the final strength of the argument.\n"
 "If the framework has been modified from the last time the final strengths were calculated\n"
 "they are calculated again. Otherwise, it returns the already calculated final strength.\n"
 "\n"
+"With max_depth, if the final strengths would have to be calculated, only the arguments from which\n"
+"the argument is reached through at most max_depth attack and support relations are evaluated.\n"
+"The final strengths of the arguments beyond them are only known to be within the range of the semantics,\n"
+"so the result is the interval (lower, upper) that contains the final strength, or a float if it is exact.\n"
+"\n"
 "Args:\n"
 "    argument (QBAFARelations): the argument\n"
+"    max_depth (int): the depth of the evaluated arguments, None to calculate the final strengths\n"
 "\n"
 "Returns:\n"
 "    float: the initial strength\n"
+"    tuple: the bounds (lower, upper) of the final strength if max_depth is given and they are not equal\n"
+"\n"
+"Raises:\n"
+"    NotImplementedError: if max_depth is given and the semantics is not one of the built-in semantics\n"
+"    ValueError: if max_depth is given, the semantics is not the basic model and an initial strength is not within [0, 1]\n"
 );
 
 PyDoc_STRVAR(add_argument_doc,
@@ -4820,6 +7911,175 @@ PyDoc_STRVAR(supportersOf_doc,
 "    list: the arguments that are supporting\n"
 );
 
+PyDoc_STRVAR(attacked_view_doc,
+"attacked_view(self, attacker)\n"
+"--\n"
+"\n"
+"Return a read-only view of the arguments that are being attacked by the argument attacker,\n"
+"without copying them. The view cannot be used after the relations are modified.\n"
+"\n"
+"Args:\n"
+"    attacker (QBAFArgument): the argument that is attacking\n"
+"\n"
+"Returns:\n"
+"    QBAFARelationsView: a sequence with the arguments, in the order their relations were added\n"
+);
+
+PyDoc_STRVAR(attackers_view_doc,
+"attackers_view(self, attacked)\n"
+"--\n"
+"\n"
+"Return a read-only view of the arguments that are attacking the argument attacked,\n"
+"without copying them. The view cannot be used after the relations are modified.\n"
+"\n"
+"Args:\n"
+"    attacked (QBAFArgument): the argument that is being attacked\n"
+"\n"
+"Returns:\n"
+"    QBAFARelationsView: a sequence with the arguments, in the order their relations were added\n"
+);
+
+PyDoc_STRVAR(supported_view_doc,
+"supported_view(self, supporter)\n"
+"--\n"
+"\n"
+"Return a read-only view of the arguments that are being supported by the argument supporter,\n"
+"without copying them. The view cannot be used after the relations are modified.\n"
+"\n"
+"Args:\n"
+"    supporter (QBAFArgument): the argument that is supporting\n"
+"\n"
+"Returns:\n"
+"    QBAFARelationsView: a sequence with the arguments, in the order their relations were added\n"
+);
+
+PyDoc_STRVAR(supporters_view_doc,
+"supporters_view(self, supported)\n"
+"--\n"
+"\n"
+"Return a read-only view of the arguments that are supporting the argument supported,\n"
+"without copying them. The view cannot be used after the relations are modified.\n"
+"\n"
+"Args:\n"
+"    supported (QBAFArgument): the argument that is being supported\n"
+"\n"
+"Returns:\n"
+"    QBAFARelationsView: a sequence with the arguments, in the order their relations were added\n"
+);
+
+PyDoc_STRVAR(in_degree_doc,
+"in_degree(self, argument, relation=None)\n"
+"--\n"
+"\n"
+"Return the number of attackers and supporters of the argument, without creating any list.\n"
+"\n"
+"Args:\n"
+"    argument (QBAFArgument): the argument\n"
+"    relation (str, optional): 'attack' to count only the attackers, 'support' to count only the supporters,\n"
+"        None to count both. Defaults to None\n"
+"\n"
+"Returns:\n"
+"    int: the number of attackers and/or supporters\n"
+);
+
+PyDoc_STRVAR(out_degree_doc,
+"out_degree(self, argument, relation=None)\n"
+"--\n"
+"\n"
+"Return the number of arguments attacked and supported by the argument, without creating any list.\n"
+"\n"
+"Args:\n"
+"    argument (QBAFArgument): the argument\n"
+"    relation (str, optional): 'attack' to count only the arguments attacked, 'support' to count only\n"
+"        the arguments supported, None to count both. Defaults to None\n"
+"\n"
+"Returns:\n"
+"    int: the number of arguments attacked and/or supported\n"
+);
+
+PyDoc_STRVAR(add_arguments_doc,
+"add_arguments(self, arguments, initial_strengths=None)\n"
+"--\n"
+"\n"
+"Add several arguments to the framework at once. The arguments that already exist are ignored.\n"
+"\n"
+"Args:\n"
+"    arguments (list): the arguments\n"
+"    initial_strengths (buffer | sequence, optional): the initial strength of every argument, as an object supporting\n"
+"        the buffer protocol with format 'd' or a sequence of numbers. Defaults to 0.0 for every argument\n"
+);
+
+PyDoc_STRVAR(modify_initial_strengths_doc,
+"modify_initial_strengths(self, arguments, initial_strengths)\n"
+"--\n"
+"\n"
+"Modify the initial strengths of several arguments at once.\n"
+"\n"
+"Args:\n"
+"    arguments (list): the arguments\n"
+"    initial_strengths (buffer | sequence): the new initial strength of every argument, as an object supporting\n"
+"        the buffer protocol with format 'd' or a sequence of numbers\n"
+);
+
+PyDoc_STRVAR(add_relations_doc,
+"add_relations(self, attacks=None, supports=None)\n"
+"--\n"
+"\n"
+"Add several attack and support relations to the framework at once.\n"
+"\n"
+"Args:\n"
+"    attacks (iterable, optional): tuples (attacker, attacked)\n"
+"    supports (iterable, optional): tuples (supporter, supported)\n"
+);
+
+PyDoc_STRVAR(remove_relations_doc,
+"remove_relations(self, attacks=None, supports=None)\n"
+"--\n"
+"\n"
+"Remove several attack and support relations from the framework at once. The relations that do not exist are ignored.\n"
+"\n"
+"Args:\n"
+"    attacks (iterable, optional): tuples (attacker, attacked)\n"
+"    supports (iterable, optional): tuples (supporter, supported)\n"
+);
+
+PyDoc_STRVAR(apply_changes_doc,
+"apply_changes(self, changeset)\n"
+"--\n"
+"\n"
+"Apply several changes at once. They are all validated first: if any of them is not valid an exception is raised\n"
+"and the framework is not modified. The relations are removed first, then the arguments and the relations are added\n"
+"and finally the initial strengths are modified. The framework is invalidated once for all of them.\n"
+"\n"
+"Args:\n"
+"    changeset (dict): with any of the keys 'add_arguments' and 'modify_initial_strengths'\n"
+"        (dicts argument: initial_strength), and 'remove_attacks', 'remove_supports', 'add_attacks'\n"
+"        and 'add_supports' (iterables of tuples (agent, patient))\n"
+);
+
+PyDoc_STRVAR(from_arrays_doc,
+"from_arrays(names, initial_strengths, attack_src, attack_dst, support_src, support_dst, **settings)\n"
+"--\n"
+"\n"
+"Create a QBAFramework from arrays, without creating a tuple for every relation.\n"
+"The relations are given as positions in names: (names[attack_src[i]], names[attack_dst[i]]) is an attack relation,\n"
+"and likewise for the support relations.\n"
+"\n"
+"Args:\n"
+"    names (list): the arguments, they must not be repeated\n"
+"    initial_strengths (buffer | sequence): the initial strength of every argument, as an object supporting\n"
+"        the buffer protocol with format 'd' (e.g. array.array('d'), numpy.float64 arrays) or a sequence of numbers\n"
+"    attack_src (buffer | sequence): the positions of the attackers, as an object supporting the buffer protocol\n"
+"        with an integer format (e.g. array.array('q'), numpy.int64 arrays) or a sequence of ints\n"
+"    attack_dst (buffer | sequence): the positions of the attacked arguments\n"
+"    support_src (buffer | sequence): the positions of the supporters\n"
+"    support_dst (buffer | sequence): the positions of the supported arguments\n"
+"    **settings: the keyword arguments of the constructor (e.g. semantics, allow_cycles)\n"
+"\n"
+"Returns:\n"
+"    QBAFramework: the new framework\n"
+);
+
 PyDoc_STRVAR(__copy___doc,
 "__copy__(self, /)\n"
 "--\n"
@@ -4834,6 +8094,119 @@ PyDoc_STRVAR(copy_doc,
 "Return a shallow copy of self.\n"
 );
 
+PyDoc_STRVAR(freeze_doc,
+"freeze(self)\n"
+"--\n"
+"\n"
+"Return an immutable copy of self, or self if it is already frozen.\n"
+"The methods that modify a frozen framework raise a TypeError, its final strengths are calculated\n"
+"at most once, even if they are requested from several threads, and it is hashable:\n"
+"equal frozen frameworks have the same hash. A copy of a frozen framework is not frozen.\n"
+"\n"
+"Returns:\n"
+"    QBAFramework: a frozen framework equal to self\n"
+);
+
+PyDoc_STRVAR(compile_doc,
+"compile(self, ordering='natural')\n"
+"--\n"
+"\n"
+"Return an immutable QBAFPlan with the current arguments, relations and semantics of the framework.\n"
+"The plan can be evaluated many times with different initial strengths without hashing any argument,\n"
+"and it is not affected by later modifications of the framework.\n"
+"\n"
+"Args:\n"
+"    ordering (str, optional): The order of the arguments in the plan. 'natural' keeps the order of the framework,\n"
+"        'rcm' (reverse Cuthill-McKee) and 'topological' (by topological level, only for acyclic frameworks)\n"
+"        place the attackers and supporters of every argument closer to it, which improves memory locality\n"
+"        on large frameworks. See the attributes bandwidth and mean_dependency_distance of the plan.\n"
+"\n"
+"Returns:\n"
+"    QBAFPlan: the evaluation plan of the framework\n"
+);
+
+PyDoc_STRVAR(explain_plan_doc,
+"explain_plan(self)\n"
+"--\n"
+"\n"
+"Return how the final strengths are going to be calculated the next time they are needed, chosen from cheap\n"
+"statistics of the structure of the framework: its size, acyclicity, components, topological levels, cycles,\n"
+"maximum number of attackers plus supporters and semantics.\n"
+"\n"
+"Returns:\n"
+"    dict: the keys update_scheme ('topological', 'jacobi', 'incremental' or None if it cannot be calculated),\n"
+"    kernel, semantics (None if custom), native (True if it runs without python functions), compress,\n"
+"    stale_components and stale_arguments (what has to be evaluated), processors, threads (that evaluate\n"
+"    independent components), hub_threads (that aggregate the argument with most attackers and supporters),\n"
+"    statistics (a dict with arguments, relations, max_in_degree, components, largest_component, levels,\n"
+"    max_level_width, cycles, largest_cycle and arguments_in_cycles) and rationale (a list of str with the reasons)\n"
+);
+
+PyDoc_STRVAR(connected_components_doc,
+"connected_components(self)\n"
+"--\n"
+"\n"
+"Return the weakly connected components of the framework: two arguments are in the same component\n"
+"if they are connected by attack or support relations, regardless of their direction.\n"
+"The final strengths of a component do not depend on the other components, so when the framework is modified\n"
+"only the components of the modified arguments and relations are calculated again.\n"
+"\n"
+"Returns:\n"
+"    list: a list of sets of QBAFArgument, ordered by the first argument of each component in the framework\n"
+);
+
+PyDoc_STRVAR(refresh_doc,
+"refresh(self)\n"
+"--\n"
+"\n"
+"Calculate again the final strengths of every argument, including the changes that were not propagated\n"
+"because they were smaller than incremental_tolerance, and reset staleness_bound to 0.\n"
+"\n"
+"Raises:\n"
+"    NotImplementedError: if the framework is cyclic and allow_cycles is False\n"
+);
+
+PyDoc_STRVAR(evaluate_expansion_doc,
+"evaluate_expansion(self, base)\n"
+"--\n"
+"\n"
+"Calculate the final strengths of the framework, a normal expansion of base (it contains every argument and relation\n"
+"of base, and the arguments of base keep their initial strengths), reusing the final strengths of base.\n"
+"Only the arguments reached from the new arguments and relations are evaluated; the rest keep the final strength\n"
+"they have in base. recalculated_arguments in last_solve_info tells how many arguments were evaluated.\n"
+"A frozen framework whose final strengths have already been calculated keeps them.\n"
+"\n"
+"Args:\n"
+"    base (QBAFramework): the framework that was expanded, with the same semantics and convergence settings\n"
+"\n"
+"Raises:\n"
+"    TypeError: if base is not a QBAFramework\n"
+"    ValueError: if the framework is not a normal expansion of base or they have different settings\n"
+"    NotImplementedError: if the framework is cyclic and allow_cycles is False\n"
+);
+
+PyDoc_STRVAR(final_strengths_by_semantics_doc,
+"final_strengths_by_semantics(self, semantics)\n"
+"--\n"
+"\n"
+"Return the final strengths of the framework under each of the given semantics.\n"
+"All the semantics are evaluated in a single traversal of the framework, sharing the gathering\n"
+"of the strengths of the attackers and supporters of every argument.\n"
+"It uses the allow_cycles, max_iterations and convergence_threshold of the framework.\n"
+"\n"
+"Args:\n"
+"    semantics (list of str): The names of the semantics\n"
+"\n"
+"Returns:\n"
+"    dict: a dictionary (semantics: str, final_strengths: dict) with the final strengths\n"
+"    (argument: QBAFArgument, final_strength: float) under every semantics\n"
+"\n"
+"Raises:\n"
+"    ValueError: if a semantics does not exist or an initial strength is out of its range\n"
+"    NotImplementedError: if the framework is cyclic and allow_cycles is False\n"
+"    RuntimeError: if the framework is cyclic and a semantics does not converge\n"
+);
+
 PyDoc_STRVAR(isacyclic_doc,
 "isacyclic(self)\n"
 "--\n"
@@ -4852,6 +8225,9 @@ PyDoc_STRVAR(are_strength_consistent_doc,
 "Return True if the argument arg1 and the argument arg2 are strength consistent\n"
 "w.r.t the Framework self and the Framework other.\n"
 "Both arguments must be contained in both Frameworks.\n"
+"If the final strengths of an acyclic Framework would have to be calculated, the bounds given by\n"
+"final_strength(arg, max_depth=3) are compared first, and the final strengths are only calculated\n"
+"if the bounds of arg1 and arg2 overlap.\n"
 "\n"
 "Args:\n"
 "    other (QBAFramework): a Framework\n"
@@ -5008,7 +8384,7 @@ PyDoc_STRVAR(change_info_doc,
  * 
  */
 static PyMethodDef QBAFramework_methods[] = {
-    {"modify_initial_strength", (PyCFunction) QBAFramework_modify_initial_strengths, METH_VARARGS | METH_KEYWORDS,
+    {"modify_initial_strength", (PyCFunction) QBAFramework_modify_initial_strength, METH_VARARGS | METH_KEYWORDS,
     modify_initial_strength_doc
     },
     {"initial_strength", (PyCFunction) QBAFramework_initial_strength, METH_VARARGS | METH_KEYWORDS,
@@ -5035,6 +8411,21 @@ static PyMethodDef QBAFramework_methods[] = {
     {"remove_support_relation", (PyCFunction) QBAFramework_remove_support_relation, METH_VARARGS | METH_KEYWORDS,
     remove_support_relation_doc
     },
+    {"add_arguments", (PyCFunction) QBAFramework_add_arguments, METH_VARARGS | METH_KEYWORDS,
+    add_arguments_doc
+    },
+    {"modify_initial_strengths", (PyCFunction) QBAFramework_modify_initial_strengths, METH_VARARGS | METH_KEYWORDS,
+    modify_initial_strengths_doc
+    },
+    {"add_relations", (PyCFunction) QBAFramework_add_relations, METH_VARARGS | METH_KEYWORDS,
+    add_relations_doc
+    },
+    {"remove_relations", (PyCFunction) QBAFramework_remove_relations, METH_VARARGS | METH_KEYWORDS,
+    remove_relations_doc
+    },
+    {"apply_changes", (PyCFunction) QBAFramework_apply_changes, METH_VARARGS | METH_KEYWORDS,
+    apply_changes_doc
+    },
     {"contains_argument", (PyCFunction) QBAFramework_contains_argument, METH_VARARGS | METH_KEYWORDS,
     contains_argument_doc
     },
@@ -5056,12 +8447,54 @@ static PyMethodDef QBAFramework_methods[] = {
     {"supportersOf", (PyCFunction) QBAFramework_supportersOf, METH_VARARGS | METH_KEYWORDS,
     supportersOf_doc
     },
+    {"attacked_view", (PyCFunction) QBAFramework_attacked_view, METH_VARARGS | METH_KEYWORDS,
+    attacked_view_doc
+    },
+    {"attackers_view", (PyCFunction) QBAFramework_attackers_view, METH_VARARGS | METH_KEYWORDS,
+    attackers_view_doc
+    },
+    {"supported_view", (PyCFunction) QBAFramework_supported_view, METH_VARARGS | METH_KEYWORDS,
+    supported_view_doc
+    },
+    {"supporters_view", (PyCFunction) QBAFramework_supporters_view, METH_VARARGS | METH_KEYWORDS,
+    supporters_view_doc
+    },
+    {"in_degree", (PyCFunction) QBAFramework_in_degree, METH_VARARGS | METH_KEYWORDS,
+    in_degree_doc
+    },
+    {"out_degree", (PyCFunction) QBAFramework_out_degree, METH_VARARGS | METH_KEYWORDS,
+    out_degree_doc
+    },
     {"__copy__", (PyCFunction) QBAFramework_copy, METH_NOARGS,
     __copy___doc
     },
+    {"from_arrays", (PyCFunction) QBAFramework_from_arrays, METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+    from_arrays_doc
+    },
     {"copy", (PyCFunction) QBAFramework_copy, METH_NOARGS,
     copy_doc
     },
+    {"freeze", (PyCFunction) QBAFramework_freeze, METH_NOARGS,
+    freeze_doc
+    },
+    {"compile", (PyCFunction) QBAFramework_compile, METH_VARARGS | METH_KEYWORDS,
+    compile_doc
+    },
+    {"explain_plan", (PyCFunction) QBAFramework_explain_plan, METH_NOARGS,
+    explain_plan_doc
+    },
+    {"connected_components", (PyCFunction) QBAFramework_connected_components, METH_NOARGS,
+    connected_components_doc
+    },
+    {"refresh", (PyCFunction) QBAFramework_refresh, METH_NOARGS,
+    refresh_doc
+    },
+    {"evaluate_expansion", (PyCFunction) QBAFramework_evaluate_expansion, METH_VARARGS | METH_KEYWORDS,
+    evaluate_expansion_doc
+    },
+    {"final_strengths_by_semantics", (PyCFunction) QBAFramework_final_strengths_by_semantics, METH_VARARGS | METH_KEYWORDS,
+    final_strengths_by_semantics_doc
+    },
     {"isacyclic", (PyCFunction) QBAFramework_isacyclic, METH_NOARGS,
     isacyclic_doc
     },
@@ -5119,7 +8552,8 @@ PyDoc_STRVAR(QBAFramework_doc,
 "    disjoint_relations=True, semantics=None,\n"
 "    aggregation_function=None, influence_function=None,\n"
 "    min_strength=-1.7976931348623157e+308, max_strength=1.7976931348623157e+308,\n"
-"    allow_cycles=False, max_iterations=1000, convergence_threshold=1e-09)\n"
+"    allow_cycles=False, max_iterations=1000, convergence_threshold=1e-09, compress=False,\n"
+"    incremental_tolerance=0.0, reject_cycles=False)\n"
 "\n"
 "Args:\n"
 "    arguments (list): a list of QBAFArgument\n"
@@ -5141,6 +8575,11 @@ PyDoc_STRVAR(QBAFramework_doc,
 "    allow_cycles (bool, optional): True if cyclic frameworks should be evaluated by synchronous iteration. Defaults to False.\n"
 "    max_iterations (int, optional): Maximum number of synchronous iterations for cyclic frameworks. Defaults to 1000.\n"
 "    convergence_threshold (float, optional): Convergence threshold for cyclic frameworks. Defaults to 1e-09.\n"
+"    compress (bool, optional): True if strength-equivalent arguments should be evaluated once. Defaults to False.\n"
+"    incremental_tolerance (float, optional): The smallest change of a final strength that is propagated\n"
+"        incrementally when initial strengths are modified. Defaults to 0.0 (every change is propagated).\n"
+"    reject_cycles (bool, optional): True if relations that would create a cycle are rejected when they are added\n"
+"        and allow_cycles is False. Defaults to False.\n"
 );
 
 /**
@@ -5163,6 +8602,7 @@ static PyTypeObject QBAFrameworkType = {
     .tp_methods = QBAFramework_methods,
     .tp_getset = QBAFramework_getsetters,
     .tp_richcompare = (richcmpfunc) QBAFramework_richcompare,   // __eq__, __ne__
+    .tp_hash = (hashfunc) QBAFramework_hash,                    // __hash__
 };
 
 /**
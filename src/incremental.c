@@ -0,0 +1,566 @@
+/**
+ * @file incremental.c
+ * @author Jose Ruiz Alarcon
+ * @brief Incremental propagation of changes through an acyclic QBAFPlan.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <math.h>
+
+#include "incremental.h"
+#include "qbaf_functions.h"
+
+#define TRUE 1
+#define FALSE 0
+
+#define KIND_SUM 0
+#define KIND_PRODUCT 1
+#define KIND_TOP 2
+
+/**
+ * @brief Swap the items i and j of an indexed heap.
+ *
+ * @param heap the heap of relations
+ * @param positions the position of every relation in heap
+ * @param i a position of heap
+ * @param j a position of heap
+ */
+static inline void
+_QBAFHeap_swap(Py_ssize_t *heap, Py_ssize_t *positions, Py_ssize_t i, Py_ssize_t j)
+{
+    Py_ssize_t item = heap[i];
+    heap[i] = heap[j];
+    heap[j] = item;
+    positions[heap[i]] = i;
+    positions[heap[j]] = j;
+}
+
+/**
+ * @brief Move the item in position i of a max-heap of relations up while it is greater than its parent.
+ *
+ * @param heap the heap of relations
+ * @param positions the position of every relation in heap
+ * @param agents the agent id of every relation
+ * @param strengths the final strengths indexed by id
+ * @param i a position of heap
+ */
+static inline void
+_QBAFHeap_sift_up(Py_ssize_t *heap, Py_ssize_t *positions, const Py_ssize_t *agents, const double *strengths, Py_ssize_t i)
+{
+    while (i > 0) {
+        Py_ssize_t parent = (i - 1) / 2;
+        if (strengths[agents[heap[i]]] <= strengths[agents[heap[parent]]]) {
+            break;
+        }
+        _QBAFHeap_swap(heap, positions, i, parent);
+        i = parent;
+    }
+}
+
+/**
+ * @brief Move the item in position i of a max-heap of relations down while it is smaller than a child.
+ *
+ * @param heap the heap of relations
+ * @param positions the position of every relation in heap
+ * @param size the number of items of heap
+ * @param agents the agent id of every relation
+ * @param strengths the final strengths indexed by id
+ * @param i a position of heap
+ */
+static inline void
+_QBAFHeap_sift_down(Py_ssize_t *heap, Py_ssize_t *positions, Py_ssize_t size,
+                    const Py_ssize_t *agents, const double *strengths, Py_ssize_t i)
+{
+    while (TRUE) {
+        Py_ssize_t largest = i;
+        Py_ssize_t left = 2 * i + 1, right = 2 * i + 2;
+        if (left < size && strengths[agents[heap[left]]] > strengths[agents[heap[largest]]]) {
+            largest = left;
+        }
+        if (right < size && strengths[agents[heap[right]]] > strengths[agents[heap[largest]]]) {
+            largest = right;
+        }
+        if (largest == i) {
+            break;
+        }
+        _QBAFHeap_swap(heap, positions, i, largest);
+        i = largest;
+    }
+}
+
+/**
+ * @brief Multiply (or divide) the product value * 2^exponent by factor, keeping value normalized within [0.5, 1).
+ * Scaling by powers of two is exact, so the result rounds like the plain product while it does not underflow.
+ *
+ * @param value the mantissa of the product
+ * @param exponent the exponent of the product
+ * @param factor a finite non-zero factor
+ * @param divide 1 to divide by factor, 0 to multiply
+ */
+static inline void
+_QBAFHub_scale(double *value, long *exponent, double factor, int divide)
+{
+    int shift;
+    *value = frexp(divide ? *value / factor : *value * factor, &shift);
+    *exponent += shift;
+}
+
+/**
+ * @brief Gather the aggregation of the hub again from the current final strengths.
+ * The hub is marked as not valid if its aggregation cannot be maintained.
+ *
+ * @param incremental the state
+ * @param hub the hub
+ * @param final_strengths the final strengths indexed by id
+ */
+static void
+_QBAFHub_rebuild(QBAFIncremental *incremental, QBAFHubAggregate *hub, const double *final_strengths)
+{
+    QBAFPlanObject *plan = incremental->plan;
+    // The attackers of the hub are followed by its supporters in plan->dependencies
+    Py_ssize_t bounds[3] = {plan->dependency_offsets[hub->id], plan->supporter_starts[hub->id], plan->dependency_offsets[hub->id+1]};
+    const Py_ssize_t *dependencies = plan->dependencies;
+    double values[2];
+    long exponents[2] = {0, 0};
+    Py_ssize_t counts[2] = {0, 0};
+
+    hub->valid = TRUE;
+    hub->updates = 0;
+
+    for (int kind = 0; kind < 2; kind++) {
+        // The same order as the aggregation functions, so a rebuilt aggregation is exact
+        values[kind] = incremental->kind == KIND_PRODUCT ? 1.0 : 0.0;
+        for (Py_ssize_t edge = bounds[kind]; edge < bounds[kind+1]; edge++) {
+            double strength = final_strengths[dependencies[edge]];
+            if (strength != strength) {
+                hub->valid = FALSE;
+                return;
+            }
+            if (incremental->kind == KIND_SUM) {
+                values[kind] = values[kind] + strength;
+            }
+            else if (incremental->kind == KIND_PRODUCT) {
+                if (!isfinite(strength)) {
+                    hub->valid = FALSE;
+                    return;
+                }
+                if (1 - strength == 0) {
+                    counts[kind]++;
+                }
+                else {
+                    _QBAFHub_scale(&values[kind], &exponents[kind], 1 - strength, FALSE);
+                }
+            }
+            else if (kind == 0 && (strength > 1 || strength < -1)) {
+                counts[kind]++;
+            }
+        }
+    }
+
+    hub->attack_value = values[0];
+    hub->support_value = values[1];
+    hub->attack_exponent = exponents[0];
+    hub->support_exponent = exponents[1];
+    hub->attack_count = counts[0];
+    hub->support_count = counts[1];
+
+    if (incremental->kind == KIND_TOP) {
+        Py_ssize_t *heaps[2] = {hub->attack_heap, hub->support_heap};
+        Py_ssize_t *positions[2] = {hub->attack_positions, hub->support_positions};
+        for (int kind = 0; kind < 2; kind++) {
+            Py_ssize_t size = bounds[kind+1] - bounds[kind];
+            const Py_ssize_t *hub_agents = dependencies + bounds[kind];
+            for (Py_ssize_t index = 0; index < size; index++) {
+                heaps[kind][index] = index;
+                positions[kind][index] = index;
+            }
+            for (Py_ssize_t index = size / 2 - 1; index >= 0; index--) {
+                _QBAFHeap_sift_down(heaps[kind], positions[kind], size, hub_agents, final_strengths, index);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Update the aggregation of the hub after the final strength of the agent of a relation changed.
+ * final_strengths must already contain the new strength.
+ *
+ * @param incremental the state
+ * @param hub the hub
+ * @param edge the index of the relation in plan->dependencies
+ * @param old_strength the previous final strength of the agent
+ * @param new_strength the new final strength of the agent
+ * @param final_strengths the final strengths indexed by id
+ */
+static void
+_QBAFHub_update(QBAFIncremental *incremental, QBAFHubAggregate *hub, Py_ssize_t edge,
+                double old_strength, double new_strength, const double *final_strengths)
+{
+    if (!hub->valid) {
+        return;
+    }
+    if (old_strength != old_strength || new_strength != new_strength) {
+        hub->valid = FALSE;
+        return;
+    }
+
+    QBAFPlanObject *plan = incremental->plan;
+    int is_attack = edge < plan->supporter_starts[hub->id];
+    Py_ssize_t dependencies = plan->dependency_offsets[hub->id+1] - plan->dependency_offsets[hub->id];
+    double *value = is_attack ? &hub->attack_value : &hub->support_value;
+    Py_ssize_t *count = is_attack ? &hub->attack_count : &hub->support_count;
+
+    if (incremental->kind == KIND_SUM) {
+        // Gather again once the rounding errors of as many updates as relations could have accumulated
+        if (++hub->updates > dependencies || !isfinite(old_strength) || !isfinite(new_strength)) {
+            _QBAFHub_rebuild(incremental, hub, final_strengths);
+            return;
+        }
+        *value = *value - old_strength + new_strength;
+    }
+    else if (incremental->kind == KIND_PRODUCT) {
+        if (++hub->updates > dependencies || !isfinite(old_strength) || !isfinite(new_strength)) {
+            _QBAFHub_rebuild(incremental, hub, final_strengths);
+            return;
+        }
+        long *exponent = is_attack ? &hub->attack_exponent : &hub->support_exponent;
+        double old_factor = 1 - old_strength, new_factor = 1 - new_strength;
+        if (old_factor == 0) {
+            (*count)--;
+        }
+        else {
+            _QBAFHub_scale(value, exponent, old_factor, TRUE);
+        }
+        if (new_factor == 0) {
+            (*count)++;
+        }
+        else {
+            _QBAFHub_scale(value, exponent, new_factor, FALSE);
+        }
+    }
+    else {
+        if (is_attack) {
+            *count += (new_strength > 1 || new_strength < -1) - (old_strength > 1 || old_strength < -1);
+        }
+        Py_ssize_t offset = is_attack ? plan->dependency_offsets[hub->id] : plan->supporter_starts[hub->id];
+        Py_ssize_t local_edge = edge - offset;
+        Py_ssize_t size = (is_attack ? plan->supporter_starts[hub->id] : plan->dependency_offsets[hub->id+1]) - offset;
+        Py_ssize_t *heap = is_attack ? hub->attack_heap : hub->support_heap;
+        Py_ssize_t *positions = is_attack ? hub->attack_positions : hub->support_positions;
+        const Py_ssize_t *agents = plan->dependencies + offset;
+        _QBAFHeap_sift_up(heap, positions, agents, final_strengths, positions[local_edge]);
+        _QBAFHeap_sift_down(heap, positions, size, agents, final_strengths, positions[local_edge]);
+    }
+}
+
+/**
+ * @brief Return the result of the aggregation function of the hub from its maintained aggregation.
+ *
+ * @param incremental the state
+ * @param hub a valid hub
+ * @param final_strengths the final strengths indexed by id
+ * @return double the result of the aggregation function
+ */
+static inline double
+_QBAFHub_aggregation(QBAFIncremental *incremental, QBAFHubAggregate *hub, const double *final_strengths)
+{
+    if (incremental->kind == KIND_SUM) {
+        return hub->support_value - hub->attack_value;
+    }
+
+    if (incremental->kind == KIND_PRODUCT) {
+        double attackers_aggregation = hub->attack_count > 0 ? 0.0 : ldexp(hub->attack_value, hub->attack_exponent);
+        double supporters_aggregation = hub->support_count > 0 ? 0.0 : ldexp(hub->support_value, hub->support_exponent);
+        return attackers_aggregation - supporters_aggregation;
+    }
+
+    if (hub->attack_count > 0) {
+        return -1;  // Like top, when an attacker strength is not within [-1, 1]
+    }
+    QBAFPlanObject *plan = incremental->plan;
+    double attackers_aggregation = 0, supporters_aggregation = 0;
+    if (plan->supporter_starts[hub->id] > plan->dependency_offsets[hub->id]) {
+        double strength = final_strengths[plan->dependencies[plan->dependency_offsets[hub->id] + hub->attack_heap[0]]];
+        attackers_aggregation = strength > 0 ? strength : 0;
+    }
+    if (plan->dependency_offsets[hub->id+1] > plan->supporter_starts[hub->id]) {
+        double strength = final_strengths[plan->dependencies[plan->supporter_starts[hub->id] + hub->support_heap[0]]];
+        supporters_aggregation = strength > 0 ? strength : 0;
+    }
+    return supporters_aggregation - attackers_aggregation;
+}
+
+/**
+ * @brief Push id to the queue of arguments waiting to be recalculated if it is not there yet.
+ *
+ * @param incremental the state
+ * @param id the id of the argument
+ */
+static void
+_QBAFIncremental_push(QBAFIncremental *incremental, Py_ssize_t id)
+{
+    if (incremental->queued[id]) {
+        return;
+    }
+    incremental->queued[id] = TRUE;
+
+    const Py_ssize_t *ranks = incremental->plan->ranks;
+    Py_ssize_t *queue = incremental->queue;
+    Py_ssize_t i = incremental->queue_size++;
+    queue[i] = id;
+    while (i > 0) {
+        Py_ssize_t parent = (i - 1) / 2;
+        if (ranks[queue[parent]] <= ranks[queue[i]]) {
+            break;
+        }
+        Py_ssize_t item = queue[i]; queue[i] = queue[parent]; queue[parent] = item;
+        i = parent;
+    }
+}
+
+/**
+ * @brief Pop the id with the lowest topological rank from the queue of arguments waiting to be recalculated.
+ *
+ * @param incremental the state with a non-empty queue
+ * @return Py_ssize_t the id
+ */
+static Py_ssize_t
+_QBAFIncremental_pop(QBAFIncremental *incremental)
+{
+    const Py_ssize_t *ranks = incremental->plan->ranks;
+    Py_ssize_t *queue = incremental->queue;
+    Py_ssize_t id = queue[0];
+    Py_ssize_t size = --incremental->queue_size;
+    queue[0] = queue[size];
+
+    Py_ssize_t i = 0;
+    while (TRUE) {
+        Py_ssize_t lowest = i;
+        Py_ssize_t left = 2 * i + 1, right = 2 * i + 2;
+        if (left < size && ranks[queue[left]] < ranks[queue[lowest]]) {
+            lowest = left;
+        }
+        if (right < size && ranks[queue[right]] < ranks[queue[lowest]]) {
+            lowest = right;
+        }
+        if (lowest == i) {
+            break;
+        }
+        Py_ssize_t item = queue[i]; queue[i] = queue[lowest]; queue[lowest] = item;
+        i = lowest;
+    }
+
+    incremental->queued[id] = FALSE;
+    return id;
+}
+
+int
+QBAFIncremental_Supports(QBAFPlanObject *plan)
+{
+    if (plan->schedule == NULL || !QBAFPlan_IsNative(plan)) {
+        return FALSE;
+    }
+    QBAFAggregationFunction aggregation_function = plan->settings.aggregation_function;
+    return aggregation_function == sum || aggregation_function == product || aggregation_function == top;
+}
+
+QBAFIncremental *
+QBAFIncremental_Create(QBAFPlanObject *plan, const double *initial_strengths, const double *final_strengths)
+{
+    if (QBAFPlan_EnsureSuccessors(plan) < 0) {
+        return NULL;
+    }
+
+    QBAFIncremental *incremental = PyMem_Calloc(1, sizeof(QBAFIncremental));
+    if (incremental == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    Py_ssize_t size = plan->size;
+    incremental->plan = plan;
+    incremental->kind = plan->settings.aggregation_function == sum ? KIND_SUM :
+                        plan->settings.aggregation_function == product ? KIND_PRODUCT : KIND_TOP;
+    incremental->hub_indices = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    incremental->queued = PyMem_Calloc(size + 1, sizeof(char));
+    incremental->queue = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    incremental->buffer = PyMem_Malloc((plan->max_dependencies + 1) * sizeof(double));
+    incremental->amplification = PyMem_Malloc((size + 1) * sizeof(double));
+    incremental->out_of_range = PyMem_Calloc(size + 1, sizeof(char));
+    if (incremental->hub_indices == NULL || incremental->queued == NULL ||
+        incremental->queue == NULL || incremental->buffer == NULL ||
+        incremental->amplification == NULL || incremental->out_of_range == NULL) {
+        QBAFIncremental_Free(incremental);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    // A change of id reaches another argument through at most amplification[id] paths
+    for (Py_ssize_t index = size - 1; index >= 0; index--) {
+        Py_ssize_t id = plan->schedule[index];
+        double paths = 0.0;
+        for (Py_ssize_t successor = plan->successor_offsets[id]; successor < plan->successor_offsets[id+1]; successor++) {
+            double successor_paths = incremental->amplification[plan->successors[successor]];
+            paths += successor_paths > 1.0 ? successor_paths : 1.0;
+        }
+        incremental->amplification[id] = paths;
+    }
+    for (Py_ssize_t id = 0; id < size; id++) {
+        incremental->out_of_range[id] = !(initial_strengths[id] >= 0.0 && initial_strengths[id] <= 1.0);
+        incremental->out_of_range_size += incremental->out_of_range[id];
+    }
+
+    Py_ssize_t hubs_size = 0;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        Py_ssize_t dependencies = plan->dependency_offsets[id+1] - plan->dependency_offsets[id];
+        incremental->hub_indices[id] = dependencies >= INCREMENTAL_HUB_MIN_DEPENDENCIES ? hubs_size++ : -1;
+    }
+
+    incremental->hubs = PyMem_Calloc(hubs_size + 1, sizeof(QBAFHubAggregate));
+    if (incremental->hubs == NULL) {
+        QBAFIncremental_Free(incremental);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    incremental->hubs_size = hubs_size;
+
+    for (Py_ssize_t id = 0; id < size; id++) {
+        if (incremental->hub_indices[id] < 0) {
+            continue;
+        }
+        QBAFHubAggregate *hub = &incremental->hubs[incremental->hub_indices[id]];
+        hub->id = id;
+        if (incremental->kind == KIND_TOP) {
+            Py_ssize_t attackers_size = plan->supporter_starts[id] - plan->dependency_offsets[id];
+            Py_ssize_t supporters_size = plan->dependency_offsets[id+1] - plan->supporter_starts[id];
+            hub->attack_heap = PyMem_Malloc((attackers_size + 1) * sizeof(Py_ssize_t));
+            hub->attack_positions = PyMem_Malloc((attackers_size + 1) * sizeof(Py_ssize_t));
+            hub->support_heap = PyMem_Malloc((supporters_size + 1) * sizeof(Py_ssize_t));
+            hub->support_positions = PyMem_Malloc((supporters_size + 1) * sizeof(Py_ssize_t));
+            if (hub->attack_heap == NULL || hub->attack_positions == NULL ||
+                hub->support_heap == NULL || hub->support_positions == NULL) {
+                QBAFIncremental_Free(incremental);
+                PyErr_NoMemory();
+                return NULL;
+            }
+        }
+        _QBAFHub_rebuild(incremental, hub, final_strengths);
+    }
+
+    return incremental;
+}
+
+void
+QBAFIncremental_Free(QBAFIncremental *incremental)
+{
+    if (incremental == NULL) {
+        return;
+    }
+    if (incremental->hubs != NULL) {
+        for (Py_ssize_t index = 0; index < incremental->hubs_size; index++) {
+            PyMem_Free(incremental->hubs[index].attack_heap);
+            PyMem_Free(incremental->hubs[index].attack_positions);
+            PyMem_Free(incremental->hubs[index].support_heap);
+            PyMem_Free(incremental->hubs[index].support_positions);
+        }
+    }
+    PyMem_Free(incremental->hubs);
+    PyMem_Free(incremental->hub_indices);
+    PyMem_Free(incremental->queued);
+    PyMem_Free(incremental->queue);
+    PyMem_Free(incremental->buffer);
+    PyMem_Free(incremental->amplification);
+    PyMem_Free(incremental->out_of_range);
+    PyMem_Free(incremental);
+}
+
+void
+QBAFIncremental_MarkChanged(QBAFIncremental *incremental, Py_ssize_t id)
+{
+    _QBAFIncremental_push(incremental, id);
+}
+
+void
+QBAFIncremental_MarkPending(QBAFIncremental *incremental, char *marks)
+{
+    for (Py_ssize_t index = 0; index < incremental->queue_size; index++) {
+        marks[incremental->queue[index]] = 1;
+    }
+}
+
+/**
+ * @brief Return 1 if a change of the final strength of an attacker or supporter is never amplified by the semantics of the plan,
+ * 0 otherwise. The native influence functions change at most as much as the aggregation, and the aggregation at most as much
+ * as any attacker or supporter, when the strengths are within [0, 1]; the basic model does it for any strength.
+ *
+ * @param incremental the state
+ * @return int 1 if the semantics is contracting, 0 otherwise
+ */
+static inline int
+_QBAFIncremental_contracting(QBAFIncremental *incremental)
+{
+    QBAFSemantics *settings = &incremental->plan->settings;
+    if (settings->aggregation_function == sum && settings->influence_function == simple_influence) {
+        return TRUE;
+    }
+    return incremental->out_of_range_size == 0;
+}
+
+Py_ssize_t
+QBAFIncremental_Update(QBAFIncremental *incremental, const double *initial_strengths, double *final_strengths,
+                       double tolerance, double *staleness_bound)
+{
+    QBAFPlanObject *plan = incremental->plan;
+    Py_ssize_t recalculated = 0;
+
+    // The queue holds the arguments whose initial strength changed, before any change is skipped
+    for (Py_ssize_t index = 0; index < incremental->queue_size; index++) {
+        Py_ssize_t id = incremental->queue[index];
+        char out_of_range = !(initial_strengths[id] >= 0.0 && initial_strengths[id] <= 1.0);
+        incremental->out_of_range_size += out_of_range - incremental->out_of_range[id];
+        incremental->out_of_range[id] = out_of_range;
+    }
+
+    while (incremental->queue_size > 0) {
+        Py_ssize_t id = _QBAFIncremental_pop(incremental);
+        double old_strength = final_strengths[id];
+        recalculated++;
+
+        Py_ssize_t hub_index = incremental->hub_indices[id];
+        if (hub_index >= 0 && incremental->hubs[hub_index].valid) {
+            double aggregation = _QBAFHub_aggregation(incremental, &incremental->hubs[hub_index], final_strengths);
+            final_strengths[id] = plan->settings.influence_function(initial_strengths[id], aggregation);
+        }
+        else {
+            // Native functions cannot fail
+            QBAFPlan_EvaluateArgument(plan, id, initial_strengths, final_strengths, incremental->buffer);
+        }
+
+        double new_strength = final_strengths[id];
+        if (new_strength == old_strength || (new_strength != new_strength && old_strength != old_strength)) {
+            continue;   // Nothing changes downstream
+        }
+
+        // Every argument downstream is off by at most the change times the number of paths that reach it
+        double change = fabs(new_strength - old_strength);
+        int skip = change < tolerance && incremental->amplification[id] > 0.0;
+        if (skip) {
+            *staleness_bound = _QBAFIncremental_contracting(incremental) ?
+                               *staleness_bound + change * incremental->amplification[id] : INFINITY;
+        }
+
+        for (Py_ssize_t index = plan->successor_offsets[id]; index < plan->successor_offsets[id+1]; index++) {
+            Py_ssize_t successor = plan->successors[index];
+            Py_ssize_t successor_hub_index = incremental->hub_indices[successor];
+            if (successor_hub_index >= 0) {     // The hubs keep gathering the current final strengths
+                _QBAFHub_update(incremental, &incremental->hubs[successor_hub_index], plan->successor_edges[index],
+                                old_strength, new_strength, final_strengths);
+            }
+            if (!skip) {
+                _QBAFIncremental_push(incremental, successor);
+            }
+        }
+    }
+
+    return recalculated;
+}
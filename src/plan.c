@@ -0,0 +1,2266 @@
+/**
+ * @file plan.c
+ * @author Jose Ruiz Alarcon
+ * @brief Definition of the PyTypeObject QBAFPlan.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "structmember.h"
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#define PLAN_HAS_THREADS 1
+#endif
+
+#include "plan.h"
+#include "relations.h"
+#include "qbaf_utils.h"
+#include "qbaf_functions.h"
+
+#define PLAN_AGGREGATION_SUM 0
+#define PLAN_AGGREGATION_PRODUCT 1
+#define PLAN_AGGREGATION_TOP 2
+
+static const char *STR_TOPOLOGICAL_KERNEL = "topological";
+static const char *STR_JACOBI_KERNEL = "jacobi";
+
+static const char *STR_NATURAL_ORDERING = "natural";
+static const char *STR_RCM_ORDERING = "rcm";
+static const char *STR_TOPOLOGICAL_ORDERING = "topological";
+
+/**
+ * @brief This function is used by the garbage collector to detect reference cycles.
+ *
+ * @param self a object of type QBAFPlan
+ * @param visit
+ * @param arg
+ * @return int 0 if the function was successful. Otherwise, -1.
+ */
+static int
+QBAFPlan_traverse(QBAFPlanObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(self->arguments);
+    Py_VISIT(self->settings.aggregation_function_callable);
+    Py_VISIT(self->settings.influence_function_callable);
+    return 0;
+}
+
+/**
+ * @brief Drop the instance’s references to those of its members that may be Python objects, and set its pointers to those members to NULL.
+ *
+ * @param self a object of type QBAFPlan
+ * @return int 0 if the function was successful. Otherwise, -1.
+ */
+static int
+QBAFPlan_clear(QBAFPlanObject *self)
+{
+    Py_CLEAR(self->arguments);
+    Py_CLEAR(self->settings.aggregation_function_callable);
+    Py_CLEAR(self->settings.influence_function_callable);
+    return 0;
+}
+
+/**
+ * @brief Destructor function that is called to free memory of a object that will no longer be used.
+ *
+ * @param self a object of type QBAFPlan
+ */
+static void
+QBAFPlan_dealloc(QBAFPlanObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    QBAFPlan_clear(self);
+    PyMem_Free(self->dependency_offsets);
+    PyMem_Free(self->supporter_starts);
+    PyMem_Free(self->dependencies);
+    PyMem_Free(self->schedule);
+    PyMem_Free(self->ranks);
+    PyMem_Free(self->successor_offsets);
+    PyMem_Free(self->successors);
+    PyMem_Free(self->successor_edges);
+    PyMem_Free(self->components);
+    PyMem_Free(self->component_offsets);
+    PyMem_Free(self->component_members);
+    Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+/**
+ * @brief Return a new PyList of PyFloat with the values of an array of doubles, NULL if an error occurred.
+ *
+ * @param values an array of doubles
+ * @param size the number of values
+ * @return PyObject* a new PyList, NULL if an error occurred
+ */
+static inline PyObject *
+PyListFloat_FromDoubles(const double *values, Py_ssize_t size)
+{
+    PyObject *list = PyList_New(size);
+    if (list == NULL)
+        return NULL;
+
+    for (Py_ssize_t index = 0; index < size; index++) {
+        PyObject *pyfloat = PyFloat_FromDouble(values[index]);
+        if (pyfloat == NULL) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, index, pyfloat);
+    }
+
+    return list;
+}
+
+/**
+ * @brief Return the result of the aggregation function of the settings,
+ * -1.0 if an error has occurred.
+ *
+ * @param settings the semantics
+ * @param attacker_strengths array of attackers' final strengths
+ * @param attackers_size the number of attackers
+ * @param supporter_strengths array of supporters' final strengths
+ * @param supporters_size the number of supporters
+ * @return double result of the aggregation function, -1.0 if an error occurred
+ */
+static inline
+double _QBAFPlan_aggregation_function(const QBAFSemantics *settings, const double *attacker_strengths, Py_ssize_t attackers_size,
+                                      const double *supporter_strengths, Py_ssize_t supporters_size)
+{
+    if (settings->aggregation_function != NULL)
+        return settings->aggregation_function(attacker_strengths, attackers_size, supporter_strengths, supporters_size);
+
+    if (settings->aggregation_function_callable != NULL) {
+        // Functions given from python receive lists of floats
+        PyObject *attacker_list = PyListFloat_FromDoubles(attacker_strengths, attackers_size);
+        if (attacker_list == NULL)
+            return -1;
+        PyObject *supporter_list = PyListFloat_FromDoubles(supporter_strengths, supporters_size);
+        if (supporter_list == NULL) {
+            Py_DECREF(attacker_list);
+            return -1;
+        }
+        PyObject *pyfloat = PyObject_CallFunction(settings->aggregation_function_callable, "OO", attacker_list, supporter_list);
+        Py_DECREF(attacker_list);
+        Py_DECREF(supporter_list);
+        if (pyfloat == NULL)
+            return -1;
+        double aggregation = PyFloat_AsDouble(pyfloat);
+        Py_DECREF(pyfloat);
+        return aggregation;
+    }
+
+    PyErr_BadArgument();
+    return -1.0;
+}
+
+/**
+ * @brief Return the result of the influence function of the settings,
+ * -1.0 in an error has occurred.
+ *
+ * @param settings the semantics
+ * @param w the initial strength
+ * @param s the result of applying the aggregation function to all attackers and supporters
+ * @return double the result, -1.0 if an error occurred
+ */
+static inline
+double _QBAFPlan_influence_function(const QBAFSemantics *settings, double w, double s)
+{
+    if (settings->influence_function != NULL)
+        return settings->influence_function(w, s);
+
+    if (settings->influence_function_callable != NULL) {
+        PyObject *pyfloat = PyObject_CallFunction(settings->influence_function_callable, "dd", w, s);
+        if (pyfloat == NULL)
+            return -1;
+        double influence = PyFloat_AsDouble(pyfloat);
+        Py_DECREF(pyfloat);
+        return influence;
+    }
+
+    PyErr_BadArgument();
+    return -1.0;
+}
+
+Py_ssize_t
+QBAFPlan_Processors(void)
+{
+#ifdef PLAN_HAS_THREADS
+    static Py_ssize_t processors = 0;
+    if (processors == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        processors = online > 0 ? online : 1;
+    }
+    return processors;
+#else
+    return 1;
+#endif
+}
+
+Py_ssize_t
+QBAFPlan_HubThreads(QBAFPlanObject *plan, Py_ssize_t dependencies)
+{
+    if (dependencies < PLAN_PARALLEL_MIN_DEPENDENCIES || plan->settings.aggregation_function == NULL) {
+        return 1;
+    }
+    if (plan->settings.aggregation_function != sum && plan->settings.aggregation_function != product &&
+        plan->settings.aggregation_function != top) {
+        return 1;
+    }
+
+    Py_ssize_t processors = QBAFPlan_Processors();
+    Py_ssize_t threads = dependencies / (PLAN_PARALLEL_MIN_DEPENDENCIES / 2);
+    if (threads > processors) {
+        threads = processors;
+    }
+    if (threads > PLAN_PARALLEL_MAX_THREADS) {
+        threads = PLAN_PARALLEL_MAX_THREADS;
+    }
+    return threads > 1 ? threads : 1;
+}
+
+Py_ssize_t
+QBAFPlan_ComponentThreads(QBAFPlanObject *plan, Py_ssize_t components_size, Py_ssize_t members_size)
+{
+    if (plan->schedule == NULL || !QBAFPlan_IsNative(plan) || components_size < 2 ||
+        members_size < PLAN_PARALLEL_MIN_COMPONENT_ARGUMENTS) {
+        return 1;
+    }
+
+    Py_ssize_t processors = QBAFPlan_Processors();
+    Py_ssize_t threads = members_size / (PLAN_PARALLEL_MIN_COMPONENT_ARGUMENTS / 2);
+    if (threads > processors) {
+        threads = processors;
+    }
+    if (threads > components_size) {
+        threads = components_size;
+    }
+    if (threads > PLAN_PARALLEL_MAX_THREADS) {
+        threads = PLAN_PARALLEL_MAX_THREADS;
+    }
+    return threads > 1 ? threads : 1;
+}
+
+#ifdef PLAN_HAS_THREADS
+/**
+ * @brief Struct with a chunk of the attackers and supporters of a hub argument and its partial aggregation.
+ *
+ */
+typedef struct {
+    QBAFPlanObject *plan;
+    const double   *strengths;          /* strengths indexed by id used for the attackers and supporters */
+    int             kind;               /* the aggregation function (PLAN_AGGREGATION_*) */
+    Py_ssize_t      attackers_begin;    /* first attack relation of the chunk in plan->dependencies */
+    Py_ssize_t      attackers_end;      /* end of the attack relations of the chunk */
+    Py_ssize_t      supporters_begin;   /* first support relation of the chunk in plan->dependencies */
+    Py_ssize_t      supporters_end;     /* end of the support relations of the chunk */
+    double          attack_value;       /* partial sum, product or maximum of the attackers */
+    double          support_value;      /* partial sum, product or maximum of the supporters */
+    int             out_of_range;       /* top: 1 if an attacker strength is not within [-1, 1] */
+} QBAFHubChunk;
+
+/**
+ * @brief Calculate the partial aggregation of a chunk of the attackers and supporters of a hub argument.
+ *
+ * @param chunk a QBAFHubChunk
+ * @return void* NULL
+ */
+static void *
+_QBAFHubChunk_reduce(void *arg)
+{
+    QBAFHubChunk *chunk = (QBAFHubChunk *) arg;
+    const double *strengths = chunk->strengths;
+    const Py_ssize_t *dependencies = chunk->plan->dependencies;
+    double attack_value, support_value;
+
+    if (chunk->kind == PLAN_AGGREGATION_SUM) {
+        attack_value = support_value = 0;
+        for (Py_ssize_t edge = chunk->attackers_begin; edge < chunk->attackers_end; edge++) {
+            attack_value = attack_value + strengths[dependencies[edge]];
+        }
+        for (Py_ssize_t edge = chunk->supporters_begin; edge < chunk->supporters_end; edge++) {
+            support_value = support_value + strengths[dependencies[edge]];
+        }
+    }
+    else if (chunk->kind == PLAN_AGGREGATION_PRODUCT) {
+        attack_value = support_value = 1;
+        for (Py_ssize_t edge = chunk->attackers_begin; edge < chunk->attackers_end; edge++) {
+            attack_value = attack_value * (1 - strengths[dependencies[edge]]);
+        }
+        for (Py_ssize_t edge = chunk->supporters_begin; edge < chunk->supporters_end; edge++) {
+            support_value = support_value * (1 - strengths[dependencies[edge]]);
+        }
+    }
+    else {
+        attack_value = support_value = 0;
+        for (Py_ssize_t edge = chunk->attackers_begin; edge < chunk->attackers_end; edge++) {
+            double strength = strengths[dependencies[edge]];
+            if (strength > 1 || strength < -1) {
+                chunk->out_of_range = 1;
+                break;
+            }
+            attack_value = attack_value > strength ? attack_value : strength;
+        }
+        for (Py_ssize_t edge = chunk->supporters_begin; edge < chunk->supporters_end; edge++) {
+            double strength = strengths[dependencies[edge]];
+            support_value = support_value > strength ? support_value : strength;
+        }
+    }
+
+    chunk->attack_value = attack_value;
+    chunk->support_value = support_value;
+    return NULL;
+}
+
+/**
+ * @brief Return the aggregation of the attackers and supporters of a hub argument,
+ * splitting them across threads and reducing the partial sums, products or maxima.
+ *
+ * @param plan a QBAFPlan with a native sum, product or top aggregation function
+ * @param id the id of the hub argument
+ * @param dependency_strengths strengths (indexed by id) used for the attackers and supporters
+ * @param threads the number of threads
+ * @return double the result of the aggregation function
+ */
+static double
+_QBAFPlan_parallel_aggregation(QBAFPlanObject *plan, Py_ssize_t id, const double *dependency_strengths, Py_ssize_t threads)
+{
+    QBAFHubChunk chunks[PLAN_PARALLEL_MAX_THREADS];
+    pthread_t thread_ids[PLAN_PARALLEL_MAX_THREADS];
+    int started[PLAN_PARALLEL_MAX_THREADS];
+    int kind = plan->settings.aggregation_function == sum ? PLAN_AGGREGATION_SUM :
+               plan->settings.aggregation_function == product ? PLAN_AGGREGATION_PRODUCT : PLAN_AGGREGATION_TOP;
+
+    Py_ssize_t attackers_begin = plan->dependency_offsets[id], attackers_size = plan->supporter_starts[id] - attackers_begin;
+    Py_ssize_t supporters_begin = plan->supporter_starts[id], supporters_size = plan->dependency_offsets[id+1] - supporters_begin;
+
+    for (Py_ssize_t index = 0; index < threads; index++) {
+        QBAFHubChunk *chunk = &chunks[index];
+        chunk->plan = plan;
+        chunk->strengths = dependency_strengths;
+        chunk->kind = kind;
+        chunk->attackers_begin = attackers_begin + attackers_size * index / threads;
+        chunk->attackers_end = attackers_begin + attackers_size * (index + 1) / threads;
+        chunk->supporters_begin = supporters_begin + supporters_size * index / threads;
+        chunk->supporters_end = supporters_begin + supporters_size * (index + 1) / threads;
+        chunk->out_of_range = 0;
+    }
+
+    // The calling thread reduces the first chunk; a chunk whose thread cannot be started is reduced here as well
+    for (Py_ssize_t index = 1; index < threads; index++) {
+        started[index] = pthread_create(&thread_ids[index], NULL, _QBAFHubChunk_reduce, &chunks[index]) == 0;
+    }
+    _QBAFHubChunk_reduce(&chunks[0]);
+    for (Py_ssize_t index = 1; index < threads; index++) {
+        if (started[index]) {
+            pthread_join(thread_ids[index], NULL);
+        }
+        else {
+            _QBAFHubChunk_reduce(&chunks[index]);
+        }
+    }
+
+    double attack_value = chunks[0].attack_value, support_value = chunks[0].support_value;
+    int out_of_range = chunks[0].out_of_range;
+    for (Py_ssize_t index = 1; index < threads; index++) {
+        if (kind == PLAN_AGGREGATION_SUM) {
+            attack_value = attack_value + chunks[index].attack_value;
+            support_value = support_value + chunks[index].support_value;
+        }
+        else if (kind == PLAN_AGGREGATION_PRODUCT) {
+            attack_value = attack_value * chunks[index].attack_value;
+            support_value = support_value * chunks[index].support_value;
+        }
+        else {
+            out_of_range |= chunks[index].out_of_range;
+            attack_value = attack_value > chunks[index].attack_value ? attack_value : chunks[index].attack_value;
+            support_value = support_value > chunks[index].support_value ? support_value : chunks[index].support_value;
+        }
+    }
+
+    if (kind == PLAN_AGGREGATION_TOP && out_of_range) {
+        return -1;  // Like top, when an attacker strength is not within [-1, 1]
+    }
+    if (kind == PLAN_AGGREGATION_PRODUCT) {
+        return attack_value - support_value;
+    }
+    return support_value - attack_value;
+}
+#endif
+
+/**
+ * @brief Calculate the final strength of the argument id from the strengths of its attackers and supporters,
+ * and store it in strengths_to_update[id].
+ *
+ * @param plan a QBAFPlan
+ * @param id the id of the argument whose final strength is calculated
+ * @param initial_strengths the initial strengths indexed by id
+ * @param dependency_strengths strengths (indexed by id) used for the attackers and supporters
+ * @param strengths_to_update strengths (indexed by id) where the result is stored
+ * @param buffer scratch space with room for plan->max_dependencies doubles
+ * @return int 0 if successful, -1 otherwise
+ */
+static inline int
+_QBAFPlan_apply_semantics(QBAFPlanObject *plan, Py_ssize_t id, const double *initial_strengths,
+                          const double *dependency_strengths, double *strengths_to_update, double *buffer)
+{
+#ifdef PLAN_HAS_THREADS
+    Py_ssize_t threads = QBAFPlan_HubThreads(plan, plan->dependency_offsets[id+1]
+                                                   - plan->dependency_offsets[id]);
+    if (threads > 1) {
+        double aggregation = _QBAFPlan_parallel_aggregation(plan, id, dependency_strengths, threads);
+        strengths_to_update[id] = plan->settings.influence_function(initial_strengths[id], aggregation);
+        return 0;
+    }
+#endif
+
+    // The attackers and supporters are contiguous, so they are gathered in a single pass
+    Py_ssize_t begin = plan->dependency_offsets[id], end = plan->dependency_offsets[id+1];
+    const Py_ssize_t *dependencies = plan->dependencies;
+    for (Py_ssize_t edge = begin; edge < end; edge++) {
+        buffer[edge - begin] = dependency_strengths[dependencies[edge]];
+    }
+    double *attacker_strengths = buffer;
+    Py_ssize_t attackers_size = plan->supporter_starts[id] - begin;
+    double *supporter_strengths = attacker_strengths + attackers_size;
+    Py_ssize_t supporters_size = end - plan->supporter_starts[id];
+
+    double aggregation = _QBAFPlan_aggregation_function(&plan->settings, attacker_strengths, attackers_size,
+                                                        supporter_strengths, supporters_size);
+    // Only python callables can fail, and native kernels may run without the GIL
+    if (plan->settings.aggregation_function == NULL && aggregation == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+
+    double final_strength = _QBAFPlan_influence_function(&plan->settings, initial_strengths[id], aggregation);
+    if (plan->settings.influence_function == NULL && final_strength == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+
+    strengths_to_update[id] = final_strength;
+    return 0;
+}
+
+int
+QBAFPlan_IsNative(QBAFPlanObject *plan)
+{
+    return plan->settings.aggregation_function != NULL && plan->settings.influence_function != NULL;
+}
+
+int
+QBAFPlan_EvaluateArgument(QBAFPlanObject *plan, Py_ssize_t id, const double *initial_strengths,
+                          double *final_strengths, double *buffer)
+{
+    return _QBAFPlan_apply_semantics(plan, id, initial_strengths, final_strengths, final_strengths, buffer);
+}
+
+int
+QBAFPlan_EvaluateAcyclic(QBAFPlanObject *plan, const double *initial_strengths, double *final_strengths, double *buffer)
+{
+    for (Py_ssize_t index = 0; index < plan->size; index++) {
+        Py_ssize_t id = plan->schedule[index];
+        if (_QBAFPlan_apply_semantics(plan, id, initial_strengths, final_strengths, final_strengths, buffer) < 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Struct with a range of the components evaluated by one thread.
+ *
+ */
+typedef struct {
+    QBAFPlanObject   *plan;
+    const Py_ssize_t *components;       /* the components evaluated by the thread */
+    Py_ssize_t        components_size;  /* the number of components */
+    const double     *initial_strengths;
+    double           *final_strengths;
+    double           *buffer;           /* scratch space with room for plan->max_dependencies doubles */
+    int               result;           /* 0 if successful, -1 if an error occurred */
+} QBAFComponentRange;
+
+/**
+ * @brief Calculate the final strengths of the members of a range of components, following their topological order.
+ *
+ * @param arg a QBAFComponentRange
+ * @return void* NULL
+ */
+static void *
+_QBAFComponentRange_evaluate(void *arg)
+{
+    QBAFComponentRange *range = (QBAFComponentRange *) arg;
+    QBAFPlanObject *plan = range->plan;
+    range->result = 0;
+    for (Py_ssize_t index = 0; index < range->components_size; index++) {
+        Py_ssize_t component = range->components[index];
+        for (Py_ssize_t member = plan->component_offsets[component]; member < plan->component_offsets[component+1]; member++) {
+            if (_QBAFPlan_apply_semantics(plan, plan->component_members[member], range->initial_strengths,
+                                          range->final_strengths, range->final_strengths, range->buffer) < 0) {
+                range->result = -1;
+                return NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+int
+QBAFPlan_EvaluateComponents(QBAFPlanObject *plan, const Py_ssize_t *components, Py_ssize_t components_size,
+                            const double *initial_strengths, double *final_strengths, double *buffer)
+{
+    QBAFComponentRange ranges[PLAN_PARALLEL_MAX_THREADS];
+
+    Py_ssize_t members = 0;
+    for (Py_ssize_t index = 0; index < components_size; index++) {
+        members += plan->component_offsets[components[index]+1] - plan->component_offsets[components[index]];
+    }
+    Py_ssize_t threads = QBAFPlan_ComponentThreads(plan, components_size, members);
+
+    ranges[0].plan = plan;
+    ranges[0].components = components;
+    ranges[0].components_size = components_size;
+    ranges[0].initial_strengths = initial_strengths;
+    ranges[0].final_strengths = final_strengths;
+    ranges[0].buffer = buffer;
+    if (threads <= 1) {
+        _QBAFComponentRange_evaluate(&ranges[0]);
+        return ranges[0].result;
+    }
+
+#ifdef PLAN_HAS_THREADS
+    // Every thread needs its own scratch space, the calling thread uses buffer
+    double *buffers = PyMem_RawMalloc(((threads - 1) * plan->max_dependencies + 1) * sizeof(double));
+    if (buffers == NULL) {
+        _QBAFComponentRange_evaluate(&ranges[0]);
+        return ranges[0].result;
+    }
+
+    // Consecutive components are assigned to a thread until it has its share of the members
+    Py_ssize_t begin = 0, accumulated = 0;
+    for (Py_ssize_t thread = 0; thread < threads; thread++) {
+        Py_ssize_t end = begin;
+        while (end < components_size && (thread == threads - 1 || accumulated < members * (thread + 1) / threads)) {
+            accumulated += plan->component_offsets[components[end]+1] - plan->component_offsets[components[end]];
+            end++;
+        }
+        QBAFComponentRange *range = &ranges[thread];
+        *range = ranges[0];
+        range->components = components + begin;
+        range->components_size = end - begin;
+        range->buffer = thread == 0 ? buffer : buffers + (thread - 1) * plan->max_dependencies;
+        begin = end;
+    }
+
+    // The calling thread evaluates the first range; a range whose thread cannot be started is evaluated here as well
+    pthread_t thread_ids[PLAN_PARALLEL_MAX_THREADS];
+    int started[PLAN_PARALLEL_MAX_THREADS];
+    for (Py_ssize_t thread = 1; thread < threads; thread++) {
+        started[thread] = pthread_create(&thread_ids[thread], NULL, _QBAFComponentRange_evaluate, &ranges[thread]) == 0;
+    }
+    _QBAFComponentRange_evaluate(&ranges[0]);
+    int result = ranges[0].result;
+    for (Py_ssize_t thread = 1; thread < threads; thread++) {
+        if (started[thread]) {
+            pthread_join(thread_ids[thread], NULL);
+        }
+        else {
+            _QBAFComponentRange_evaluate(&ranges[thread]);
+        }
+        result = ranges[thread].result < 0 ? -1 : result;
+    }
+    PyMem_RawFree(buffers);
+    return result;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Gather the strengths of the attackers and supporters of the argument id for every semantics.
+ * The strengths of the semantics k are stored in buffer[k*dependencies : (k+1)*dependencies],
+ * first the attackers and then the supporters.
+ *
+ * @param plan a QBAFPlan
+ * @param id the id of the argument
+ * @param count the number of semantics
+ * @param dependency_strengths strengths indexed by id * count + k
+ * @param buffer scratch space with room for plan->max_dependencies * count doubles
+ * @return Py_ssize_t the number of attackers plus supporters of id
+ */
+static inline Py_ssize_t
+_QBAFPlan_gather_multiple(QBAFPlanObject *plan, Py_ssize_t id, Py_ssize_t count,
+                          const double *dependency_strengths, double *buffer)
+{
+    Py_ssize_t begin = plan->dependency_offsets[id];
+    Py_ssize_t dependencies = plan->dependency_offsets[id+1] - begin;
+
+    for (Py_ssize_t position = 0; position < dependencies; position++) {
+        const double *strengths = dependency_strengths + plan->dependencies[begin + position] * count;
+        for (Py_ssize_t k = 0; k < count; k++) {
+            buffer[k * dependencies + position] = strengths[k];
+        }
+    }
+
+    return dependencies;
+}
+
+int
+QBAFPlan_EvaluateMultiple(QBAFPlanObject *plan, const QBAFSemantics *semantics, Py_ssize_t count,
+                          const double *initial_strengths, double *final_strengths,
+                          double *work_strengths, char *converged, double *buffer)
+{
+    Py_ssize_t size = plan->size;
+
+    if (plan->schedule != NULL) {
+        for (Py_ssize_t index = 0; index < size; index++) {
+            Py_ssize_t id = plan->schedule[index];
+            Py_ssize_t attackers_size = plan->supporter_starts[id] - plan->dependency_offsets[id];
+            Py_ssize_t dependencies = _QBAFPlan_gather_multiple(plan, id, count, final_strengths, buffer);
+            for (Py_ssize_t k = 0; k < count; k++) {
+                double *strengths = buffer + k * dependencies;
+                double aggregation = semantics[k].aggregation_function(strengths, attackers_size,
+                                                                       strengths + attackers_size, dependencies - attackers_size);
+                final_strengths[id * count + k] = semantics[k].influence_function(initial_strengths[id], aggregation);
+            }
+        }
+        return 0;
+    }
+
+    // Synchronous fixed-point iteration: a semantics stops being updated once it has converged,
+    // so every column ends exactly as if it was evaluated on its own
+    double *previous = work_strengths;
+    double *updated = work_strengths + size * count;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        for (Py_ssize_t k = 0; k < count; k++) {
+            previous[id * count + k] = initial_strengths[id];
+        }
+    }
+    for (Py_ssize_t k = 0; k < count; k++) {
+        converged[k] = 0;
+    }
+
+    Py_ssize_t pending = count;
+    for (Py_ssize_t iteration = 0; iteration < plan->settings.max_iterations && pending > 0; iteration++) {
+        for (Py_ssize_t id = 0; id < size; id++) {
+            Py_ssize_t attackers_size = plan->supporter_starts[id] - plan->dependency_offsets[id];
+            Py_ssize_t dependencies = _QBAFPlan_gather_multiple(plan, id, count, previous, buffer);
+            for (Py_ssize_t k = 0; k < count; k++) {
+                if (converged[k]) {
+                    continue;
+                }
+                double *strengths = buffer + k * dependencies;
+                double aggregation = semantics[k].aggregation_function(strengths, attackers_size,
+                                                                       strengths + attackers_size, dependencies - attackers_size);
+                updated[id * count + k] = semantics[k].influence_function(initial_strengths[id], aggregation);
+            }
+        }
+
+        for (Py_ssize_t k = 0; k < count; k++) {
+            if (converged[k]) {
+                continue;
+            }
+            double max_residual = 0.0;
+            for (Py_ssize_t id = 0; id < size; id++) {
+                double strength_difference = fabs(updated[id * count + k] - previous[id * count + k]);
+                if (strength_difference > max_residual || strength_difference != strength_difference) { // NaN never converges
+                    max_residual = strength_difference;
+                }
+            }
+            if (max_residual <= plan->settings.convergence_threshold) {
+                converged[k] = 1;
+                pending--;
+                for (Py_ssize_t id = 0; id < size; id++) {
+                    final_strengths[id * count + k] = updated[id * count + k];
+                }
+            }
+        }
+
+        // Converged columns are not read again, so they can be swapped with the rest
+        double *swap = previous;
+        previous = updated;
+        updated = swap;
+    }
+
+    return pending > 0 ? 1 : 0;
+}
+
+/**
+ * @brief Add the residual of iteration to trace if it is sampled, keeping at most
+ * PLAN_MAX_RESIDUALS items by doubling the sampling stride when needed.
+ *
+ * @param trace a QBAFSolveTrace
+ * @param iteration the index of the iteration
+ * @param residual the maximum residual of the iteration
+ */
+static inline void
+_QBAFSolveTrace_sample(QBAFSolveTrace *trace, Py_ssize_t iteration, double residual)
+{
+    if (iteration % trace->residual_stride != 0) {
+        return;
+    }
+
+    if (trace->residuals_size == PLAN_MAX_RESIDUALS) {
+        // Keep every other residual and double the stride
+        Py_ssize_t kept = 0;
+        for (Py_ssize_t index = 0; index < trace->residuals_size; index += 2) {
+            trace->residuals[kept++] = trace->residuals[index];
+        }
+        trace->residuals_size = kept;
+        trace->residual_stride *= 2;
+        if (iteration % trace->residual_stride != 0) {
+            return;
+        }
+    }
+
+    trace->residuals[trace->residuals_size++] = residual;
+}
+
+int
+QBAFPlan_EvaluateIterative(QBAFPlanObject *plan, const Py_ssize_t *ids, Py_ssize_t ids_size,
+                           const double *initial_strengths, double *final_strengths,
+                           double *previous_strengths, double *buffer, QBAFSolveTrace *trace)
+{
+    QBAFSolveTrace local_trace;
+    if (trace == NULL) {
+        trace = &local_trace;
+    }
+    trace->iterations = 0;
+    trace->converged = 0;
+    trace->final_residual = 0.0;
+    trace->residuals_size = 0;
+    trace->residual_stride = 1;
+
+    Py_ssize_t size = ids != NULL ? ids_size : plan->size;
+    double *previous = previous_strengths;
+    double *updated = final_strengths;
+    for (Py_ssize_t index = 0; index < size; index++) {
+        Py_ssize_t id = ids != NULL ? ids[index] : index;
+        previous[id] = initial_strengths[id];
+    }
+
+    Py_ssize_t iteration;
+    for (iteration = 0; iteration < plan->settings.max_iterations; iteration++) {
+        for (Py_ssize_t index = 0; index < size; index++) {
+            Py_ssize_t id = ids != NULL ? ids[index] : index;
+            if (_QBAFPlan_apply_semantics(plan, id, initial_strengths, previous, updated, buffer) < 0) {
+                return -1;
+            }
+        }
+
+        double max_residual = 0.0;
+        for (Py_ssize_t index = 0; index < size; index++) {
+            Py_ssize_t id = ids != NULL ? ids[index] : index;
+            double strength_difference = fabs(updated[id] - previous[id]);
+            if (strength_difference > max_residual || strength_difference != strength_difference) { // NaN never converges
+                max_residual = strength_difference;
+            }
+        }
+        trace->final_residual = max_residual;
+        _QBAFSolveTrace_sample(trace, iteration, max_residual);
+
+        if (max_residual <= plan->settings.convergence_threshold) {
+            trace->converged = 1;
+            iteration++;
+            break;
+        }
+        if (iteration + 1 < plan->settings.max_iterations) {
+            double *swap = previous;
+            previous = updated;
+            updated = swap;
+        }
+    }
+    trace->iterations = iteration;
+
+    // The last iteration must end up in final_strengths and the previous one in previous_strengths
+    if (updated != final_strengths) {
+        for (Py_ssize_t index = 0; index < size; index++) {
+            Py_ssize_t id = ids != NULL ? ids[index] : index;
+            double swap = final_strengths[id];
+            final_strengths[id] = previous_strengths[id];
+            previous_strengths[id] = swap;
+        }
+    }
+
+    return trace->converged ? 0 : 1;
+}
+
+/**
+ * @brief Fill the attackers and supporters of every argument of the plan from the snapshots of the relations:
+ * the attackers of every argument followed by its supporters, in the order of the relations.
+ * The relations are bound to the ids of id_arguments, so their ids are copied as they are.
+ *
+ * @param plan a QBAFPlan with dependency_offsets, supporter_starts and dependencies allocated
+ * @param id_arguments a PyList of QBAFArgument indexed by id
+ * @param argument_ids a PyDict (argument: QBAFArgument, id: int)
+ * @param attack_relations the attack relations bound to argument_ids
+ * @param support_relations the support relations bound to argument_ids
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFPlan_fill_dependencies(QBAFPlanObject *plan, PyObject *id_arguments, PyObject *argument_ids,
+                            QBAFARelationsObject *attack_relations, QBAFARelationsObject *support_relations)
+{
+    Py_ssize_t size = PyList_GET_SIZE(id_arguments);
+
+    if (!attack_relations->bound || attack_relations->argument_ids != argument_ids ||
+        !support_relations->bound || support_relations->argument_ids != argument_ids) {
+        PyErr_SetString(PyExc_RuntimeError, "relations are inconsistent with the arguments of the framework");
+        return -1;
+    }
+    const QBAFAdjacency *attacks = QBAFARelations_Adjacency(attack_relations, size);
+    const QBAFAdjacency *supports = QBAFARelations_Adjacency(support_relations, size);
+    if (attacks == NULL || supports == NULL) {
+        return -1;
+    }
+
+    Py_ssize_t offset = 0;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        plan->dependency_offsets[id] = offset;
+        Py_ssize_t attackers_size = attacks->agent_offsets[id+1] - attacks->agent_offsets[id];
+        memcpy(plan->dependencies + offset, attacks->agents + attacks->agent_offsets[id], attackers_size * sizeof(Py_ssize_t));
+        offset += attackers_size;
+        plan->supporter_starts[id] = offset;
+        Py_ssize_t supporters_size = supports->agent_offsets[id+1] - supports->agent_offsets[id];
+        memcpy(plan->dependencies + offset, supports->agents + supports->agent_offsets[id], supporters_size * sizeof(Py_ssize_t));
+        offset += supporters_size;
+    }
+    plan->dependency_offsets[size] = offset;
+
+    return 0;
+}
+
+/**
+ * @brief Calculate the topological order of the plan (every argument after its attackers and supporters).
+ * If the plan is cyclic the schedule is left NULL.
+ *
+ * @param plan a QBAFPlan with its attackers and supporters
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFPlan_build_schedule(QBAFPlanObject *plan)
+{
+    enum { NOT_VISITED = 0, ON_STACK = 1, SCHEDULED = 2 };
+    Py_ssize_t size = plan->size;
+    // Every argument is pushed once as a root and at most once per relation as a dependency
+    Py_ssize_t stack_capacity = size + plan->dependency_offsets[size] + 1;
+
+    char *state = PyMem_Calloc(size + 1, sizeof(char));
+    Py_ssize_t *argument_stack = PyMem_Malloc(stack_capacity * sizeof(Py_ssize_t));
+    Py_ssize_t *schedule = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (state == NULL || argument_stack == NULL || schedule == NULL) {
+        PyMem_Free(state); PyMem_Free(argument_stack); PyMem_Free(schedule);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    const Py_ssize_t *offsets = plan->dependency_offsets;
+    const Py_ssize_t *dependency_ids = plan->dependencies;
+    Py_ssize_t scheduled = 0;
+
+    for (Py_ssize_t root = 0; root < size; root++) {
+        if (state[root] == SCHEDULED) {
+            continue;
+        }
+
+        Py_ssize_t stack_size = 0;
+        argument_stack[stack_size++] = root;
+
+        while (stack_size > 0) {
+            Py_ssize_t current = argument_stack[stack_size-1];
+
+            if (state[current] == SCHEDULED) {
+                stack_size--;
+                continue;
+            }
+
+            // On first visit push dependencies. On second visit schedule the argument.
+            if (state[current] == NOT_VISITED) {
+                state[current] = ON_STACK;
+                for (Py_ssize_t edge = offsets[current]; edge < offsets[current+1]; edge++) {
+                    Py_ssize_t dependency = dependency_ids[edge];
+                    if (state[dependency] == ON_STACK) {    // A cycle was found
+                        PyMem_Free(state); PyMem_Free(argument_stack); PyMem_Free(schedule);
+                        return 0;
+                    }
+                    if (state[dependency] == NOT_VISITED) {
+                        argument_stack[stack_size++] = dependency;
+                    }
+                }
+                continue;
+            }
+
+            state[current] = SCHEDULED;
+            schedule[scheduled++] = current;
+            stack_size--;
+        }
+    }
+
+    PyMem_Free(state);
+    PyMem_Free(argument_stack);
+
+    Py_ssize_t *ranks = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (ranks == NULL) {
+        PyMem_Free(schedule);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (Py_ssize_t index = 0; index < size; index++) {
+        ranks[schedule[index]] = index;
+    }
+
+    plan->schedule = schedule;
+    plan->ranks = ranks;
+    return 0;
+}
+
+int
+QBAFPlan_EnsureSuccessors(QBAFPlanObject *plan)
+{
+    if (plan->successor_offsets != NULL) {
+        return 0;
+    }
+
+    Py_ssize_t size = plan->size;
+    Py_ssize_t relations_size = plan->dependency_offsets[size];
+    Py_ssize_t *successor_offsets = PyMem_Calloc(size + 1, sizeof(Py_ssize_t));
+    Py_ssize_t *successors = PyMem_Malloc((relations_size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *successor_edges = PyMem_Malloc((relations_size + 1) * sizeof(Py_ssize_t));
+    if (successor_offsets == NULL || successors == NULL || successor_edges == NULL) {
+        PyMem_Free(successor_offsets); PyMem_Free(successors); PyMem_Free(successor_edges);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    // Count the successors of every argument, then turn the counts into offsets
+    for (Py_ssize_t edge = 0; edge < relations_size; edge++) {
+        successor_offsets[plan->dependencies[edge] + 1]++;
+    }
+    for (Py_ssize_t id = 0; id < size; id++) {
+        successor_offsets[id+1] += successor_offsets[id];
+    }
+
+    Py_ssize_t *positions = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (positions == NULL) {
+        PyMem_Free(successor_offsets); PyMem_Free(successors); PyMem_Free(successor_edges);
+        PyErr_NoMemory();
+        return -1;
+    }
+    memcpy(positions, successor_offsets, size * sizeof(Py_ssize_t));
+
+    for (Py_ssize_t id = 0; id < size; id++) {
+        for (Py_ssize_t edge = plan->dependency_offsets[id]; edge < plan->dependency_offsets[id+1]; edge++) {
+            Py_ssize_t position = positions[plan->dependencies[edge]]++;
+            successors[position] = id;
+            successor_edges[position] = edge;
+        }
+    }
+    PyMem_Free(positions);
+
+    plan->successor_offsets = successor_offsets;
+    plan->successors = successors;
+    plan->successor_edges = successor_edges;
+    return 0;
+}
+
+/**
+ * @brief Return the representative of the set of id in the disjoint-set forest parents, halving the path on the way.
+ *
+ * @param parents the parent of every id
+ * @param id an id
+ * @return Py_ssize_t the representative of the set of id
+ */
+static inline Py_ssize_t
+_QBAFPlan_find_root(Py_ssize_t *parents, Py_ssize_t id)
+{
+    while (parents[id] != id) {
+        parents[id] = parents[parents[id]];
+        id = parents[id];
+    }
+    return id;
+}
+
+int
+QBAFPlan_EnsureComponents(QBAFPlanObject *plan)
+{
+    if (plan->components != NULL) {
+        return 0;
+    }
+
+    Py_ssize_t size = plan->size;
+    Py_ssize_t *parents = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *components = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *component_offsets = PyMem_Calloc(size + 2, sizeof(Py_ssize_t));
+    Py_ssize_t *component_members = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (parents == NULL || components == NULL || component_offsets == NULL || component_members == NULL) {
+        PyMem_Free(parents); PyMem_Free(components); PyMem_Free(component_offsets); PyMem_Free(component_members);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    // Join every argument with its attackers and supporters; the smallest id represents the set
+    for (Py_ssize_t id = 0; id < size; id++) {
+        parents[id] = id;
+    }
+    for (Py_ssize_t id = 0; id < size; id++) {
+        for (Py_ssize_t edge = plan->dependency_offsets[id]; edge < plan->dependency_offsets[id+1]; edge++) {
+            Py_ssize_t root = _QBAFPlan_find_root(parents, id);
+            Py_ssize_t agent_root = _QBAFPlan_find_root(parents, plan->dependencies[edge]);
+            if (root < agent_root) {
+                parents[agent_root] = root;
+            }
+            else {
+                parents[root] = agent_root;
+            }
+        }
+    }
+
+    // The representatives are found in increasing order, so components are numbered by their smallest id
+    Py_ssize_t components_size = 0;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        Py_ssize_t root = _QBAFPlan_find_root(parents, id);
+        components[id] = root == id ? components_size++ : components[root];
+        component_offsets[components[id] + 1]++;
+    }
+    for (Py_ssize_t component = 0; component < components_size; component++) {
+        component_offsets[component+1] += component_offsets[component];
+    }
+
+    // Reuse parents as the next free position of every component
+    memcpy(parents, component_offsets, components_size * sizeof(Py_ssize_t));
+    for (Py_ssize_t index = 0; index < size; index++) {
+        Py_ssize_t id = plan->schedule != NULL ? plan->schedule[index] : index;
+        component_members[parents[components[id]]++] = id;
+    }
+    PyMem_Free(parents);
+
+    plan->components_size = components_size;
+    plan->components = components;
+    plan->component_offsets = component_offsets;
+    plan->component_members = component_members;
+    return 0;
+}
+
+/**
+ * @brief Return the id of the dependency position of the argument id: its attackers first and then its supporters.
+ *
+ * @param plan a QBAFPlan
+ * @param id the id of the argument
+ * @param position a position lower than the number of attackers plus supporters of id
+ * @return Py_ssize_t the id of the attacker or supporter
+ */
+static inline Py_ssize_t
+_QBAFPlan_dependency(QBAFPlanObject *plan, Py_ssize_t id, Py_ssize_t position)
+{
+    return plan->dependencies[plan->dependency_offsets[id] + position];
+}
+
+/**
+ * @brief Count the strongly connected components with a cycle of the plan (Tarjan's algorithm without recursion)
+ * and store their number, the size of the largest and their total number of arguments in statistics.
+ *
+ * @param plan a QBAFPlan
+ * @param statistics the QBAFPlanStatistics that is filled
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFPlan_cycle_statistics(QBAFPlanObject *plan, QBAFPlanStatistics *statistics)
+{
+    Py_ssize_t size = plan->size;
+    Py_ssize_t *indices = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *lowlinks = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *stack = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *calls = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));       // the arguments being visited
+    Py_ssize_t *positions = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));   // the next dependency of every visit
+    char *on_stack = PyMem_Calloc(size + 1, sizeof(char));
+    if (indices == NULL || lowlinks == NULL || stack == NULL || calls == NULL || positions == NULL || on_stack == NULL) {
+        PyMem_Free(indices); PyMem_Free(lowlinks); PyMem_Free(stack); PyMem_Free(calls); PyMem_Free(positions); PyMem_Free(on_stack);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (Py_ssize_t id = 0; id < size; id++) {
+        indices[id] = -1;
+    }
+
+    Py_ssize_t counter = 0, stack_size = 0;
+    for (Py_ssize_t root = 0; root < size; root++) {
+        if (indices[root] >= 0) {
+            continue;
+        }
+        Py_ssize_t calls_size = 0;
+        calls[calls_size] = root; positions[calls_size++] = 0;
+        indices[root] = lowlinks[root] = counter++;
+        stack[stack_size++] = root; on_stack[root] = 1;
+
+        while (calls_size > 0) {
+            Py_ssize_t id = calls[calls_size-1];
+            Py_ssize_t dependencies = plan->dependency_offsets[id+1]
+                                    - plan->dependency_offsets[id];
+            if (positions[calls_size-1] < dependencies) {
+                Py_ssize_t dependency = _QBAFPlan_dependency(plan, id, positions[calls_size-1]++);
+                if (indices[dependency] < 0) {
+                    indices[dependency] = lowlinks[dependency] = counter++;
+                    stack[stack_size++] = dependency; on_stack[dependency] = 1;
+                    calls[calls_size] = dependency; positions[calls_size++] = 0;
+                }
+                else if (on_stack[dependency] && indices[dependency] < lowlinks[id]) {
+                    lowlinks[id] = indices[dependency];
+                }
+                continue;
+            }
+
+            if (lowlinks[id] == indices[id]) {
+                Py_ssize_t members = 0, member;
+                do {
+                    member = stack[--stack_size];
+                    on_stack[member] = 0;
+                    members++;
+                } while (member != id);
+                int cyclic = members > 1;
+                for (Py_ssize_t position = 0; !cyclic && position < dependencies; position++) {
+                    cyclic = _QBAFPlan_dependency(plan, id, position) == id;   // Relation with itself
+                }
+                if (cyclic) {
+                    statistics->cycles++;
+                    statistics->arguments_in_cycles += members;
+                    if (members > statistics->largest_cycle) {
+                        statistics->largest_cycle = members;
+                    }
+                }
+            }
+            calls_size--;
+            if (calls_size > 0 && lowlinks[id] < lowlinks[calls[calls_size-1]]) {
+                lowlinks[calls[calls_size-1]] = lowlinks[id];
+            }
+        }
+    }
+
+    PyMem_Free(indices); PyMem_Free(lowlinks); PyMem_Free(stack); PyMem_Free(calls); PyMem_Free(positions); PyMem_Free(on_stack);
+    return 0;
+}
+
+int
+QBAFPlan_Statistics(QBAFPlanObject *plan, QBAFPlanStatistics *statistics)
+{
+    Py_ssize_t size = plan->size;
+    memset(statistics, 0, sizeof(QBAFPlanStatistics));
+    statistics->relations = plan->dependency_offsets[size];
+    for (Py_ssize_t id = 0; id < size; id++) {
+        Py_ssize_t dependencies = plan->dependency_offsets[id+1]
+                                - plan->dependency_offsets[id];
+        if (dependencies > statistics->max_in_degree) {
+            statistics->max_in_degree = dependencies;
+        }
+    }
+
+    if (QBAFPlan_EnsureComponents(plan) < 0) {
+        return -1;
+    }
+    statistics->components = plan->components_size;
+    for (Py_ssize_t component = 0; component < plan->components_size; component++) {
+        Py_ssize_t members = plan->component_offsets[component+1] - plan->component_offsets[component];
+        if (members > statistics->largest_component) {
+            statistics->largest_component = members;
+        }
+    }
+
+    if (plan->schedule == NULL) {
+        return _QBAFPlan_cycle_statistics(plan, statistics);
+    }
+
+    // The level of an argument is one more than the highest level of its attackers and supporters
+    Py_ssize_t *levels = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *widths = PyMem_Calloc(size + 1, sizeof(Py_ssize_t));
+    if (levels == NULL || widths == NULL) {
+        PyMem_Free(levels); PyMem_Free(widths);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (Py_ssize_t index = 0; index < size; index++) {
+        Py_ssize_t id = plan->schedule[index];
+        Py_ssize_t level = 0;
+        for (Py_ssize_t edge = plan->dependency_offsets[id]; edge < plan->supporter_starts[id]; edge++) {
+            level = levels[plan->dependencies[edge]] + 1 > level ? levels[plan->dependencies[edge]] + 1 : level;
+        }
+        for (Py_ssize_t edge = plan->supporter_starts[id]; edge < plan->dependency_offsets[id+1]; edge++) {
+            level = levels[plan->dependencies[edge]] + 1 > level ? levels[plan->dependencies[edge]] + 1 : level;
+        }
+        levels[id] = level;
+        if (++widths[level] > statistics->max_level_width) {
+            statistics->max_level_width = widths[level];
+        }
+        if (level + 1 > statistics->levels) {
+            statistics->levels = level + 1;
+        }
+    }
+    PyMem_Free(levels); PyMem_Free(widths);
+    return 0;
+}
+
+/**
+ * @brief Python definition for the class QBAFPlan (defined below)
+ *
+ */
+static PyTypeObject QBAFPlanType;
+
+PyObject *
+QBAFPlan_Create(PyObject *id_arguments, PyObject *argument_ids,
+                QBAFARelationsObject *attack_relations, QBAFARelationsObject *support_relations,
+                const QBAFSemantics *settings)
+{
+    QBAFPlanObject *plan = (QBAFPlanObject *) QBAFPlanType.tp_alloc(&QBAFPlanType, 0);
+    if (plan == NULL) {
+        return NULL;
+    }
+
+    Py_ssize_t size = PyList_GET_SIZE(id_arguments);
+    plan->size = size;
+    plan->ordering = STR_NATURAL_ORDERING;
+    plan->settings = *settings;
+    Py_XINCREF(plan->settings.aggregation_function_callable);
+    Py_XINCREF(plan->settings.influence_function_callable);
+
+    plan->arguments = PyList_AsTuple(id_arguments);
+    if (plan->arguments == NULL) {
+        Py_DECREF(plan);
+        return NULL;
+    }
+
+    Py_ssize_t relations_size = QBAFARelations_Size(attack_relations) + QBAFARelations_Size(support_relations);
+    plan->dependency_offsets = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    plan->supporter_starts = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    plan->dependencies = PyMem_Malloc((relations_size + 1) * sizeof(Py_ssize_t));
+    if (plan->dependency_offsets == NULL || plan->supporter_starts == NULL || plan->dependencies == NULL) {
+        Py_DECREF(plan);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    if (_QBAFPlan_fill_dependencies(plan, id_arguments, argument_ids, attack_relations, support_relations) < 0) {
+        Py_DECREF(plan);
+        return NULL;
+    }
+
+    plan->max_dependencies = 0;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        Py_ssize_t number_of_dependencies = plan->dependency_offsets[id+1]
+                                          - plan->dependency_offsets[id];
+        if (number_of_dependencies > plan->max_dependencies) {
+            plan->max_dependencies = number_of_dependencies;
+        }
+    }
+
+    if (_QBAFPlan_build_schedule(plan) < 0) {
+        Py_DECREF(plan);
+        return NULL;
+    }
+
+    return (PyObject *) plan;
+}
+
+/**
+ * @brief Struct used to sort ids by their degree.
+ *
+ */
+typedef struct {
+    Py_ssize_t degree;
+    Py_ssize_t id;
+} QBAFDegreeItem;
+
+/**
+ * @brief Compare two QBAFDegreeItem by degree and then by id.
+ *
+ * @param a a QBAFDegreeItem
+ * @param b a QBAFDegreeItem
+ * @return int negative if a goes first, positive if b goes first, 0 if they are equal
+ */
+static int
+_QBAFDegreeItem_compare(const void *a, const void *b)
+{
+    const QBAFDegreeItem *item_a = a, *item_b = b;
+    if (item_a->degree != item_b->degree) {
+        return item_a->degree < item_b->degree ? -1 : 1;
+    }
+    return item_a->id < item_b->id ? -1 : (item_a->id > item_b->id);
+}
+
+/**
+ * @brief Fill order with the ids of the plan in reverse Cuthill-McKee order,
+ * ignoring the direction and the kind of the relations.
+ *
+ * @param plan a QBAFPlan with successors
+ * @param order an array of size ids where the new order is stored (order[new id] = old id)
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFPlan_rcm_order(QBAFPlanObject *plan, Py_ssize_t *order)
+{
+    Py_ssize_t size = plan->size;
+    QBAFDegreeItem *items = PyMem_Malloc((size + 1) * sizeof(QBAFDegreeItem));
+    QBAFDegreeItem *neighbours = PyMem_Malloc((size + 1) * sizeof(QBAFDegreeItem));
+    char *visited = PyMem_Calloc(size + 1, sizeof(char));
+    if (items == NULL || neighbours == NULL || visited == NULL) {
+        PyMem_Free(items); PyMem_Free(neighbours); PyMem_Free(visited);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (Py_ssize_t id = 0; id < size; id++) {
+        items[id].id = id;
+        items[id].degree = plan->dependency_offsets[id+1]
+                         - plan->dependency_offsets[id]
+                         + plan->successor_offsets[id+1] - plan->successor_offsets[id];
+    }
+    // Roots are taken by increasing degree, while items keeps the degree of every id
+    QBAFDegreeItem *roots = PyMem_Malloc((size + 1) * sizeof(QBAFDegreeItem));
+    if (roots == NULL) {
+        PyMem_Free(items); PyMem_Free(neighbours); PyMem_Free(visited);
+        PyErr_NoMemory();
+        return -1;
+    }
+    memcpy(roots, items, size * sizeof(QBAFDegreeItem));
+    qsort(roots, size, sizeof(QBAFDegreeItem), _QBAFDegreeItem_compare);
+
+    const Py_ssize_t *offsets[2] = {plan->dependency_offsets, plan->successor_offsets};
+    const Py_ssize_t *adjacent[2] = {plan->dependencies, plan->successors};
+    Py_ssize_t ordered = 0;
+
+    for (Py_ssize_t root_index = 0; root_index < size; root_index++) {
+        Py_ssize_t root = roots[root_index].id;
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = 1;
+        Py_ssize_t head = ordered;
+        order[ordered++] = root;
+
+        // Breadth-first search, visiting the neighbours of every id by increasing degree
+        while (head < ordered) {
+            Py_ssize_t current = order[head++];
+            Py_ssize_t neighbours_size = 0;
+            for (int kind = 0; kind < 2; kind++) {
+                for (Py_ssize_t edge = offsets[kind][current]; edge < offsets[kind][current+1]; edge++) {
+                    Py_ssize_t neighbour = adjacent[kind][edge];
+                    if (!visited[neighbour]) {
+                        visited[neighbour] = 1;
+                        neighbours[neighbours_size++] = items[neighbour];
+                    }
+                }
+            }
+            qsort(neighbours, neighbours_size, sizeof(QBAFDegreeItem), _QBAFDegreeItem_compare);
+            for (Py_ssize_t index = 0; index < neighbours_size; index++) {
+                order[ordered++] = neighbours[index].id;
+            }
+        }
+    }
+
+    // Reverse the Cuthill-McKee order
+    for (Py_ssize_t index = 0; index < size / 2; index++) {
+        Py_ssize_t swap = order[index];
+        order[index] = order[size - 1 - index];
+        order[size - 1 - index] = swap;
+    }
+
+    PyMem_Free(items); PyMem_Free(neighbours); PyMem_Free(visited); PyMem_Free(roots);
+    return 0;
+}
+
+/**
+ * @brief Fill order with the ids of an acyclic plan sorted by topological level
+ * (the length of the longest chain of attackers and supporters that ends in the argument), then by id.
+ *
+ * @param plan a QBAFPlan with a schedule
+ * @param order an array of size ids where the new order is stored (order[new id] = old id)
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFPlan_level_order(QBAFPlanObject *plan, Py_ssize_t *order)
+{
+    Py_ssize_t size = plan->size;
+    Py_ssize_t *levels = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *level_offsets = PyMem_Calloc(size + 2, sizeof(Py_ssize_t));
+    if (levels == NULL || level_offsets == NULL) {
+        PyMem_Free(levels); PyMem_Free(level_offsets);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (Py_ssize_t index = 0; index < size; index++) {
+        Py_ssize_t id = plan->schedule[index];
+        Py_ssize_t level = 0;
+        for (Py_ssize_t edge = plan->dependency_offsets[id]; edge < plan->supporter_starts[id]; edge++) {
+            if (levels[plan->dependencies[edge]] + 1 > level) {
+                level = levels[plan->dependencies[edge]] + 1;
+            }
+        }
+        for (Py_ssize_t edge = plan->supporter_starts[id]; edge < plan->dependency_offsets[id+1]; edge++) {
+            if (levels[plan->dependencies[edge]] + 1 > level) {
+                level = levels[plan->dependencies[edge]] + 1;
+            }
+        }
+        levels[id] = level;
+        level_offsets[level + 1]++;
+    }
+
+    // Counting sort by level, stable by id
+    for (Py_ssize_t level = 0; level < size; level++) {
+        level_offsets[level + 1] += level_offsets[level];
+    }
+    for (Py_ssize_t id = 0; id < size; id++) {
+        order[level_offsets[levels[id]]++] = id;
+    }
+
+    PyMem_Free(levels); PyMem_Free(level_offsets);
+    return 0;
+}
+
+/**
+ * @brief Fill the dependencies of the reordered plan from the dependencies of plan.
+ * The relations of every argument keep their order, so the aggregations are calculated exactly in the same way.
+ *
+ * @param plan the QBAFPlan that is reordered
+ * @param order the new order (order[new id] = old id)
+ * @param new_ids the new id of every old id
+ * @param reordered the reordered QBAFPlan, with its dependency arrays allocated
+ */
+static void
+_QBAFPlan_permute_dependencies(QBAFPlanObject *plan, const Py_ssize_t *order, const Py_ssize_t *new_ids,
+                               QBAFPlanObject *reordered)
+{
+    Py_ssize_t offset = 0;
+    for (Py_ssize_t new_id = 0; new_id < plan->size; new_id++) {
+        Py_ssize_t id = order[new_id];
+        reordered->dependency_offsets[new_id] = offset;
+        reordered->supporter_starts[new_id] = offset + plan->supporter_starts[id] - plan->dependency_offsets[id];
+        for (Py_ssize_t edge = plan->dependency_offsets[id]; edge < plan->dependency_offsets[id+1]; edge++) {
+            reordered->dependencies[offset++] = new_ids[plan->dependencies[edge]];
+        }
+    }
+    reordered->dependency_offsets[plan->size] = offset;
+}
+
+PyObject *
+QBAFPlan_Reorder(QBAFPlanObject *plan, const char *ordering)
+{
+    Py_ssize_t size = plan->size;
+    int topological = strcmp(ordering, STR_TOPOLOGICAL_ORDERING) == 0;
+
+    if (strcmp(ordering, STR_NATURAL_ORDERING) == 0) {
+        Py_INCREF(plan);
+        return (PyObject *) plan;
+    }
+    if (!topological && strcmp(ordering, STR_RCM_ORDERING) != 0) {
+        PyErr_SetString(PyExc_ValueError, "ordering must be 'natural', 'rcm' or 'topological'");
+        return NULL;
+    }
+    if (topological && plan->schedule == NULL) {
+        PyErr_SetString(PyExc_ValueError, "the topological ordering requires an acyclic framework");
+        return NULL;
+    }
+    if (!topological && QBAFPlan_EnsureSuccessors(plan) < 0) {
+        return NULL;
+    }
+
+    Py_ssize_t *order = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *new_ids = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    if (order == NULL || new_ids == NULL) {
+        PyMem_Free(order); PyMem_Free(new_ids);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    if ((topological ? _QBAFPlan_level_order(plan, order) : _QBAFPlan_rcm_order(plan, order)) < 0) {
+        PyMem_Free(order); PyMem_Free(new_ids);
+        return NULL;
+    }
+    for (Py_ssize_t new_id = 0; new_id < size; new_id++) {
+        new_ids[order[new_id]] = new_id;
+    }
+
+    QBAFPlanObject *reordered = (QBAFPlanObject *) QBAFPlanType.tp_alloc(&QBAFPlanType, 0);
+    if (reordered == NULL) {
+        PyMem_Free(order); PyMem_Free(new_ids);
+        return NULL;
+    }
+    reordered->size = size;
+    reordered->settings = plan->settings;
+    Py_XINCREF(reordered->settings.aggregation_function_callable);
+    Py_XINCREF(reordered->settings.influence_function_callable);
+    reordered->max_dependencies = plan->max_dependencies;
+    reordered->ordering = topological ? STR_TOPOLOGICAL_ORDERING : STR_RCM_ORDERING;
+
+    reordered->arguments = PyTuple_New(size);
+    reordered->dependency_offsets = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    reordered->supporter_starts = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    reordered->dependencies = PyMem_Malloc((plan->dependency_offsets[size] + 1) * sizeof(Py_ssize_t));
+    if (plan->schedule != NULL) {
+        reordered->schedule = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+        reordered->ranks = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    }
+    if (reordered->arguments == NULL || reordered->dependency_offsets == NULL ||
+        reordered->supporter_starts == NULL || reordered->dependencies == NULL ||
+        (plan->schedule != NULL && (reordered->schedule == NULL || reordered->ranks == NULL))) {
+        PyMem_Free(order); PyMem_Free(new_ids);
+        Py_DECREF(reordered);
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        return NULL;
+    }
+
+    for (Py_ssize_t new_id = 0; new_id < size; new_id++) {
+        PyObject *argument = PyTuple_GET_ITEM(plan->arguments, order[new_id]);
+        Py_INCREF(argument);
+        PyTuple_SET_ITEM(reordered->arguments, new_id, argument);
+    }
+    _QBAFPlan_permute_dependencies(plan, order, new_ids, reordered);
+
+    if (plan->schedule != NULL) {
+        // The level order is already a topological order, so the arguments are evaluated sequentially
+        for (Py_ssize_t index = 0; index < size; index++) {
+            reordered->schedule[index] = topological ? index : new_ids[plan->schedule[index]];
+            reordered->ranks[reordered->schedule[index]] = index;
+        }
+    }
+
+    PyMem_Free(order); PyMem_Free(new_ids);
+    return (PyObject *) reordered;
+}
+
+/**
+ * @brief Struct with a partition of the ids of a plan into classes identified by a signature:
+ * a key of the argument itself and the sorted classes of its attackers and supporters.
+ *
+ */
+typedef struct {
+    Py_ssize_t *table;              /* open addressing table of classes, -1 if the slot is empty */
+    Py_ssize_t  table_mask;         /* the number of slots of table minus 1 (a power of 2 minus 1) */
+    uint64_t   *hashes;             /* the hash of the signature of every class */
+    uint64_t   *keys;               /* the key of the argument of every class */
+    Py_ssize_t *signature_offsets;  /* the signature of class c is signatures[signature_offsets[c]:signature_offsets[c+1]] */
+    Py_ssize_t *signatures;         /* the number of attackers, then the sorted attacker classes and the sorted supporter classes */
+    Py_ssize_t *representatives;    /* the first id of every class */
+    Py_ssize_t  size;               /* number of classes */
+} QBAFPartition;
+
+/**
+ * @brief Compare two Py_ssize_t.
+ *
+ * @param a a Py_ssize_t
+ * @param b a Py_ssize_t
+ * @return int negative if a goes first, positive if b goes first, 0 if they are equal
+ */
+static int
+_QBAFPlan_compare_ids(const void *a, const void *b)
+{
+    Py_ssize_t id_a = *(const Py_ssize_t *)a, id_b = *(const Py_ssize_t *)b;
+    return id_a < id_b ? -1 : (id_a > id_b);
+}
+
+/**
+ * @brief Remove all the classes of the partition.
+ *
+ * @param partition a QBAFPartition
+ */
+static void
+_QBAFPartition_reset(QBAFPartition *partition)
+{
+    for (Py_ssize_t slot = 0; slot <= partition->table_mask; slot++) {
+        partition->table[slot] = -1;
+    }
+    partition->signature_offsets[0] = 0;
+    partition->size = 0;
+}
+
+/**
+ * @brief Return the class of the argument id given its key and the classes of the other ids,
+ * creating a new class if no class has the same signature.
+ *
+ * @param partition a QBAFPartition
+ * @param plan a QBAFPlan
+ * @param id the id of the argument
+ * @param key the key of the argument (e.g. the bits of its initial strength)
+ * @param dependency_classes the classes of the attackers and supporters, NULL to classify by key only
+ * @param signature scratch space with room for plan->max_dependencies + 1 items
+ * @return Py_ssize_t the class of id
+ */
+static Py_ssize_t
+_QBAFPartition_classify(QBAFPartition *partition, QBAFPlanObject *plan, Py_ssize_t id, uint64_t key,
+                        const Py_ssize_t *dependency_classes, Py_ssize_t *signature)
+{
+    Py_ssize_t signature_size = 0;
+    if (dependency_classes != NULL) {
+        Py_ssize_t attackers_size = plan->supporter_starts[id] - plan->dependency_offsets[id];
+        signature[signature_size++] = attackers_size;
+        for (Py_ssize_t edge = plan->dependency_offsets[id]; edge < plan->dependency_offsets[id+1]; edge++) {
+            signature[signature_size++] = dependency_classes[plan->dependencies[edge]];
+        }
+        // The relations of an argument are a multiset: their order does not matter
+        qsort(signature + 1, attackers_size, sizeof(Py_ssize_t), _QBAFPlan_compare_ids);
+        qsort(signature + 1 + attackers_size, signature_size - 1 - attackers_size, sizeof(Py_ssize_t), _QBAFPlan_compare_ids);
+    }
+
+    uint64_t hash = key ^ 0x9e3779b97f4a7c15ULL;
+    for (Py_ssize_t index = 0; index < signature_size; index++) {
+        hash = (hash ^ (uint64_t) signature[index]) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+
+    Py_ssize_t slot = (Py_ssize_t) (hash & (uint64_t) partition->table_mask);
+    while (partition->table[slot] >= 0) {
+        Py_ssize_t class = partition->table[slot];
+        Py_ssize_t offset = partition->signature_offsets[class];
+        if (partition->hashes[class] == hash && partition->keys[class] == key &&
+            partition->signature_offsets[class+1] - offset == signature_size &&
+            memcmp(partition->signatures + offset, signature, signature_size * sizeof(Py_ssize_t)) == 0) {
+            return class;
+        }
+        slot = (slot + 1) & partition->table_mask;
+    }
+
+    Py_ssize_t class = partition->size++;
+    Py_ssize_t offset = partition->signature_offsets[class];
+    memcpy(partition->signatures + offset, signature, signature_size * sizeof(Py_ssize_t));
+    partition->signature_offsets[class+1] = offset + signature_size;
+    partition->hashes[class] = hash;
+    partition->keys[class] = key;
+    partition->representatives[class] = id;
+    partition->table[slot] = class;
+    return class;
+}
+
+/**
+ * @brief Store in classes the coarsest partition of the ids of plan into strength-equivalent classes,
+ * and return the number of classes.
+ * Acyclic plans are partitioned in one pass in topological order, since the attackers and supporters of an argument
+ * are classified before it. Cyclic plans are refined from the initial strengths until the partition is stable.
+ *
+ * @param plan a QBAFPlan
+ * @param initial_strengths the initial strengths indexed by id
+ * @param partition a QBAFPartition with room for plan->size classes
+ * @param classes the array where the class of every id is stored
+ * @param previous_classes scratch space with room for plan->size items
+ * @param signature scratch space with room for plan->max_dependencies + 1 items
+ * @return Py_ssize_t the number of classes
+ */
+static Py_ssize_t
+_QBAFPlan_partition(QBAFPlanObject *plan, const double *initial_strengths, QBAFPartition *partition,
+                    Py_ssize_t *classes, Py_ssize_t *previous_classes, Py_ssize_t *signature)
+{
+    Py_ssize_t size = plan->size;
+
+    _QBAFPartition_reset(partition);
+    if (plan->schedule != NULL) {
+        for (Py_ssize_t index = 0; index < size; index++) {
+            Py_ssize_t id = plan->schedule[index];
+            uint64_t key;
+            memcpy(&key, &initial_strengths[id], sizeof(uint64_t));
+            classes[id] = _QBAFPartition_classify(partition, plan, id, key, classes, signature);
+        }
+        return partition->size;
+    }
+
+    for (Py_ssize_t id = 0; id < size; id++) {
+        uint64_t key;
+        memcpy(&key, &initial_strengths[id], sizeof(uint64_t));
+        classes[id] = _QBAFPartition_classify(partition, plan, id, key, NULL, signature);
+    }
+    // Every round refines the previous partition, so it is stable once the number of classes does not grow
+    Py_ssize_t classes_size;
+    do {
+        classes_size = partition->size;
+        memcpy(previous_classes, classes, size * sizeof(Py_ssize_t));
+        _QBAFPartition_reset(partition);
+        for (Py_ssize_t id = 0; id < size; id++) {
+            classes[id] = _QBAFPartition_classify(partition, plan, id, (uint64_t) previous_classes[id],
+                                                  previous_classes, signature);
+        }
+    } while (partition->size > classes_size);
+
+    return partition->size;
+}
+
+PyObject *
+QBAFPlan_Compress(QBAFPlanObject *plan, const double *initial_strengths, Py_ssize_t *classes)
+{
+    Py_ssize_t size = plan->size;
+    Py_ssize_t relations_size = plan->dependency_offsets[size];
+
+    QBAFPartition partition;
+    Py_ssize_t table_size = 16;
+    while (table_size < 2 * size) {
+        table_size *= 2;
+    }
+    partition.table = PyMem_Malloc(table_size * sizeof(Py_ssize_t));
+    partition.table_mask = table_size - 1;
+    partition.hashes = PyMem_Malloc((size + 1) * sizeof(uint64_t));
+    partition.keys = PyMem_Malloc((size + 1) * sizeof(uint64_t));
+    partition.signature_offsets = PyMem_Malloc((size + 2) * sizeof(Py_ssize_t));
+    partition.signatures = PyMem_Malloc((size + relations_size + 1) * sizeof(Py_ssize_t));
+    partition.representatives = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *previous_classes = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    Py_ssize_t *signature = PyMem_Malloc((plan->max_dependencies + 2) * sizeof(Py_ssize_t));
+    QBAFPlanObject *quotient = NULL;
+
+    if (partition.table == NULL || partition.hashes == NULL || partition.keys == NULL ||
+        partition.signature_offsets == NULL || partition.signatures == NULL || partition.representatives == NULL ||
+        previous_classes == NULL || signature == NULL) {
+        PyErr_NoMemory();
+        goto error;
+    }
+
+    Py_ssize_t classes_size = _QBAFPlan_partition(plan, initial_strengths, &partition, classes, previous_classes, signature);
+
+    quotient = (QBAFPlanObject *) QBAFPlanType.tp_alloc(&QBAFPlanType, 0);
+    if (quotient == NULL) {
+        goto error;
+    }
+    quotient->size = classes_size;
+    quotient->settings = plan->settings;
+    Py_XINCREF(quotient->settings.aggregation_function_callable);
+    Py_XINCREF(quotient->settings.influence_function_callable);
+    quotient->ordering = STR_NATURAL_ORDERING;
+
+    // The relations of every class are those of its representative
+    Py_ssize_t dependencies_size = 0;
+    for (Py_ssize_t class = 0; class < classes_size; class++) {
+        Py_ssize_t id = partition.representatives[class];
+        dependencies_size += plan->dependency_offsets[id+1] - plan->dependency_offsets[id];
+    }
+    quotient->arguments = PyTuple_New(classes_size);
+    quotient->dependency_offsets = PyMem_Malloc((classes_size + 1) * sizeof(Py_ssize_t));
+    quotient->supporter_starts = PyMem_Malloc((classes_size + 1) * sizeof(Py_ssize_t));
+    quotient->dependencies = PyMem_Malloc((dependencies_size + 1) * sizeof(Py_ssize_t));
+    if (plan->schedule != NULL) {
+        quotient->schedule = PyMem_Malloc((classes_size + 1) * sizeof(Py_ssize_t));
+        quotient->ranks = PyMem_Malloc((classes_size + 1) * sizeof(Py_ssize_t));
+    }
+    if (quotient->arguments == NULL || quotient->dependency_offsets == NULL ||
+        quotient->supporter_starts == NULL || quotient->dependencies == NULL ||
+        (plan->schedule != NULL && (quotient->schedule == NULL || quotient->ranks == NULL))) {
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        goto error;
+    }
+
+    Py_ssize_t offset = 0;
+    for (Py_ssize_t class = 0; class < classes_size; class++) {
+        Py_ssize_t id = partition.representatives[class];
+        PyObject *argument = PyTuple_GET_ITEM(plan->arguments, id);
+        Py_INCREF(argument);
+        PyTuple_SET_ITEM(quotient->arguments, class, argument);
+
+        quotient->dependency_offsets[class] = offset;
+        quotient->supporter_starts[class] = offset + plan->supporter_starts[id] - plan->dependency_offsets[id];
+        for (Py_ssize_t edge = plan->dependency_offsets[id]; edge < plan->dependency_offsets[id+1]; edge++) {
+            quotient->dependencies[offset++] = classes[plan->dependencies[edge]];
+        }
+
+        Py_ssize_t dependencies = offset - quotient->dependency_offsets[class];
+        if (dependencies > quotient->max_dependencies) {
+            quotient->max_dependencies = dependencies;
+        }
+        // Classes are created in topological order, after the classes of their attackers and supporters
+        if (quotient->schedule != NULL) {
+            quotient->schedule[class] = class;
+            quotient->ranks[class] = class;
+        }
+    }
+    quotient->dependency_offsets[classes_size] = offset;
+
+    PyMem_Free(partition.table); PyMem_Free(partition.hashes); PyMem_Free(partition.keys);
+    PyMem_Free(partition.signature_offsets); PyMem_Free(partition.signatures); PyMem_Free(partition.representatives);
+    PyMem_Free(previous_classes); PyMem_Free(signature);
+    return (PyObject *) quotient;
+
+error:
+    Py_XDECREF(quotient);
+    PyMem_Free(partition.table); PyMem_Free(partition.hashes); PyMem_Free(partition.keys);
+    PyMem_Free(partition.signature_offsets); PyMem_Free(partition.signatures); PyMem_Free(partition.representatives);
+    PyMem_Free(previous_classes); PyMem_Free(signature);
+    return NULL;
+}
+
+/**
+ * @brief Store in bandwidth the maximum and in mean_distance the average distance between the id of an argument
+ * and the ids of its attackers and supporters, a proxy of the cache misses of the evaluation.
+ *
+ * @param plan a QBAFPlan
+ * @param bandwidth where the maximum distance is stored
+ * @param mean_distance where the average distance is stored
+ */
+static void
+_QBAFPlan_dependency_distances(QBAFPlanObject *plan, Py_ssize_t *bandwidth, double *mean_distance)
+{
+    Py_ssize_t maximum = 0, relations = 0;
+    double total = 0;
+
+    for (Py_ssize_t id = 0; id < plan->size; id++) {
+        for (Py_ssize_t edge = plan->dependency_offsets[id]; edge < plan->dependency_offsets[id+1]; edge++) {
+            Py_ssize_t dependency = plan->dependencies[edge];
+            Py_ssize_t distance = dependency > id ? dependency - id : id - dependency;
+            if (distance > maximum) {
+                maximum = distance;
+            }
+            total += (double) distance;
+            relations++;
+        }
+    }
+
+    *bandwidth = maximum;
+    *mean_distance = relations > 0 ? total / relations : 0.0;
+}
+
+/**
+ * @brief Read the initial strengths given to evaluate into a new array of doubles.
+ * They can be given as an object supporting the buffer protocol with format 'd' or as a sequence of numbers.
+ *
+ * @param self a QBAFPlan
+ * @param initial_strengths the python object with the initial strengths
+ * @return double* a new array (it must be freed with PyMem_Free), NULL if an error occurred
+ */
+static double *
+_QBAFPlan_read_strengths(QBAFPlanObject *self, PyObject *initial_strengths)
+{
+    double *strengths = PyMem_Malloc((self->size + 1) * sizeof(double));
+    if (strengths == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    if (PyObject_CheckBuffer(initial_strengths)) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(initial_strengths, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+            PyMem_Free(strengths);
+            return NULL;
+        }
+        const char *format = view.format != NULL ? view.format : "B";
+        if (format[0] == '@' || format[0] == '=' || format[0] == '<') {
+            format++;
+        }
+        if (strcmp(format, "d") != 0 || view.itemsize != sizeof(double)) {
+            PyBuffer_Release(&view);
+            PyMem_Free(strengths);
+            PyErr_SetString(PyExc_TypeError, "initial_strengths buffer must contain doubles (format 'd')");
+            return NULL;
+        }
+        if (view.len != self->size * (Py_ssize_t)sizeof(double)) {
+            PyBuffer_Release(&view);
+            PyMem_Free(strengths);
+            PyErr_SetString(PyExc_ValueError, "the length of initial_strengths must be equal to the number of arguments of the plan");
+            return NULL;
+        }
+        if (self->size > 0) {
+            memcpy(strengths, view.buf, view.len);
+        }
+        PyBuffer_Release(&view);
+    } else {
+        PyObject *sequence = PySequence_Fast(initial_strengths, "initial_strengths must be a buffer of doubles or a sequence of numbers");
+        if (sequence == NULL) {
+            PyMem_Free(strengths);
+            return NULL;
+        }
+        if (PySequence_Fast_GET_SIZE(sequence) != self->size) {
+            Py_DECREF(sequence);
+            PyMem_Free(strengths);
+            PyErr_SetString(PyExc_ValueError, "the length of initial_strengths must be equal to the number of arguments of the plan");
+            return NULL;
+        }
+        for (Py_ssize_t id = 0; id < self->size; id++) {
+            PyObject *item = PySequence_Fast_GET_ITEM(sequence, id);
+            if (!PyFloat_Check(item) && !PyLong_Check(item)) {
+                Py_DECREF(sequence);
+                PyMem_Free(strengths);
+                PyErr_SetString(PyExc_TypeError, "all items of initial_strengths must be of a numeric type (int, float)");
+                return NULL;
+            }
+            strengths[id] = PyFloat_AsDouble(item);
+            if (strengths[id] == -1.0 && PyErr_Occurred()) {
+                Py_DECREF(sequence);
+                PyMem_Free(strengths);
+                return NULL;
+            }
+        }
+        Py_DECREF(sequence);
+    }
+
+    for (Py_ssize_t id = 0; id < self->size; id++) {
+        if (strengths[id] < self->settings.min_strength || strengths[id] > self->settings.max_strength) {
+            PyMem_Free(strengths);
+            char msg[100];
+            sprintf(msg, "every initial_strength must be within range (%.2f, %.2f)", self->settings.min_strength, self->settings.max_strength);
+            PyErr_SetString(PyExc_ValueError, msg);
+            return NULL;
+        }
+    }
+
+    return strengths;
+}
+
+/**
+ * @brief Return a new array.array('d') of the given size, NULL if an error occurred.
+ *
+ * @param size the number of items
+ * @return PyObject* a new array.array
+ */
+static PyObject *
+_QBAFPlan_new_double_array(Py_ssize_t size)
+{
+    PyObject *array_module = PyImport_ImportModule("array");
+    if (array_module == NULL) {
+        return NULL;
+    }
+    PyObject *zeros = PyBytes_FromStringAndSize(NULL, size * sizeof(double));
+    if (zeros == NULL) {
+        Py_DECREF(array_module);
+        return NULL;
+    }
+    memset(PyBytes_AS_STRING(zeros), 0, size * sizeof(double));
+    PyObject *array = PyObject_CallMethod(array_module, "array", "sO", "d", zeros);
+    Py_DECREF(array_module);
+    Py_DECREF(zeros);
+    return array;
+}
+
+/**
+ * @brief Return the final strengths of the plan given some initial strengths, NULL if an error occurred.
+ *
+ * @param self an instance of QBAFPlan
+ * @param args the argument values (initial_strengths: buffer or sequence, out: writable buffer)
+ * @param kwds the argument names
+ * @return PyObject* out if given, a new array.array('d') otherwise
+ */
+static PyObject *
+QBAFPlan_evaluate(QBAFPlanObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"initial_strengths", "out", NULL};
+    PyObject *initial_strengths, *out = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
+                                     &initial_strengths, &out))
+        return NULL;
+
+    if (self->schedule == NULL && !self->settings.allow_cycles) {
+        PyErr_SetString(PyExc_NotImplementedError, "calculate final strengths of cyclic framework requires allow_cycles=True");
+        return NULL;
+    }
+
+    if (out == Py_None) {
+        out = _QBAFPlan_new_double_array(self->size);
+        if (out == NULL) {
+            return NULL;
+        }
+    } else {
+        Py_INCREF(out);
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(out, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE) < 0) {
+        Py_DECREF(out);
+        return NULL;
+    }
+    const char *format = view.format != NULL ? view.format : "B";
+    if (format[0] == '@' || format[0] == '=' || format[0] == '<') {
+        format++;
+    }
+    if (strcmp(format, "d") != 0 || view.len != self->size * (Py_ssize_t)sizeof(double)) {
+        PyBuffer_Release(&view); Py_DECREF(out);
+        PyErr_SetString(PyExc_ValueError, "out must be a writable buffer of doubles with one item per argument of the plan");
+        return NULL;
+    }
+
+    double *initial = _QBAFPlan_read_strengths(self, initial_strengths);
+    double *previous = PyMem_Malloc((self->size + 1) * sizeof(double));
+    double *buffer = PyMem_Malloc((self->max_dependencies + 1) * sizeof(double));
+    if (initial == NULL || previous == NULL || buffer == NULL) {
+        PyMem_Free(initial); PyMem_Free(previous); PyMem_Free(buffer);
+        PyBuffer_Release(&view); Py_DECREF(out);
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        return NULL;
+    }
+
+    double *final = (double *) view.buf;
+    int result;
+    // The native kernels do not touch python objects, so other threads can run meanwhile
+    if (QBAFPlan_IsNative(self)) {
+        Py_BEGIN_ALLOW_THREADS
+        if (self->schedule != NULL) {
+            result = QBAFPlan_EvaluateAcyclic(self, initial, final, buffer);
+        } else {
+            result = QBAFPlan_EvaluateIterative(self, NULL, 0, initial, final, previous, buffer, NULL);
+        }
+        Py_END_ALLOW_THREADS
+    } else {
+        if (self->schedule != NULL) {
+            result = QBAFPlan_EvaluateAcyclic(self, initial, final, buffer);
+        } else {
+            result = QBAFPlan_EvaluateIterative(self, NULL, 0, initial, final, previous, buffer, NULL);
+        }
+    }
+
+    PyMem_Free(initial); PyMem_Free(previous); PyMem_Free(buffer);
+    PyBuffer_Release(&view);
+
+    if (result != 0) {
+        if (result > 0) {
+            PyErr_Format(PyExc_RuntimeError, "cyclic framework did not converge within %zd iterations",
+                         self->settings.max_iterations);
+        }
+        Py_DECREF(out);
+        return NULL;
+    }
+
+    return out;
+}
+
+/**
+ * @brief Return the number of arguments of the plan.
+ *
+ * @param self a QBAFPlan
+ * @return Py_ssize_t the number of arguments
+ */
+static Py_ssize_t
+QBAFPlan___len__(QBAFPlanObject *self)
+{
+    return self->size;
+}
+
+/**
+ * @brief Getter of the attribute arguments.
+ *
+ * @param self the QBAFPlan object
+ * @param closure
+ * @return PyObject* the tuple of QBAFArgument
+ */
+static PyObject *
+QBAFPlan_getarguments(QBAFPlanObject *self, void *closure)
+{
+    Py_INCREF(self->arguments);
+    return self->arguments;
+}
+
+/**
+ * @brief Getter of the attribute kernel.
+ *
+ * @param self the QBAFPlan object
+ * @param closure
+ * @return PyObject* new PyUnicode
+ */
+static PyObject *
+QBAFPlan_getkernel(QBAFPlanObject *self, void *closure)
+{
+    return PyUnicode_FromString(self->schedule != NULL ? STR_TOPOLOGICAL_KERNEL : STR_JACOBI_KERNEL);
+}
+
+/**
+ * @brief Getter of the attribute semantics.
+ *
+ * @param self the QBAFPlan object
+ * @param closure
+ * @return PyObject* new PyUnicode, or None if the semantics are custom
+ */
+static PyObject *
+QBAFPlan_getsemantics(QBAFPlanObject *self, void *closure)
+{
+    if (self->settings.semantics == NULL) {
+        Py_RETURN_NONE;
+    }
+    return PyUnicode_FromString(self->settings.semantics);
+}
+
+/**
+ * @brief A list with the attributes of the class QBAFPlan
+ *
+ */
+static PyMemberDef QBAFPlan_members[] = {
+    {NULL}  /* Sentinel */
+};
+
+PyDoc_STRVAR(plan_arguments_doc,
+"The arguments of the plan. The strength buffers given to and returned by evaluate follow this order.\n"
+"\n"
+"Type: tuple of QBAFArgument\n"
+);
+
+PyDoc_STRVAR(kernel_doc,
+"The kernel used to evaluate the plan: 'topological' for acyclic frameworks\n"
+"(every argument is calculated once after its attackers and supporters)\n"
+"and 'jacobi' for cyclic frameworks (synchronous fixed-point iteration).\n"
+"\n"
+"Type: str\n"
+);
+
+PyDoc_STRVAR(plan_semantics_doc,
+"The name of the semantics of the plan, None if custom functions are used.\n"
+"\n"
+"Type: str or None\n"
+);
+
+/**
+ * @brief Getter of the attribute ordering.
+ *
+ * @param self the QBAFPlan object
+ * @param closure
+ * @return PyObject* the name of the ordering of the arguments
+ */
+static PyObject *
+QBAFPlan_getordering(QBAFPlanObject *self, void *closure)
+{
+    return PyUnicode_FromString(self->ordering);
+}
+
+/**
+ * @brief Getter of the attribute bandwidth.
+ *
+ * @param self the QBAFPlan object
+ * @param closure
+ * @return PyObject* the maximum distance between the position of an argument and its attackers and supporters
+ */
+static PyObject *
+QBAFPlan_getbandwidth(QBAFPlanObject *self, void *closure)
+{
+    Py_ssize_t bandwidth;
+    double mean_distance;
+    _QBAFPlan_dependency_distances(self, &bandwidth, &mean_distance);
+    return PyLong_FromSsize_t(bandwidth);
+}
+
+/**
+ * @brief Getter of the attribute mean_dependency_distance.
+ *
+ * @param self the QBAFPlan object
+ * @param closure
+ * @return PyObject* the average distance between the position of an argument and its attackers and supporters
+ */
+static PyObject *
+QBAFPlan_getmean_dependency_distance(QBAFPlanObject *self, void *closure)
+{
+    Py_ssize_t bandwidth;
+    double mean_distance;
+    _QBAFPlan_dependency_distances(self, &bandwidth, &mean_distance);
+    return PyFloat_FromDouble(mean_distance);
+}
+
+PyDoc_STRVAR(ordering_doc,
+"The ordering of the arguments of the plan: 'natural' (the order of the framework),\n"
+"'rcm' (reverse Cuthill-McKee) or 'topological' (by topological level).\n"
+"\n"
+"Type: str\n"
+);
+
+PyDoc_STRVAR(bandwidth_doc,
+"The maximum distance between the position of an argument in the attribute arguments\n"
+"and the positions of its attackers and supporters.\n"
+"\n"
+"Type: int\n"
+);
+
+PyDoc_STRVAR(mean_dependency_distance_doc,
+"The average distance between the position of an argument in the attribute arguments\n"
+"and the positions of its attackers and supporters. Lower values mean that the strengths\n"
+"gathered for an argument are closer in memory, so the evaluation has fewer cache misses.\n"
+"\n"
+"Type: float\n"
+);
+
+/**
+ * @brief A list with the setters and getters of the class QBAFPlan
+ *
+ */
+static PyGetSetDef QBAFPlan_getsetters[] = {
+    {"arguments", (getter) QBAFPlan_getarguments, NULL,
+     plan_arguments_doc, NULL},
+    {"kernel", (getter) QBAFPlan_getkernel, NULL,
+     kernel_doc, NULL},
+    {"semantics", (getter) QBAFPlan_getsemantics, NULL,
+     plan_semantics_doc, NULL},
+    {"ordering", (getter) QBAFPlan_getordering, NULL,
+     ordering_doc, NULL},
+    {"bandwidth", (getter) QBAFPlan_getbandwidth, NULL,
+     bandwidth_doc, NULL},
+    {"mean_dependency_distance", (getter) QBAFPlan_getmean_dependency_distance, NULL,
+     mean_dependency_distance_doc, NULL},
+    {NULL}  /* Sentinel */
+};
+
+PyDoc_STRVAR(evaluate_doc,
+"evaluate(self, initial_strengths, out=None)\n"
+"--\n"
+"\n"
+"Return the final strengths of the arguments given their initial strengths.\n"
+"Both follow the order of the attribute arguments.\n"
+"\n"
+"Args:\n"
+"    initial_strengths (buffer or sequence): The initial strengths, either an object supporting\n"
+"        the buffer protocol with format 'd' (e.g. array.array('d')) or a sequence of numbers\n"
+"    out (buffer, optional): A writable buffer of doubles where the final strengths are stored\n"
+"\n"
+"Returns:\n"
+"    array.array: The final strengths (out if it was given)\n"
+"\n"
+"Raises:\n"
+"    ValueError: If the length of a buffer does not match the number of arguments\n"
+"        or an initial strength is out of range\n"
+"    NotImplementedError: If the plan is cyclic and cycles are not allowed\n"
+"    RuntimeError: If a cyclic plan does not converge\n"
+);
+
+/**
+ * @brief A list with the methods of the class QBAFPlan
+ *
+ */
+static PyMethodDef QBAFPlan_methods[] = {
+    {"evaluate", (PyCFunction) QBAFPlan_evaluate, METH_VARARGS | METH_KEYWORDS,
+     evaluate_doc},
+    {NULL}  /* Sentinel */
+};
+
+/**
+ * @brief A list with the sequence methods of the class QBAFPlan
+ *
+ */
+static PySequenceMethods QBAFPlan_sequencemethods = {
+    .sq_length = (lenfunc) QBAFPlan___len__,
+};
+
+PyDoc_STRVAR(QBAFPlan_doc,
+"Class representing an immutable evaluation plan of a QBAFramework, created with QBAFramework.compile().\n"
+"It keeps the arguments, the attackers and supporters of every argument in compressed arrays,\n"
+"the evaluation order and the semantics, so it can be evaluated many times with different initial strengths.\n"
+"It is not affected by later modifications of the framework, and it can be shared between threads.\n"
+);
+
+/**
+ * @brief Python definition for the class QBAFPlan
+ *
+ */
+static PyTypeObject QBAFPlanType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "qbaf.QBAFPlan",
+    .tp_doc = QBAFPlan_doc,
+    .tp_basicsize = sizeof(QBAFPlanObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_dealloc = (destructor) QBAFPlan_dealloc,
+    .tp_traverse = (traverseproc) QBAFPlan_traverse,
+    .tp_clear = (inquiry) QBAFPlan_clear,
+    .tp_members = QBAFPlan_members,
+    .tp_methods = QBAFPlan_methods,
+    .tp_getset = QBAFPlan_getsetters,
+    .tp_as_sequence = &QBAFPlan_sequencemethods,          // __len__
+};
+
+/**
+ * @brief Get the QBAFPlanType object created above that defines the class QBAFPlan
+ *
+ * @return PyTypeObject* a pointer to the QBAFPlan class definition
+ */
+PyTypeObject *get_QBAFPlanType(void) {
+    return &QBAFPlanType;
+}
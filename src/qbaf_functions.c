@@ -13,166 +13,85 @@
 
 /**
  * @brief Given the final strengths of attackers and supporters, return the result of the aggregation function 'sum'.
- * Return -1 if an error has occurred.
  * 
- * @param attacker_strengths PyList of attackers' final strengths
- * @param supporter_strengths PyList of supporters' final strengths
- * @return double the result of the aggregation function 'sum', -1 if an error has occurred.
+ * @param attacker_strengths array of attackers' final strengths
+ * @param attackers_size the number of attackers
+ * @param supporter_strengths array of supporters' final strengths
+ * @param supporters_size the number of supporters
+ * @return double the result of the aggregation function 'sum'
  */
-double sum(PyObject *attacker_strengths, PyObject *supporter_strengths)
+double sum(const double *attacker_strengths, Py_ssize_t attackers_size,
+           const double *supporter_strengths, Py_ssize_t supporters_size)
 {
     double attackers_aggregation = 0;
     double supporters_aggregation = 0;
 
-    PyObject *iterator = PyObject_GetIter(attacker_strengths);
-    PyObject *item;
-
-    if (iterator == NULL) {
-        return -1.0;
-    }
-
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        double strength = PyFloat_AsDouble(item);
-        Py_DECREF(item);
-        if (strength == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(iterator);
-            return -1;
-        }
-
-        attackers_aggregation = attackers_aggregation + strength;
-    }
-
-    Py_DECREF(iterator);
-
-    iterator = PyObject_GetIter(supporter_strengths);
-
-    if (iterator == NULL) {
-        return -1.0;
+    for (Py_ssize_t index = 0; index < attackers_size; index++) {
+        attackers_aggregation = attackers_aggregation + attacker_strengths[index];
     }
 
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        double strength = PyFloat_AsDouble(item);
-        Py_DECREF(item);
-        if (strength == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(iterator);
-            return -1;
-        }
-
-        supporters_aggregation = supporters_aggregation + strength;
+    for (Py_ssize_t index = 0; index < supporters_size; index++) {
+        supporters_aggregation = supporters_aggregation + supporter_strengths[index];
     }
 
-    Py_DECREF(iterator);
-
     return supporters_aggregation - attackers_aggregation;
 }
 
 /**
  * @brief Given the final strengths of attackers and supporters, return the result of the aggregation function 'product'.
- * Return -1 if an error has occurred.
  * 
- * @param attacker_strengths PyList of attackers' final strengths
- * @param supporter_strengths PyList of supporters' final strengths
- * @return double the result of the aggregation function 'product', -1 if an error has occurred.
+ * @param attacker_strengths array of attackers' final strengths
+ * @param attackers_size the number of attackers
+ * @param supporter_strengths array of supporters' final strengths
+ * @param supporters_size the number of supporters
+ * @return double the result of the aggregation function 'product'
  */
-double product(PyObject *attacker_strengths, PyObject *supporter_strengths)
+double product(const double *attacker_strengths, Py_ssize_t attackers_size,
+               const double *supporter_strengths, Py_ssize_t supporters_size)
 {
     double attackers_aggregation = 1;
     double supporters_aggregation = 1;
 
-    PyObject *iterator = PyObject_GetIter(attacker_strengths);
-    PyObject *item;
-
-    if (iterator == NULL) {
-        return -1.0;
+    for (Py_ssize_t index = 0; index < attackers_size; index++) {
+        attackers_aggregation = attackers_aggregation * (1 - attacker_strengths[index]);
     }
 
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        double strength = PyFloat_AsDouble(item);
-        Py_DECREF(item);
-        if (strength == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(iterator);
-            return -1;
-        }
-
-        attackers_aggregation = attackers_aggregation * (1 - strength);
+    for (Py_ssize_t index = 0; index < supporters_size; index++) {
+        supporters_aggregation = supporters_aggregation * (1 - supporter_strengths[index]);
     }
 
-    Py_DECREF(iterator);
-
-    iterator = PyObject_GetIter(supporter_strengths);
-
-    if (iterator == NULL) {
-        return -1.0;
-    }
-
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        double strength = PyFloat_AsDouble(item);
-        Py_DECREF(item);
-        if (strength == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(iterator);
-            return -1;
-        }
-
-        supporters_aggregation = supporters_aggregation * (1 - strength);
-    }
-
-    Py_DECREF(iterator);
-
     return attackers_aggregation - supporters_aggregation;
 }
 
 /**
  * @brief Given the final strengths of attackers and supporters, return the result of the aggregation function 'top'.
- * Return -1 if an error has occurred.
+ * Return -1 if the strength of an attacker is not within [-1, 1].
  * 
- * @param attacker_strengths PyList of attackers' final strengths
- * @param supporter_strengths PyList of supporters' final strengths
- * @return double the result of the aggregation function 'top', -1 if an error has occurred.
+ * @param attacker_strengths array of attackers' final strengths
+ * @param attackers_size the number of attackers
+ * @param supporter_strengths array of supporters' final strengths
+ * @param supporters_size the number of supporters
+ * @return double the result of the aggregation function 'top', -1 if an attacker strength is out of range.
  */
-double top(PyObject *attacker_strengths, PyObject *supporter_strengths)
+double top(const double *attacker_strengths, Py_ssize_t attackers_size,
+           const double *supporter_strengths, Py_ssize_t supporters_size)
 {
     double attackers_aggregation = 0;
     double supporters_aggregation = 0;
 
-    PyObject *iterator = PyObject_GetIter(attacker_strengths);
-    PyObject *item;
-
-    if (iterator == NULL) {
-        return -1.0;
-    }
-
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        double strength = PyFloat_AsDouble(item);
-        Py_DECREF(item);
-        if (strength > 1 || strength < -1 || (strength == -1.0 && PyErr_Occurred())) {
-            Py_DECREF(iterator);
+    for (Py_ssize_t index = 0; index < attackers_size; index++) {
+        double strength = attacker_strengths[index];
+        if (strength > 1 || strength < -1) {
             return -1;
         }
 
         attackers_aggregation = max(attackers_aggregation, strength);
     }
 
-    Py_DECREF(iterator);
-
-    iterator = PyObject_GetIter(supporter_strengths);
-
-    if (iterator == NULL) {
-        return -1.0;
+    for (Py_ssize_t index = 0; index < supporters_size; index++) {
+        supporters_aggregation = max(supporters_aggregation, supporter_strengths[index]);
     }
 
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        double strength = PyFloat_AsDouble(item);
-        Py_DECREF(item);
-        if (strength == -1.0 && PyErr_Occurred()) {
-            Py_DECREF(iterator);
-            return -1;
-        }
-
-        supporters_aggregation = max(supporters_aggregation, strength);
-    }
-
-    Py_DECREF(iterator);
-
     return supporters_aggregation - attackers_aggregation;
 }
 
@@ -34,18 +34,30 @@ PyInit_qbaf(void)
     // A pointer to the class description of QBAFARelations
     PyTypeObject *QBAFARelationsType = get_QBAFARelationsType();
 
+    // A pointer to the class description of QBAFARelationsView
+    PyTypeObject *QBAFARelationsViewType = get_QBAFARelationsViewType();
+
     // A pointer to the class description of QBAFramework
     PyTypeObject *QBAFrameworkType = get_QBAFrameworkType();
 
+    // A pointer to the class description of QBAFPlan
+    PyTypeObject *QBAFPlanType = get_QBAFPlanType();
+
     if (PyType_Ready(QBAFArgumentType) < 0)
         return NULL;
 
     if (PyType_Ready(QBAFARelationsType) < 0)
         return NULL;
 
+    if (PyType_Ready(QBAFARelationsViewType) < 0)
+        return NULL;
+
     if (PyType_Ready(QBAFrameworkType) < 0)
         return NULL;
 
+    if (PyType_Ready(QBAFPlanType) < 0)
+        return NULL;
+
     PyObject *m = PyModule_Create(&QBAFmodule);
     if (m == NULL)
         return NULL;
@@ -65,9 +77,30 @@ PyInit_qbaf(void)
         return NULL;
     }
     
+    Py_INCREF(QBAFARelationsViewType);
+    if (PyModule_AddObject(m, "QBAFARelationsView", (PyObject *) QBAFARelationsViewType) < 0) {
+        Py_DECREF(QBAFARelationsViewType);
+        Py_DECREF(QBAFARelationsType);
+        Py_DECREF(QBAFArgumentType);
+        Py_DECREF(m);
+        return NULL;
+    }
+
     Py_INCREF(QBAFrameworkType);
     if (PyModule_AddObject(m, "QBAFramework", (PyObject *) QBAFrameworkType) < 0) {
         Py_DECREF(QBAFrameworkType);
+        Py_DECREF(QBAFARelationsViewType);
+        Py_DECREF(QBAFARelationsType);
+        Py_DECREF(QBAFArgumentType);
+        Py_DECREF(m);
+        return NULL;
+    }
+
+    Py_INCREF(QBAFPlanType);
+    if (PyModule_AddObject(m, "QBAFPlan", (PyObject *) QBAFPlanType) < 0) {
+        Py_DECREF(QBAFPlanType);
+        Py_DECREF(QBAFrameworkType);
+        Py_DECREF(QBAFARelationsViewType);
         Py_DECREF(QBAFARelationsType);
         Py_DECREF(QBAFArgumentType);
         Py_DECREF(m);
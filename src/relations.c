@@ -17,12 +17,589 @@
  */
 //typedef struct {
 //    PyObject_HEAD
-//    PyObject *relations;        /* set of tuples (Agent: QBAFArgument, Patient: QBAFArgument) */
-//    PyObject *agent_patients;   /* dictonary of (key, value) = (Agent, set of Patients) */
-//    PyObject *patient_agents;   /* dictonary of (key, value) = (Patient, set of Agents) */
+//    QBAFPairSet pairs;          /* the relations (agent id, patient id); the set of tuples is only created on demand */
+//    PyObject *argument_ids;     /* dictionary (argument: QBAFArgument, id: int) with the id of every interned argument */
+//    PyObject *id_arguments;     /* list of QBAFArgument indexed by id */
+//    QBAFIdArray *patients;      /* the ids of the patients of every agent, indexed by the id of the agent */
+//    QBAFIdArray *agents;        /* the ids of the agents of every patient, indexed by the id of the patient */
+//    Py_ssize_t ids_capacity;    /* the allocated length of patients and agents */
+//    Py_ssize_t *shared;         /* number of copies that share pairs, patients and agents, NULL if only self uses them */
+//    Py_ssize_t *block;          /* the ids of the arrays with capacity 0, copied at once from shared relations */
+//    QBAFAdjacency adjacency;    /* the snapshot of patients and agents, valid if adjacency_valid is 1 */
+//    int adjacency_valid;        /* 1 if adjacency is up to date, 0 if it must be built again */
+//    int bound;                  /* 1 if the ids are the internal ids of a QBAFramework, 0 if they are its own */
+//    Py_ssize_t version;         /* incremented every time the relations are modified */
 //    int modifiable;             /* 1 if this object can be modified through python, 0 otherwise */
 //} QBAFARelationsObject;
 
+/**
+ * @brief Free the ids of array, unless they are part of a block, and leave it empty.
+ *
+ * @param array a QBAFIdArray
+ */
+static inline void
+_QBAFIdArray_free(QBAFIdArray *array)
+{
+    if (array->capacity > 0) {
+        PyMem_Free(array->ids);
+    }
+    memset(array, 0, sizeof(QBAFIdArray));
+}
+
+/**
+ * @brief Free the arrays of ids of the relations.
+ *
+ * @param patients the patients of every agent
+ * @param agents the agents of every patient
+ * @param capacity the length of patients and agents
+ */
+static void
+_QBAFARelations_free_ids(QBAFIdArray *patients, QBAFIdArray *agents, Py_ssize_t capacity)
+{
+    for (Py_ssize_t id = 0; id < capacity; id++) {
+        _QBAFIdArray_free(&patients[id]);
+        _QBAFIdArray_free(&agents[id]);
+    }
+    PyMem_Free(patients);
+    PyMem_Free(agents);
+}
+
+/**
+ * @brief Free the snapshot of the relations and mark it as outdated.
+ *
+ * @param self instance of QBAFARelations
+ */
+static inline void
+_QBAFARelations_invalidate_adjacency(QBAFARelationsObject *self)
+{
+    PyMem_Free(self->adjacency.agent_offsets);
+    PyMem_Free(self->adjacency.agents);
+    PyMem_Free(self->adjacency.patient_offsets);
+    PyMem_Free(self->adjacency.patients);
+    memset(&self->adjacency, 0, sizeof(QBAFAdjacency));
+    self->adjacency_valid = 0;
+}
+
+/**
+ * @brief Mark the relations as modified: the snapshot is outdated and so are the views created before.
+ *
+ * @param self instance of QBAFARelations
+ */
+static inline void
+_QBAFARelations_modified(QBAFARelationsObject *self)
+{
+    _QBAFARelations_invalidate_adjacency(self);
+    self->version++;
+}
+
+/**
+ * @brief Make sure the arrays of ids of the relations can hold at least capacity arguments.
+ *
+ * @param self instance of QBAFARelations
+ * @param capacity the minimum number of arguments
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFARelations_reserve_ids(QBAFARelationsObject *self, Py_ssize_t capacity)
+{
+    if (capacity <= self->ids_capacity) {
+        return 0;
+    }
+    Py_ssize_t new_capacity = self->ids_capacity > 0 ? self->ids_capacity : 16;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+
+    QBAFIdArray *patients = PyMem_Realloc(self->patients, new_capacity * sizeof(QBAFIdArray));
+    if (patients == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->patients = patients;
+    QBAFIdArray *agents = PyMem_Realloc(self->agents, new_capacity * sizeof(QBAFIdArray));
+    if (agents == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->agents = agents;
+    memset(patients + self->ids_capacity, 0, (new_capacity - self->ids_capacity) * sizeof(QBAFIdArray));
+    memset(agents + self->ids_capacity, 0, (new_capacity - self->ids_capacity) * sizeof(QBAFIdArray));
+    self->ids_capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * @brief Make sure array can hold at least capacity ids.
+ *
+ * @param array a QBAFIdArray
+ * @param capacity the minimum number of ids
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static inline int
+_QBAFIdArray_reserve(QBAFIdArray *array, Py_ssize_t capacity)
+{
+    if (capacity <= array->capacity || (array->capacity == 0 && capacity <= array->size)) {
+        return 0;
+    }
+    Py_ssize_t *ids;
+    if (array->capacity > 0) {
+        ids = PyMem_Realloc(array->ids, capacity * sizeof(Py_ssize_t));
+    } else {    // The ids are part of a block: the array gets its own copy
+        ids = PyMem_Malloc(capacity * sizeof(Py_ssize_t));
+        if (ids != NULL && array->size > 0) {
+            memcpy(ids, array->ids, array->size * sizeof(Py_ssize_t));
+        }
+    }
+    if (ids == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    array->ids = ids;
+    array->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief Append id to array.
+ *
+ * @param array a QBAFIdArray
+ * @param id the id
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static inline int
+_QBAFIdArray_append(QBAFIdArray *array, Py_ssize_t id)
+{
+    if (array->size >= array->capacity && _QBAFIdArray_reserve(array, array->size > 0 ? 2 * array->size : 4) < 0) {
+        return -1;
+    }
+    array->ids[array->size++] = id;
+    return 0;
+}
+
+/**
+ * @brief Remove id from array, keeping the order of the rest of ids.
+ *
+ * @param array a QBAFIdArray that contains id
+ * @param id the id
+ */
+static inline void
+_QBAFIdArray_remove(QBAFIdArray *array, Py_ssize_t id)
+{
+    for (Py_ssize_t index = 0; index < array->size; index++) {
+        if (array->ids[index] == id) {
+            memmove(array->ids + index, array->ids + index + 1, (array->size - index - 1) * sizeof(Py_ssize_t));
+            array->size--;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Replace the id from by the id to in array.
+ *
+ * @param array a QBAFIdArray
+ * @param from the id that is replaced
+ * @param to the new id
+ */
+static inline void
+_QBAFIdArray_replace(QBAFIdArray *array, Py_ssize_t from, Py_ssize_t to)
+{
+    for (Py_ssize_t index = 0; index < array->size; index++) {
+        if (array->ids[index] == from) {
+            array->ids[index] = to;
+            return;
+        }
+    }
+}
+
+#define QBAF_PAIR_EMPTY     UINT64_MAX          /* slot that has never had a relation */
+#define QBAF_PAIR_DELETED   (UINT64_MAX - 1)    /* slot whose relation was removed */
+#define QBAF_PAIR_MAX_ID    0xFFFFFFFE          /* the highest id that can be packed (the sentinels have higher agents) */
+
+/**
+ * @brief Return the relation between the ids agent and patient packed in 64 bits.
+ *
+ * @param agent the id of the agent
+ * @param patient the id of the patient
+ * @return uint64_t the packed relation
+ */
+static inline uint64_t
+_QBAFPairSet_key(Py_ssize_t agent, Py_ssize_t patient)
+{
+    return ((uint64_t) agent << 32) | (uint64_t) patient;
+}
+
+/**
+ * @brief Return the first slot of a packed relation in a table with mask + 1 slots.
+ *
+ * @param key a packed relation
+ * @param mask the number of slots - 1
+ * @return Py_ssize_t the slot
+ */
+static inline Py_ssize_t
+_QBAFPairSet_slot(uint64_t key, Py_ssize_t mask)
+{
+    // Finalizer of MurmurHash3: the ids are dense, so their bits must be mixed
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (Py_ssize_t) (key & (uint64_t) mask);
+}
+
+/**
+ * @brief Return the slot of key in set, -1 if it is not contained.
+ *
+ * @param set a QBAFPairSet
+ * @param key a packed relation
+ * @return Py_ssize_t the slot of key, -1 if not contained
+ */
+static inline Py_ssize_t
+_QBAFPairSet_find(const QBAFPairSet *set, uint64_t key)
+{
+    if (set->keys == NULL) {
+        return -1;
+    }
+    Py_ssize_t slot = _QBAFPairSet_slot(key, set->mask);
+    while (set->keys[slot] != QBAF_PAIR_EMPTY) {
+        if (set->keys[slot] == key) {
+            return slot;
+        }
+        slot = (slot + 1) & set->mask;
+    }
+    return -1;
+}
+
+/**
+ * @brief Move the relations of set to a new table with room for at least capacity relations.
+ *
+ * @param set a QBAFPairSet
+ * @param capacity the number of relations
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFPairSet_resize(QBAFPairSet *set, Py_ssize_t capacity)
+{
+    // The table is kept at most half full
+    Py_ssize_t slots = 16;
+    while (slots < 2 * capacity) {
+        slots *= 2;
+    }
+    uint64_t *keys = PyMem_Malloc(slots * sizeof(uint64_t));
+    if (keys == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(keys, 0xFF, slots * sizeof(uint64_t));   // QBAF_PAIR_EMPTY
+
+    for (Py_ssize_t index = 0; set->keys != NULL && index <= set->mask; index++) {
+        uint64_t key = set->keys[index];
+        if (key == QBAF_PAIR_EMPTY || key == QBAF_PAIR_DELETED) {
+            continue;
+        }
+        Py_ssize_t slot = _QBAFPairSet_slot(key, slots - 1);
+        while (keys[slot] != QBAF_PAIR_EMPTY) {
+            slot = (slot + 1) & (slots - 1);
+        }
+        keys[slot] = key;
+    }
+    PyMem_Free(set->keys);
+    set->keys = keys;
+    set->mask = slots - 1;
+    set->used = set->size;
+    return 0;
+}
+
+/**
+ * @brief Add key to set.
+ *
+ * @param set a QBAFPairSet
+ * @param key a packed relation
+ * @return int 1 if it was added, 0 if it was already contained, -1 if an error occurred
+ */
+static int
+_QBAFPairSet_add(QBAFPairSet *set, uint64_t key)
+{
+    if (_QBAFPairSet_find(set, key) >= 0) {
+        return 0;
+    }
+    if (set->keys == NULL || 2 * (set->used + 1) > set->mask + 1) {
+        if (_QBAFPairSet_resize(set, set->size + 1) < 0) {
+            return -1;
+        }
+    }
+    Py_ssize_t slot = _QBAFPairSet_slot(key, set->mask);
+    while (set->keys[slot] != QBAF_PAIR_EMPTY && set->keys[slot] != QBAF_PAIR_DELETED) {
+        slot = (slot + 1) & set->mask;
+    }
+    if (set->keys[slot] == QBAF_PAIR_EMPTY) {
+        set->used++;
+    }
+    set->keys[slot] = key;
+    set->size++;
+    return 1;
+}
+
+/**
+ * @brief Remove key from set.
+ *
+ * @param set a QBAFPairSet
+ * @param key a packed relation
+ * @return int 1 if it was removed, 0 if it was not contained
+ */
+static int
+_QBAFPairSet_discard(QBAFPairSet *set, uint64_t key)
+{
+    Py_ssize_t slot = _QBAFPairSet_find(set, key);
+    if (slot < 0) {
+        return 0;
+    }
+    set->keys[slot] = QBAF_PAIR_DELETED;
+    set->size--;
+    return 1;
+}
+
+/**
+ * @brief Free the table of set and leave it empty.
+ *
+ * @param set a QBAFPairSet
+ */
+static inline void
+_QBAFPairSet_clear(QBAFPairSet *set)
+{
+    PyMem_Free(set->keys);
+    memset(set, 0, sizeof(QBAFPairSet));
+}
+
+/**
+ * @brief Copy the relations of from to the empty set to.
+ *
+ * @param to an empty QBAFPairSet
+ * @param from a QBAFPairSet
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFPairSet_copy(QBAFPairSet *to, const QBAFPairSet *from)
+{
+    if (from->keys == NULL) {
+        return 0;
+    }
+    to->keys = PyMem_Malloc((from->mask + 1) * sizeof(uint64_t));
+    if (to->keys == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memcpy(to->keys, from->keys, (from->mask + 1) * sizeof(uint64_t));
+    to->size = from->size;
+    to->used = from->used;
+    to->mask = from->mask;
+    return 0;
+}
+
+/**
+ * @brief Make self use the relations of from, which are shared by both until one of them is modified.
+ *
+ * @param self instance of QBAFARelations without relations
+ * @param from instance of QBAFARelations
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFARelations_share(QBAFARelationsObject *self, QBAFARelationsObject *from)
+{
+    if (from->shared == NULL) {
+        from->shared = PyMem_Malloc(sizeof(Py_ssize_t));
+        if (from->shared == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        *from->shared = 1;
+    }
+    (*from->shared)++;
+    self->shared = from->shared;
+    self->pairs = from->pairs;
+    self->patients = from->patients;
+    self->agents = from->agents;
+    self->ids_capacity = from->ids_capacity;
+    self->block = from->block;
+    return 0;
+}
+
+/**
+ * @brief Make sure self is the only user of its relations, copying them if they are shared.
+ * It must be called before the relations are modified.
+ *
+ * @param self instance of QBAFARelations
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static int
+_QBAFARelations_unshare(QBAFARelationsObject *self)
+{
+    if (self->shared == NULL) {
+        return 0;
+    }
+    if (*self->shared == 1) {   // The copies that shared them have been modified or deallocated
+        PyMem_Free(self->shared);
+        self->shared = NULL;
+        return 0;
+    }
+
+    // All the ids are copied to one block, the arrays get their own ids when they grow
+    QBAFPairSet pairs = {NULL, 0, 0, 0};
+    Py_ssize_t capacity = self->ids_capacity, size = 0;
+    for (Py_ssize_t id = 0; id < capacity; id++) {
+        size += self->patients[id].size + self->agents[id].size;
+    }
+    QBAFIdArray *patients = PyMem_Calloc(capacity > 0 ? capacity : 1, sizeof(QBAFIdArray));
+    QBAFIdArray *agents = PyMem_Calloc(capacity > 0 ? capacity : 1, sizeof(QBAFIdArray));
+    Py_ssize_t *block = PyMem_Malloc((size > 0 ? size : 1) * sizeof(Py_ssize_t));
+    if (patients == NULL || agents == NULL || block == NULL) {
+        PyMem_Free(patients);
+        PyMem_Free(agents);
+        PyMem_Free(block);
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (_QBAFPairSet_copy(&pairs, &self->pairs) < 0) {
+        PyMem_Free(patients);
+        PyMem_Free(agents);
+        PyMem_Free(block);
+        return -1;
+    }
+    Py_ssize_t offset = 0;
+    for (Py_ssize_t id = 0; id < capacity; id++) {
+        QBAFIdArray *arrays[2][2] = {{&self->patients[id], &patients[id]}, {&self->agents[id], &agents[id]}};
+        for (int kind = 0; kind < 2; kind++) {
+            QBAFIdArray *from = arrays[kind][0], *to = arrays[kind][1];
+            if (from->size == 0) {
+                continue;
+            }
+            to->ids = block + offset;
+            to->size = from->size;
+            memcpy(to->ids, from->ids, from->size * sizeof(Py_ssize_t));
+            offset += from->size;
+        }
+    }
+
+    (*self->shared)--;
+    self->shared = NULL;
+    self->pairs = pairs;
+    self->patients = patients;
+    self->agents = agents;
+    self->block = block;
+    return 0;
+}
+
+/**
+ * @brief Free the relations of self, unless they are still shared with a copy, and leave self without relations.
+ *
+ * @param self instance of QBAFARelations
+ */
+static void
+_QBAFARelations_free_relations(QBAFARelationsObject *self)
+{
+    if (self->shared != NULL && --(*self->shared) > 0) {
+        memset(&self->pairs, 0, sizeof(QBAFPairSet));  // They belong to the copies now
+    } else {
+        _QBAFARelations_free_ids(self->patients, self->agents, self->ids_capacity);
+        _QBAFPairSet_clear(&self->pairs);
+        PyMem_Free(self->block);
+        PyMem_Free(self->shared);
+    }
+    self->shared = NULL;
+    self->block = NULL;
+    self->patients = NULL;
+    self->agents = NULL;
+    self->ids_capacity = 0;
+}
+
+/**
+ * @brief Return 1 and store the id of argument in id if it has one, 0 if it does not, -1 if an error has occurred.
+ * If intern is 1 and the relations have their own ids, an argument without id gets a new one.
+ *
+ * @param self instance of QBAFARelations
+ * @param argument a QBAFArgument
+ * @param intern 1 if a new id is assigned to argument if it does not have one, 0 otherwise
+ * @param id where the id is stored
+ * @return int 1 if argument has an id, 0 if not, -1 if an error occurred
+ */
+static int
+_QBAFARelations_argument_id(QBAFARelationsObject *self, PyObject *argument, int intern, Py_ssize_t *id)
+{
+    PyObject *pyid = PyDict_GetItemWithError(self->argument_ids, argument);   // Borrowed reference
+    if (pyid != NULL) {
+        *id = PyLong_AsSsize_t(pyid);
+        return 1;
+    }
+    if (PyErr_Occurred()) {
+        return -1;
+    }
+    if (!intern) {
+        return 0;
+    }
+    if (self->bound) {
+        PyErr_SetString(PyExc_ValueError, "the arguments of the relations must be arguments of the QBAFramework");
+        return -1;
+    }
+
+    *id = PyList_GET_SIZE(self->id_arguments);
+    pyid = PyLong_FromSsize_t(*id);
+    if (pyid == NULL) {
+        return -1;
+    }
+    if (PyDict_SetItem(self->argument_ids, argument, pyid) < 0) {
+        Py_DECREF(pyid);
+        return -1;
+    }
+    Py_DECREF(pyid);
+    if (PyList_Append(self->id_arguments, argument) < 0) {
+        PyDict_DelItem(self->argument_ids, argument);
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * @brief Add the relation between the ids agent and patient, if it is not contained.
+ *
+ * @param self instance of QBAFARelations
+ * @param agent the id of the agent
+ * @param patient the id of the patient
+ * @return int 0 if successful, -1 if an error occurred
+ */
+static inline int
+_QBAFARelations_add_ids(QBAFARelationsObject *self, Py_ssize_t agent, Py_ssize_t patient)
+{
+    if (agent > QBAF_PAIR_MAX_ID || patient > QBAF_PAIR_MAX_ID) {
+        PyErr_SetString(PyExc_OverflowError, "too many arguments in the relations");
+        return -1;
+    }
+    uint64_t key = _QBAFPairSet_key(agent, patient);
+    if (_QBAFPairSet_find(&self->pairs, key) >= 0) {
+        return 0;
+    }
+    if (_QBAFARelations_unshare(self) < 0) {
+        return -1;
+    }
+    int added = _QBAFPairSet_add(&self->pairs, key);
+    if (added <= 0) {
+        return added;   // It was already contained, or an error
+    }
+    _QBAFARelations_modified(self);
+    if (_QBAFARelations_reserve_ids(self, (agent > patient ? agent : patient) + 1) < 0) {
+        _QBAFPairSet_discard(&self->pairs, key);
+        return -1;
+    }
+    if (_QBAFIdArray_append(&self->patients[agent], patient) < 0) {
+        _QBAFPairSet_discard(&self->pairs, key);
+        return -1;
+    }
+    if (_QBAFIdArray_append(&self->agents[patient], agent) < 0) {
+        self->patients[agent].size--;
+        _QBAFPairSet_discard(&self->pairs, key);
+        return -1;
+    }
+    return 0;
+}
+
 /**
  * @brief This function is used by the garbage collector to detect reference cycles.
  * 
@@ -34,9 +611,8 @@
 static int
 QBAFARelations_traverse(QBAFARelationsObject *self, visitproc visit, void *arg)
 {
-    Py_VISIT(self->relations);
-    Py_VISIT(self->agent_patients);
-    Py_VISIT(self->patient_agents);
+    Py_VISIT(self->argument_ids);
+    Py_VISIT(self->id_arguments);
     return 0;
 }
 
@@ -49,9 +625,8 @@ QBAFARelations_traverse(QBAFARelationsObject *self, visitproc visit, void *arg)
 static int
 QBAFARelations_clear(QBAFARelationsObject *self)
 {
-    Py_CLEAR(self->relations);
-    Py_CLEAR(self->agent_patients);
-    Py_CLEAR(self->patient_agents);
+    Py_CLEAR(self->argument_ids);
+    Py_CLEAR(self->id_arguments);
     return 0;
 }
 
@@ -65,6 +640,8 @@ QBAFARelations_dealloc(QBAFARelationsObject *self)
 {
     PyObject_GC_UnTrack(self);
     QBAFARelations_clear(self);
+    _QBAFARelations_free_relations(self);
+    _QBAFARelations_invalidate_adjacency(self);
     Py_TYPE(self)->tp_free((PyObject *) self);
 }
 
@@ -82,21 +659,18 @@ QBAFARelations_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     QBAFARelationsObject *self;
     self = (QBAFARelationsObject *) type->tp_alloc(type, 0);
     if (self != NULL) {
-        self->relations = PySet_New(NULL);
-        if (self->relations == NULL) {
-            Py_DECREF(self);
-            return NULL;
-        }
-        self->agent_patients = PyDict_New();
-        if (self->agent_patients == NULL) {
-            Py_DECREF(self->relations);
-            Py_DECREF(self);
-            return NULL;
-        }
-        self->patient_agents = PyDict_New();
-        if (self->patient_agents == NULL) {
-            Py_DECREF(self->relations);
-            Py_DECREF(self->agent_patients);
+        self->patients = NULL;
+        self->agents = NULL;
+        self->ids_capacity = 0;
+        self->shared = NULL;
+        self->block = NULL;
+        memset(&self->adjacency, 0, sizeof(QBAFAdjacency));
+        self->adjacency_valid = 0;
+        self->bound = 0;
+        memset(&self->pairs, 0, sizeof(QBAFPairSet));
+        self->argument_ids = PyDict_New();
+        self->id_arguments = PyList_New(0);
+        if (self->argument_ids == NULL || self->id_arguments == NULL) {
             Py_DECREF(self);
             return NULL;
         }
@@ -105,37 +679,6 @@ QBAFARelations_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     return (PyObject *) self;
 }
 
-/**
- * @brief Return the object from dictionary dict which has a key key. If the key does not exist return a new set.
- * Return NULL with an exception set if an exception occurred.
- * 
- * @param dict the dictionary
- * @param key the key
- * @return PyObject* Borrowed reference
- */
-static inline PyObject *
-PyDict_GetItemDefaultPySet_New(PyObject *dict, PyObject *key)
-{
-    PyObject *set;
-    int contains = PyDict_Contains(dict, key);
-    if (contains < 0) { //PyDict_Contains returns -1 in case of error
-        return NULL;
-    }
-    if (!contains) {
-        set = PySet_New(NULL);      // Return new reference
-        if (set == NULL)
-            return NULL;
-        // Add a new set to the dictionary
-        if (PyDict_SetItem(dict, key, set) < 0) {
-            Py_DECREF(set);
-            return NULL;
-        }
-        Py_DECREF(set);
-        return set;
-    }
-    return PyDict_GetItemWithError(dict, key);
-}
-
 /**
  * @brief Initializer of a QBAFARelations. It is called right after the constructor by the python interpreter.
  * 
@@ -148,7 +691,7 @@ static int
 QBAFARelations_init(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
 {
     static char *kwlist[] = {"relations", NULL};
-    PyObject *relations, *tmp;
+    PyObject *relations;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
                                      &relations))
@@ -160,20 +703,21 @@ QBAFARelations_init(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
         return -1;
     }
 
-    // Initialize relations
-    tmp = self->relations;
-    relations = PySet_New(relations);           // It creates a new reference
-    if (relations == NULL) { // If any item is not hashable it raises and error
+    // Initialize the ids
+    Py_SETREF(self->argument_ids, PyDict_New());
+    Py_SETREF(self->id_arguments, PyList_New(0));
+    if (self->argument_ids == NULL || self->id_arguments == NULL) {
         return -1;
     }
-    self->relations = relations;
-    Py_DECREF(tmp);                             // This instance stops owning the set created in the constructor
+    _QBAFARelations_free_relations(self);
+    self->bound = 0;
+    _QBAFARelations_modified(self);
 
-    // Initialize agent_patients & patient_agents
-    PyObject *iterator = PyObject_GetIter(self->relations);
+    // The relations are only stored as ids: repeated relations are added once
+    PyObject *iterator = PyObject_GetIter(relations);
     PyObject *item;
     PyObject *agent, *patient;
-    PyObject *set;
+    Py_ssize_t agent_id = 0, patient_id = 0;
 
     if (iterator == NULL) {
         /* propagate error */
@@ -192,132 +736,484 @@ QBAFARelations_init(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
         agent = PyTuple_GetItem(item, 0);       // Returns borrowed reference. NULL if the index is wrong.
         patient = PyTuple_GetItem(item, 1);     // Returns borrowed reference. NULL if the index is wrong.
 
-        Py_DECREF(item);
+        Py_DECREF(item);
+
+        if (agent == NULL || patient == NULL) {
+            break;
+        }
+
+        if (_QBAFARelations_argument_id(self, agent, 1, &agent_id) < 0 ||
+            _QBAFARelations_argument_id(self, patient, 1, &patient_id) < 0 ||
+            _QBAFARelations_add_ids(self, agent_id, patient_id) < 0) {
+            break;
+        }
+    }
+
+    Py_DECREF(iterator);
+
+    if (PyErr_Occurred()) {
+        /* propagate error */
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Return a new PyList with the tuples (agent, patient) of the relations, ordered by the id of the agent.
+ *
+ * @param self the QBAFARelations instance
+ * @return PyObject* new PyList of tuples (Agent: QBAFArgument, Patient: QBAFArgument), NULL if an error occurred
+ */
+static PyObject *
+_QBAFARelations_tuples(QBAFARelationsObject *self)
+{
+    PyObject *list = PyList_New(self->pairs.size);
+    if (list == NULL) {
+        return NULL;
+    }
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    if (size > self->ids_capacity) {
+        size = self->ids_capacity;
+    }
+    Py_ssize_t index = 0;
+    for (Py_ssize_t agent = 0; agent < size; agent++) {
+        for (Py_ssize_t position = 0; position < self->patients[agent].size; position++) {
+            PyObject *tuple = PyTuple_Pack(2, PyList_GET_ITEM(self->id_arguments, agent),
+                                           PyList_GET_ITEM(self->id_arguments, self->patients[agent].ids[position]));
+            if (tuple == NULL) {
+                Py_DECREF(list);
+                return NULL;
+            }
+            PyList_SET_ITEM(list, index++, tuple);
+        }
+    }
+    return list;
+}
+
+/**
+ * @brief Getter of the attribute relations.
+ * The set is created from the ids of the relations every time it is requested.
+ * 
+ * @param self the QBAFARelations instance
+ * @param closure 
+ * @return PyObject* a new set with the relations
+ */
+static PyObject *
+QBAFArgument_getrelations(QBAFARelationsObject *self, void *closure)
+{
+    PyObject *list = _QBAFARelations_tuples(self);
+    if (list == NULL) {
+        return NULL;
+    }
+    PyObject *set = PySet_New(list);
+    Py_DECREF(list);
+    return set;
+}
+
+/**
+ * @brief Return the string format of a QBAFARelations object
+ * 
+ * @param self the QBAFARelations instance
+ * @return PyObject* the string representing the object
+ */
+static PyObject *
+QBAFARelations___str__(QBAFARelationsObject *self)
+{
+    PyObject *relations = QBAFArgument_getrelations(self, NULL);
+    if (relations == NULL) {
+        return NULL;
+    }
+    PyObject *str = PyUnicode_FromFormat("QBAFARelations%S", relations);
+    Py_DECREF(relations);
+    return str;
+}
+
+/**
+ * @brief Return the amount of relations of the instance.
+ * 
+ * @param self instance of QBAFARelations
+ * @return Py_ssize_t number of relations
+ */
+static Py_ssize_t
+QBAFARelations___len__(QBAFARelationsObject *self)
+{
+    return self->pairs.size;
+}
+
+/**
+ * @brief Return whether or not exists the relation (agent, patient) in this instance.
+ * 
+ * @param self instance of QBAFARelations
+ * @param key a tuple (agent: QBAFArgument, patient: QBAFArgument)
+ * @return int 1 if found, 0 if not found, and -1 if an error is encountered
+ */
+static int
+QBAFARelations___contains__(QBAFARelationsObject *self, PyObject *key)
+{
+    if (!PyTuple_Check(key) || (PyTuple_Size(key) != 2)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "relation must be a tuple of size 2");
+        return -1;
+    }
+
+    return _QBAFARelations_contains(self, PyTuple_GET_ITEM(key, 0), PyTuple_GET_ITEM(key, 1));
+}
+
+/**
+ * @brief Return a new PyList with the arguments of the ids of array.
+ *
+ * @param self instance of QBAFARelations
+ * @param array a QBAFIdArray
+ * @return PyObject* new PyList of QBAFArgument, NULL if an error occurred
+ */
+static PyObject *
+_QBAFARelations_arguments_of(QBAFARelationsObject *self, QBAFIdArray *array)
+{
+    PyObject *list = PyList_New(array->size);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (Py_ssize_t index = 0; index < array->size; index++) {
+        PyObject *argument = PyList_GET_ITEM(self->id_arguments, array->ids[index]);
+        Py_INCREF(argument);
+        PyList_SET_ITEM(list, index, argument);
+    }
+    return list;
+}
+
+/**
+ * @brief Return the patients that undergo the effect of a certain action (e.g. attack, support)
+ * initiated by the agent. Return NULL if an error has ocurred.
+ * 
+ * @param self instance of QBAFARelations
+ * @param agent instance of QBAFArgument
+ * @return PyObject* list of QBAFArgument
+ */
+PyObject *
+_QBAFARelations_patients(QBAFARelationsObject *self, PyObject *agent) {
+    Py_ssize_t id = 0;
+    int contains = _QBAFARelations_argument_id(self, agent, 0, &id);
+    if (contains < 0)
+        return NULL;
+    if (contains && id < self->ids_capacity) {
+        return _QBAFARelations_arguments_of(self, &self->patients[id]);
+    }
+
+    return PyList_New(0);
+}
+
+/**
+ * @brief Return the patients that undergo the effect of a certain action (e.g. attack, support)
+ * initiated by the agent. Return NULL if an error has ocurred.
+ * 
+ * @param self instance of QBAFARelations
+ * @param args the argument values (agent: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* list of QBAFArgument 
+ */
+static PyObject *
+QBAFARelations_patients(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"agent", NULL};
+    PyObject *agent;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &agent))
+        return NULL;
+
+    return _QBAFARelations_patients(self, agent);
+}
+
+/**
+ * @brief Return the agents that initiate a certain action (e.g. attack, support)
+ * which effects are undergone by the patient. Return NULL if an error has ocurred.
+ * 
+ * @param self instance of QBAFARelations
+ * @param patient instance of QBAFArgument
+ * @return PyObject* list of QBAFArgument
+ */
+PyObject *
+_QBAFARelations_agents(QBAFARelationsObject *self, PyObject *patient) {
+    Py_ssize_t id = 0;
+    int contains = _QBAFARelations_argument_id(self, patient, 0, &id);
+    if (contains < 0)
+        return NULL;
+    if (contains && id < self->ids_capacity) {
+        return _QBAFARelations_arguments_of(self, &self->agents[id]);
+    }
+
+    return PyList_New(0);
+}
+
+/**
+ * @brief Return the agents that initiate a certain action (e.g. attack, support)
+ * which effects are undergone by the patient. Return NULL if an error has ocurred.
+ * 
+ * @param self instance of QBAFARelations
+ * @param args the argument values (patient: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* list of QBAFArgument
+ */
+static PyObject *
+QBAFARelations_agents(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"patient", NULL};
+    PyObject *patient;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &patient))
+        return NULL;
 
-        if (agent == NULL || patient == NULL) {
-            break;
-        }
+    return _QBAFARelations_agents(self, patient);
+}
 
-        set = PyDict_GetItemDefaultPySet_New(self->agent_patients, agent);  // Return borrowed reference
-        if (set == NULL) {
-            break;
-        }
-        // Add patient to the set
-        if (PySet_Add(set, patient) < 0) {
-            break;
-        }
+/**
+ * @brief Struct that defines the Object Type ARelationsView: a read-only sequence with the agents
+ * or the patients of an argument, read from the arrays of ids of the relations without copying them.
+ *
+ */
+typedef struct {
+    PyObject_HEAD
+    QBAFARelationsObject *relations;    /* the relations of the view */
+    Py_ssize_t id;                      /* the id of the argument, -1 if it has no relations */
+    int agents;                         /* 1 if the view has the agents of the argument, 0 if it has its patients */
+    Py_ssize_t version;                 /* the version of relations when the view was created */
+} QBAFARelationsViewObject;
 
-        set = PyDict_GetItemDefaultPySet_New(self->patient_agents, patient);  // Return borrowed reference
-        if (set == NULL) {
-            break;
-        }
-        // Add agent to the set
-        if (PySet_Add(set, agent) < 0) {
-            break;
-        }
-        
+/**
+ * @brief Return the ids of the view and store their number in size, NULL with a RuntimeError
+ * if the relations have been modified since the view was created.
+ *
+ * @param self instance of QBAFARelationsView
+ * @param size where the number of ids is stored
+ * @return const Py_ssize_t* the ids of the view (NULL without exception if there are none)
+ */
+static inline const Py_ssize_t *
+_QBAFARelationsView_ids(QBAFARelationsViewObject *self, Py_ssize_t *size)
+{
+    *size = 0;
+    if (self->version != self->relations->version) {
+        PyErr_SetString(PyExc_RuntimeError, "the relations were modified after the view was created");
+        *size = -1;
+        return NULL;
     }
-
-    Py_DECREF(iterator);
-
-    if (PyErr_Occurred()) {
-        /* propagate error */
-        return -1;
+    if (self->id < 0) {
+        return NULL;
     }
+    return self->agents ? QBAFARelations_AgentIds(self->relations, self->id, size)
+                        : QBAFARelations_PatientIds(self->relations, self->id, size);
+}
 
+/**
+ * @brief This function is used by the garbage collector to detect reference cycles.
+ *
+ * @param self a object of type QBAFARelationsView
+ * @param visit
+ * @param arg
+ * @return int 0 if the function was successful. Otherwise, -1.
+ */
+static int
+QBAFARelationsView_traverse(QBAFARelationsViewObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(self->relations);
     return 0;
 }
 
 /**
- * @brief Getter of the attribute relations.
- * 
- * @param self the QBAFARelations instance
- * @param closure 
- * @return PyObject* a copy of the relations set
+ * @brief Drop the instance’s references to those of its members that may be Python objects.
+ *
+ * @param self a object of type QBAFARelationsView
+ * @return int 0 if the function was successful. Otherwise, -1.
  */
-static PyObject *
-QBAFArgument_getrelations(QBAFARelationsObject *self, void *closure)
+static int
+QBAFARelationsView_clear(QBAFARelationsViewObject *self)
 {
-    return PySet_New(self->relations);
+    Py_CLEAR(self->relations);
+    return 0;
 }
 
 /**
- * @brief Return the string format of a QBAFARelations object
- * 
- * @param self the QBAFARelations instance
- * @return PyObject* the string representing the object
+ * @brief Destructor function that is called to free memory of a object that will no longer be used.
+ *
+ * @param self a object of type QBAFARelationsView
  */
-static PyObject *
-QBAFARelations___str__(QBAFARelationsObject *self)
+static void
+QBAFARelationsView_dealloc(QBAFARelationsViewObject *self)
 {
-    return PyUnicode_FromFormat("QBAFARelations%S", self->relations);
+    PyObject_GC_UnTrack(self);
+    QBAFARelationsView_clear(self);
+    Py_TYPE(self)->tp_free((PyObject *) self);
 }
 
 /**
- * @brief Return the amount of relations of the instance.
- * 
- * @param self instance of QBAFARelations
- * @return Py_ssize_t length of set relations
+ * @brief Return the number of arguments of the view, -1 if the relations have been modified.
+ *
+ * @param self instance of QBAFARelationsView
+ * @return Py_ssize_t the number of arguments
  */
 static Py_ssize_t
-QBAFARelations___len__(QBAFARelationsObject *self)
+QBAFARelationsView___len__(QBAFARelationsViewObject *self)
 {
-    return PySet_Size(self->relations);
+    Py_ssize_t size;
+    _QBAFARelationsView_ids(self, &size);
+    return size;
 }
 
 /**
- * @brief Return whether or not exists the relation (agent, patient) in this instance.
- * 
- * @param self instance of QBAFARelations
- * @param key a tuple (agent: QBAFArgument, patient: QBAFArgument)
+ * @brief Return the argument at position index of the view, in the order their relations were added.
+ *
+ * @param self instance of QBAFARelationsView
+ * @param index the position
+ * @return PyObject* new reference to the QBAFArgument, NULL if an error occurred
+ */
+static PyObject *
+QBAFARelationsView___getitem__(QBAFARelationsViewObject *self, Py_ssize_t index)
+{
+    Py_ssize_t size;
+    const Py_ssize_t *ids = _QBAFARelationsView_ids(self, &size);
+    if (size < 0) {
+        return NULL;
+    }
+    if (index < 0 || index >= size) {
+        PyErr_SetString(PyExc_IndexError, "view index out of range");
+        return NULL;
+    }
+    PyObject *argument = PyList_GET_ITEM(self->relations->id_arguments, ids[index]);
+    Py_INCREF(argument);
+    return argument;
+}
+
+/**
+ * @brief Return whether argument is in the view, answered by the index of relations.
+ *
+ * @param self instance of QBAFARelationsView
+ * @param argument a QBAFArgument
  * @return int 1 if found, 0 if not found, and -1 if an error is encountered
  */
 static int
-QBAFARelations___contains__(QBAFARelationsObject *self, PyObject *key)
+QBAFARelationsView___contains__(QBAFARelationsViewObject *self, PyObject *argument)
 {
-    if (!PyTuple_Check(key) || (PyTuple_Size(key) != 2)) {
-        PyErr_SetString(PyExc_TypeError,
-                        "relation must be a tuple of size 2");
-        return -1;
+    Py_ssize_t size, id = 0;
+    _QBAFARelationsView_ids(self, &size);
+    if (size <= 0) {
+        return size < 0 ? -1 : 0;
+    }
+    int contains = _QBAFARelations_argument_id(self->relations, argument, 0, &id);
+    if (contains <= 0) {
+        return contains;
     }
+    return self->agents ? QBAFARelations_HasRelation(self->relations, id, self->id)
+                        : QBAFARelations_HasRelation(self->relations, self->id, id);
+}
 
-    return PySet_Contains(self->relations, key);
+/**
+ * @brief Return the string format of a QBAFARelationsView object.
+ *
+ * @param self the QBAFARelationsView instance
+ * @return PyObject* the string representing the object
+ */
+static PyObject *
+QBAFARelationsView___str__(QBAFARelationsViewObject *self)
+{
+    PyObject *list = PySequence_List((PyObject *) self);
+    if (list == NULL) {
+        return NULL;
+    }
+    PyObject *str = PyUnicode_FromFormat("QBAFARelationsView(%S)", list);
+    Py_DECREF(list);
+    return str;
 }
 
+static PySequenceMethods QBAFARelationsView_sequencemethods = {
+    .sq_length = (lenfunc) QBAFARelationsView___len__,              // __len__
+    .sq_item = (ssizeargfunc) QBAFARelationsView___getitem__,       // __getitem__
+    .sq_contains = (objobjproc) QBAFARelationsView___contains__,    // __contains__
+};
+
+PyDoc_STRVAR(QBAFARelationsView_doc,
+"Read-only sequence with the agents or the patients of an argument, in the order their relations were added.\n"
+"It reads the relations without copying them, so creating it, len() and the membership test take constant time.\n"
+"Using it after the relations have been modified raises a RuntimeError.\n"
+);
+
 /**
- * @brief Return the patients that undergo the effect of a certain action (e.g. attack, support)
- * initiated by the agent. Return NULL if an error has ocurred.
- * 
- * @param self instance of QBAFARelations
- * @param agent instance of QBAFArgument
- * @return PyObject* list of QBAFArgument
+ * @brief Python definition for the class QBAFARelationsView
+ *
+ */
+static PyTypeObject QBAFARelationsViewType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "qbaf.QBAFARelationsView",
+    .tp_doc = QBAFARelationsView_doc,
+    .tp_basicsize = sizeof(QBAFARelationsViewObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_dealloc = (destructor) QBAFARelationsView_dealloc,
+    .tp_traverse = (traverseproc) QBAFARelationsView_traverse,
+    .tp_clear = (inquiry) QBAFARelationsView_clear,
+    .tp_str = (reprfunc) QBAFARelationsView___str__,                // __str__
+    .tp_repr = (reprfunc) QBAFARelationsView___str__,               // __repr__
+    .tp_as_sequence = &QBAFARelationsView_sequencemethods,          // __len__, __getitem__, __contains__
+};
+
+/**
+ * @brief Get the QBAFARelationsViewType object created above that defines the class QBAFARelationsView
+ *
+ * @return PyTypeObject* a pointer to the QBAFARelationsView class definition
  */
+PyTypeObject *get_QBAFARelationsViewType(void) {
+    return &QBAFARelationsViewType;
+}
+
 PyObject *
-_QBAFARelations_patients(QBAFARelationsObject *self, PyObject *agent) {
-    PyObject *set, *list;
-    int contains = PyDict_Contains(self->agent_patients, agent);
-    if (contains < 0)
+QBAFARelations_View(QBAFARelationsObject *self, PyObject *argument, int agents)
+{
+    Py_ssize_t id = 0;
+    int contains = _QBAFARelations_argument_id(self, argument, 0, &id);
+    if (contains < 0) {
         return NULL;
-    if (contains) {
-        set = PyDict_GetItem(self->agent_patients, agent);
-        list = PyList_Copy(set, PySet_GET_SIZE(set));
-        return list;
     }
 
-    return PyList_New(0);
+    QBAFARelationsViewObject *view = PyObject_GC_New(QBAFARelationsViewObject, &QBAFARelationsViewType);
+    if (view == NULL) {
+        return NULL;
+    }
+    Py_INCREF(self);
+    view->relations = self;
+    view->id = contains ? id : -1;
+    view->agents = agents;
+    view->version = self->version;
+    PyObject_GC_Track(view);
+    return (PyObject *) view;
+}
+
+Py_ssize_t
+QBAFARelations_Degree(QBAFARelationsObject *self, PyObject *argument, int agents)
+{
+    Py_ssize_t id = 0, size = 0;
+    int contains = _QBAFARelations_argument_id(self, argument, 0, &id);
+    if (contains <= 0) {
+        return contains;
+    }
+    if (agents) {
+        QBAFARelations_AgentIds(self, id, &size);
+    }
+    else {
+        QBAFARelations_PatientIds(self, id, &size);
+    }
+    return size;
 }
 
 /**
- * @brief Return the patients that undergo the effect of a certain action (e.g. attack, support)
- * initiated by the agent. Return NULL if an error has ocurred.
- * 
+ * @brief Return a view of the patients of the agent. Return NULL if an error has ocurred.
+ *
  * @param self instance of QBAFARelations
  * @param args the argument values (agent: QBAFArgument)
  * @param kwds the argument names
- * @return PyObject* list of QBAFArgument 
+ * @return PyObject* new QBAFARelationsView, NULL if an error occurred
  */
 static PyObject *
-QBAFARelations_patients(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
+QBAFARelations_patients_view(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
 {
     static char *kwlist[] = {"agent", NULL};
     PyObject *agent;
@@ -326,43 +1222,65 @@ QBAFARelations_patients(QBAFARelationsObject *self, PyObject *args, PyObject *kw
                                      &agent))
         return NULL;
 
-    return _QBAFARelations_patients(self, agent);
+    return QBAFARelations_View(self, agent, 0);
 }
 
 /**
- * @brief Return the agents that initiate a certain action (e.g. attack, support)
- * which effects are undergone by the patient. Return NULL if an error has ocurred.
- * 
+ * @brief Return a view of the agents of the patient. Return NULL if an error has ocurred.
+ *
  * @param self instance of QBAFARelations
- * @param patient instance of QBAFArgument
- * @return PyObject* list of QBAFArgument
+ * @param args the argument values (patient: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new QBAFARelationsView, NULL if an error occurred
  */
-PyObject *
-_QBAFARelations_agents(QBAFARelationsObject *self, PyObject *patient) {
-    PyObject *set, *list;
-    int contains = PyDict_Contains(self->patient_agents, patient);
-    if (contains < 0)
+static PyObject *
+QBAFARelations_agents_view(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"patient", NULL};
+    PyObject *patient;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &patient))
         return NULL;
-    if (contains) {
-        set = PyDict_GetItem(self->patient_agents, patient);
-        list = PyList_Copy(set, PySet_GET_SIZE(set));
-        return list;
-    }
 
-    return PyList_New(0);
+    return QBAFARelations_View(self, patient, 1);
 }
 
 /**
- * @brief Return the agents that initiate a certain action (e.g. attack, support)
- * which effects are undergone by the patient. Return NULL if an error has ocurred.
- * 
+ * @brief Return the number of patients of the agent. Return NULL if an error has ocurred.
+ *
+ * @param self instance of QBAFARelations
+ * @param args the argument values (agent: QBAFArgument)
+ * @param kwds the argument names
+ * @return PyObject* new PyLong, NULL if an error occurred
+ */
+static PyObject *
+QBAFARelations_out_degree(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"agent", NULL};
+    PyObject *agent;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|", kwlist,
+                                     &agent))
+        return NULL;
+
+    Py_ssize_t degree = QBAFARelations_Degree(self, agent, 0);
+    if (degree < 0) {
+        return NULL;
+    }
+    return PyLong_FromSsize_t(degree);
+}
+
+/**
+ * @brief Return the number of agents of the patient. Return NULL if an error has ocurred.
+ *
  * @param self instance of QBAFARelations
  * @param args the argument values (patient: QBAFArgument)
  * @param kwds the argument names
- * @return PyObject* list of QBAFArgument
+ * @return PyObject* new PyLong, NULL if an error occurred
  */
 static PyObject *
-QBAFARelations_agents(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
+QBAFARelations_in_degree(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
 {
     static char *kwlist[] = {"patient", NULL};
     PyObject *patient;
@@ -371,7 +1289,11 @@ QBAFARelations_agents(QBAFARelationsObject *self, PyObject *args, PyObject *kwds
                                      &patient))
         return NULL;
 
-    return _QBAFARelations_agents(self, patient);
+    Py_ssize_t degree = QBAFARelations_Degree(self, patient, 1);
+    if (degree < 0) {
+        return NULL;
+    }
+    return PyLong_FromSsize_t(degree);
 }
 
 /**
@@ -386,22 +1308,17 @@ QBAFARelations_agents(QBAFARelationsObject *self, PyObject *args, PyObject *kwds
 int
 _QBAFARelations_contains(QBAFARelationsObject *self, PyObject *agent, PyObject *patient)
 {
-    PyObject *tuple;
-
-    Py_INCREF(agent);
-    Py_INCREF(patient);
-    tuple = PyTuple_Pack(2, agent, patient);    // new reference
-    if (tuple == NULL) {
-        Py_DECREF(agent);
-        Py_DECREF(patient);
-        return -1;
+    Py_ssize_t agent_id = 0, patient_id = 0;
+    int contains = _QBAFARelations_argument_id(self, agent, 0, &agent_id);
+    if (contains <= 0) {
+        return contains;
+    }
+    contains = _QBAFARelations_argument_id(self, patient, 0, &patient_id);
+    if (contains <= 0) {
+        return contains;
     }
-    
-    int contains = PySet_Contains(self->relations, tuple); // QBAFARelations___contains__(self, tuple);
-
-    Py_DECREF(tuple);
 
-    return contains;
+    return _QBAFPairSet_find(&self->pairs, _QBAFPairSet_key(agent_id, patient_id)) >= 0;
 }
 
 /**
@@ -445,54 +1362,14 @@ QBAFARelations_contains(QBAFARelationsObject *self, PyObject *args, PyObject *kw
 int
 _QBAFARelations_add(QBAFARelationsObject *self, PyObject *agent, PyObject *patient)
 {
-    PyObject *tuple, *set;
-
-    Py_INCREF(agent);
-    Py_INCREF(patient);
-    tuple = PyTuple_Pack(2, agent, patient);    // new reference
-    if (tuple == NULL) {
-        Py_DECREF(agent);
-        Py_DECREF(patient);
-        return -1;
-    }
-
-    int contains = PySet_Contains(self->relations, tuple);
-    if (contains < 0) {
-        Py_DECREF(tuple);
-        return -1;
-    }
-    if (contains) {
-        Py_DECREF(tuple);
-        return 0;
-    }
-
-    // If not contains it is inserted
-
-    if (PySet_Add(self->relations, tuple) < 0) {
-        Py_DECREF(tuple);
-        return -1;
-    }
-    Py_DECREF(tuple);
-
-    set = PyDict_GetItemDefaultPySet_New(self->agent_patients, agent);  // Return borrowed reference
-    if (set == NULL) {
-        return -1;
-    }
-    // Add patient to the set
-    if (PySet_Add(set, patient) < 0) {
-        return -1;
-    }
-
-    set = PyDict_GetItemDefaultPySet_New(self->patient_agents, patient);  // Return borrowed reference
-    if (set == NULL) {
-        return -1;
-    }
-    // Add agent to the set
-    if (PySet_Add(set, agent) < 0) {
+    Py_ssize_t agent_id = 0, patient_id = 0;
+    if (_QBAFARelations_argument_id(self, agent, 1, &agent_id) < 0 ||
+        _QBAFARelations_argument_id(self, patient, 1, &patient_id) < 0) {
         return -1;
     }
 
-    return 0;
+    // If it is contained it is not inserted again
+    return _QBAFARelations_add_ids(self, agent_id, patient_id);
 }
 
 /**
@@ -537,53 +1414,28 @@ QBAFARelations_add(QBAFARelationsObject *self, PyObject *args, PyObject *kwds)
 int
 _QBAFARelations_remove(QBAFARelationsObject *self, PyObject *agent, PyObject *patient)
 {
-    PyObject *tuple, *set;
-
-    Py_INCREF(agent);
-    Py_INCREF(patient);
-    tuple = PyTuple_Pack(2, agent, patient);    // new reference
-    if (tuple == NULL) {
-        Py_DECREF(agent);
-        Py_DECREF(patient);
-        return -1;
-    }
-
-    int contains = PySet_Contains(self->relations, tuple);
-    if (contains < 0) {
-        Py_DECREF(tuple);
-        return -1;
-    }
-    if (!contains) {
-        Py_DECREF(tuple);
-        return 0;
-    }
-
-    // If contains it is removed
-
-    if (PySet_Discard(self->relations, tuple) < 0) {
-        Py_DECREF(tuple);
-        return -1;
-    }
-
-    Py_DECREF(tuple);
-
-    set = PyDict_GetItem(self->agent_patients, agent);  // Return borrowed reference
-    if (set == NULL) {
-        return -1;
+    Py_ssize_t agent_id = 0, patient_id = 0;
+    int contains = _QBAFARelations_argument_id(self, agent, 0, &agent_id);
+    if (contains <= 0) {
+        return contains;
     }
-    // Remove patient from the set
-    if (PySet_Discard(set, patient) < 0) {
-        return -1;
+    contains = _QBAFARelations_argument_id(self, patient, 0, &patient_id);
+    if (contains <= 0) {
+        return contains;
     }
 
-    set = PyDict_GetItem(self->patient_agents, patient);  // Return borrowed reference
-    if (set == NULL) {
-        return -1;
+    // If it is contained it is removed
+    uint64_t key = _QBAFPairSet_key(agent_id, patient_id);
+    if (_QBAFPairSet_find(&self->pairs, key) < 0) {
+        return 0;
     }
-    // Remove agent from the set
-    if (PySet_Discard(set, agent) < 0) {
+    if (_QBAFARelations_unshare(self) < 0) {
         return -1;
     }
+    _QBAFPairSet_discard(&self->pairs, key);
+    _QBAFIdArray_remove(&self->patients[agent_id], patient_id);
+    _QBAFIdArray_remove(&self->agents[patient_id], agent_id);
+    _QBAFARelations_modified(self);
 
     return 0;
 }
@@ -630,27 +1482,25 @@ QBAFARelations_remove(QBAFARelationsObject *self, PyObject *args, PyObject *kwds
 PyObject *
 QBAFARelations_copy(QBAFARelationsObject *self, PyObject *Py_UNUSED(ignored))
 {
-    PyObject *kwds = NULL;
-    PyObject *args = PyTuple_Pack(1, self->relations);
-    if (args == NULL)
-        return NULL;
-
-    QBAFARelationsObject *copy = (QBAFARelationsObject *)QBAFARelations_new(Py_TYPE(self), args, kwds);
+    QBAFARelationsObject *copy = (QBAFARelationsObject *)QBAFARelations_new(Py_TYPE(self), NULL, NULL);
     if (copy == NULL) {
-        Py_DECREF(args);
         return NULL;
     }
-    if (QBAFARelations_init(copy, args, kwds) < 0) {
+
+    // The copy keeps the ids of self (and the order of the relations), with its own intern table
+    Py_SETREF(copy->argument_ids, PyDict_Copy(self->argument_ids));
+    Py_SETREF(copy->id_arguments, PyList_GetSlice(self->id_arguments, 0, PyList_GET_SIZE(self->id_arguments)));
+    if (copy->argument_ids == NULL || copy->id_arguments == NULL || _QBAFARelations_share(copy, self) < 0) {
         Py_DECREF(copy);
-        Py_DECREF(args);
         return NULL;
     }
-    Py_DECREF(args);
+
     return (PyObject *)copy;
 }
 
 /**
- * @brief Return an iterator of the set relations.
+ * @brief Return an iterator of the relations.
+ * It iterates a snapshot of the relations, so they can be modified during the iteration.
  * 
  * @param self a QBAFARelations object
  * @return PyObject* new PyIter
@@ -658,7 +1508,58 @@ QBAFARelations_copy(QBAFARelationsObject *self, PyObject *Py_UNUSED(ignored))
 PyObject *
 QBAFARelations_iter(QBAFARelationsObject *self)
 {
-    return PyObject_GetIter(self->relations);
+    PyObject *list = _QBAFARelations_tuples(self);
+    if (list == NULL) {
+        return NULL;
+    }
+    PyObject *iterator = PyObject_GetIter(list);
+    Py_DECREF(list);
+    return iterator;
+}
+
+int
+QBAFARelations_HasRelation(QBAFARelationsObject *self, Py_ssize_t agent, Py_ssize_t patient)
+{
+    return _QBAFPairSet_find(&self->pairs, _QBAFPairSet_key(agent, patient)) >= 0;
+}
+
+int
+QBAFARelations_ContainsIds(QBAFARelationsObject *self, QBAFARelationsObject *other, Py_ssize_t agent, Py_ssize_t patient)
+{
+    // Relations with the same intern table have the same ids
+    if (self->argument_ids == other->argument_ids) {
+        return QBAFARelations_HasRelation(self, agent, patient);
+    }
+    return _QBAFARelations_contains(self, PyList_GET_ITEM(other->id_arguments, agent),
+                                    PyList_GET_ITEM(other->id_arguments, patient));
+}
+
+/**
+ * @brief Return 1 if every relation of self is a relation of other, 0 if not, -1 if an error is encountered.
+ *
+ * @param self a QBAFARelations instance
+ * @param other a QBAFARelations instance
+ * @return int 1 if self is a subset of other, 0 if it is not, and -1 if an error is encountered
+ */
+static int
+_QBAFARelations_isSubset(QBAFARelationsObject *self, QBAFARelationsObject *other)
+{
+    if (self->pairs.size > other->pairs.size) {
+        return 0;
+    }
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    if (size > self->ids_capacity) {
+        size = self->ids_capacity;
+    }
+    for (Py_ssize_t agent = 0; agent < size; agent++) {
+        for (Py_ssize_t position = 0; position < self->patients[agent].size; position++) {
+            int contains = QBAFARelations_ContainsIds(other, self, agent, self->patients[agent].ids[position]);
+            if (contains <= 0) {
+                return contains;
+            }
+        }
+    }
+    return 1;
 }
 
 /**
@@ -670,7 +1571,25 @@ QBAFARelations_iter(QBAFARelationsObject *self)
  */
 int
 _QBAFARelations_isDisjoint(QBAFARelationsObject *self, QBAFARelationsObject *other) {
-    return PySet_IsDisjoint(self->relations, other->relations);
+    // The relations of the smaller instance are looked up in the larger one
+    if (self->pairs.size > other->pairs.size) {
+        QBAFARelationsObject *swap = self;
+        self = other;
+        other = swap;
+    }
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    if (size > self->ids_capacity) {
+        size = self->ids_capacity;
+    }
+    for (Py_ssize_t agent = 0; agent < size; agent++) {
+        for (Py_ssize_t position = 0; position < self->patients[agent].size; position++) {
+            int contains = QBAFARelations_ContainsIds(other, self, agent, self->patients[agent].ids[position]);
+            if (contains != 0) {
+                return contains < 0 ? -1 : 0;
+            }
+        }
+    }
+    return 1;
 }
 
 /**
@@ -720,7 +1639,33 @@ QBAFARelations_richcompare(QBAFARelationsObject *self, PyObject *other, int op)
         return NULL;
     }
 
-    return PyObject_RichCompare(self->relations, ((QBAFARelationsObject *)other)->relations, op);
+    QBAFARelationsObject *relations = (QBAFARelationsObject *)other;
+    int result;
+    switch (op) {
+        case Py_EQ:
+        case Py_NE:
+            result = self->pairs.size == relations->pairs.size ? _QBAFARelations_isSubset(self, relations) : 0;
+            if (result >= 0 && op == Py_NE) {
+                result = !result;
+            }
+            break;
+        case Py_LE:
+            result = _QBAFARelations_isSubset(self, relations);
+            break;
+        case Py_LT:
+            result = self->pairs.size < relations->pairs.size ? _QBAFARelations_isSubset(self, relations) : 0;
+            break;
+        case Py_GE:
+            result = _QBAFARelations_isSubset(relations, self);
+            break;
+        default:    // Py_GT
+            result = self->pairs.size > relations->pairs.size ? _QBAFARelations_isSubset(relations, self) : 0;
+            break;
+    }
+    if (result < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(result);
 }
 
 /**
@@ -734,7 +1679,7 @@ static PyMemberDef QBAFARelations_members[] = {
 PyDoc_STRVAR(relations_doc,
 "Set of argument relations (Agent, Patient).\n"
 "\n"
-"Getter: Return a copy of the QBAFARelation's set of relations\n"
+"Getter: Return a new set with the QBAFARelation's relations\n"
 "Type: set of (QBAFArgument, QBAFArgument)\n"
 );
 
@@ -776,6 +1721,60 @@ PyDoc_STRVAR(agents_doc,
 "    list: The list of QBAFArgment that initiate the action\n"
 );
 
+PyDoc_STRVAR(patients_view_doc,
+"patients_view(self, agent)\n"
+"--\n"
+"\n"
+"Return a read-only view of the patients of the agent, without copying them.\n"
+"The view cannot be used after the relations are modified.\n"
+"\n"
+"Args:\n"
+"    agent (QBAFArgument): The initiator of the action\n"
+"\n"
+"Returns:\n"
+"    QBAFARelationsView: The sequence of QBAFArgment that undergo the effect of the action\n"
+);
+
+PyDoc_STRVAR(agents_view_doc,
+"agents_view(self, patient)\n"
+"--\n"
+"\n"
+"Return a read-only view of the agents of the patient, without copying them.\n"
+"The view cannot be used after the relations are modified.\n"
+"\n"
+"Args:\n"
+"    patient (QBAFArgument): The entity undergoing the effect of the action\n"
+"\n"
+"Returns:\n"
+"    QBAFARelationsView: The sequence of QBAFArgment that initiate the action\n"
+);
+
+PyDoc_STRVAR(out_degree_doc,
+"out_degree(self, agent)\n"
+"--\n"
+"\n"
+"Return the number of patients of the agent.\n"
+"\n"
+"Args:\n"
+"    agent (QBAFArgument): The initiator of the action\n"
+"\n"
+"Returns:\n"
+"    int: The number of relations whose agent is agent\n"
+);
+
+PyDoc_STRVAR(in_degree_doc,
+"in_degree(self, patient)\n"
+"--\n"
+"\n"
+"Return the number of agents of the patient.\n"
+"\n"
+"Args:\n"
+"    patient (QBAFArgument): The entity undergoing the effect of the action\n"
+"\n"
+"Returns:\n"
+"    int: The number of relations whose patient is patient\n"
+);
+
 PyDoc_STRVAR(contains_doc,
 "contains(self, agent, patient)\n"
 "--\n"
@@ -850,6 +1849,18 @@ static PyMethodDef QBAFARelations_methods[] = {
     {"agents", (PyCFunction) QBAFARelations_agents, METH_VARARGS | METH_KEYWORDS,
     agents_doc
     },
+    {"patients_view", (PyCFunction) QBAFARelations_patients_view, METH_VARARGS | METH_KEYWORDS,
+    patients_view_doc
+    },
+    {"agents_view", (PyCFunction) QBAFARelations_agents_view, METH_VARARGS | METH_KEYWORDS,
+    agents_view_doc
+    },
+    {"out_degree", (PyCFunction) QBAFARelations_out_degree, METH_VARARGS | METH_KEYWORDS,
+    out_degree_doc
+    },
+    {"in_degree", (PyCFunction) QBAFARelations_in_degree, METH_VARARGS | METH_KEYWORDS,
+    in_degree_doc
+    },
     {"contains", (PyCFunction) QBAFARelations_contains, METH_VARARGS | METH_KEYWORDS,
     contains_doc
     },
@@ -976,49 +1987,21 @@ QBAFARelations_Create(PyObject *relations)
  */
 int
 QBAFARelations_ArgsContained(QBAFARelationsObject *self, PyObject *arguments) {
-    PyObject *iterator = PyObject_GetIter(self->relations);
-    PyObject *item;
-    PyObject *agent, *patient;
-    int contains;
-
-    if (iterator == NULL) {
-        /* propagate error */
-        return -1;
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    if (size > self->ids_capacity) {
+        size = self->ids_capacity;
     }
 
-    while ((item = PyIter_Next(iterator))) {    // PyIter_Next returns a new reference
-        agent = PyTuple_GetItem(item, 0);       // Returns borrowed reference. NULL if the index is wrong.
-        patient = PyTuple_GetItem(item, 1);     // Returns borrowed reference. NULL if the index is wrong.
-        Py_DECREF(item);
-
-        if (agent == NULL || patient == NULL) {
-            Py_DECREF(iterator);
-            return -1;
-        }
-
-        contains = PySet_Contains(arguments, agent);
-        if (contains < 0) {
-            Py_DECREF(iterator);
-            return -1;
-        }
-        if (!contains) {
-            Py_DECREF(iterator);
-            return 0;   // return False
-        }
-
-        contains = PySet_Contains(arguments, patient);
-        if (contains < 0) {
-            Py_DECREF(iterator);
-            return -1;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        if (self->patients[id].size == 0 && self->agents[id].size == 0) {
+            continue;
         }
-        if (!contains) {
-            Py_DECREF(iterator);
-            return 0;   // return False
+        int contains = PySet_Contains(arguments, PyList_GET_ITEM(self->id_arguments, id));
+        if (contains <= 0) {
+            return contains;   // return False or error
         }
     }
 
-    Py_DECREF(iterator);
-
     return 1;   // return True
 }
 
@@ -1031,34 +2014,13 @@ QBAFARelations_ArgsContained(QBAFARelationsObject *self, PyObject *arguments) {
  */
 int
 QBAFARelations_contains_argument(QBAFARelationsObject *self, PyObject *argument) {
-    PyObject *tuple, *list;
-
-    tuple = PyTuple_Pack(1, argument); // New reference
-
-    list = QBAFARelations_agents(self, tuple, NULL);
-    if (list == NULL) {
-        Py_DECREF(tuple);
-        return -1;
-    }
-    if (PyList_GET_SIZE(list) > 0) {
-        Py_DECREF(tuple);
-        return 1;   // return True
-    }
-
-    list = QBAFARelations_patients(self, tuple, NULL);
-    if (list == NULL) {
-        Py_DECREF(tuple);
-        return -1;
-    }
-
-    if (PyList_GET_SIZE(list) > 0) {
-        Py_DECREF(tuple);
-        return 1;   // return True
+    Py_ssize_t id = 0;
+    int contains = _QBAFARelations_argument_id(self, argument, 0, &id);
+    if (contains <= 0) {
+        return contains;
     }
 
-    Py_DECREF(tuple);
-
-    return 0;   // return False
+    return id < self->ids_capacity && (self->agents[id].size > 0 || self->patients[id].size > 0);
 }
 
 /**
@@ -1072,45 +2034,25 @@ QBAFARelations_contains_argument(QBAFARelationsObject *self, PyObject *argument)
 static inline int
 _QBAFARelations_remove_argument(QBAFARelationsObject *self, PyObject *argument)
 {
-    PyObject *list, *iterator, *agent, *patient;
-    
-    list = _QBAFARelations_agents(self, argument); // New reference
-    if (list == NULL) {
-        return -1;
+    Py_ssize_t id = 0;
+    int contains = _QBAFARelations_argument_id(self, argument, 0, &id);
+    if (contains <= 0 || id >= self->ids_capacity) {
+        return contains < 0 ? -1 : 0;
     }
-    iterator = PyObject_GetIter(list);
-    if (iterator == NULL) {
-        Py_DECREF(list);
-        return -1;
-    }
-    while ((agent = PyIter_Next(iterator))) {
+
+    // The last relations are removed first, so the arrays of ids are not shifted
+    while (self->agents[id].size > 0) {
+        PyObject *agent = PyList_GET_ITEM(self->id_arguments, self->agents[id].ids[self->agents[id].size - 1]);
         if (_QBAFARelations_remove(self, agent, argument) < 0) {
-            Py_DECREF(list); Py_DECREF(iterator); Py_DECREF(agent);
             return -1;
         }
-        Py_DECREF(agent);
     }
-    Py_DECREF(iterator);
-    Py_DECREF(list);
-
-    list = _QBAFARelations_patients(self, argument); // New reference
-    if (list == NULL) {
-        return -1;
-    }
-    iterator = PyObject_GetIter(list);
-    if (iterator == NULL) {
-        Py_DECREF(list);
-        return -1;
-    }
-    while ((patient = PyIter_Next(iterator))) {
+    while (self->patients[id].size > 0) {
+        PyObject *patient = PyList_GET_ITEM(self->id_arguments, self->patients[id].ids[self->patients[id].size - 1]);
         if (_QBAFARelations_remove(self, argument, patient) < 0) {
-            Py_DECREF(list); Py_DECREF(iterator); Py_DECREF(patient);
             return -1;
         }
-        Py_DECREF(patient);
     }
-    Py_DECREF(iterator);
-    Py_DECREF(list);
 
     return 0;
 }
@@ -1149,23 +2091,16 @@ _QBAFARelations_remove_arguments(QBAFARelationsObject *self, PyObject *iterable)
  * 
  * @param self instance of QBAFARelations
  * @param agent instance of QBAFArgument
- * @return PyObject* borrowed PySet of QBAFArgument, NULL if an error occurred
+ * @return PyObject* new PySet of QBAFArgument, NULL if an error occurred
  */
 PyObject *
 _QBAFARelations_patients_set(QBAFARelationsObject *self, PyObject *agent) {
-    int contains = PyDict_Contains(self->agent_patients, agent);
-    if (contains < 0)
+    PyObject *list = _QBAFARelations_patients(self, agent);
+    if (list == NULL)
         return NULL;
-    if (!contains) {
-        PyObject *set = PySet_New(NULL);
-        if (PyDict_SetItem(self->agent_patients, agent, set) < 0) {
-            Py_XDECREF(set);
-            return NULL;
-        }
-        Py_XDECREF(set);
-    }
-
-    return PyDict_GetItem(self->agent_patients, agent);
+    PyObject *set = PySet_New(list);
+    Py_DECREF(list);
+    return set;
 }
 
 /**
@@ -1180,13 +2115,402 @@ _QBAFARelations_patients_set(QBAFARelationsObject *self, PyObject *agent) {
 int
 _QBAFARelations_equal_patients(QBAFARelationsObject *self, QBAFARelationsObject *other, PyObject *agent)
 {
-    PyObject *self_patients = _QBAFARelations_patients_set(self, agent); // Borrowed reference
-    if (self_patients == NULL) {
+    Py_ssize_t self_id = 0, other_id = 0, self_size = 0, other_size = 0;
+    int self_contains = _QBAFARelations_argument_id(self, agent, 0, &self_id);
+    if (self_contains < 0) {
+        return -1;
+    }
+    int other_contains = _QBAFARelations_argument_id(other, agent, 0, &other_id);
+    if (other_contains < 0) {
+        return -1;
+    }
+    const Py_ssize_t *patients = self_contains ? QBAFARelations_PatientIds(self, self_id, &self_size) : NULL;
+    if (other_contains) {
+        QBAFARelations_PatientIds(other, other_id, &other_size);
+    }
+
+    // The patients of an agent are not repeated, so they are equal if every patient of self is a patient in other
+    if (self_size != other_size) {
+        return 0;
+    }
+    for (Py_ssize_t index = 0; index < self_size; index++) {
+        Py_ssize_t patient = patients[index];
+        if (self->argument_ids != other->argument_ids) {
+            int contains = _QBAFARelations_argument_id(other, PyList_GET_ITEM(self->id_arguments, patient), 0, &patient);
+            if (contains <= 0) {
+                return contains;
+            }
+        }
+        if (!QBAFARelations_HasRelation(other, other_id, patient)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Use the ids of a QBAFramework instead of the own ids of the relations.
+ * The relations keep the order of the agents and patients of every argument, and they cannot be modified from python.
+ *
+ * @param self an instance of QBAFARelations
+ * @param argument_ids the dictionary (argument: QBAFArgument, id: int) of the QBAFramework
+ * @param id_arguments the list of QBAFArgument indexed by id of the QBAFramework
+ * @return int 0 if successful, -1 if an error occurred (ValueError if an argument of the relations has no id)
+ */
+int
+QBAFARelations_Bind(QBAFARelationsObject *self, PyObject *argument_ids, PyObject *id_arguments)
+{
+    if (_QBAFARelations_unshare(self) < 0) {
+        return -1;
+    }
+    Py_ssize_t size = PyList_GET_SIZE(self->id_arguments);
+    if (size > self->ids_capacity) {
+        size = self->ids_capacity;
+    }
+    Py_ssize_t capacity = PyList_GET_SIZE(id_arguments);
+    Py_ssize_t *new_ids = PyMem_Malloc((size > 0 ? size : 1) * sizeof(Py_ssize_t));
+    if (new_ids == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    // One lookup per argument of the relations
+    for (Py_ssize_t id = 0; id < size; id++) {
+        new_ids[id] = -1;
+        if (self->patients[id].size == 0 && self->agents[id].size == 0) {
+            continue;
+        }
+        PyObject *pyid = PyDict_GetItemWithError(argument_ids, PyList_GET_ITEM(self->id_arguments, id));   // Borrowed reference
+        if (pyid == NULL) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_ValueError, "the arguments of the relations must be arguments of the QBAFramework");
+            }
+            PyMem_Free(new_ids);
+            return -1;
+        }
+        new_ids[id] = PyLong_AsSsize_t(pyid);
+    }
+    if (capacity > QBAF_PAIR_MAX_ID) {
+        PyErr_SetString(PyExc_OverflowError, "too many arguments in the relations");
+        PyMem_Free(new_ids);
+        return -1;
+    }
+
+    Py_ssize_t new_capacity = capacity > 0 ? capacity : 1;
+    QBAFIdArray *patients = PyMem_Calloc(new_capacity, sizeof(QBAFIdArray));
+    QBAFIdArray *agents = PyMem_Calloc(new_capacity, sizeof(QBAFIdArray));
+    QBAFPairSet pairs = {NULL, 0, 0, 0};
+    if (patients == NULL || agents == NULL || _QBAFPairSet_resize(&pairs, self->pairs.size) < 0) {
+        PyMem_Free(patients);
+        PyMem_Free(agents);
+        PyMem_Free(new_ids);
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        return -1;
+    }
+    // The table has room for every relation, so adding them does not fail
+    for (Py_ssize_t id = 0; id < size; id++) {
+        for (Py_ssize_t index = 0; new_ids[id] >= 0 && index < self->patients[id].size; index++) {
+            _QBAFPairSet_add(&pairs, _QBAFPairSet_key(new_ids[id], new_ids[self->patients[id].ids[index]]));
+        }
+    }
+
+    // The arrays are moved to the new ids, and so are their contents
+    for (Py_ssize_t id = 0; id < size; id++) {
+        if (new_ids[id] < 0) {
+            _QBAFIdArray_free(&self->patients[id]);
+            _QBAFIdArray_free(&self->agents[id]);
+            continue;
+        }
+        patients[new_ids[id]] = self->patients[id];
+        agents[new_ids[id]] = self->agents[id];
+        for (Py_ssize_t index = 0; index < self->patients[id].size; index++) {
+            patients[new_ids[id]].ids[index] = new_ids[self->patients[id].ids[index]];
+        }
+        for (Py_ssize_t index = 0; index < self->agents[id].size; index++) {
+            agents[new_ids[id]].ids[index] = new_ids[self->agents[id].ids[index]];
+        }
+    }
+    for (Py_ssize_t id = size; id < self->ids_capacity; id++) {
+        _QBAFIdArray_free(&self->patients[id]);
+        _QBAFIdArray_free(&self->agents[id]);
+    }
+    PyMem_Free(self->patients);
+    PyMem_Free(self->agents);
+    PyMem_Free(new_ids);
+
+    self->patients = patients;
+    self->agents = agents;
+    self->ids_capacity = new_capacity;
+    _QBAFPairSet_clear(&self->pairs);
+    self->pairs = pairs;
+    _QBAFARelations_modified(self);
+    Py_INCREF(argument_ids);
+    Py_SETREF(self->argument_ids, argument_ids);
+    Py_INCREF(id_arguments);
+    Py_SETREF(self->id_arguments, id_arguments);
+    self->bound = 1;
+    self->modifiable = 0;
+    return 0;
+}
+
+/**
+ * @brief Return new relations bound to a QBAFramework (argument_ids and id_arguments) with the same ids as self.
+ * They share the relations of self until one of them is modified, which then copies them.
+ *
+ * @param self an instance of QBAFARelations
+ * @param argument_ids the dictionary (argument: QBAFArgument, id: int) of the QBAFramework, with the ids of self
+ * @param id_arguments the list of QBAFArgument indexed by id of the QBAFramework, with the ids of self
+ * @return PyObject* new QBAFARelations, NULL if an error occurred
+ */
+PyObject *
+QBAFARelations_Share(QBAFARelationsObject *self, PyObject *argument_ids, PyObject *id_arguments)
+{
+    QBAFARelationsObject *copy = (QBAFARelationsObject *)QBAFARelations_new(Py_TYPE(self), NULL, NULL);
+    if (copy == NULL) {
+        return NULL;
+    }
+    if (_QBAFARelations_share(copy, self) < 0) {
+        Py_DECREF(copy);
+        return NULL;
+    }
+    QBAFARelations_SetIds(copy, argument_ids, id_arguments);
+    copy->bound = 1;
+    copy->modifiable = 0;
+    return (PyObject *)copy;
+}
+
+/**
+ * @brief Replace the ids of the QBAFramework that self is bound to by a copy of them with the same ids.
+ *
+ * @param self an instance of QBAFARelations bound to a QBAFramework
+ * @param argument_ids the new dictionary (argument: QBAFArgument, id: int) of the QBAFramework
+ * @param id_arguments the new list of QBAFArgument indexed by id of the QBAFramework
+ */
+void
+QBAFARelations_SetIds(QBAFARelationsObject *self, PyObject *argument_ids, PyObject *id_arguments)
+{
+    Py_INCREF(argument_ids);
+    Py_SETREF(self->argument_ids, argument_ids);
+    Py_INCREF(id_arguments);
+    Py_SETREF(self->id_arguments, id_arguments);
+}
+
+/**
+ * @brief Add the relations (agents[index], patients[index]) between ids of the QBAFramework that self is bound to.
+ * The relations of every argument are counted first, so every array of ids and the set of relations grow once
+ * and nothing can fail after the first relation is added.
+ *
+ * @param self an instance of QBAFARelations bound to a QBAFramework
+ * @param agents the ids of the agents, each lower than the number of arguments of the QBAFramework
+ * @param patients the ids of the patients, each lower than the number of arguments of the QBAFramework
+ * @param size the number of relations
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int
+QBAFARelations_AddIdArrays(QBAFARelationsObject *self, const Py_ssize_t *agents, const Py_ssize_t *patients, Py_ssize_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+    Py_ssize_t ids = PyList_GET_SIZE(self->id_arguments);
+    if (ids - 1 > QBAF_PAIR_MAX_ID) {
+        PyErr_SetString(PyExc_OverflowError, "too many arguments in the relations");
+        return -1;
+    }
+    if (_QBAFARelations_unshare(self) < 0 || _QBAFARelations_reserve_ids(self, ids) < 0) {
+        return -1;
+    }
+
+    // The number of new patients of every agent, followed by the number of new agents of every patient
+    Py_ssize_t *counts = PyMem_Calloc(2 * ids, sizeof(Py_ssize_t));
+    if (counts == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (Py_ssize_t index = 0; index < size; index++) {
+        counts[agents[index]]++;
+        counts[ids + patients[index]]++;
+    }
+    for (Py_ssize_t id = 0; id < ids; id++) {
+        if (_QBAFIdArray_reserve(&self->patients[id], self->patients[id].size + counts[id]) < 0 ||
+            _QBAFIdArray_reserve(&self->agents[id], self->agents[id].size + counts[ids + id]) < 0) {
+            PyMem_Free(counts);
+            return -1;
+        }
+    }
+    PyMem_Free(counts);
+    if (2 * (self->pairs.used + size) > self->pairs.mask + 1 &&
+        _QBAFPairSet_resize(&self->pairs, self->pairs.size + size) < 0) {
+        return -1;
+    }
+
+    for (Py_ssize_t index = 0; index < size; index++) {
+        Py_ssize_t agent = agents[index], patient = patients[index];
+        if (_QBAFPairSet_add(&self->pairs, _QBAFPairSet_key(agent, patient)) > 0) {
+            self->patients[agent].ids[self->patients[agent].size++] = patient;
+            self->agents[patient].ids[self->agents[patient].size++] = agent;
+        }
+    }
+    _QBAFARelations_modified(self);
+    return 0;
+}
+
+/**
+ * @brief Remove the relations (agents[index], patients[index]) that are contained in self.
+ *
+ * @param self an instance of QBAFARelations bound to a QBAFramework
+ * @param agents the ids of the agents
+ * @param patients the ids of the patients
+ * @param size the number of relations
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int
+QBAFARelations_RemoveIdArrays(QBAFARelationsObject *self, const Py_ssize_t *agents, const Py_ssize_t *patients, Py_ssize_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+    if (_QBAFARelations_unshare(self) < 0) {
         return -1;
     }
-    PyObject *other_patients = _QBAFARelations_patients_set(other, agent);  // Borrowed reference
-    if (other_patients == NULL) {
+    for (Py_ssize_t index = 0; index < size; index++) {
+        Py_ssize_t agent = agents[index], patient = patients[index];
+        if (_QBAFPairSet_discard(&self->pairs, _QBAFPairSet_key(agent, patient))) {
+            _QBAFIdArray_remove(&self->patients[agent], patient);
+            _QBAFIdArray_remove(&self->agents[patient], agent);
+        }
+    }
+    _QBAFARelations_modified(self);
+    return 0;
+}
+
+/**
+ * @brief Give the id to the argument with the id from, after the argument with the id to has been deleted
+ * from the QBAFramework that self is bound to. The argument with the id to must not have any relation.
+ *
+ * @param self an instance of QBAFARelations bound to a QBAFramework
+ * @param from the old id of the argument
+ * @param to its new id
+ * @return int 0 if successful, -1 if an error occurred
+ */
+int
+QBAFARelations_MoveId(QBAFARelationsObject *self, Py_ssize_t from, Py_ssize_t to)
+{
+    if (_QBAFARelations_unshare(self) < 0) {
         return -1;
     }
-    return PyObject_RichCompareBool(self_patients, other_patients, Py_EQ);
-}
\ No newline at end of file
+    _QBAFARelations_modified(self);
+    if (to < self->ids_capacity) {
+        _QBAFIdArray_free(&self->patients[to]);
+        _QBAFIdArray_free(&self->agents[to]);
+    }
+    if (from == to || from >= self->ids_capacity) {
+        return 0;
+    }
+
+    QBAFIdArray *patients = &self->patients[from], *agents = &self->agents[from];
+    // The packed relations are removed before the new ones are added, so a relation of from with itself is not lost
+    for (Py_ssize_t index = 0; index < patients->size; index++) {
+        _QBAFPairSet_discard(&self->pairs, _QBAFPairSet_key(from, patients->ids[index]));
+    }
+    for (Py_ssize_t index = 0; index < agents->size; index++) {
+        _QBAFPairSet_discard(&self->pairs, _QBAFPairSet_key(agents->ids[index], from));
+    }
+    for (Py_ssize_t index = 0; index < patients->size; index++) {
+        Py_ssize_t patient = patients->ids[index];
+        if (_QBAFPairSet_add(&self->pairs, _QBAFPairSet_key(to, patient == from ? to : patient)) < 0) {
+            return -1;
+        }
+    }
+    for (Py_ssize_t index = 0; index < agents->size; index++) {
+        Py_ssize_t agent = agents->ids[index];
+        if (agent != from && _QBAFPairSet_add(&self->pairs, _QBAFPairSet_key(agent, to)) < 0) {
+            return -1;
+        }
+    }
+
+    for (Py_ssize_t index = 0; index < patients->size; index++) {
+        Py_ssize_t patient = patients->ids[index];
+        _QBAFIdArray_replace(&self->agents[patient], from, to);
+    }
+    for (Py_ssize_t index = 0; index < agents->size; index++) {
+        Py_ssize_t agent = agents->ids[index];
+        // The agent of a relation of the argument with itself has just been replaced by to
+        _QBAFIdArray_replace(agent == to ? patients : &self->patients[agent], from, to);
+    }
+
+    self->patients[to] = *patients;
+    self->agents[to] = *agents;
+    memset(patients, 0, sizeof(QBAFIdArray));
+    memset(agents, 0, sizeof(QBAFIdArray));
+    return 0;
+}
+
+/**
+ * @brief Fill offsets and ids with the arrays of ids arrays[0] ... arrays[size - 1] one after another.
+ *
+ * @param arrays the QBAFIdArray of every id
+ * @param capacity the number of items of arrays
+ * @param size the number of ids of the snapshot
+ * @param offsets an array of size + 1 offsets
+ * @param ids an array with room for all the ids of arrays
+ */
+static inline void
+_QBAFAdjacency_fill(const QBAFIdArray *arrays, Py_ssize_t capacity, Py_ssize_t size, Py_ssize_t *offsets, Py_ssize_t *ids)
+{
+    Py_ssize_t offset = 0;
+    for (Py_ssize_t id = 0; id < size; id++) {
+        offsets[id] = offset;
+        if (id < capacity && arrays[id].size > 0) {
+            memcpy(ids + offset, arrays[id].ids, arrays[id].size * sizeof(Py_ssize_t));
+            offset += arrays[id].size;
+        }
+    }
+    offsets[size] = offset;
+}
+
+/**
+ * @brief Return the compressed sparse row snapshot of the relations for the ids 0 ... size - 1.
+ * It is built lazily and kept until the relations are modified.
+ *
+ * @param self instance of QBAFARelations
+ * @param size the number of ids (at least the number of ids that have relations)
+ * @return const QBAFAdjacency* the snapshot (owned by self), NULL if an error occurred
+ */
+const QBAFAdjacency *
+QBAFARelations_Adjacency(QBAFARelationsObject *self, Py_ssize_t size)
+{
+    if (self->adjacency_valid && self->adjacency.size == size) {
+        return &self->adjacency;
+    }
+    _QBAFARelations_invalidate_adjacency(self);
+
+    Py_ssize_t edges = 0;
+    Py_ssize_t limit = size < self->ids_capacity ? size : self->ids_capacity;
+    for (Py_ssize_t id = 0; id < limit; id++) {
+        edges += self->agents[id].size;
+    }
+    if (edges != self->pairs.size) {
+        PyErr_SetString(PyExc_RuntimeError, "relations are inconsistent with the arguments of the framework");
+        return NULL;
+    }
+
+    QBAFAdjacency *adjacency = &self->adjacency;
+    adjacency->agent_offsets = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    adjacency->patient_offsets = PyMem_Malloc((size + 1) * sizeof(Py_ssize_t));
+    adjacency->agents = PyMem_Malloc((edges > 0 ? edges : 1) * sizeof(Py_ssize_t));
+    adjacency->patients = PyMem_Malloc((edges > 0 ? edges : 1) * sizeof(Py_ssize_t));
+    if (adjacency->agent_offsets == NULL || adjacency->patient_offsets == NULL ||
+        adjacency->agents == NULL || adjacency->patients == NULL) {
+        _QBAFARelations_invalidate_adjacency(self);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    _QBAFAdjacency_fill(self->agents, self->ids_capacity, size, adjacency->agent_offsets, adjacency->agents);
+    _QBAFAdjacency_fill(self->patients, self->ids_capacity, size, adjacency->patient_offsets, adjacency->patients);
+    adjacency->size = size;
+    self->adjacency_valid = 1;
+    return adjacency;
+}
@@ -0,0 +1,141 @@
+import array
+import pytest
+from qbaf import QBAFramework
+
+
+args = ['a', 'b', 'c', 'd']
+strengths = [0.5, 0.6, 0.7, 0.8]
+att = [('b', 'a'), ('d', 'c')]
+supp = [('c', 'a'), ('d', 'b')]
+
+
+def test_from_arrays():
+    framework = QBAFramework.from_arrays(['a', 'b', 'c', 'd'], array.array('d', [0.5, 0.6, 0.7, 0.8]),
+                                         array.array('i', [1, 3]), array.array('i', [0, 2]),
+                                         array.array('Q', [2, 3]), array.array('Q', [0, 1]), semantics='DFQuAD_model')
+    expected = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    assert framework.arguments == expected.arguments
+    assert framework.attack_relations == expected.attack_relations
+    assert framework.support_relations == expected.support_relations
+    assert framework.semantics == 'DFQuAD_model'
+    assert framework.final_strengths == expected.final_strengths
+
+    framework.add_argument('e', 0.1)
+    framework.add_attack_relation('e', 'a')
+    expected.add_argument('e', 0.1)
+    expected.add_attack_relation('e', 'a')
+    assert framework.final_strengths == expected.final_strengths
+
+
+def test_from_arrays_with_sequences():
+    framework = QBAFramework.from_arrays(names=['a', 'b', 'c', 'd'], initial_strengths=[0.5, 0.6, 0.7, 0.8],
+                                         attack_src=[1, 3, 1], attack_dst=[0, 2, 0], support_src=[2, 3], support_dst=[0, 1])
+    assert len(framework.attack_relations) == 2
+    assert framework.final_strengths == QBAFramework(args, strengths, att, supp).final_strengths
+    assert QBAFramework.from_arrays([], [], [], [], [], []).arguments == set()
+
+
+def test_from_arrays_errors():
+    names, strengths = ['a', 'b'], array.array('d', [0.5, 0.5])
+    with pytest.raises(ValueError):
+        QBAFramework.from_arrays(names, array.array('d', [0.5]), [], [], [], [])
+    with pytest.raises(TypeError):
+        QBAFramework.from_arrays(names, array.array('f', [0.5, 0.5]), [], [], [], [])
+    with pytest.raises(TypeError):
+        QBAFramework.from_arrays(names, strengths, array.array('d', [0.0]), [1], [], [])
+    with pytest.raises(ValueError):
+        QBAFramework.from_arrays(names, strengths, [0, 1], [1], [], [])
+    with pytest.raises(ValueError):
+        QBAFramework.from_arrays(names, strengths, [0], [2], [], [])
+    with pytest.raises(ValueError):
+        QBAFramework.from_arrays(names, strengths, array.array('b', [-1]), [1], [], [])
+    with pytest.raises(ValueError, match=r'every id of attack_src must be within range \[0, 2\)'):
+        QBAFramework.from_arrays(names, strengths, array.array('Q', [2**63]), array.array('Q', [1]), [], [])
+    with pytest.raises(ValueError):
+        QBAFramework.from_arrays(['a', 'a'], strengths, [], [], [], [])
+    with pytest.raises(ValueError):
+        QBAFramework.from_arrays(names, strengths, [0], [1], [0], [1])
+    with pytest.raises(ValueError):
+        QBAFramework.from_arrays(names, [0.5, 1.5], [], [], [], [], semantics='DFQuAD_model')
+    with pytest.raises(ValueError):
+        QBAFramework.from_arrays(names, strengths, [0, 1], [1, 0], [], [], reject_cycles=True)
+    with pytest.raises(TypeError):
+        QBAFramework.from_arrays(names, strengths, [], [], [])
+    with pytest.raises(TypeError):
+        QBAFramework.from_arrays(names, strengths, [], [], [], [], names=names)
+    with pytest.raises(TypeError):
+        QBAFramework.from_arrays(names, strengths, [], [], [], [], unknown=1)
+
+
+def test_add_arguments_and_relations():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    framework.final_strengths
+    framework.add_arguments(['e', 'f', 'a'], array.array('d', [0.1, 0.2, 0.9]))
+    framework.add_relations(attacks=[('e', 'a'), ('f', 'e')], supports=[('f', 'b')])
+    expected = QBAFramework(['a', 'b', 'c', 'd', 'e', 'f'], [0.5, 0.6, 0.7, 0.8, 0.1, 0.2],
+                            [('b', 'a'), ('d', 'c'), ('e', 'a'), ('f', 'e')], [('c', 'a'), ('d', 'b'), ('f', 'b')],
+                            semantics='DFQuAD_model')
+    assert framework.final_strengths == expected.final_strengths
+    assert framework.attack_relations == expected.attack_relations
+    framework.add_arguments(['g'])
+    assert framework.initial_strength('g') == 0.0
+
+    framework.remove_relations(attacks=[('e', 'a'), ('a', 'g')], supports=[('f', 'b')])
+    expected.remove_attack_relation('e', 'a')
+    expected.remove_support_relation('f', 'b')
+    assert framework.final_strengths == pytest.approx({**expected.final_strengths, 'g': 0.0})
+
+
+def test_modify_initial_strengths_is_incremental():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    framework.final_strengths
+    framework.modify_initial_strengths(['a', 'd'], [0.1, 0.2])
+    expected = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    expected.modify_initial_strength('a', 0.1)
+    expected.modify_initial_strength('d', 0.2)
+    assert framework.final_strengths == expected.final_strengths
+    assert framework.last_solve_info['update_scheme'] == 'incremental'
+
+
+def test_apply_changes():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    framework.apply_changes({'add_arguments': {'e': 0.3, 'a': 0.9}, 'add_attacks': [('e', 'a')],
+                             'remove_supports': [('c', 'a'), ('a', 'b')], 'modify_initial_strengths': {'e': 0.4, 'c': 0.1}})
+    expected = QBAFramework(['a', 'b', 'c', 'd', 'e'], [0.5, 0.6, 0.1, 0.8, 0.4], [('b', 'a'), ('d', 'c'), ('e', 'a')],
+                            [('d', 'b')], semantics='DFQuAD_model')
+    assert framework.arguments == expected.arguments
+    assert framework.attack_relations == expected.attack_relations
+    assert framework.support_relations == expected.support_relations
+    assert framework.final_strengths == expected.final_strengths
+
+    # A relation can be moved from the supports to the attacks in the same changeset
+    framework.apply_changes({'remove_supports': [('d', 'b')], 'add_attacks': [('d', 'b')]})
+    assert framework.attack_relations.contains('d', 'b') and len(framework.support_relations) == 0
+
+
+def test_apply_changes_is_atomic():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model', reject_cycles=True)
+    final_strengths = framework.final_strengths
+    with pytest.raises(ValueError):     # a -> d -> b -> a
+        framework.apply_changes({'add_arguments': {'e': 0.5}, 'add_attacks': [('e', 'a'), ('a', 'd')],
+                                 'remove_attacks': [('d', 'c')]})
+    with pytest.raises(ValueError):
+        framework.apply_changes({'add_arguments': {'e': 0.5}, 'add_attacks': [('e', 'a')], 'add_supports': [('e', 'a')]})
+    with pytest.raises(ValueError):
+        framework.apply_changes({'add_arguments': {'e': 0.5}, 'add_attacks': [('e', 'x')]})
+    with pytest.raises(ValueError):
+        framework.apply_changes({'add_arguments': {'e': 2.0}})
+    with pytest.raises(ValueError):
+        framework.apply_changes({'modify_initial_strengths': {'x': 0.5}})
+    with pytest.raises(ValueError):
+        framework.apply_changes({'add_relations': []})
+    with pytest.raises(TypeError):
+        framework.apply_changes({'add_attacks': [('a', 'b', 'c')]})
+    with pytest.raises(TypeError):
+        framework.apply_changes({'add_arguments': ['e']})
+    with pytest.raises(ValueError):
+        framework.modify_initial_strengths(['a'], [0.5, 0.5])
+    assert framework.arguments == {'a', 'b', 'c', 'd'}
+    assert framework.attack_relations == QBAFramework(args, strengths, att, supp).attack_relations
+    assert framework.support_relations == QBAFramework(args, strengths, att, supp).support_relations
+    assert framework.final_strengths == final_strengths
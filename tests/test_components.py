@@ -0,0 +1,105 @@
+import pytest
+from qbaf import QBAFramework
+
+
+# Three chains of four arguments that alternate attacks and supports
+args = [f'c{c}_{i}' for c in range(3) for i in range(4)]
+strengths = [((index * 7) % 10) / 10 for index in range(len(args))]
+att = [(f'c{c}_{i}', f'c{c}_{i+1}') for c in range(3) for i in range(0, 3, 2)]
+supp = [(f'c{c}_{i}', f'c{c}_{i+1}') for c in range(3) for i in range(1, 3, 2)]
+
+
+def test_connected_components():
+    framework = QBAFramework(args + ['alone'], strengths + [0.5], att, supp)
+    components = framework.connected_components()
+    assert components == [{f'c{c}_{i}' for i in range(4)} for c in range(3)] + [{'alone'}]
+
+    framework.add_support_relation('c0_3', 'c2_0')
+    assert len(framework.connected_components()) == 3
+    assert QBAFramework([], [], [], []).connected_components() == []
+
+
+def test_structural_modification_recalculates_its_component():
+    framework = QBAFramework(args, strengths, att, supp, semantics='QuadraticEnergy_model')
+    framework.final_strengths
+    assert framework.last_solve_info['recalculated_arguments'] == 12
+
+    framework.remove_attack_relation('c1_0', 'c1_1')
+    new_att = [relation for relation in att if relation != ('c1_0', 'c1_1')]
+    assert framework.final_strengths == QBAFramework(args, strengths, new_att, supp,
+                                                     semantics='QuadraticEnergy_model').final_strengths
+    assert framework.last_solve_info['recalculated_arguments'] == 3   # c1_1, c1_2 and c1_3
+
+    framework.add_argument('new', 0.3)
+    framework.add_attack_relation('new', 'c2_3')
+    assert framework.final_strengths == QBAFramework(args + ['new'], strengths + [0.3], new_att + [('new', 'c2_3')], supp,
+                                                     semantics='QuadraticEnergy_model').final_strengths
+    assert framework.last_solve_info['recalculated_arguments'] == 5
+
+
+def test_removed_argument_does_not_recalculate():
+    framework = QBAFramework(args + ['alone'], strengths + [0.5], att, supp)
+    framework.final_strengths
+    framework.remove_argument('alone')
+    assert framework.final_strengths == QBAFramework(args, strengths, att, supp).final_strengths
+    assert framework.last_solve_info['recalculated_arguments'] == 0
+
+
+def test_cyclic_components():
+    args = ['a', 'b', 'c', 'd']
+    att = [('a', 'b'), ('b', 'a'), ('c', 'd')]
+    supp = [('d', 'c')]
+    framework = QBAFramework(args, [1.0, 0.5, 0.2, 0.8], att, supp, semantics='DFQuAD_model', allow_cycles=True)
+    framework.final_strengths
+    assert framework.last_solve_info['recalculated_arguments'] == 4
+
+    framework.modify_initial_strength('c', 0.6)
+    final_strengths = framework.final_strengths
+    assert framework.last_solve_info['update_scheme'] == 'jacobi'
+    assert framework.last_solve_info['recalculated_arguments'] == 2
+    expected = QBAFramework(args, [1.0, 0.5, 0.6, 0.8], att, supp, semantics='DFQuAD_model',
+                            allow_cycles=True).final_strengths
+    assert final_strengths == pytest.approx(expected)
+
+
+def test_custom_functions_recalculate_modified_component():
+    calls = []
+
+    def aggregation(attackers, supporters):
+        calls.append(1)
+        return sum(supporters) - sum(attackers)
+
+    framework = QBAFramework(args, strengths, att, supp,
+                             aggregation_function=aggregation, influence_function=lambda w, s: w + s)
+    framework.final_strengths
+    calls.clear()
+    framework.modify_initial_strength('c2_0', 0.9)
+    framework.final_strengths
+    assert len(calls) == 4
+
+
+def test_copy_keeps_outdated_components():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    framework.final_strengths
+    framework.modify_initial_strength('c0_0', 0.9)
+    framework.remove_support_relation('c2_1', 'c2_2')
+    copy = framework.copy()
+    expected = QBAFramework(args, [0.9] + strengths[1:], att, [relation for relation in supp if relation != ('c2_1', 'c2_2')],
+                            semantics='DFQuAD_model').final_strengths
+    assert copy.final_strengths == expected
+    assert framework.final_strengths == expected
+
+
+def test_many_components():
+    # Enough arguments for the components to be evaluated by several threads
+    chains = 2 ** 14 + 1
+    chain_args = [f'c{c}_{i}' for c in range(chains) for i in range(4)]
+    chain_strengths = [((index * 7) % 10) / 10 for index in range(len(chain_args))]
+    chain_att = [(f'c{c}_{i}', f'c{c}_{i+1}') for c in range(chains) for i in range(0, 3, 2)]
+    chain_supp = [(f'c{c}_{i}', f'c{c}_{i+1}') for c in range(chains) for i in range(1, 3, 2)]
+    framework = QBAFramework(chain_args, chain_strengths, chain_att, chain_supp, semantics='EulerBased_model')
+    final_strengths = framework.final_strengths
+    assert len(framework.connected_components()) == 2 ** 14 + 1
+    plan = framework.compile(ordering='rcm')
+    evaluated = dict(zip(plan.arguments, plan.evaluate([framework.initial_strength(arg) for arg in plan.arguments])))
+    assert final_strengths == evaluated
@@ -0,0 +1,87 @@
+import random
+import pytest
+from qbaf import QBAFramework
+
+
+# Leaves with few distinct strengths, so many arguments of the next layers are equivalent
+rnd = random.Random(0)
+leaves = [f'l{i}' for i in range(60)]
+middle = [f'm{i}' for i in range(20)]
+tops = [f't{i}' for i in range(5)]
+layered_args = leaves + middle + tops
+layered_strengths = [rnd.choice([0.2, 0.5]) for _ in leaves] + [0.5] * len(middle) + [0.8] * len(tops)
+layered_att = ([(leaves[(3 * index + k) % 6], arg) for index, arg in enumerate(middle) for k in range(2)] +
+               [(middle[(index + k) % len(middle)], arg) for index, arg in enumerate(tops) for k in range(3)])
+layered_supp = [(leaves[6 + index % 3], arg) for index, arg in enumerate(middle)]
+
+
+@pytest.mark.parametrize('semantics', ['basic_model', 'DFQuAD_model', 'EulerBasedTop_model', 'QuadraticEnergy_model'])
+def test_compressed_final_strengths(semantics):
+    expected = QBAFramework(layered_args, layered_strengths, layered_att, layered_supp, semantics=semantics).final_strengths
+    framework = QBAFramework(layered_args, layered_strengths, layered_att, layered_supp, semantics=semantics, compress=True)
+    assert framework.final_strengths == pytest.approx(expected, abs=1e-12)
+    assert framework.last_solve_info['compression_ratio'] > 1
+    assert framework.last_solve_info['recalculated_arguments'] < len(layered_args)
+
+
+def test_compression_ratio():
+    args = ['a1', 'a2', 'a3', 'a4', 'b1', 'b2', 'c']
+    initial_strengths = [0.5, 0.5, 0.5, 0.5, 0.3, 0.3, 0.1]
+    att = [('a1', 'b1'), ('a2', 'b1'), ('a3', 'b2'), ('a4', 'b2'), ('b1', 'c')]
+    supp = [('b2', 'c')]
+    framework = QBAFramework(args, initial_strengths, att, supp, compress=True)
+    framework.final_strengths
+    assert framework.last_solve_info['recalculated_arguments'] == 3
+    assert framework.last_solve_info['compression_ratio'] == pytest.approx(7 / 3)
+
+    framework.modify_initial_strength('a4', 0.4)   # a4 and b2 are not equivalent to a1 and b1 anymore
+    framework.remove_attack_relation('b1', 'c')
+    assert framework.final_strengths == QBAFramework(args, [0.5, 0.5, 0.5, 0.4, 0.3, 0.3, 0.1],
+                                                     att[:-1], supp).final_strengths
+    assert framework.last_solve_info['recalculated_arguments'] == 5
+
+
+def test_compressed_cyclic_framework():
+    args = ['a', 'b', 'c', 'd', 'e']
+    att = [('a', 'b'), ('b', 'a'), ('c', 'd'), ('d', 'c')]
+    supp = [('e', 'a')]
+    initial_strengths = [0.5, 0.5, 0.5, 0.5, 0.5]
+    expected = QBAFramework(args, initial_strengths, att, supp, semantics='DFQuAD_model', allow_cycles=True)
+    framework = QBAFramework(args, initial_strengths, att, supp, semantics='DFQuAD_model', allow_cycles=True,
+                             compress=True)
+    assert framework.final_strengths == expected.final_strengths
+    assert framework.last_solve_info['update_scheme'] == 'jacobi'
+    assert framework.last_solve_info['iterations'] == expected.last_solve_info['iterations']
+    # Only c and d are equivalent: a is supported by e, and b is attacked by a
+    assert framework.last_solve_info['recalculated_arguments'] == 4
+
+    with pytest.raises(NotImplementedError):
+        QBAFramework(args, initial_strengths, att, supp, compress=True).final_strengths
+
+
+def test_compress_with_custom_functions():
+    calls = []
+
+    def aggregation(attackers, supporters):
+        calls.append(1)
+        return sum(supporters) - sum(attackers)
+
+    framework = QBAFramework(layered_args, layered_strengths, layered_att, layered_supp, compress=True,
+                             aggregation_function=aggregation, influence_function=lambda w, s: w + s)
+    expected = QBAFramework(layered_args, layered_strengths, layered_att, layered_supp).final_strengths
+    assert framework.final_strengths == pytest.approx(expected, abs=1e-12)
+    assert len(calls) == framework.last_solve_info['recalculated_arguments'] < len(layered_args)
+
+
+def test_compress_attribute():
+    framework = QBAFramework(['a', 'b'], [0.5, 0.5], [], [])
+    assert framework.compress is False
+    framework.final_strengths
+    assert 'compression_ratio' not in framework.last_solve_info
+    framework.compress = True
+    assert framework.copy().compress is True
+    with pytest.raises(TypeError):
+        framework.compress = 1
+    framework.add_argument('c', 0.5)
+    assert framework.final_strengths == {'a': 0.5, 'b': 0.5, 'c': 0.5}
+    assert framework.last_solve_info['compression_ratio'] == 3.0
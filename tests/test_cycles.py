@@ -165,3 +165,149 @@ def test_four_node_attack_cycle():
     assert values[0] == pytest.approx(values[1])
     assert values[1] == pytest.approx(values[2])
     assert values[2] == pytest.approx(values[3])
+
+
+def test_last_solve_info_for_cyclic_framework():
+    framework = QBAFramework(['a', 'b'], [1.0, 0.5], [('a', 'b'), ('b', 'a')], [],
+                             semantics="DFQuAD_model", allow_cycles=True)
+    assert framework.last_solve_info is None
+    _ = framework.final_strengths
+    info = framework.last_solve_info
+    assert info['update_scheme'] == 'jacobi'
+    assert info['converged'] is True
+    assert 0 < info['iterations'] <= framework.max_iterations
+    assert info['final_residual'] <= framework.convergence_threshold
+    assert len(info['residuals']) == info['iterations']
+    assert info['residual_stride'] == 1
+    assert info['residuals'][-1] == pytest.approx(info['final_residual'])
+    assert {argument for argument, _ in info['largest_residuals']} == {'a', 'b'}
+    assert info['wall_time'] >= 0.0
+
+
+def test_last_solve_info_for_non_converging_framework():
+    framework = QBAFramework(['a', 'b'], [1.0, 0.5], [('a', 'b'), ('b', 'a')], [],
+                             semantics="basic_model", allow_cycles=True, max_iterations=5000)
+    with pytest.raises(RuntimeError, match="did not converge"):
+        _ = framework.final_strengths
+    info = framework.last_solve_info
+    assert info['converged'] is False
+    assert info['iterations'] == 5000
+    assert info['final_residual'] > framework.convergence_threshold
+    assert len(info['residuals']) <= 1024
+    assert info['residual_stride'] > 1
+    residuals = [residual for _, residual in info['largest_residuals']]
+    assert residuals == sorted(residuals, reverse=True)
+
+
+def test_not_converged_message():
+    framework = QBAFramework(['a', 'b'], [1.0, 0.5], [('a', 'b'), ('b', 'a')], [], allow_cycles=True, max_iterations=3)
+    with pytest.raises(RuntimeError, match=r'final residual [0-9]'):
+        framework.final_strengths
+
+
+def test_diverging_framework_does_not_converge():
+    # The strengths grow to inf, and the residual inf - inf is nan
+    framework = QBAFramework(['a', 'b', 'c'], [1.0, 1.0, 1.0], [], [('a', 'b'), ('a', 'c'), ('b', 'a'), ('c', 'a')],
+                             semantics="basic_model", allow_cycles=True, max_iterations=3000)
+    with pytest.raises(RuntimeError, match='final residual nan'):
+        framework.final_strengths
+    assert framework.last_solve_info['converged'] is False
+
+
+def test_last_solve_info_for_acyclic_framework():
+    framework = QBAFramework(['a', 'b'], [1.0, 0.5], [('a', 'b')], [], semantics="DFQuAD_model")
+    _ = framework.final_strengths
+    info = framework.last_solve_info
+    assert info['update_scheme'] == 'topological'
+    assert info['converged'] is True
+    assert info['iterations'] == 1
+    assert info['largest_residuals'] == []
+
+
+def _fresh_isacyclic(framework):
+    return QBAFramework(list(framework.arguments), [framework.initial_strength(arg) for arg in framework.arguments],
+                        list(framework.attack_relations), list(framework.support_relations),
+                        allow_cycles=True).isacyclic()
+
+
+def test_isacyclic_is_maintained_on_modifications():
+    import random
+    rnd = random.Random(0)
+    args = [f'a{i}' for i in range(12)]
+    framework = QBAFramework(args, [0.5] * len(args), [], [], allow_cycles=True)
+    assert framework.isacyclic() is True
+    for step in range(400):
+        agent, patient = rnd.choice(args), rnd.choice(args)
+        action = rnd.random()
+        if action < 0.5:
+            if not framework.contains_support_relation(agent, patient):
+                framework.add_attack_relation(agent, patient)
+        elif action < 0.7:
+            if not framework.contains_attack_relation(agent, patient):
+                framework.add_support_relation(agent, patient)
+        elif action < 0.85:
+            framework.remove_attack_relation(agent, patient)
+        elif action < 0.95:
+            framework.remove_support_relation(agent, patient)
+        elif not any(agent in relation for relation in list(framework.attack_relations) + list(framework.support_relations)):
+            framework.remove_argument(agent)
+            framework.add_argument(agent, 0.5)
+        if step % 5 == 0:
+            assert framework.isacyclic() == _fresh_isacyclic(framework)
+
+
+def test_reject_cycles_on_insertion():
+    framework = QBAFramework(['a', 'b', 'c', 'd'], [0.5, 0.6, 0.7, 0.8], [('a', 'b')], [('b', 'c')],
+                             semantics='DFQuAD_model', reject_cycles=True)
+    assert framework.reject_cycles is True
+    framework.final_strengths
+    with pytest.raises(ValueError):
+        framework.add_attack_relation('c', 'a')
+    with pytest.raises(ValueError):
+        framework.add_support_relation('d', 'd')
+    assert not framework.contains_attack_relation('c', 'a')
+    framework.add_support_relation('d', 'a')
+    with pytest.raises(ValueError):
+        framework.add_attack_relation('c', 'd')
+    assert framework.isacyclic() is True
+    assert framework.final_strengths == QBAFramework(['a', 'b', 'c', 'd'], [0.5, 0.6, 0.7, 0.8], [('a', 'b')],
+                                                     [('b', 'c'), ('d', 'a')], semantics='DFQuAD_model').final_strengths
+    assert framework.copy().reject_cycles is True
+
+    framework.reject_cycles = False
+    framework.add_attack_relation('c', 'd')
+    assert framework.isacyclic() is False
+    with pytest.raises(ValueError):
+        framework.reject_cycles = True
+    framework.remove_attack_relation('c', 'd')
+    framework.reject_cycles = True
+    with pytest.raises(TypeError):
+        framework.reject_cycles = 1
+
+
+def test_reject_cycles_in_constructor():
+    with pytest.raises(ValueError):
+        QBAFramework(['a', 'b'], [0.5, 0.5], [('a', 'b'), ('b', 'a')], [], reject_cycles=True)
+    framework = QBAFramework(['a', 'b'], [0.5, 0.5], [('a', 'b')], [], reject_cycles=True, allow_cycles=True)
+    framework.add_attack_relation('b', 'a')     # Cycles are allowed, so nothing is rejected
+    assert framework.isacyclic() is False
+
+
+def test_reject_cycles_matches_full_check():
+    import random
+    rnd = random.Random(1)
+    args = [f'a{i}' for i in range(30)]
+    framework = QBAFramework(args, [0.5] * len(args), [], [], reject_cycles=True)
+    for _ in range(300):
+        agent, patient = rnd.choice(args), rnd.choice(args)
+        if framework.contains_attack_relation(agent, patient):
+            continue
+        candidate = QBAFramework(args, [0.5] * len(args), list(framework.attack_relations) + [(agent, patient)],
+                                 list(framework.support_relations), allow_cycles=True)
+        if candidate.isacyclic():
+            framework.add_attack_relation(agent, patient)
+        else:
+            with pytest.raises(ValueError):
+                framework.add_attack_relation(agent, patient)
+    assert len(framework.attack_relations) > 30
+    assert framework.final_strengths
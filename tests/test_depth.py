@@ -0,0 +1,141 @@
+import random
+import pytest
+from qbaf import QBAFramework
+
+
+# Every argument attacks or supports up to three earlier arguments
+rnd = random.Random(1)
+deep_args = [f'a{i}' for i in range(300)]
+deep_strengths = [rnd.random() for _ in deep_args]
+deep_att, deep_supp = set(), set()
+for i in range(1, len(deep_args)):
+    for _ in range(3):
+        relation = (deep_args[i], deep_args[rnd.randrange(i)])
+        if relation not in deep_att and relation not in deep_supp:
+            (deep_att if rnd.random() < 0.5 else deep_supp).add(relation)
+deep_att, deep_supp = sorted(deep_att), sorted(deep_supp)
+
+
+@pytest.mark.parametrize('semantics', ['DFQuAD_model', 'EulerBased_model', 'QuadraticEnergy_model',
+                                       'SquaredDFQuAD_model', 'EulerBasedTop_model'])
+def test_depth_bounds_contain_final_strength(semantics):
+    exact = QBAFramework(deep_args, deep_strengths, deep_att, deep_supp, semantics=semantics).final_strength('a0')
+    framework = QBAFramework(deep_args, deep_strengths, deep_att, deep_supp, semantics=semantics)
+    widths = []
+    for depth in range(12):
+        bounds = framework.final_strength('a0', max_depth=depth)
+        if isinstance(bounds, float):
+            assert bounds == pytest.approx(exact, abs=1e-12)
+            break
+        lower, upper = bounds
+        assert lower - 1e-12 <= exact <= upper + 1e-12
+        widths.append(upper - lower)
+    else:
+        pytest.fail('the whole cone should be evaluated within 12 relations')
+    assert widths[0] == 1.0
+    assert widths == sorted(widths, reverse=True)
+    assert framework.last_solve_info is None    # the final strengths have not been calculated
+
+
+def test_depth_bounds_of_chain():
+    args = ['a', 'b', 'c', 'd']
+    framework = QBAFramework(args, [0.5, 0.4, 0.8, 0.6], [('b', 'a'), ('d', 'c')], [('c', 'b')],
+                             semantics='DFQuAD_model')
+    assert framework.final_strength('a', max_depth=0) == (0.0, 1.0)
+    assert framework.final_strength('a', max_depth=1) == (0.0, 0.5)     # b is within [0, 1]
+    lower, upper = framework.final_strength('a', max_depth=2)           # c is within [0, 1]
+    assert (lower, upper) == pytest.approx((0.5 * (1 - 1.0), 0.5 * (1 - 0.4)))
+    assert framework.final_strength('a', max_depth=3) == framework.copy().final_strength('a')
+    assert framework.final_strength('d', max_depth=0) == 0.6            # d has no attackers nor supporters
+
+    # Once the final strengths are up to date they are returned
+    final_strength = framework.final_strength('a')
+    assert framework.final_strength('a', max_depth=0) == final_strength
+
+
+def test_depth_bounds_of_cyclic_framework():
+    args = ['a', 'b', 'c', 'd']
+    att, supp = [('b', 'a'), ('a', 'b'), ('d', 'c')], [('c', 'a')]
+    framework = QBAFramework(args, [0.5, 0.6, 0.3, 0.9], att, supp, semantics='DFQuAD_model', allow_cycles=True)
+    lower, upper = framework.final_strength('a', max_depth=2)
+    assert upper - lower < 1e-9
+    assert framework.copy().final_strength('a') == pytest.approx(lower, abs=1e-9)
+
+    with pytest.raises(NotImplementedError):
+        QBAFramework(args, [0.5, 0.6, 0.3, 0.9], att, supp, semantics='DFQuAD_model').final_strength('a', max_depth=2)
+
+
+def test_depth_bounds_errors():
+    framework = QBAFramework(['a', 'b', 'c'], [0.5, 0.5, 0.5], [('b', 'a'), ('c', 'b')], [], semantics='DFQuAD_model')
+    with pytest.raises(ValueError):
+        framework.final_strength('a', max_depth=-1)
+    with pytest.raises(TypeError):
+        framework.final_strength('a', max_depth=1.5)
+    with pytest.raises(ValueError):
+        framework.final_strength('z', max_depth=1)
+
+    framework.modify_initial_strength('c', -0.5)
+    with pytest.raises(ValueError):     # the final strength of c could be outside [0, 1]
+        framework.final_strength('a', max_depth=1)
+    assert framework.final_strength('a', max_depth=2) == framework.copy().final_strength('a')
+
+    # A cyclic cone without a cut is iterated from [0, 1] too
+    cyclic = QBAFramework(['a0', 'a1', 'a2', 'a3', 'a4'], [0.901, 0.189, 0.845, 0.092, -0.956], [('a1', 'a1'), ('a4', 'a2')],
+                          [('a0', 'a1'), ('a0', 'a4'), ('a1', 'a0'), ('a3', 'a3')],
+                          semantics='QuadraticEnergy_model', allow_cycles=True)
+    with pytest.raises(ValueError):
+        cyclic.final_strength('a4', max_depth=3)
+    assert cyclic.final_strength('a4') == pytest.approx(-0.0667, abs=1e-4)
+    assert cyclic.final_strength('a4', max_depth=3) == cyclic.final_strength('a4')
+
+    basic = QBAFramework(['a', 'b', 'c'], [0.5, 0.5, 3.0], [('b', 'a'), ('c', 'b')], [])
+    assert basic.final_strength('a', max_depth=1) == (float('-inf'), float('inf'))
+    assert basic.final_strength('a', max_depth=2) == 3.0
+
+    custom = QBAFramework(['a', 'b'], [0.5, 0.5], [('b', 'a')], [],
+                          aggregation_function=lambda att, supp: sum(supp) - sum(att),
+                          influence_function=lambda w, s: w + s)
+    with pytest.raises(NotImplementedError):
+        custom.final_strength('a', max_depth=1)
+
+
+def test_strength_consistency_decided_by_bounds():
+    args = ['a', 'b', 'c', 'd', 'e', 'f']
+    att = [('c', 'a'), ('d', 'c'), ('e', 'd'), ('f', 'e')]
+    supp = [('d', 'b')]
+    framework = QBAFramework(args, [0.9, 0.1, 0.2, 0.5, 0.5, 0.5], att, supp, semantics='DFQuAD_model')
+    other = QBAFramework(args, [0.1, 0.9, 0.2, 0.5, 0.5, 0.5], att, supp, semantics='DFQuAD_model')
+    # Within depth 3, a is within [0.72, 0.81] and b within [0.1, 0.55] in framework, the opposite in other
+    assert not framework.are_strength_consistent(other, 'a', 'b')
+    assert framework.last_solve_info is None and other.last_solve_info is None
+
+    # Now b is 0.75 and overlaps with the bounds of a in framework, so only its final strengths are calculated
+    framework.modify_initial_strength('b', 0.6)
+    assert not framework.are_strength_consistent(other, 'a', 'b')
+    assert framework.last_solve_info is not None and other.last_solve_info is None
+    assert framework.final_strength('a') > framework.final_strength('b')
+
+    # The bounds are only used if the framework is acyclic, the errors of a cyclic one are raised
+    cyclic = QBAFramework(['a', 'b', 'c'], [0.9, 0.3, 0.5], [], [('c', 'c')], semantics='DFQuAD_model')
+    with pytest.raises(NotImplementedError):
+        cyclic.are_strength_consistent(cyclic.copy(), 'a', 'b')
+    divergent = QBAFramework(['a', 'b', 'c'], [0.9, 0.3, 0.5], [], [('c', 'b'), ('b', 'c')], allow_cycles=True)
+    with pytest.raises(RuntimeError):
+        divergent.are_strength_consistent(divergent.copy(), 'a', 'b')
+
+
+@pytest.mark.parametrize('semantics', ['basic_model', 'DFQuAD_model', 'EulerBased_model', 'QuadraticEnergy_model'])
+def test_strength_consistency_with_bounds_agrees(semantics):
+    rnd = random.Random(2)
+    for _ in range(10):
+        other_strengths = [rnd.random() for _ in deep_args]
+        framework = QBAFramework(deep_args, deep_strengths, deep_att, deep_supp, semantics=semantics)
+        other = QBAFramework(deep_args, other_strengths, deep_att, deep_supp, semantics=semantics)
+        framework_strengths = framework.copy().final_strengths
+        other_final_strengths = other.copy().final_strengths
+        arg1, arg2 = rnd.sample(deep_args, 2)
+        expected = ((framework_strengths[arg1] > framework_strengths[arg2]) ==
+                    (other_final_strengths[arg1] > other_final_strengths[arg2]) and
+                    (framework_strengths[arg1] < framework_strengths[arg2]) ==
+                    (other_final_strengths[arg1] < other_final_strengths[arg2]))
+        assert framework.are_strength_consistent(other, arg1, arg2) == expected
@@ -0,0 +1,93 @@
+import random
+import pytest
+from qbaf import QBAFramework
+from qbaf_robustness.consistency_checks import is_expansion_robust_consistent
+from qbaf_robustness.inconsistency_checks import is_expansion_robust_inconsistent
+
+
+# Every argument is attacked or supported by up to two earlier arguments
+rnd = random.Random(0)
+args = [f'a{i}' for i in range(40)]
+strengths = [round(rnd.random(), 2) for _ in args]
+att, supp = [], []
+for i in range(1, len(args)):
+    for j in rnd.sample(range(i), min(i, 2)):
+        (att if rnd.random() < 0.5 else supp).append((args[j], args[i]))
+
+
+@pytest.mark.parametrize('semantics', ['basic_model', 'DFQuAD_model', 'EulerBased_model'])
+def test_evaluate_expansion(semantics):
+    base = QBAFramework(args, strengths, att, supp, semantics=semantics)
+    expansion = QBAFramework(args + ['x', 'y'], strengths + [0.3, 0.9], att + [('x', 'a35'), ('y', 'x')],
+                             supp + [('a2', 'a38')], semantics=semantics)
+    expected = expansion.copy().final_strengths
+    expansion.evaluate_expansion(base)
+    recalculated = expansion.last_solve_info['recalculated_arguments']
+    assert expansion.final_strengths == expected
+    assert 3 <= recalculated < len(expected) / 2
+    assert expansion.last_solve_info['update_scheme'] == 'topological'
+
+
+def test_evaluate_expansion_of_cyclic_framework():
+    base = QBAFramework(['a', 'b', 'c', 'd'], [1.0, 0.5, 0.4, 0.3], [('a', 'b'), ('b', 'a')], [('c', 'd')],
+                        semantics='DFQuAD_model', allow_cycles=True)
+    expansion = QBAFramework(['a', 'b', 'c', 'd', 'e'], [1.0, 0.5, 0.4, 0.3, 0.6], [('a', 'b'), ('b', 'a'), ('e', 'd')],
+                             [('c', 'd')], semantics='DFQuAD_model', allow_cycles=True)
+    expected = expansion.copy().final_strengths
+    expansion.evaluate_expansion(base)
+    assert expansion.last_solve_info['recalculated_arguments'] == 2    # e and d
+    assert expansion.final_strengths == pytest.approx(expected)
+
+    expansion = QBAFramework(['a', 'b', 'c', 'd'], [1.0, 0.5, 0.4, 0.3], [('a', 'b'), ('b', 'a')], [('c', 'd'), ('d', 'a')],
+                             semantics='DFQuAD_model', allow_cycles=True)
+    expected = expansion.copy().final_strengths
+    expansion.evaluate_expansion(base)
+    assert expansion.last_solve_info['update_scheme'] == 'jacobi'
+    assert expansion.final_strengths == pytest.approx(expected)
+
+
+def test_evaluate_expansion_errors():
+    base = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    with pytest.raises(TypeError):
+        base.evaluate_expansion(1)
+    changed = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    changed.modify_initial_strength('a0', 0.123)
+    with pytest.raises(ValueError):
+        changed.evaluate_expansion(base)
+    smaller = QBAFramework(args, strengths, att[1:], supp, semantics='DFQuAD_model')
+    with pytest.raises(ValueError):
+        smaller.evaluate_expansion(base)
+    other_semantics = QBAFramework(args, strengths, att, supp)
+    with pytest.raises(ValueError):
+        other_semantics.evaluate_expansion(base)
+    cyclic = QBAFramework(args, strengths, att + [('a39', 'a0')], supp + [('a0', 'a39')], semantics='DFQuAD_model')
+    with pytest.raises(NotImplementedError):
+        cyclic.evaluate_expansion(base)
+    # The final strengths are calculated from scratch after an error
+    assert changed.final_strengths['a0'] == pytest.approx(changed.copy().final_strengths['a0'])
+
+
+def test_expansion_robust_consistency_reuses_base():
+    base = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    expansions = [QBAFramework(args + [f'n{k}'], strengths + [0.5], att + [(f'n{k}', f'a{30 + k}')], supp,
+                               semantics='DFQuAD_model') for k in range(5)]
+    expected = [expansion.copy().are_strength_consistent(base, 'a38', 'a39') for expansion in expansions]
+    assert is_expansion_robust_consistent(base, expansions, 'a38', 'a39') == all(expected)
+    assert all(expansion.last_solve_info['recalculated_arguments'] < len(args) / 2 for expansion in expansions)
+
+
+def test_expansion_robust_consistency_of_frozen_frameworks():
+    base = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model').freeze()
+    expansions = [QBAFramework(args + [f'n{k}'], strengths + [0.5], att + [(f'n{k}', f'a{30 + k}')], supp,
+                               semantics='DFQuAD_model').freeze() for k in range(5)]
+    expected = [expansion.copy().are_strength_consistent(base, 'a38', 'a39') for expansion in expansions]
+    assert is_expansion_robust_consistent(base, expansions, 'a38', 'a39') == all(expected)
+    assert is_expansion_robust_inconsistent(base, expansions, 'a38', 'a39') == all(expected)
+    assert all(expansion.last_solve_info['recalculated_arguments'] < len(args) / 2 for expansion in expansions)
+
+    # The final strengths of a frozen framework are only calculated once
+    last_solve_info = expansions[0].last_solve_info
+    expansions[0].evaluate_expansion(base)
+    assert expansions[0].last_solve_info == last_solve_info
+    with pytest.raises(ValueError):
+        base.evaluate_expansion(expansions[0])
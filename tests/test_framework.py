@@ -250,6 +250,19 @@ def test_modify_initial_strength():
     qbf.add_argument('a', 0.0)
     assert qbf.initial_strength('a') == 1.0
 
+    with pytest.raises(ValueError):
+        qbf.modify_initial_strength('d', 1.0)
+    assert not qbf.contains_argument('d')
+
+def test_initial_strengths_after_removing_arguments():
+    qbf = QBAFramework(['a', 'b', 'c', 'd'], [1, 2, 3, 4], [('c', 'd')], [])
+    qbf.remove_argument('a')
+    assert qbf.initial_strengths == {'b': 2.0, 'c': 3.0, 'd': 4.0}
+    qbf.add_argument('e', 5)
+    qbf.remove_argument('b')
+    assert qbf.initial_strengths == {'c': 3.0, 'd': 4.0, 'e': 5.0}
+    assert qbf.final_strengths == {'c': 3.0, 'd': 1.0, 'e': 5.0}
+
 # TEST ATTACK RELATIONS
 
 def test_access_attack_relations():
@@ -415,6 +428,34 @@ def test_supportersOf():
     for arg in ['a', 'b', 'c', 'e']:
         assert set(framework.support_relations.agents(arg)) == set(framework.supportersOf(arg))
 
+def test_views_and_degrees():
+    framework = QBAFramework(['a', 'b', 'c', 'e'], [1, 1, 5, 3],
+                            [('a', 'c'), ('e', 'c')],
+                            [('a', 'b'), ('e', 'a')])
+    for arg in ['a', 'b', 'c', 'e']:
+        assert list(framework.attacked_view(arg)) == framework.attackedBy(arg)
+        assert list(framework.attackers_view(arg)) == framework.attackersOf(arg)
+        assert list(framework.supported_view(arg)) == framework.supportedBy(arg)
+        assert list(framework.supporters_view(arg)) == framework.supportersOf(arg)
+        assert framework.in_degree(arg, 'attack') == len(framework.attackersOf(arg))
+        assert framework.in_degree(arg, 'support') == len(framework.supportersOf(arg))
+        assert framework.out_degree(arg) == len(framework.attackedBy(arg)) + len(framework.supportedBy(arg))
+    assert framework.in_degree('c') == 2 and framework.out_degree('e', relation='support') == 1
+    assert 'e' in framework.attackers_view('c') and 'b' not in framework.attackers_view('c')
+
+    view = framework.attackers_view('c')
+    framework.remove_attack_relation('a', 'c')
+    with pytest.raises(RuntimeError):
+        len(view)
+    assert list(framework.attackers_view('c')) == ['e']
+
+    with pytest.raises(ValueError):
+        framework.attackers_view('f')
+    with pytest.raises(ValueError):
+        framework.in_degree('f')
+    with pytest.raises(ValueError):
+        framework.out_degree('a', 'attacks')
+
 # TEST COPY
 
 def test_copy():
@@ -444,6 +485,27 @@ def test_copy_semantics():
     assert qbf.min_strength == copy.min_strength
     assert qbf.max_strength == copy.max_strength
 
+def test_copy_on_write():
+    qbf = QBAFramework(['a', 'b', 'c'], [1, 1, 5], [('a', 'c')], [('a', 'b')])
+    copy = qbf.copy()
+    copy_of_copy = copy.copy()
+    attacked = copy.attacked_view('a')
+    qbf.add_argument('d', 3)
+    qbf.add_attack_relation('d', 'c')
+    qbf.remove_support_relation('a', 'b')
+    assert copy.arguments == copy_of_copy.arguments == {'a', 'b', 'c'}
+    assert copy.attack_relations.relations == {('a', 'c')}
+    assert copy.support_relations.relations == {('a', 'b')}
+    assert list(attacked) == ['c']
+
+    copy.remove_attack_relation('a', 'c')
+    copy.remove_argument('c')
+    assert copy_of_copy.attack_relations.relations == {('a', 'c')}
+    assert copy_of_copy.final_strengths == QBAFramework(['a', 'b', 'c'], [1, 1, 5], [('a', 'c')], [('a', 'b')]).final_strengths
+    assert copy.final_strengths == QBAFramework(['a', 'b'], [1, 1], [], [('a', 'b')]).final_strengths
+    assert list(qbf.attackers_view('c')) == ['a', 'd']
+    assert qbf.final_strengths == QBAFramework(['a', 'b', 'c', 'd'], [1, 1, 5, 3], [('a', 'c'), ('d', 'c')], []).final_strengths
+
 # TEST ACYCLIC
 
 def test_isacyclic():
@@ -574,6 +636,22 @@ def test_reversal_output():
     assert qbfa == qbfe.reversal(qbfa, ['a', 'e'])
     assert qbfe == qbfa.reversal(qbfe, ['a', 'e'])
 
+def test_reversal_does_not_modify_the_frameworks():
+    qbfa = QBAFramework(['a', 'b', 'c'], [2, 1, 5], [('a', 'c')], [('a', 'b')])
+    qbfe = QBAFramework(['a', 'b', 'c', 'e'], [1, 1, 5, 3], [('a', 'c'), ('e', 'c')], [('a', 'b')])
+    qbfa.final_strengths
+    qbfe.final_strengths
+    reversal = qbfe.reversal(qbfa, ['a', 'e'])
+    reversal.add_argument('f', 0.5)
+    reversal.add_support_relation('f', 'c')
+    assert qbfa.arguments == {'a', 'b', 'c'}
+    assert qbfe.arguments == {'a', 'b', 'c', 'e'}
+    assert qbfe.attack_relations.relations == {('a', 'c'), ('e', 'c')}
+    assert qbfe.initial_strengths == {'a': 1, 'b': 1, 'c': 5, 'e': 3}
+    expected = QBAFramework(['a', 'b', 'c', 'f'], [2, 1, 5, 0.5], [('a', 'c')], [('a', 'b'), ('f', 'c')])
+    assert reversal == expected
+    assert reversal.final_strengths == expected.final_strengths
+
 # TEST IS SSI EXPLANATION
 
 def test_isSSIExplanation_input():
@@ -734,6 +812,13 @@ def test_minimalSSIExplanations_output():
     assert qbfe.minimalSSIExplanations(qbfa, 'b', 'c') in ([{'e'}, {'a'}], [{'a'}, {'e'}])
     assert qbfa.minimalSSIExplanations(qbfe, 'b', 'c') == [{'e'}]
 
+def test_minimalSSIExplanations_same_number_of_patients():
+    # a attacks a different argument with the same number of attacks
+    qbfa = QBAFramework(['a', 'b', 'c'], [2, 1, 2], [('a', 'b')], [])
+    qbfe = QBAFramework(['a', 'b', 'c'], [2, 1, 2], [('a', 'c')], [])
+    assert qbfe.minimalSSIExplanations(qbfa, 'b', 'c') == [{'a'}]
+    assert qbfa.minimalSSIExplanations(qbfe, 'b', 'c') == [{'a'}]
+
 # TEST MINIMAL CSI EXPLANATIONS
 
 def test_minimalCSIExplanations_input():
@@ -808,4 +893,24 @@ def test_change_info():
     assert removed_attack_relations == [('a', 'b')]
     assert added_attack_relations == [('a', 'd')]
     assert removed_support_relations == [('a', 'c')]
-    assert added_support_relations == [('a', 'b')]
\ No newline at end of file
+    assert added_support_relations == [('a', 'b')]
+
+# Test relations with the ids of the framework
+
+def test_relations_after_removing_arguments():
+    qbf = QBAFramework(['a', 'b', 'c', 'd', 'e'], [0.5, 0.5, 0.5, 0.5, 0.5],
+                       [('e', 'c'), ('e', 'e')], [('d', 'e'), ('c', 'd')], semantics='DFQuAD_model', allow_cycles=True)
+    qbf.remove_argument('a')    # e takes the id of a
+    qbf.remove_argument('b')    # d takes the id of b
+    assert set(qbf.attack_relations.patients('e')) == {'c', 'e'}
+    assert qbf.attack_relations.agents('e') == ['e']
+    assert qbf.support_relations.agents('e') == ['d']
+    assert qbf.support_relations.patients('c') == ['d']
+    expected = QBAFramework(['c', 'd', 'e'], [0.5, 0.5, 0.5], [('e', 'c'), ('e', 'e')], [('d', 'e'), ('c', 'd')],
+                            semantics='DFQuAD_model', allow_cycles=True)
+    assert qbf.final_strengths == pytest.approx(expected.final_strengths)
+    with pytest.raises(PermissionError):
+        qbf.copy().attack_relations.add('c', 'd')
+    qbf.remove_attack_relation('e', 'e')
+    assert qbf.attack_relations.agents('e') == []
+    assert qbf.attack_relations.patients('e') == ['c']
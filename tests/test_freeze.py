@@ -0,0 +1,100 @@
+import threading
+import pytest
+from qbaf import QBAFramework
+
+
+args = ['a', 'b', 'c', 'd']
+strengths = [0.5, 0.6, 0.7, 0.8]
+att = [('b', 'a'), ('d', 'c')]
+supp = [('c', 'a'), ('d', 'b')]
+
+
+def test_freeze():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    frozen = framework.freeze()
+    assert frozen.frozen is True and framework.frozen is False
+    assert frozen == framework
+    assert frozen.freeze() is frozen
+    assert frozen.final_strengths == framework.final_strengths
+
+    copy = frozen.copy()
+    assert copy.frozen is False
+    copy.add_argument('e', 0.1)
+    assert 'e' not in frozen.arguments
+
+    framework.add_argument('e', 0.1)
+    assert 'e' not in frozen.arguments
+
+
+def test_frozen_framework_cannot_be_modified():
+    frozen = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model').freeze()
+    modifications = [
+        lambda: frozen.add_argument('e', 0.1),
+        lambda: frozen.remove_argument('a'),
+        lambda: frozen.modify_initial_strength('a', 0.1),
+        lambda: frozen.add_attack_relation('a', 'b'),
+        lambda: frozen.remove_attack_relation('b', 'a'),
+        lambda: frozen.add_support_relation('a', 'b'),
+        lambda: frozen.remove_support_relation('c', 'a'),
+        lambda: frozen.add_arguments(['e'], [0.1]),
+        lambda: frozen.modify_initial_strengths(['a'], [0.1]),
+        lambda: frozen.add_relations([('a', 'b')], []),
+        lambda: frozen.remove_relations([('b', 'a')], []),
+        lambda: frozen.__init__(['a'], [0.5], [], []),
+        lambda: setattr(frozen, 'compress', True),
+        lambda: setattr(frozen, 'reject_cycles', True),
+    ]
+    for modification in modifications:
+        with pytest.raises(TypeError):
+            modification()
+    assert frozen == QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+
+
+def test_frozen_framework_hash():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    with pytest.raises(TypeError):
+        hash(framework)
+
+    # The same framework built in a different order
+    other = QBAFramework(['d', 'c', 'b', 'a'], [0.8, 0.7, 0.6, 0.5], [('d', 'c'), ('b', 'a')],
+                         [('d', 'b'), ('c', 'a')], semantics='DFQuAD_model')
+    assert hash(framework.freeze()) == hash(other.freeze())
+    assert len({framework.freeze(), other.freeze()}) == 1
+    cache = {framework.freeze(): 'value'}
+    assert cache[other.freeze()] == 'value'
+
+    other.modify_initial_strength('a', 0.4)
+    assert hash(other.freeze()) != hash(framework.freeze())
+    other.modify_initial_strength('a', 0.5)
+    other.remove_support_relation('c', 'a')
+    other.add_attack_relation('c', 'a')
+    assert hash(other.freeze()) != hash(framework.freeze())
+    assert other.freeze() != framework.freeze()
+
+
+def test_frozen_final_strengths_are_calculated_once():
+    calls = []
+
+    def aggregation(attackers, supporters):
+        calls.append(1)
+        return sum(supporters) - sum(attackers)
+
+    args = [f'a{i}' for i in range(200)]
+    att = [(args[i], args[i+1]) for i in range(0, len(args) - 1, 2)]
+    supp = [(args[i], args[i+1]) for i in range(1, len(args) - 1, 2)]
+    frozen = QBAFramework(args, [0.5] * len(args), att, supp, aggregation_function=aggregation,
+                          influence_function=lambda w, s: max(0.0, min(1.0, w + s)),
+                          min_strength=0, max_strength=1).freeze()
+    results = []
+
+    def read():
+        for _ in range(20):
+            results.append(frozen.final_strengths)
+
+    threads = [threading.Thread(target=read) for _ in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert len(calls) == len(args)
+    assert len(results) == 80 and all(result == results[0] for result in results)
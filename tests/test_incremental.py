@@ -0,0 +1,138 @@
+import math
+import random
+import pytest
+from qbaf import QBAFramework
+
+
+# A hub with 100 attackers and supporters, and an argument attacked by it
+rnd = random.Random(0)
+args = [f'a{i}' for i in range(100)] + ['hub', 'down']
+hub_strengths = [rnd.random() for _ in range(100)] + [0.5, 0.5]
+att = [(f'a{i}', 'hub') for i in range(0, 100, 2)] + [('hub', 'down')]
+supp = [(f'a{i}', 'hub') for i in range(1, 100, 2)] + [('a0', 'a1'), ('a2', 'down')]
+
+
+@pytest.mark.parametrize('semantics', ['basic_model', 'QuadraticEnergy_model', 'SquaredDFQuAD_model',
+                                       'EulerBasedTop_model', 'EulerBased_model', 'DFQuAD_model'])
+def test_incremental_update_matches_full_evaluation(semantics):
+    initial_strengths = list(hub_strengths)
+    framework = QBAFramework(args, initial_strengths, att, supp, semantics=semantics)
+    framework.final_strengths
+    rnd = random.Random(1)
+    for _ in range(50):
+        index = rnd.randrange(len(args))
+        strength = rnd.choice([rnd.random(), 0.0, 1.0])
+        initial_strengths[index] = strength
+        framework.modify_initial_strength(args[index], strength)
+        final_strengths = framework.final_strengths
+        assert framework.last_solve_info['update_scheme'] == 'incremental'
+        expected = QBAFramework(args, initial_strengths, att, supp, semantics=semantics).final_strengths
+        for arg in args:
+            assert final_strengths[arg] == pytest.approx(expected[arg], abs=1e-12)
+
+
+def test_incremental_update_only_recalculates_affected_arguments():
+    initial_strengths = list(hub_strengths)
+    framework = QBAFramework(args, initial_strengths, att, supp, semantics='basic_model')
+    framework.final_strengths
+    framework.modify_initial_strength('a10', 0.25)
+    assert framework.final_strength('down') == pytest.approx(
+        QBAFramework(args, [0.25 if arg == 'a10' else s for arg, s in zip(args, initial_strengths)],
+                     att, supp, semantics='basic_model').final_strength('down'))
+    assert framework.last_solve_info['recalculated_arguments'] == 3   # a10, hub and down
+
+
+def test_incremental_update_with_top_out_of_range():
+    initial_strengths = list(hub_strengths)
+    framework = QBAFramework(args, initial_strengths, att, supp, semantics='EulerBasedTop_model')
+    framework.final_strengths
+    for strength in [2.0, 0.3, 0.9]:
+        framework.modify_initial_strength('a0', strength)
+        initial_strengths[0] = strength
+        expected = QBAFramework(args, initial_strengths, att, supp, semantics='EulerBasedTop_model').final_strengths
+        for arg, value in framework.final_strengths.items():
+            assert math.isclose(value, expected[arg], abs_tol=1e-12)
+
+
+def test_structural_modification_after_incremental_update():
+    initial_strengths = list(hub_strengths)
+    framework = QBAFramework(args, initial_strengths, att, supp, semantics='EulerBased_model')
+    framework.final_strengths
+    framework.modify_initial_strength('a3', 0.1)
+    framework.final_strengths
+    framework.remove_attack_relation('a4', 'hub')
+    framework.modify_initial_strength('a5', 0.2)
+    assert framework.final_strengths
+    assert framework.last_solve_info['update_scheme'] == 'topological'
+    initial_strengths[3], initial_strengths[5] = 0.1, 0.2
+    expected = QBAFramework(args, initial_strengths, [relation for relation in att if relation != ('a4', 'hub')], supp,
+                            semantics='EulerBased_model').final_strengths
+    assert framework.final_strengths == pytest.approx(expected)
+
+
+@pytest.mark.parametrize('semantics', ['basic_model', 'DFQuAD_model', 'EulerBasedTop_model', 'QuadraticEnergy_model'])
+def test_approximate_update_within_staleness_bound(semantics):
+    initial_strengths = list(hub_strengths)
+    framework = QBAFramework(args, initial_strengths, att, supp, semantics=semantics, incremental_tolerance=1e-2)
+    exact = QBAFramework(args, initial_strengths, att, supp, semantics=semantics)
+    framework.final_strengths
+    rnd = random.Random(2)
+    recalculated = 0
+    for _ in range(30):
+        index = rnd.randrange(len(args))
+        strength = min(1.0, max(0.0, initial_strengths[index] + rnd.uniform(-0.01, 0.01)))
+        initial_strengths[index] = strength
+        framework.modify_initial_strength(args[index], strength)
+        exact.modify_initial_strength(args[index], strength)
+        final_strengths = framework.final_strengths
+        recalculated += framework.last_solve_info['recalculated_arguments']
+        expected = exact.final_strengths
+        for arg in args:
+            assert abs(final_strengths[arg] - expected[arg]) <= framework.staleness_bound + 1e-12
+    assert 0 < framework.staleness_bound < math.inf
+    assert recalculated < 30 * 3
+
+    framework.refresh()
+    assert framework.staleness_bound == 0.0
+    assert framework.final_strengths == QBAFramework(args, initial_strengths, att, supp,
+                                                     semantics=semantics).final_strengths
+
+
+def test_staleness_bound_without_contraction():
+    framework = QBAFramework(['a', 'b', 'c'], [0.5, 0.5, 0.5], [('a', 'b')], [('b', 'c')],
+                             semantics='EulerBased_model', incremental_tolerance=0.5)
+    framework.final_strengths
+    framework.modify_initial_strength('a', 0.6)
+    framework.final_strengths
+    assert framework.last_solve_info['recalculated_arguments'] == 1
+    assert framework.staleness_bound == pytest.approx(0.1)    # a single path reaches b and c
+    copy = framework.copy()
+    assert copy.staleness_bound == framework.staleness_bound
+
+    framework.modify_initial_strength('c', 2.0)    # The Euler-based influence may amplify changes out of [0, 1]
+    framework.modify_initial_strength('a', 0.7)
+    framework.final_strengths
+    assert framework.staleness_bound == math.inf
+    framework.remove_support_relation('b', 'c')
+    framework.final_strengths
+    assert framework.staleness_bound == math.inf   # Only the component of c was calculated again
+    framework.refresh()
+    assert framework.staleness_bound == 0.0
+    assert framework.final_strength('b') == QBAFramework(['a', 'b'], [0.7, 0.5], [('a', 'b')], [],
+                                                         semantics='EulerBased_model').final_strength('b')
+
+
+def test_incremental_tolerance_attribute():
+    framework = QBAFramework(['a', 'b'], [0.5, 0.5], [('a', 'b')], [])
+    assert framework.incremental_tolerance == 0.0
+    assert framework.staleness_bound == 0.0
+    framework.incremental_tolerance = 1
+    assert framework.copy().incremental_tolerance == 1.0
+    with pytest.raises(ValueError):
+        framework.incremental_tolerance = -0.1
+    with pytest.raises(TypeError):
+        framework.incremental_tolerance = '0.1'
+    with pytest.raises(ValueError):
+        QBAFramework(['a'], [0.5], [], [], incremental_tolerance=float('nan'))
+    with pytest.raises(AttributeError):
+        framework.staleness_bound = 0.0
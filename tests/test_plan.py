@@ -0,0 +1,216 @@
+import array
+import math
+import threading
+import pytest
+from qbaf import QBAFramework, QBAFPlan
+
+
+args = ['a', 'b', 'c', 'd']
+strengths = [0.5, 0.6, 0.7, 0.8]
+att = [('b', 'a'), ('d', 'c')]
+supp = [('c', 'a'), ('d', 'b')]
+
+
+def test_compile_acyclic_framework():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    plan = framework.compile()
+    assert isinstance(plan, QBAFPlan)
+    assert len(plan) == 4
+    assert set(plan.arguments) == {'a', 'b', 'c', 'd'}
+    assert plan.kernel == 'topological'
+    assert plan.semantics == 'DFQuAD_model'
+
+    initial_strengths = [framework.initial_strength(arg) for arg in plan.arguments]
+    final_strengths = plan.evaluate(array.array('d', initial_strengths))
+    for arg, strength in zip(plan.arguments, final_strengths):
+        assert strength == framework.final_strength(arg)
+    assert list(plan.evaluate(initial_strengths)) == list(final_strengths)
+
+
+def test_compile_cyclic_framework():
+    framework = QBAFramework(['a', 'b'], [1.0, 0.5], [('a', 'b'), ('b', 'a')], [],
+                             semantics='DFQuAD_model', allow_cycles=True)
+    plan = framework.compile()
+    assert plan.kernel == 'jacobi'
+    final_strengths = plan.evaluate([framework.initial_strength(arg) for arg in plan.arguments])
+    for arg, strength in zip(plan.arguments, final_strengths):
+        assert strength == pytest.approx(framework.final_strength(arg))
+
+    framework = QBAFramework(['a', 'b'], [1.0, 0.5], [('a', 'b'), ('b', 'a')], [], semantics='DFQuAD_model')
+    plan = framework.compile()
+    with pytest.raises(NotImplementedError):
+        plan.evaluate([1.0, 0.5])
+
+
+def test_plan_evaluate_with_out():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    plan = framework.compile()
+    out = array.array('d', [0.0] * len(plan))
+    result = plan.evaluate([0.1, 0.2, 0.3, 0.4], out=out)
+    assert result is out
+    framework_copy = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    for arg, strength in zip(plan.arguments, [0.1, 0.2, 0.3, 0.4]):
+        framework_copy.modify_initial_strength(arg, strength)
+    for arg, strength in zip(plan.arguments, out):
+        assert strength == framework_copy.final_strength(arg)
+
+
+def test_plan_evaluate_errors():
+    plan = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model').compile()
+    with pytest.raises(ValueError):
+        plan.evaluate([0.5, 0.5, 0.5])
+    with pytest.raises(ValueError):
+        plan.evaluate([0.5, 0.5, 0.5, 1.5])
+    with pytest.raises(TypeError):
+        plan.evaluate([0.5, 0.5, 0.5, 'a'])
+    with pytest.raises(ValueError):
+        plan.evaluate([0.5] * 4, out=array.array('d', [0.0]))
+    with pytest.raises(TypeError):
+        QBAFPlan()
+
+
+def test_plan_is_not_affected_by_modifications():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    plan = framework.compile()
+    initial_strengths = [framework.initial_strength(arg) for arg in plan.arguments]
+    before = list(plan.evaluate(initial_strengths))
+    framework.remove_attack_relation('b', 'a')
+    framework.add_argument('e', 0.9)
+    framework.add_support_relation('e', 'd')
+    assert list(plan.evaluate(initial_strengths)) == before
+    assert len(framework.compile()) == 5
+    assert framework.compile() is framework.compile()
+
+
+def test_plan_with_custom_functions():
+    framework = QBAFramework(['a', 'b'], [0.5, 0.5], [('b', 'a')], [],
+                             aggregation_function=lambda att, supp: sum(supp) - sum(att),
+                             influence_function=lambda w, s: max(0.0, min(1.0, w + s)),
+                             min_strength=0, max_strength=1)
+    plan = framework.compile()
+    assert plan.semantics is None
+    final_strengths = plan.evaluate([0.5, 0.5])
+    for arg, strength in zip(plan.arguments, final_strengths):
+        assert strength == framework.final_strength(arg)
+
+
+def test_plan_evaluate_from_threads():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    plan = framework.compile()
+    initial_strengths = [framework.initial_strength(arg) for arg in plan.arguments]
+    expected = list(plan.evaluate(initial_strengths))
+    results = []
+
+    def evaluate():
+        for _ in range(100):
+            results.append(list(plan.evaluate(initial_strengths)) == expected)
+
+    threads = [threading.Thread(target=evaluate) for _ in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert all(results) and len(results) == 400
+
+
+def test_final_strengths_by_semantics():
+    semantics = ['DFQuAD_model', 'EulerBased_model', 'QuadraticEnergy_model', 'SquaredDFQuAD_model', 'EulerBasedTop_model']
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    strengths_by_semantics = framework.final_strengths_by_semantics(semantics)
+    assert list(strengths_by_semantics) == semantics
+    for name in semantics:
+        other = QBAFramework(args, strengths, att, supp, semantics=name)
+        assert strengths_by_semantics[name] == other.final_strengths
+    assert framework.final_strengths_by_semantics([]) == {}
+
+
+def test_final_strengths_by_semantics_cyclic():
+    args = ['a', 'b', 'c']
+    att, supp = [('a', 'b'), ('b', 'a')], [('c', 'a'), ('a', 'c')]
+    semantics = ['DFQuAD_model', 'QuadraticEnergy_model', 'SquaredDFQuAD_model']
+    framework = QBAFramework(args, [1.0, 0.5, 0.2], att, supp, allow_cycles=True)
+    strengths_by_semantics = framework.final_strengths_by_semantics(semantics)
+    for name in semantics:
+        other = QBAFramework(args, [1.0, 0.5, 0.2], att, supp, semantics=name, allow_cycles=True)
+        assert strengths_by_semantics[name] == other.final_strengths
+
+    with pytest.raises(NotImplementedError):
+        QBAFramework(args, [1.0, 0.5, 0.2], att, supp).final_strengths_by_semantics(semantics)
+
+
+def test_final_strengths_by_semantics_errors():
+    framework = QBAFramework(['a', 'b'], [2.0, 0.5], [('b', 'a')], [])
+    with pytest.raises(ValueError):
+        framework.final_strengths_by_semantics(['unknown_model'])
+    with pytest.raises(TypeError):
+        framework.final_strengths_by_semantics([1])
+    with pytest.raises(TypeError):
+        framework.final_strengths_by_semantics(1)
+    with pytest.raises(ValueError):
+        framework.final_strengths_by_semantics(['DFQuAD_model'])
+
+
+@pytest.mark.parametrize('semantics', ['basic_model', 'DFQuAD_model', 'EulerBasedTop_model'])
+def test_hub_with_many_dependencies(semantics):
+    # Enough attackers and supporters for the aggregation of the hub to be split across threads
+    size = 2 ** 18 + 2
+    args = [f'a{i}' for i in range(size)] + ['hub']
+    initial_strengths = [(i % 1000) / 1000 for i in range(size)] + [0.5]
+    att = [(f'a{i}', 'hub') for i in range(0, size, 2)]
+    supp = [(f'a{i}', 'hub') for i in range(1, size, 2)]
+    framework = QBAFramework(args, initial_strengths, att, supp, semantics=semantics)
+
+    attacker_strengths = initial_strengths[0:size:2]
+    supporter_strengths = initial_strengths[1:size:2]
+    if semantics == 'basic_model':
+        expected = 0.5 + math.fsum(supporter_strengths) - math.fsum(attacker_strengths)
+    elif semantics == 'DFQuAD_model':
+        expected = 0.5     # both products underflow to 0
+    else:
+        aggregation = max(supporter_strengths) - max(attacker_strengths)
+        expected = 1 - (1 - 0.5 ** 2) / (1 + 0.5 * math.exp(aggregation))
+    assert framework.final_strength('hub') == pytest.approx(expected, rel=1e-9)
+
+
+@pytest.mark.parametrize('ordering', ['rcm', 'topological'])
+def test_compile_with_ordering(ordering):
+    size = 200
+    chain = [f'a{i}' for i in range(size)]
+    att = [(chain[i], chain[i+1]) for i in range(0, size - 1, 2)]
+    supp = [(chain[i], chain[i+1]) for i in range(1, size - 1, 2)]
+    args = chain[0::2] + chain[1::2]    # Neighbours in the chain are far from each other
+    initial_strengths = [(i % 10) / 10 for i in range(size)]
+    framework = QBAFramework(args, initial_strengths, att, supp, semantics='DFQuAD_model')
+
+    natural = framework.compile()
+    plan = framework.compile(ordering=ordering)
+    assert natural.ordering == 'natural'
+    assert plan.ordering == ordering
+    assert set(plan.arguments) == set(args)
+    assert plan.bandwidth < natural.bandwidth
+    assert plan.mean_dependency_distance < natural.mean_dependency_distance
+
+    final_strengths = plan.evaluate([framework.initial_strength(arg) for arg in plan.arguments])
+    assert dict(zip(plan.arguments, final_strengths)) == framework.final_strengths
+
+
+def test_compile_with_ordering_errors():
+    framework = QBAFramework(['a', 'b'], [1.0, 0.5], [('a', 'b'), ('b', 'a')], [], allow_cycles=True)
+    assert framework.compile(ordering='rcm').kernel == 'jacobi'
+    with pytest.raises(ValueError):
+        framework.compile(ordering='topological')
+    with pytest.raises(ValueError):
+        framework.compile(ordering='unknown')
+
+
+def test_compile_after_modifying_relations():
+    framework = QBAFramework(args, strengths, att, supp, semantics='DFQuAD_model')
+    framework.compile()
+    framework.add_argument('e', 0.9)
+    framework.add_attack_relation('e', 'a')
+    framework.remove_support_relation('d', 'b')
+    plan = framework.compile()
+    expected = QBAFramework(['a', 'b', 'c', 'd', 'e'], [0.5, 0.6, 0.7, 0.8, 0.9], [('b', 'a'), ('d', 'c'), ('e', 'a')],
+                            [('c', 'a')], semantics='DFQuAD_model').final_strengths
+    final_strengths = plan.evaluate([framework.initial_strength(arg) for arg in plan.arguments])
+    assert dict(zip(plan.arguments, final_strengths)) == pytest.approx(expected)
@@ -0,0 +1,65 @@
+import pytest
+from qbaf import QBAFramework
+
+
+def test_explain_plan_acyclic():
+    args = ['a', 'b', 'c', 'd', 'e', 'f']
+    att = [('a', 'b'), ('b', 'c'), ('e', 'f')]
+    supp = [('a', 'c'), ('d', 'c')]
+    framework = QBAFramework(args, [0.5] * 6, att, supp, semantics='DFQuAD_model')
+    plan = framework.explain_plan()
+    assert plan['update_scheme'] == 'topological'
+    assert plan['kernel'] == 'topological'
+    assert plan['semantics'] == 'DFQuAD_model'
+    assert plan['native'] is True and plan['compress'] is False
+    assert plan['stale_components'] == 2 and plan['stale_arguments'] == 6
+    assert plan['threads'] == 1 and plan['hub_threads'] == 1
+    assert plan['processors'] >= 1
+    assert plan['statistics'] == {'arguments': 6, 'relations': 5, 'max_in_degree': 3, 'components': 2,
+                                  'largest_component': 4, 'levels': 3, 'max_level_width': 3,
+                                  'cycles': 0, 'largest_cycle': 0, 'arguments_in_cycles': 0}
+    assert all(isinstance(reason, str) for reason in plan['rationale'])
+    assert plan['rationale'][0].startswith('acyclic')
+
+    framework.final_strengths
+    plan = framework.explain_plan()
+    assert plan['stale_arguments'] == 0
+    assert any('up to date' in reason for reason in plan['rationale'])
+
+    framework.modify_initial_strength('e', 0.2)
+    plan = framework.explain_plan()
+    assert plan['update_scheme'] == 'incremental'
+    assert plan['stale_components'] == 1 and plan['stale_arguments'] == 2
+
+    framework.remove_attack_relation('a', 'b')
+    plan = framework.explain_plan()
+    assert plan['update_scheme'] == 'topological'
+    assert plan['stale_components'] == 2     # b changed, and e changed before
+    assert plan['stale_arguments'] == 6
+
+
+def test_explain_plan_cyclic():
+    args = ['a', 'b', 'c', 'd', 'e', 'f']
+    att = [('a', 'b'), ('b', 'c'), ('c', 'a'), ('d', 'e'), ('e', 'd'), ('f', 'f')]
+    framework = QBAFramework(args, [0.5] * 6, att, [], semantics='DFQuAD_model', allow_cycles=True)
+    plan = framework.explain_plan()
+    assert plan['update_scheme'] == 'jacobi'
+    statistics = plan['statistics']
+    assert statistics['cycles'] == 3
+    assert statistics['largest_cycle'] == 3
+    assert statistics['arguments_in_cycles'] == 6
+    assert statistics['levels'] == 0
+
+    framework = QBAFramework(args, [0.5] * 6, att, [], semantics='DFQuAD_model')
+    assert framework.explain_plan()['update_scheme'] is None
+
+
+def test_explain_plan_custom_functions():
+    framework = QBAFramework(['a', 'b'], [0.5, 0.5], [('a', 'b')], [],
+                             aggregation_function=lambda att, supp: sum(supp) - sum(att),
+                             influence_function=lambda w, s: w + s, compress=True)
+    plan = framework.explain_plan()
+    assert plan['semantics'] is None
+    assert plan['native'] is False
+    assert plan['compress'] is True
+    assert any('GIL' in reason for reason in plan['rationale'])
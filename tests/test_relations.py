@@ -170,6 +170,18 @@ def test_copy_relations():
     assert copy.relations == {(a,b), (a,c)}
 
 
+def test_copy_is_independent():
+    a, b, c = Arg('a'), Arg('b'), Arg('c')
+    relations = QBAFARelations([(a,b), (a,c)])
+    copy = relations.copy()
+    relations.remove(a, b)
+    copy.add(c, b)
+    assert relations.relations == {(a,c)}
+    assert copy.relations == {(a,b), (a,c), (c,b)}
+    assert set(copy.agents(b)) == {a, c}
+    assert set(relations.agents(b)) == set()
+
+
 def test_copy_patients():
     a, b, c = Arg('a'), Arg('b'), Arg('c')
     relations = QBAFARelations([(a,b), (a,c)])
@@ -327,4 +339,71 @@ def test___eq__():
     copy = relations.copy()
     assert relations == copy
     copy.remove(a,b)
-    assert relations != copy
\ No newline at end of file
+    assert relations != copy
+
+# TEST IDS
+
+def test_order_of_agents_and_patients():
+    a, b, c, d = Arg('a'), Arg('b'), Arg('c'), Arg('d')
+    relations = QBAFARelations([])
+    relations.add(c, a)
+    relations.add(b, a)
+    relations.add(d, a)
+    relations.add(a, a)
+    assert relations.agents(a) == [c, b, d, a]
+    relations.remove(b, a)
+    assert relations.agents(a) == [c, d, a]
+    assert relations.patients(a) == [a]
+    copy = relations.copy()
+    assert copy.agents(a) == [c, d, a]
+    copy.remove(a, a)
+    assert relations.patients(a) == [a]
+    assert copy.patients(a) == []
+
+def test_views_and_degrees():
+    a, b, c, d = Arg('a'), Arg('b'), Arg('c'), Arg('d')
+    relations = QBAFARelations([(b,a), (c,a), (a,c)])
+    agents = relations.agents_view(a)
+    assert len(agents) == 2 and agents[0] == b and agents[-1] == c
+    assert list(agents) == relations.agents(a)
+    assert c in agents and a not in agents and d not in agents
+    with pytest.raises(IndexError):
+        agents[2]
+    assert list(relations.patients_view(a)) == [c]
+    assert len(relations.patients_view(d)) == 0
+    assert relations.in_degree(a) == 2 and relations.out_degree(a) == 1
+    assert relations.in_degree(d) == 0 and relations.out_degree(b) == 1
+    relations.add(d, a)
+    with pytest.raises(RuntimeError):
+        list(agents)
+    assert relations.agents_view(a)[2] == d and relations.in_degree(a) == 3
+
+# TEST COMPACT STORAGE
+
+def test_repeated_relations_are_stored_once():
+    a, b, c = Arg('a'), Arg('b'), Arg('c')
+    relations = QBAFARelations([(a,b), (a,c), (a,b)])
+    assert len(relations) == 2
+    assert relations.agents(b) == [a]
+    relations.add(a, c)
+    assert len(relations) == 2
+    assert sorted(relations, key=str) == sorted([(a,b), (a,c)], key=str)
+    assert str(relations) == str(QBAFARelations([(a,b), (a,c)]))
+
+def test_comparisons():
+    a, b, c = Arg('a'), Arg('b'), Arg('c')
+    rel1 = QBAFARelations([(a,b)])
+    rel2 = QBAFARelations([(b,c), (a,b)])
+    assert rel1 < rel2 and rel1 <= rel2 and rel2 > rel1 and rel2 >= rel1
+    assert not rel2 < rel1 and not rel1 == rel2
+    assert rel1 == QBAFARelations([(a,b)]) and rel1 <= rel1 and not rel1 < rel1
+
+def test_many_relations():
+    args = [Arg(str(i)) for i in range(1000)]
+    pairs = [(args[i], args[(7 * i + j) % 1000]) for i in range(1000) for j in range(5)]
+    relations = QBAFARelations(pairs)
+    assert len(relations) == 5000
+    for agent, patient in pairs[::13]:
+        relations.remove(agent, patient)
+        assert not relations.contains(agent, patient)
+    assert relations.relations == set(pairs) - set(pairs[::13])